@@ -164,6 +164,8 @@ static void log_profiling_info(struct adreno_device *adreno_dev, u32 *rcvd)
 		info.active = cmd->active;
 	info.retired_on_gmu = cmd->retired_on_gmu;
 
+	kgsl_pwrscale_frame_work(device, context, info.active);
+
 	trace_adreno_cmdbatch_retired(context, &info, 0, 0, 0);
 
 	log_kgsl_cmdbatch_retired_event(context->id, cmd->ts, context->priority,
@@ -1624,6 +1626,8 @@ static void a6xx_add_profile_events(struct adreno_device *adreno_dev,
 		!!(drawobj->flags & KGSL_DRAWOBJ_END_OF_FRAME));
 	trace_adreno_cmdbatch_submitted(drawobj, &info, time->ticks,
 		(unsigned long) time_in_s, time_in_ns / 1000, 0);
+	trace_adreno_cmdbatch_submit_latency(drawobj,
+		time->ktime - cmdobj->create_ns);
 
 	log_kgsl_cmdbatch_submitted_event(context->id, drawobj->timestamp,
 		context->priority, drawobj->flags);
@@ -339,12 +339,12 @@ static int ctx_print(struct seq_file *s, void *unused)
 
 	seq_puts(s, "drawqueue:\n");
 
-	spin_lock(&drawctxt->lock);
+	spin_lock(&drawctxt->drawqueue_lock);
 	for (i = drawctxt->drawqueue_head;
-		i != drawctxt->drawqueue_tail;
+		i != adreno_drawqueue_tail(drawctxt);
 		i = DRAWQUEUE_NEXT(i, ADRENO_CONTEXT_DRAWQUEUE_SIZE))
 		drawobj_print(s, drawctxt->drawqueue[i]);
-	spin_unlock(&drawctxt->lock);
+	spin_unlock(&drawctxt->drawqueue_lock);
 
 	seq_puts(s, "events:\n");
 	spin_lock(&drawctxt->base.events.lock);
@@ -211,23 +211,16 @@ static void _retire_timestamp(struct kgsl_drawobj *drawobj)
 
 static int _check_context_queue(struct adreno_context *drawctxt, u32 count)
 {
-	int ret;
-
-	spin_lock(&drawctxt->lock);
-
 	/*
 	 * Wake up if there is room in the context or if the whole thing got
 	 * invalidated while we were asleep
 	 */
 
 	if (kgsl_context_invalid(&drawctxt->base))
-		ret = 1;
-	else
-		ret = ((drawctxt->queued + count) < _context_drawqueue_size) ? 1 : 0;
-
-	spin_unlock(&drawctxt->lock);
+		return 1;
 
-	return ret;
+	return ((adreno_drawqueue_count(drawctxt) + count) <
+		_context_drawqueue_size) ? 1 : 0;
 }
 
 /*
@@ -245,9 +238,7 @@ static bool _marker_expired(struct kgsl_drawobj_cmd *markerobj)
 
 static inline void _pop_drawobj(struct adreno_context *drawctxt)
 {
-	drawctxt->drawqueue_head = DRAWQUEUE_NEXT(drawctxt->drawqueue_head,
-		ADRENO_CONTEXT_DRAWQUEUE_SIZE);
-	drawctxt->queued--;
+	adreno_drawqueue_pop(drawctxt);
 }
 
 static int dispatch_retire_markerobj(struct kgsl_drawobj *drawobj,
@@ -270,7 +261,7 @@ static int dispatch_retire_markerobj(struct kgsl_drawobj *drawobj,
 	 * skip isn't set then we block this queue
 	 * until the dependent timestamp expires
 	 */
-	return test_bit(CMDOBJ_SKIP, &cmdobj->priv) ? 1 : -EAGAIN;
+	return adreno_drawqueue_marker_skip(drawctxt, cmdobj) ? 1 : -EAGAIN;
 }
 
 static int dispatch_retire_syncobj(struct kgsl_drawobj *drawobj,
@@ -341,12 +332,12 @@ static struct kgsl_drawobj *_process_drawqueue_get_next_drawobj(
 				struct adreno_context *drawctxt)
 {
 	struct kgsl_drawobj *drawobj;
-	unsigned int i = drawctxt->drawqueue_head;
+	unsigned int i, tail = adreno_drawqueue_tail(drawctxt);
 
-	if (drawctxt->drawqueue_head == drawctxt->drawqueue_tail)
+	if (drawctxt->drawqueue_head == tail)
 		return NULL;
 
-	for (i = drawctxt->drawqueue_head; i != drawctxt->drawqueue_tail;
+	for (i = drawctxt->drawqueue_head; i != tail;
 			i = DRAWQUEUE_NEXT(i, ADRENO_CONTEXT_DRAWQUEUE_SIZE)) {
 		int ret = 0;
 
@@ -398,36 +389,20 @@ static inline int adreno_dispatcher_requeue_cmdobj(
 		struct adreno_context *drawctxt,
 		struct kgsl_drawobj_cmd *cmdobj)
 {
-	unsigned int prev;
 	struct kgsl_drawobj *drawobj = DRAWOBJ(cmdobj);
 
-	spin_lock(&drawctxt->lock);
+	spin_lock(&drawctxt->drawqueue_lock);
 
 	if (kgsl_context_is_bad(&drawctxt->base)) {
-		spin_unlock(&drawctxt->lock);
+		spin_unlock(&drawctxt->drawqueue_lock);
 		/* get rid of this drawobj since the context is bad */
 		kgsl_drawobj_destroy(drawobj);
 		return -ENOENT;
 	}
 
-	prev = drawctxt->drawqueue_head == 0 ?
-		(ADRENO_CONTEXT_DRAWQUEUE_SIZE - 1) :
-		(drawctxt->drawqueue_head - 1);
-
-	/*
-	 * The maximum queue size always needs to be one less then the size of
-	 * the ringbuffer queue so there is "room" to put the drawobj back in
-	 */
-
-	WARN_ON(prev == drawctxt->drawqueue_tail);
-
-	drawctxt->drawqueue[prev] = drawobj;
-	drawctxt->queued++;
-
-	/* Reset the command queue head to reflect the newly requeued change */
-	drawctxt->drawqueue_head = prev;
+	adreno_drawqueue_requeue(drawctxt, drawobj);
 	cmdobj->requeue_cnt++;
-	spin_unlock(&drawctxt->lock);
+	spin_unlock(&drawctxt->drawqueue_lock);
 	return 0;
 }
 
@@ -634,6 +609,9 @@ static int sendcmd(struct adreno_device *adreno_dev,
 			time.ticks, (unsigned long) secs, nsecs / 1000,
 			dispatch_q->inflight);
 
+	trace_adreno_cmdbatch_submit_latency(drawobj,
+			time.ktime - cmdobj->create_ns);
+
 	log_kgsl_cmdbatch_submitted_event(context->id, drawobj->timestamp,
 		context->priority, drawobj->flags);
 
@@ -685,9 +663,9 @@ static int dispatcher_context_sendcmds(struct adreno_device *adreno_dev,
 	unsigned int timestamp;
 
 	if (dispatch_q->inflight >= inflight) {
-		spin_lock(&drawctxt->lock);
+		spin_lock(&drawctxt->drawqueue_lock);
 		_process_drawqueue_get_next_drawobj(drawctxt);
-		spin_unlock(&drawctxt->lock);
+		spin_unlock(&drawctxt->drawqueue_lock);
 		return -EBUSY;
 	}
 
@@ -703,7 +681,8 @@ static int dispatcher_context_sendcmds(struct adreno_device *adreno_dev,
 		if (adreno_gpu_fault(adreno_dev) != 0)
 			break;
 
-		spin_lock(&drawctxt->lock);
+		/* Only the consumer side is locked, submitters are not held up */
+		spin_lock(&drawctxt->drawqueue_lock);
 		drawobj = _process_drawqueue_get_next_drawobj(drawctxt);
 
 		/*
@@ -716,11 +695,11 @@ static int dispatcher_context_sendcmds(struct adreno_device *adreno_dev,
 		if (IS_ERR_OR_NULL(drawobj)) {
 			if (IS_ERR(drawobj))
 				ret = PTR_ERR(drawobj);
-			spin_unlock(&drawctxt->lock);
+			spin_unlock(&drawctxt->drawqueue_lock);
 			break;
 		}
 		_pop_drawobj(drawctxt);
-		spin_unlock(&drawctxt->lock);
+		spin_unlock(&drawctxt->drawqueue_lock);
 
 		timestamp = drawobj->timestamp;
 		cmdobj = CMDOBJ(drawobj);
@@ -1018,9 +997,10 @@ static inline int _wait_for_room_in_context_queue(
 	 * There is always a possibility that dispatcher may end up pushing
 	 * the last popped draw object back to the context drawqueue. Hence,
 	 * we can only queue up to _context_drawqueue_size - 1 here to make
-	 * sure we never let drawqueue->queued exceed _context_drawqueue_size.
+	 * sure we never let the queued count exceed _context_drawqueue_size.
 	 */
-	if ((drawctxt->queued + count) > (_context_drawqueue_size - 1)) {
+	if ((adreno_drawqueue_count(drawctxt) + count) >
+		(_context_drawqueue_size - 1)) {
 		trace_adreno_drawctxt_sleep(drawctxt);
 		spin_unlock(&drawctxt->lock);
 
@@ -1061,15 +1041,13 @@ static void _queue_drawobj(struct adreno_context *drawctxt,
 	struct kgsl_context *context = drawobj->context;
 
 	/* Put the command into the queue */
-	drawctxt->drawqueue[drawctxt->drawqueue_tail] = drawobj;
-	drawctxt->drawqueue_tail = (drawctxt->drawqueue_tail + 1) %
-			ADRENO_CONTEXT_DRAWQUEUE_SIZE;
-	drawctxt->queued++;
+	adreno_drawqueue_push(drawctxt, drawobj);
 	msm_perf_events_update(MSM_PERF_GFX, MSM_PERF_QUEUE,
 				pid_nr(context->proc_priv->pid),
 				context->id, drawobj->timestamp,
 				!!(drawobj->flags & KGSL_DRAWOBJ_END_OF_FRAME));
-	trace_adreno_cmdbatch_queued(drawobj, drawctxt->queued);
+	trace_adreno_cmdbatch_queued(drawobj,
+		adreno_drawqueue_count(drawctxt));
 }
 
 static int drawctxt_queue_bindobj(struct adreno_context *drawctxt,
@@ -1115,8 +1093,9 @@ static int drawctxt_queue_markerobj(struct adreno_device *adreno_dev,
 	 * See if we can fastpath this thing - if nothing is queued
 	 * and nothing is inflight retire without bothering the GPU
 	 */
-	if (!drawctxt->queued && kgsl_check_timestamp(drawobj->device,
-			drawobj->context, drawctxt->queued_timestamp)) {
+	if (!adreno_drawqueue_count(drawctxt) &&
+		kgsl_check_timestamp(drawobj->device, drawobj->context,
+			drawctxt->queued_timestamp)) {
 		_retire_timestamp(drawobj);
 		return 1;
 	}
@@ -1142,7 +1121,6 @@ static int drawctxt_queue_cmdobj(struct adreno_device *adreno_dev,
 	uint32_t *timestamp, unsigned int user_ts)
 {
 	struct kgsl_drawobj_cmd *cmdobj = CMDOBJ(drawobj);
-	unsigned int j;
 	int ret;
 
 	ret = get_timestamp(drawctxt, drawobj, timestamp, user_ts);
@@ -1151,20 +1129,10 @@ static int drawctxt_queue_cmdobj(struct adreno_device *adreno_dev,
 
 	/*
 	 * If this is a real command then we need to force any markers
-	 * queued before it to dispatch to keep time linear - set the
-	 * skip bit so the commands get NOPed.
+	 * queued before it to dispatch to keep time linear. The dispatcher
+	 * sets the skip bit on those markers so the commands get NOPed.
 	 */
-	j = drawctxt->drawqueue_head;
-
-	while (j != drawctxt->drawqueue_tail) {
-		if (drawctxt->drawqueue[j]->type == MARKEROBJ_TYPE) {
-			struct kgsl_drawobj_cmd *markerobj =
-				CMDOBJ(drawctxt->drawqueue[j]);
-				set_bit(CMDOBJ_SKIP, &markerobj->priv);
-		}
-
-		j = DRAWQUEUE_NEXT(j, ADRENO_CONTEXT_DRAWQUEUE_SIZE);
-	}
+	WRITE_ONCE(drawctxt->cmd_queued_timestamp, *timestamp);
 
 	drawctxt->queued_timestamp = *timestamp;
 	_set_ft_policy(adreno_dev, drawctxt, cmdobj);
@@ -1205,7 +1173,7 @@ static int adreno_dispatcher_queue_cmds(struct kgsl_device_private *dev_priv,
 	 * There is always a possibility that dispatcher may end up pushing
 	 * the last popped draw object back to the context drawqueue. Hence,
 	 * we can only queue up to _context_drawqueue_size - 1 here to make
-	 * sure we never let drawqueue->queued exceed _context_drawqueue_size.
+	 * sure we never let the queued count exceed _context_drawqueue_size.
 	 */
 	if (!count || count > _context_drawqueue_size - 1)
 		return -EINVAL;
@@ -2157,6 +2125,8 @@ static void retire_cmdobj(struct adreno_device *adreno_dev,
 		kgsl_work_period_update(KGSL_DEVICE(adreno_dev),
 					     context->proc_priv->period, active);
 
+	kgsl_pwrscale_frame_work(KGSL_DEVICE(adreno_dev), context, active);
+
 	msm_perf_events_update(MSM_PERF_GFX, MSM_PERF_RETIRED,
 			       pid_nr(context->proc_priv->pid),
 			       context->id, drawobj->timestamp,
@@ -2165,6 +2135,7 @@ static void retire_cmdobj(struct adreno_device *adreno_dev,
 	if (drawobj->flags & KGSL_DRAWOBJ_END_OF_FRAME) {
 		atomic64_inc(&context->proc_priv->frame_count);
 		atomic_inc(&context->proc_priv->period->frames);
+		kgsl_pwrscale_frame_done(KGSL_DEVICE(adreno_dev), context);
 	}
 
 	/*
@@ -72,19 +72,31 @@ void adreno_drawctxt_dump(struct kgsl_device *device,
 		context->id, queue, drawctxt->submitted_timestamp,
 		start, retire);
 
-	if (drawctxt->drawqueue_head != drawctxt->drawqueue_tail) {
+	/* The dispatcher pops drawobjs under drawqueue_lock only */
+	if (!spin_trylock(&drawctxt->drawqueue_lock)) {
+		dev_err(device->dev, "  context[%u]: could not get queue lock\n",
+			context->id);
+		goto stats;
+	}
+
+	if (drawctxt->drawqueue_head != adreno_drawqueue_tail(drawctxt)) {
 		struct kgsl_drawobj *drawobj =
 			drawctxt->drawqueue[drawctxt->drawqueue_head];
 
 		if (test_bit(ADRENO_CONTEXT_FENCE_LOG, &context->priv)) {
+			spin_unlock(&drawctxt->drawqueue_lock);
 			dev_err(device->dev,
 				"  possible deadlock. Context %u might be blocked for itself\n",
 				context->id);
 			goto stats;
 		}
 
-		if (!kref_get_unless_zero(&drawobj->refcount))
+		if (!kref_get_unless_zero(&drawobj->refcount)) {
+			spin_unlock(&drawctxt->drawqueue_lock);
 			goto stats;
+		}
+
+		spin_unlock(&drawctxt->drawqueue_lock);
 
 		if (drawobj->type == SYNCOBJ_TYPE) {
 			struct kgsl_drawobj_sync *syncobj = SYNCOBJ(drawobj);
@@ -99,6 +111,8 @@ void adreno_drawctxt_dump(struct kgsl_device *device,
 		}
 
 		kgsl_drawobj_put(drawobj);
+	} else {
+		spin_unlock(&drawctxt->drawqueue_lock);
 	}
 
 stats:
@@ -231,16 +245,16 @@ static int drawctxt_detach_drawobjs(struct adreno_context *drawctxt,
 {
 	int count = 0;
 
-	while (drawctxt->drawqueue_head != drawctxt->drawqueue_tail) {
-		struct kgsl_drawobj *drawobj =
-			drawctxt->drawqueue[drawctxt->drawqueue_head];
+	/* Keep the dispatcher away while the queue is drained */
+	spin_lock(&drawctxt->drawqueue_lock);
 
-		drawctxt->drawqueue_head = (drawctxt->drawqueue_head + 1) %
-			ADRENO_CONTEXT_DRAWQUEUE_SIZE;
-
-		list[count++] = drawobj;
+	while (drawctxt->drawqueue_head != adreno_drawqueue_tail(drawctxt)) {
+		list[count++] = drawctxt->drawqueue[drawctxt->drawqueue_head];
+		adreno_drawqueue_pop(drawctxt);
 	}
 
+	spin_unlock(&drawctxt->drawqueue_lock);
+
 	return count;
 }
 
@@ -389,6 +403,7 @@ adreno_drawctxt_create(struct kgsl_device_private *dev_priv,
 	drawctxt->type = (drawctxt->base.flags & KGSL_CONTEXT_TYPE_MASK)
 		>> KGSL_CONTEXT_TYPE_SHIFT;
 	spin_lock_init(&drawctxt->lock);
+	spin_lock_init(&drawctxt->drawqueue_lock);
 	init_waitqueue_head(&drawctxt->wq);
 	init_waitqueue_head(&drawctxt->waiting);
 	init_waitqueue_head(&drawctxt->timeout);
@@ -28,15 +28,14 @@ struct kgsl_device_private;
  * @internal_timestamp: Global timestamp of the last issued command
  *			NOTE: guarded by device->mutex, not drawctxt->mutex!
  * @type: Context type (GL, CL, RS)
- * @mutex: Mutex to protect the drawqueue
+ * @lock: Spinlock serializing the submitters and the context state
  * @drawqueue: Queue of drawobjs waiting to be dispatched for this
  *			context
- * @drawqueue_head: Head of the drawqueue queue
- * @drawqueue_tail: Tail of the drawqueue queue
+ * @drawqueue_head: Head of the drawqueue queue, only moved by the consumer
+ * @drawqueue_tail: Tail of the drawqueue queue, only moved by the producer
  * @wq: Workqueue structure for contexts to sleep pending room in the queue
  * @waiting: Workqueue structure for contexts waiting for a timestamp or event
  * @timeout: Workqueue structure for contexts waiting to invalidate
- * @queued: Number of commands queued in the drawqueue
  * @fault_policy: GFT fault policy set in _skip_cmd();
  * @debug_root: debugfs entry for this context.
  * @queued_timestamp: The last timestamp that was queued on this context
@@ -65,7 +64,6 @@ struct adreno_context {
 	wait_queue_head_t waiting;
 	wait_queue_head_t timeout;
 
-	int queued;
 	unsigned int fault_policy;
 	struct dentry *debug_root;
 	unsigned int queued_timestamp;
@@ -88,8 +86,131 @@ struct adreno_context {
 	u32 hw_fence_count;
 	/** @syncobj_timestamp: Timestamp to check whether GMU has consumed a syncobj */
 	u32 syncobj_timestamp;
+	/**
+	 * @drawqueue_lock: Serializes the consumers of the drawqueue, i.e. the
+	 * dispatcher against the detach, invalidate and debug paths. Nests
+	 * inside @lock.
+	 */
+	spinlock_t drawqueue_lock;
+	/**
+	 * @cmd_queued_timestamp: Timestamp of the last command object queued.
+	 * Markers queued before it are dispatched as NOPs.
+	 */
+	u32 cmd_queued_timestamp;
 };
 
+/*
+ * The drawqueue is a single producer/single consumer ring. Submitters hold
+ * drawctxt->lock and only move the tail, the consumers hold
+ * drawctxt->drawqueue_lock and only move the head, so that queueing a command
+ * never waits for the dispatcher and vice versa.
+ */
+
+/**
+ * adreno_drawqueue_count() - Number of drawobjs in the context drawqueue
+ * @drawctxt: Pointer to the adreno draw context
+ *
+ * Return: Number of drawobjs queued, may be stale when called by the side not
+ * owning the index that moved
+ */
+static inline u32 adreno_drawqueue_count(struct adreno_context *drawctxt)
+{
+	u32 head = smp_load_acquire(&drawctxt->drawqueue_head);
+	u32 tail = smp_load_acquire(&drawctxt->drawqueue_tail);
+
+	return (tail + ADRENO_CONTEXT_DRAWQUEUE_SIZE - head) %
+		ADRENO_CONTEXT_DRAWQUEUE_SIZE;
+}
+
+/**
+ * adreno_drawqueue_push() - Add a drawobj at the tail of the drawqueue
+ * @drawctxt: Pointer to the adreno draw context
+ * @drawobj: Pointer to the drawobj to queue
+ *
+ * Must be called with drawctxt->lock held and room in the queue.
+ */
+static inline void adreno_drawqueue_push(struct adreno_context *drawctxt,
+		struct kgsl_drawobj *drawobj)
+{
+	u32 tail = drawctxt->drawqueue_tail;
+
+	drawctxt->drawqueue[tail] = drawobj;
+
+	/* Publish the slot before the consumer can see the new tail */
+	smp_store_release(&drawctxt->drawqueue_tail,
+		(tail + 1) % ADRENO_CONTEXT_DRAWQUEUE_SIZE);
+}
+
+/**
+ * adreno_drawqueue_tail() - Get the tail of the drawqueue for the consumer
+ * @drawctxt: Pointer to the adreno draw context
+ *
+ * Return: The tail index. All the slots up to it are safe to read.
+ */
+static inline u32 adreno_drawqueue_tail(struct adreno_context *drawctxt)
+{
+	return smp_load_acquire(&drawctxt->drawqueue_tail);
+}
+
+/**
+ * adreno_drawqueue_pop() - Remove the drawobj at the head of the drawqueue
+ * @drawctxt: Pointer to the adreno draw context
+ *
+ * Must be called with drawctxt->drawqueue_lock held.
+ */
+static inline void adreno_drawqueue_pop(struct adreno_context *drawctxt)
+{
+	/* The producer may reuse the slot once the head moves */
+	smp_store_release(&drawctxt->drawqueue_head,
+		(drawctxt->drawqueue_head + 1) % ADRENO_CONTEXT_DRAWQUEUE_SIZE);
+}
+
+/**
+ * adreno_drawqueue_requeue() - Put a drawobj back at the head of the drawqueue
+ * @drawctxt: Pointer to the adreno draw context
+ * @drawobj: Pointer to the drawobj that was last popped
+ *
+ * Must be called with drawctxt->drawqueue_lock held.
+ */
+static inline void adreno_drawqueue_requeue(struct adreno_context *drawctxt,
+		struct kgsl_drawobj *drawobj)
+{
+	u32 prev = drawctxt->drawqueue_head == 0 ?
+		(ADRENO_CONTEXT_DRAWQUEUE_SIZE - 1) :
+		(drawctxt->drawqueue_head - 1);
+
+	/*
+	 * The maximum queue size always needs to be one less then the size of
+	 * the ringbuffer queue so there is "room" to put the drawobj back in
+	 */
+	WARN_ON(prev == adreno_drawqueue_tail(drawctxt));
+
+	drawctxt->drawqueue[prev] = drawobj;
+	smp_store_release(&drawctxt->drawqueue_head, prev);
+}
+
+/**
+ * adreno_drawqueue_marker_skip() - Check if a queued marker must be dispatched
+ * @drawctxt: Pointer to the adreno draw context
+ * @markerobj: Pointer to the marker at the head of the drawqueue
+ *
+ * A real command queued after the marker forces the marker to be sent to the
+ * GPU as a NOP to keep the timestamps linear. The consumer sets the skip bit
+ * itself so that submitters never touch drawobjs already in the queue.
+ *
+ * Return: True if the CMDOBJ_SKIP bit is set on the marker
+ */
+static inline bool adreno_drawqueue_marker_skip(
+		struct adreno_context *drawctxt,
+		struct kgsl_drawobj_cmd *markerobj)
+{
+	if (timestamp_cmp(READ_ONCE(drawctxt->cmd_queued_timestamp),
+			DRAWOBJ(markerobj)->timestamp) > 0)
+		set_bit(CMDOBJ_SKIP, &markerobj->priv);
+
+	return test_bit(CMDOBJ_SKIP, &markerobj->priv);
+}
+
 /* Flag definitions for flag field in adreno_context */
 
 /**
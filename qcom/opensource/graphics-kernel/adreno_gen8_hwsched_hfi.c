@@ -225,6 +225,8 @@ static void log_profiling_info(struct adreno_device *adreno_dev, u32 *rcvd)
 		kgsl_work_period_update(device, context->proc_priv->period,
 					     info.active);
 
+	kgsl_pwrscale_frame_work(device, context, info.active);
+
 	trace_adreno_cmdbatch_retired(context, &info, 0, 0, 0);
 
 	log_kgsl_cmdbatch_retired_event(context->id, cmd->ts,
@@ -2595,6 +2597,8 @@ static void gen8_add_profile_events(struct adreno_device *adreno_dev,
 		!!(drawobj->flags & KGSL_DRAWOBJ_END_OF_FRAME));
 	trace_adreno_cmdbatch_submitted(drawobj, &info, time->ticks,
 		(unsigned long) time_in_s, time_in_ns / 1000, 0);
+	trace_adreno_cmdbatch_submit_latency(drawobj,
+		time->ktime - cmdobj->create_ns);
 
 	log_kgsl_cmdbatch_submitted_event(context->id, drawobj->timestamp,
 			context->priority, drawobj->flags);
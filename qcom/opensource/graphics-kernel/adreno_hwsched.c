@@ -53,30 +53,21 @@ static bool is_cmdobj(struct kgsl_drawobj *drawobj)
 
 static bool _check_context_queue(struct adreno_context *drawctxt, u32 count)
 {
-	bool ret;
-
-	spin_lock(&drawctxt->lock);
-
 	/*
 	 * Wake up if there is room in the context or if the whole thing got
 	 * invalidated while we were asleep
 	 */
 
 	if (kgsl_context_invalid(&drawctxt->base))
-		ret = false;
-	else
-		ret = ((drawctxt->queued + count) < _context_drawqueue_size) ? 1 : 0;
-
-	spin_unlock(&drawctxt->lock);
+		return false;
 
-	return ret;
+	return ((adreno_drawqueue_count(drawctxt) + count) <
+		_context_drawqueue_size) ? 1 : 0;
 }
 
 static void _pop_drawobj(struct adreno_context *drawctxt)
 {
-	drawctxt->drawqueue_head = DRAWQUEUE_NEXT(drawctxt->drawqueue_head,
-		ADRENO_CONTEXT_DRAWQUEUE_SIZE);
-	drawctxt->queued--;
+	adreno_drawqueue_pop(drawctxt);
 }
 
 static int _retire_syncobj(struct adreno_device *adreno_dev,
@@ -189,7 +180,7 @@ static int _retire_markerobj(struct adreno_device *adreno_dev, struct kgsl_drawo
 	 * until the dependent timestamp expires
 	 */
 
-	return test_bit(CMDOBJ_SKIP, &cmdobj->priv) ? 1 : -EAGAIN;
+	return adreno_drawqueue_marker_skip(drawctxt, cmdobj) ? 1 : -EAGAIN;
 }
 
 static int _retire_timelineobj(struct kgsl_drawobj *drawobj,
@@ -237,15 +228,15 @@ static struct kgsl_drawobj *_process_drawqueue_get_next_drawobj(
 	struct adreno_device *adreno_dev, struct adreno_context *drawctxt)
 {
 	struct kgsl_drawobj *drawobj;
-	unsigned int i = drawctxt->drawqueue_head;
+	unsigned int i, tail = adreno_drawqueue_tail(drawctxt);
 	struct kgsl_drawobj_cmd *cmdobj;
 	struct adreno_hwsched *hwsched = &adreno_dev->hwsched;
 	int ret = 0;
 
-	if (drawctxt->drawqueue_head == drawctxt->drawqueue_tail)
+	if (drawctxt->drawqueue_head == tail)
 		return NULL;
 
-	for (i = drawctxt->drawqueue_head; i != drawctxt->drawqueue_tail;
+	for (i = drawctxt->drawqueue_head; i != tail;
 			i = DRAWQUEUE_NEXT(i, ADRENO_CONTEXT_DRAWQUEUE_SIZE)) {
 
 		drawobj = drawctxt->drawqueue[i];
@@ -306,39 +297,22 @@ static inline int hwsched_dispatcher_requeue_drawobj(
 		struct adreno_context *drawctxt,
 		struct kgsl_drawobj *drawobj)
 {
-	unsigned int prev;
-
-	spin_lock(&drawctxt->lock);
+	spin_lock(&drawctxt->drawqueue_lock);
 
 	if (kgsl_context_is_bad(&drawctxt->base)) {
-		spin_unlock(&drawctxt->lock);
+		spin_unlock(&drawctxt->drawqueue_lock);
 		/* get rid of this drawobj since the context is bad */
 		kgsl_drawobj_destroy(drawobj);
 		return -ENOENT;
 	}
 
-	prev = drawctxt->drawqueue_head == 0 ?
-		(ADRENO_CONTEXT_DRAWQUEUE_SIZE - 1) :
-		(drawctxt->drawqueue_head - 1);
-
-	/*
-	 * The maximum queue size always needs to be one less then the size of
-	 * the ringbuffer queue so there is "room" to put the drawobj back in
-	 */
-
-	WARN_ON(prev == drawctxt->drawqueue_tail);
-
-	drawctxt->drawqueue[prev] = drawobj;
-	drawctxt->queued++;
-
-	/* Reset the command queue head to reflect the newly requeued change */
-	drawctxt->drawqueue_head = prev;
+	adreno_drawqueue_requeue(drawctxt, drawobj);
 	if (is_cmdobj(drawobj)) {
 		struct kgsl_drawobj_cmd *cmdobj = CMDOBJ(drawobj);
 
 		cmdobj->requeue_cnt++;
 	}
-	spin_unlock(&drawctxt->lock);
+	spin_unlock(&drawctxt->drawqueue_lock);
 	return 0;
 }
 
@@ -529,7 +503,8 @@ static int hwsched_sendcmds(struct adreno_device *adreno_dev,
 		struct kgsl_drawobj_cmd *cmdobj = NULL;
 		struct kgsl_context *context;
 
-		spin_lock(&drawctxt->lock);
+		/* Only the consumer side is locked, submitters are not held up */
+		spin_lock(&drawctxt->drawqueue_lock);
 		drawobj = _process_drawqueue_get_next_drawobj(adreno_dev,
 				drawctxt);
 
@@ -543,11 +518,11 @@ static int hwsched_sendcmds(struct adreno_device *adreno_dev,
 		if (IS_ERR_OR_NULL(drawobj)) {
 			if (IS_ERR(drawobj))
 				ret = PTR_ERR(drawobj);
-			spin_unlock(&drawctxt->lock);
+			spin_unlock(&drawctxt->drawqueue_lock);
 			break;
 		}
 		_pop_drawobj(drawctxt);
-		spin_unlock(&drawctxt->lock);
+		spin_unlock(&drawctxt->drawqueue_lock);
 
 		if (is_cmdobj(drawobj) || is_marker_skip(drawobj)) {
 			cmdobj = CMDOBJ(drawobj);
@@ -755,9 +730,10 @@ static inline int _wait_for_room_in_context_queue(
 	 * There is always a possibility that dispatcher may end up pushing
 	 * the last popped draw object back to the context drawqueue. Hence,
 	 * we can only queue up to _context_drawqueue_size - 1 here to make
-	 * sure we never let drawqueue->queued exceed _context_drawqueue_size.
+	 * sure we never let the queued count exceed _context_drawqueue_size.
 	 */
-	if ((drawctxt->queued + count) > (_context_drawqueue_size - 1)) {
+	if ((adreno_drawqueue_count(drawctxt) + count) >
+		(_context_drawqueue_size - 1)) {
 		trace_adreno_drawctxt_sleep(drawctxt);
 		spin_unlock(&drawctxt->lock);
 
@@ -798,15 +774,13 @@ static void _queue_drawobj(struct adreno_context *drawctxt,
 	struct kgsl_context *context = drawobj->context;
 
 	/* Put the command into the queue */
-	drawctxt->drawqueue[drawctxt->drawqueue_tail] = drawobj;
-	drawctxt->drawqueue_tail = (drawctxt->drawqueue_tail + 1) %
-			ADRENO_CONTEXT_DRAWQUEUE_SIZE;
-	drawctxt->queued++;
+	adreno_drawqueue_push(drawctxt, drawobj);
 	msm_perf_events_update(MSM_PERF_GFX, MSM_PERF_QUEUE,
 		pid_nr(context->proc_priv->pid),
 		context->id, drawobj->timestamp,
 		!!(drawobj->flags & KGSL_DRAWOBJ_END_OF_FRAME));
-	trace_adreno_cmdbatch_queued(drawobj, drawctxt->queued);
+	trace_adreno_cmdbatch_queued(drawobj,
+		adreno_drawqueue_count(drawctxt));
 }
 
 static int _queue_cmdobj(struct adreno_device *adreno_dev,
@@ -814,7 +788,6 @@ static int _queue_cmdobj(struct adreno_device *adreno_dev,
 	uint32_t *timestamp, unsigned int user_ts)
 {
 	struct kgsl_drawobj *drawobj = DRAWOBJ(cmdobj);
-	u32 j;
 	int ret;
 
 	ret = get_timestamp(drawctxt, drawobj, timestamp, user_ts);
@@ -823,21 +796,10 @@ static int _queue_cmdobj(struct adreno_device *adreno_dev,
 
 	/*
 	 * If this is a real command then we need to force any markers
-	 * queued before it to dispatch to keep time linear - set the
-	 * skip bit so the commands get NOPed.
+	 * queued before it to dispatch to keep time linear. The dispatcher
+	 * sets the skip bit on those markers so the commands get NOPed.
 	 */
-	j = drawctxt->drawqueue_head;
-
-	while (j != drawctxt->drawqueue_tail) {
-		if (drawctxt->drawqueue[j]->type == MARKEROBJ_TYPE) {
-			struct kgsl_drawobj_cmd *markerobj =
-				CMDOBJ(drawctxt->drawqueue[j]);
-
-			set_bit(CMDOBJ_SKIP, &markerobj->priv);
-		}
-
-		j = DRAWQUEUE_NEXT(j, ADRENO_CONTEXT_DRAWQUEUE_SIZE);
-	}
+	WRITE_ONCE(drawctxt->cmd_queued_timestamp, *timestamp);
 
 	drawctxt->queued_timestamp = *timestamp;
 
@@ -872,8 +834,9 @@ static int _queue_markerobj(struct adreno_device *adreno_dev,
 	 * See if we can fastpath this thing - if nothing is queued
 	 * and nothing is inflight retire without bothering the GPU
 	 */
-	if (!drawctxt->queued && kgsl_check_timestamp(drawobj->device,
-		drawobj->context, drawctxt->queued_timestamp)) {
+	if (!adreno_drawqueue_count(drawctxt) &&
+		kgsl_check_timestamp(drawobj->device, drawobj->context,
+			drawctxt->queued_timestamp)) {
 		_retire_timestamp(drawobj);
 		return 1;
 	}
@@ -936,7 +899,7 @@ static int adreno_hwsched_queue_cmds(struct kgsl_device_private *dev_priv,
 	 * There is always a possibility that dispatcher may end up pushing
 	 * the last popped draw object back to the context drawqueue. Hence,
 	 * we can only queue up to _context_drawqueue_size - 1 here to make
-	 * sure we never let drawqueue->queued exceed _context_drawqueue_size.
+	 * sure we never let the queued count exceed _context_drawqueue_size.
 	 */
 	if (!count || count > _context_drawqueue_size - 1)
 		return -EINVAL;
@@ -1085,6 +1048,7 @@ void adreno_hwsched_retire_cmdobj(struct adreno_hwsched *hwsched,
 	if (drawobj->flags & KGSL_DRAWOBJ_END_OF_FRAME) {
 		atomic64_inc(&drawobj->context->proc_priv->frame_count);
 		atomic_inc(&drawobj->context->proc_priv->period->frames);
+		kgsl_pwrscale_frame_done(drawobj->device, context);
 	}
 
 	entry = cmdobj->profiling_buf_entry;
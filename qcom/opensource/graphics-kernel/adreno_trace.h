@@ -228,6 +228,28 @@ TRACE_EVENT(adreno_cmdbatch_submitted,
 	)
 );
 
+TRACE_EVENT(adreno_cmdbatch_submit_latency,
+	TP_PROTO(struct kgsl_drawobj *drawobj, u64 latency_ns),
+	TP_ARGS(drawobj, latency_ns),
+	TP_STRUCT__entry(
+		__field(unsigned int, id)
+		__field(unsigned int, timestamp)
+		__field(int, prio)
+		__field(u64, latency_ns)
+	),
+	TP_fast_assign(
+		__entry->id = drawobj->context->id;
+		__entry->timestamp = drawobj->timestamp;
+		__entry->prio = drawobj->context->priority;
+		__entry->latency_ns = latency_ns;
+	),
+	TP_printk(
+		"ctx=%u ctx_prio=%d ts=%u latency_ns=%llu",
+			__entry->id, __entry->prio, __entry->timestamp,
+			__entry->latency_ns
+	)
+);
+
 TRACE_EVENT(adreno_cmdbatch_retired,
 		TP_PROTO(struct kgsl_context *context, struct retire_info *info,
 			unsigned int flags, int q_inflight,
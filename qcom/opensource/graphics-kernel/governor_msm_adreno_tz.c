@@ -18,6 +18,7 @@
 #include <linux/qtee_shmbridge.h>
 
 #include "governor.h"
+#include "kgsl_trace.h"
 #include "msm_adreno_devfreq.h"
 
 static DEFINE_SPINLOCK(tz_lock);
@@ -56,6 +57,14 @@ static DEFINE_SPINLOCK(suspend_lock);
 
 #define TAG "msm_adreno_tz: "
 
+/*
+ * Fall back to the TZ algorithm when no frame retired for FRAME_STALE_NS,
+ * i.e. the GPU is running something that isn't frame based
+ */
+#define FRAME_STALE_NS		(100 * NSEC_PER_MSEC)
+/* The prediction moves down by 1/(2^FRAME_DECAY_SHIFT) per sample */
+#define FRAME_DECAY_SHIFT	2
+
 static u64 suspend_time;
 static u64 suspend_start;
 static unsigned long acc_total, acc_relative_busy;
@@ -151,15 +160,76 @@ static ssize_t mod_percent_show(struct device *dev,
 	return scnprintf(buf, PAGE_SIZE, "%u\n", priv->mod_percent);
 }
 
+static ssize_t frame_deadline_us_store(struct device *dev,
+			struct device_attribute *attr,
+			const char *buf, size_t count)
+{
+	int ret;
+	unsigned int val;
+	struct devfreq *devfreq = to_devfreq(dev);
+	struct devfreq_msm_adreno_tz_data *priv = devfreq->data;
+
+	ret = kstrtou32(buf, 0, &val);
+	if (ret)
+		return ret;
+
+	/* 0 disables the frame based selection */
+	WRITE_ONCE(priv->frame.deadline_us, min_t(u32, val, USEC_PER_SEC));
+
+	return count;
+}
+
+static ssize_t frame_deadline_us_show(struct device *dev,
+			struct device_attribute *attr, char *buf)
+{
+	struct devfreq *devfreq = to_devfreq(dev);
+	struct devfreq_msm_adreno_tz_data *priv = devfreq->data;
+
+	return scnprintf(buf, PAGE_SIZE, "%u\n",
+		READ_ONCE(priv->frame.deadline_us));
+}
+
+static ssize_t frame_headroom_store(struct device *dev,
+			struct device_attribute *attr,
+			const char *buf, size_t count)
+{
+	int ret;
+	unsigned int val;
+	struct devfreq *devfreq = to_devfreq(dev);
+	struct devfreq_msm_adreno_tz_data *priv = devfreq->data;
+
+	ret = kstrtou32(buf, 0, &val);
+	if (ret)
+		return ret;
+
+	WRITE_ONCE(priv->frame.headroom, min_t(u32, val, 100));
+
+	return count;
+}
+
+static ssize_t frame_headroom_show(struct device *dev,
+			struct device_attribute *attr, char *buf)
+{
+	struct devfreq *devfreq = to_devfreq(dev);
+	struct devfreq_msm_adreno_tz_data *priv = devfreq->data;
+
+	return scnprintf(buf, PAGE_SIZE, "%u\n",
+		READ_ONCE(priv->frame.headroom));
+}
+
 static DEVICE_ATTR_RO(gpu_load);
 
 static DEVICE_ATTR_RO(suspend_time);
 static DEVICE_ATTR_RW(mod_percent);
+static DEVICE_ATTR_RW(frame_deadline_us);
+static DEVICE_ATTR_RW(frame_headroom);
 
 static const struct device_attribute *adreno_tz_attr_list[] = {
 		&dev_attr_gpu_load,
 		&dev_attr_suspend_time,
 		&dev_attr_mod_percent,
+		&dev_attr_frame_deadline_us,
+		&dev_attr_frame_headroom,
 		NULL
 };
 
@@ -343,12 +413,135 @@ static inline int devfreq_get_freq_level(struct devfreq *devfreq,
 	return -EINVAL;
 }
 
+void msm_adreno_tz_frame_update(struct devfreq_msm_adreno_tz_data *priv,
+		u64 cycles)
+{
+	spin_lock(&priv->frame.lock);
+	priv->frame.window_cycles += cycles;
+	priv->frame.window_max = max(priv->frame.window_max, cycles);
+	priv->frame.window_frames++;
+	priv->frame.last_ns = ktime_get_ns();
+	spin_unlock(&priv->frame.lock);
+}
+
+/*
+ * GPU cycles needed per deadline period. The frames of all the contexts
+ * retired during the sample share the GPU, so their cycles are summed and
+ * scaled to one deadline period, and never more than the GPU was actually
+ * busy for. A single frame heavier than that still has to fit the deadline.
+ */
+static u64 frame_demand(u64 sum_cycles, u64 max_cycles, u64 busy_cycles,
+		u64 elapsed_us, u32 deadline_us)
+{
+	u64 period_cycles;
+
+	sum_cycles = min(sum_cycles, busy_cycles);
+	max_cycles = min(max_cycles, sum_cycles);
+
+	if (!elapsed_us)
+		return max_cycles;
+
+	period_cycles = div64_u64(sum_cycles * deadline_us, elapsed_us);
+
+	return max(period_cycles, max_cycles);
+}
+
+/*
+ * Jump to the heaviest demand of the sample right away so that a heavier
+ * scene doesn't jank, and only decay slowly towards lighter frames so that a
+ * steady load settles on the lowest level that meets the deadline.
+ */
+static u64 frame_predict(u64 predicted, u64 demand)
+{
+	if (demand >= predicted)
+		return demand;
+
+	return predicted - ((predicted - demand) >> FRAME_DECAY_SHIFT);
+}
+
+/*
+ * Lowest level of @freq_table, level 0 being the highest frequency, that can
+ * run @predicted cycles plus @headroom percent within @deadline_us
+ */
+static int frame_pick_level(const unsigned long *freq_table, int max_state,
+		u64 predicted, u32 headroom, u32 deadline_us, u64 *target)
+{
+	int level;
+
+	/* Cycles per second needed to finish the frame within the deadline */
+	*target = div_u64(predicted * (100 + headroom) * (USEC_PER_SEC / 100),
+		deadline_us);
+
+	for (level = max_state - 1; level > 0; level--)
+		if (freq_table[level] >= *target)
+			break;
+
+	return level;
+}
+
+/*
+ * Pick the level for the frames retired during the sample. Returns a
+ * negative error when the TZ algorithm should be used instead.
+ */
+static int frame_get_target_level(struct devfreq *devfreq,
+		struct devfreq_msm_adreno_tz_data *priv, u64 busy_us,
+		u64 elapsed_us, unsigned long cur_freq)
+{
+	u32 deadline = READ_ONCE(priv->frame.deadline_us);
+	u64 window, window_max, busy_cycles, demand, predicted, target;
+	u32 frames;
+	int level;
+
+	if (!deadline)
+		return -EINVAL;
+
+	busy_cycles = div_u64(busy_us * cur_freq, USEC_PER_SEC);
+
+	spin_lock(&priv->frame.lock);
+
+	if (ktime_get_ns() - priv->frame.last_ns > FRAME_STALE_NS) {
+		priv->frame.predicted = 0;
+		spin_unlock(&priv->frame.lock);
+		return -ENODATA;
+	}
+
+	window = priv->frame.window_cycles;
+	window_max = priv->frame.window_max;
+	frames = priv->frame.window_frames;
+	priv->frame.window_cycles = 0;
+	priv->frame.window_max = 0;
+	priv->frame.window_frames = 0;
+
+	demand = frame_demand(window, window_max, busy_cycles, elapsed_us,
+		deadline);
+
+	/* Keep the last prediction if no frame retired during this sample */
+	if (frames)
+		priv->frame.predicted = frame_predict(priv->frame.predicted,
+			demand);
+
+	predicted = priv->frame.predicted;
+
+	spin_unlock(&priv->frame.lock);
+
+	level = frame_pick_level(devfreq->profile->freq_table,
+		devfreq->profile->max_state, predicted,
+		READ_ONCE(priv->frame.headroom), deadline, &target);
+
+	trace_kgsl_frame_dcvs(deadline, frames, window, window_max,
+		busy_cycles, elapsed_us, predicted, target,
+		devfreq->profile->freq_table[level]);
+
+	return level;
+}
+
 static int tz_get_target_freq(struct devfreq *devfreq, unsigned long *freq)
 {
 	int result = 0;
 	struct devfreq_msm_adreno_tz_data *priv = devfreq->data;
 	struct devfreq_dev_status *stats = &devfreq->last_status;
 	int val, level = 0;
+	int frame_level;
 	int context_count = 0;
 	u64 busy_time;
 
@@ -398,13 +591,21 @@ static int tz_get_target_freq(struct devfreq *devfreq, unsigned long *freq)
 		return 0;
 	}
 
+	/* Consumes the frames of the sample even on a busy burst */
+	frame_level = frame_get_target_level(devfreq, priv,
+		priv->bin.busy_time, priv->bin.total_time,
+		stats->current_frequency);
+
 	/*
 	 * If there is an extended block of busy processing,
-	 * increase frequency.  Otherwise run the normal algorithm.
+	 * increase frequency.  Otherwise pick the level for the frame
+	 * deadline, or run the normal algorithm.
 	 */
 	if (!priv->disable_busy_time_burst &&
 			priv->bin.busy_time > CEILING) {
 		val = -1 * level;
+	} else if (frame_level >= 0) {
+		val = frame_level - level;
 	} else {
 		val = __secure_tz_update_entry3(level, priv->bin.total_time,
 			priv->bin.busy_time, context_count, priv);
@@ -507,6 +708,12 @@ static int tz_suspend(struct devfreq *devfreq)
 
 	priv->bin.total_time = 0;
 	priv->bin.busy_time = 0;
+
+	spin_lock(&priv->frame.lock);
+	priv->frame.window_cycles = 0;
+	priv->frame.window_max = 0;
+	priv->frame.window_frames = 0;
+	spin_unlock(&priv->frame.lock);
 	return 0;
 }
 
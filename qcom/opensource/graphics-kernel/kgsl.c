@@ -266,6 +266,7 @@ static struct kgsl_mem_entry *kgsl_mem_entry_create(void)
 		kref_get(&entry->refcount);
 		atomic_set(&entry->map_count, 0);
 		atomic_set(&entry->vbo_count, 0);
+		RB_CLEAR_NODE(&entry->gpuaddr_node.rb);
 	}
 
 	return entry;
@@ -426,7 +427,8 @@ kgsl_mem_entry_destroy(struct kref *kref)
 
 	kgsl_sharedmem_free(&entry->memdesc);
 
-	kfree(entry);
+	/* kgsl_sharedmem_find() may still be walking over the entry */
+	kfree_rcu(entry, rcu);
 }
 
 /* Scheduled by kgsl_mem_entry_destroy_deferred() */
@@ -447,6 +449,46 @@ void kgsl_mem_entry_destroy_deferred(struct kref *kref)
 	queue_work(kgsl_driver.lockless_workqueue, &entry->work);
 }
 
+/*
+ * Add the entry to the GPU address interval tree of its process once it has a
+ * GPU address. Must be called with the process mem_lock held.
+ */
+static void kgsl_mem_entry_tree_insert(struct kgsl_mem_entry *entry)
+{
+	struct kgsl_process_private *private = entry->priv;
+	struct kgsl_memdesc *memdesc = &entry->memdesc;
+
+	lockdep_assert_held(&private->mem_lock);
+
+	if (!memdesc->gpuaddr || !memdesc->size ||
+		!RB_EMPTY_NODE(&entry->gpuaddr_node.rb))
+		return;
+
+	entry->gpuaddr_node.start = memdesc->gpuaddr;
+	entry->gpuaddr_node.last = memdesc->gpuaddr + memdesc->size - 1;
+
+	write_seqcount_begin(&private->mem_seq);
+	interval_tree_insert(&entry->gpuaddr_node, &private->mem_tree);
+	write_seqcount_end(&private->mem_seq);
+}
+
+/* Must be called with the process mem_lock held */
+static void kgsl_mem_entry_tree_remove(struct kgsl_mem_entry *entry)
+{
+	struct kgsl_process_private *private = entry->priv;
+
+	lockdep_assert_held(&private->mem_lock);
+
+	if (RB_EMPTY_NODE(&entry->gpuaddr_node.rb))
+		return;
+
+	write_seqcount_begin(&private->mem_seq);
+	interval_tree_remove(&entry->gpuaddr_node, &private->mem_tree);
+	write_seqcount_end(&private->mem_seq);
+
+	RB_CLEAR_NODE(&entry->gpuaddr_node.rb);
+}
+
 /* Commit the entry to the process so it can be accessed by other operations */
 static void kgsl_mem_entry_commit_process(struct kgsl_mem_entry *entry)
 {
@@ -455,6 +497,7 @@ static void kgsl_mem_entry_commit_process(struct kgsl_mem_entry *entry)
 
 	spin_lock(&entry->priv->mem_lock);
 	idr_replace(&entry->priv->mem_idr, entry, entry->id);
+	kgsl_mem_entry_tree_insert(entry);
 	spin_unlock(&entry->priv->mem_lock);
 }
 
@@ -539,6 +582,111 @@ static int kgsl_mem_entry_attach_and_map(struct kgsl_device *device,
 	return ret;
 }
 
+#if IS_ENABLED(CONFIG_QCOM_KGSL_ASYNC_MAP)
+/* Allocations at least this big are mapped in the background */
+#define KGSL_ASYNC_MAP_MIN_SIZE SZ_64M
+
+static bool kgsl_mem_entry_use_async_map(struct kgsl_memdesc *memdesc)
+{
+	/*
+	 * Secure buffers are mapped through the secure pagetable and buffers
+	 * using the CPU map get their GPU address at mmap time, keep both
+	 * synchronous
+	 */
+	return memdesc->size >= KGSL_ASYNC_MAP_MIN_SIZE &&
+		!(memdesc->flags & (KGSL_MEMFLAGS_SECURE |
+			KGSL_MEMFLAGS_USE_CPU_MAP));
+}
+
+static void kgsl_mem_entry_async_map_work(struct work_struct *work)
+{
+	struct kgsl_mem_entry *entry =
+		container_of(work, struct kgsl_mem_entry, map_work);
+	struct kgsl_process_private *private = entry->priv;
+	struct kgsl_memdesc *memdesc = &entry->memdesc;
+	int ret;
+
+	/* The entry is committed, leave memdesc->priv to the other users */
+	ret = kgsl_mmu_map_unflagged(memdesc->pagetable, memdesc);
+	if (!ret) {
+		kgsl_memfree_purge(memdesc->pagetable, memdesc->gpuaddr,
+			memdesc->size);
+	} else {
+		WRITE_ONCE(entry->map_err, ret);
+		WRITE_ONCE(private->async_map_err, ret);
+		atomic_inc(&private->async_map_failed);
+	}
+
+	if (atomic_dec_and_test(&private->async_maps))
+		wake_up_all(&private->async_map_wq);
+
+	/* Put the refcount we took when scheduling the worker */
+	kgsl_mem_entry_put(entry);
+}
+
+/*
+ * Queue the IOMMU map of an attached entry. The entry is flagged as mapped
+ * up front so that the worker never updates the memdesc private flags of a
+ * committed entry, a failed map is recorded in @map_err instead.
+ */
+static void kgsl_mem_entry_map_async(struct kgsl_mem_entry *entry)
+{
+	struct kgsl_process_private *private = entry->priv;
+
+	entry->memdesc.priv |= KGSL_MEMDESC_MAPPED;
+
+	kgsl_mem_entry_get(entry);
+	atomic_inc(&private->async_maps);
+
+	INIT_WORK(&entry->map_work, kgsl_mem_entry_async_map_work);
+	queue_work(kgsl_driver.lockless_workqueue, &entry->map_work);
+}
+
+/*
+ * Wait for the background maps of the process before the GPU gets a chance
+ * to access the memory. Submissions keep failing as long as the process
+ * holds an allocation whose map failed.
+ */
+static int kgsl_process_wait_async_maps(struct kgsl_process_private *private)
+{
+	int ret;
+
+	ret = wait_event_interruptible(private->async_map_wq,
+		!atomic_read(&private->async_maps));
+	if (ret)
+		return ret;
+
+	if (atomic_read(&private->async_map_failed))
+		return READ_ONCE(private->async_map_err);
+
+	return 0;
+}
+
+/* Account the release of an entry whose background map failed */
+static void kgsl_mem_entry_async_map_release(struct kgsl_mem_entry *entry)
+{
+	atomic_dec(&entry->priv->async_map_failed);
+}
+#else
+static bool kgsl_mem_entry_use_async_map(struct kgsl_memdesc *memdesc)
+{
+	return false;
+}
+
+static void kgsl_mem_entry_map_async(struct kgsl_mem_entry *entry)
+{
+}
+
+static int kgsl_process_wait_async_maps(struct kgsl_process_private *private)
+{
+	return 0;
+}
+
+static void kgsl_mem_entry_async_map_release(struct kgsl_mem_entry *entry)
+{
+}
+#endif
+
 /* Detach a memory entry from a process and unmap it from the MMU */
 static void kgsl_mem_entry_detach_process(struct kgsl_mem_entry *entry)
 {
@@ -550,13 +698,24 @@ static void kgsl_mem_entry_detach_process(struct kgsl_mem_entry *entry)
 	 * so that no one can operate on obsolete values
 	 */
 	spin_lock(&entry->priv->mem_lock);
+	kgsl_mem_entry_tree_remove(entry);
 	if (entry->id != 0)
 		idr_remove(&entry->priv->mem_idr, entry->id);
 	entry->id = 0;
 
 	spin_unlock(&entry->priv->mem_lock);
 
-	kgsl_sharedmem_put_gpuaddr(&entry->memdesc);
+	if (entry->map_err) {
+		/* The background map failed so only the GPU address is left */
+		kgsl_mmu_put_gpuaddr(entry->memdesc.pagetable, &entry->memdesc);
+		entry->memdesc.gpuaddr = 0;
+		entry->memdesc.pagetable = NULL;
+		/* Flagged before the map, let the pages be freed */
+		entry->memdesc.priv &= ~KGSL_MEMDESC_MAPPED;
+		kgsl_mem_entry_async_map_release(entry);
+	} else {
+		kgsl_sharedmem_put_gpuaddr(&entry->memdesc);
+	}
 
 	if (entry->memdesc.priv & KGSL_MEMDESC_RECLAIMED)
 		atomic_sub(entry->memdesc.page_count,
@@ -1288,6 +1447,9 @@ static struct kgsl_process_private *kgsl_process_private_new(
 	mutex_init(&private->private_mutex);
 
 	idr_init(&private->mem_idr);
+	private->mem_tree = RB_ROOT_CACHED;
+	seqcount_spinlock_init(&private->mem_seq, &private->mem_lock);
+	init_waitqueue_head(&private->async_map_wq);
 	idr_init(&private->syncsource_idr);
 
 	kgsl_reclaim_proc_private_init(private);
@@ -1595,10 +1757,6 @@ err:
 	return result;
 }
 
-#define GPUADDR_IN_MEMDESC(_val, _memdesc) \
-	(((_val) >= (_memdesc)->gpuaddr) && \
-	 ((_val) < ((_memdesc)->gpuaddr + (_memdesc)->size)))
-
 /**
  * kgsl_sharedmem_find() - Find a gpu memory allocation
  *
@@ -1606,13 +1764,15 @@ err:
  * @gpuaddr: start address of the region
  *
  * Find a gpu allocation. Caller must kgsl_mem_entry_put()
- * the returned entry when finished using it.
+ * the returned entry when finished using it. The lookup walks the process
+ * GPU address interval tree under RCU and does not take the mem_lock.
  */
 struct kgsl_mem_entry * __must_check
 kgsl_sharedmem_find(struct kgsl_process_private *private, uint64_t gpuaddr)
 {
-	int id;
+	struct interval_tree_node *node;
 	struct kgsl_mem_entry *entry, *ret = NULL;
+	unsigned int seq;
 
 	if (!private)
 		return NULL;
@@ -1622,15 +1782,22 @@ kgsl_sharedmem_find(struct kgsl_process_private *private, uint64_t gpuaddr)
 			private->pagetable->mmu->securepagetable, gpuaddr, 0))
 		return NULL;
 
-	spin_lock(&private->mem_lock);
-	idr_for_each_entry(&private->mem_idr, entry, id) {
-		if (GPUADDR_IN_MEMDESC(gpuaddr, &entry->memdesc)) {
-			if (!entry->pending_free)
-				ret = kgsl_mem_entry_get(entry);
-			break;
-		}
+	rcu_read_lock();
+
+	/* Retry if the tree changed under the walk */
+	do {
+		seq = read_seqcount_begin(&private->mem_seq);
+		node = interval_tree_iter_first(&private->mem_tree, gpuaddr,
+			gpuaddr);
+	} while (read_seqcount_retry(&private->mem_seq, seq));
+
+	if (node) {
+		entry = container_of(node, struct kgsl_mem_entry, gpuaddr_node);
+		if (!READ_ONCE(entry->pending_free))
+			ret = kgsl_mem_entry_get(entry);
 	}
-	spin_unlock(&private->mem_lock);
+
+	rcu_read_unlock();
 
 	return ret;
 }
@@ -2170,6 +2337,9 @@ long kgsl_ioctl_rb_issueibcmds(struct kgsl_device_private *dev_priv,
 	if (result == 0)
 		result = kgsl_reclaim_to_pinned_state(dev_priv->process_priv);
 
+	if (result == 0)
+		result = kgsl_process_wait_async_maps(dev_priv->process_priv);
+
 	if (result == 0)
 		result = dev_priv->device->ftbl->queue_cmds(dev_priv, context,
 				&drawobj, 1, &param->timestamp);
@@ -2286,6 +2456,11 @@ long kgsl_ioctl_submit_commands(struct kgsl_device_private *dev_priv,
 					dev_priv->process_priv);
 			if (result)
 				goto done;
+
+			result = kgsl_process_wait_async_maps(
+					dev_priv->process_priv);
+			if (result)
+				goto done;
 		}
 	}
 
@@ -2381,6 +2556,11 @@ long kgsl_ioctl_gpu_command(struct kgsl_device_private *dev_priv,
 					dev_priv->process_priv);
 			if (result)
 				goto done;
+
+			result = kgsl_process_wait_async_maps(
+					dev_priv->process_priv);
+			if (result)
+				goto done;
 		}
 	}
 
@@ -2638,7 +2818,10 @@ long kgsl_ioctl_recurring_command(struct kgsl_device_private *dev_priv,
 		if (!result)
 			kgsl_drawobj_destroy(drawobj);
 	} else {
-		result = device->ftbl->queue_recurring_cmd(dev_priv, context, drawobj);
+		result = kgsl_process_wait_async_maps(dev_priv->process_priv);
+		if (!result)
+			result = device->ftbl->queue_recurring_cmd(dev_priv,
+				context, drawobj);
 	}
 
 done:
@@ -4295,6 +4478,7 @@ struct kgsl_mem_entry *gpumem_alloc_entry(
 	struct kgsl_mem_entry *entry;
 	struct kgsl_device *device = dev_priv->device;
 	u32 cachemode;
+	bool async_map;
 
 	/* For 32-bit kernel world nothing to do with this flag */
 	if (BITS_PER_LONG == 32)
@@ -4338,7 +4522,13 @@ struct kgsl_mem_entry *gpumem_alloc_entry(
 	if (ret != 0)
 		goto err;
 
-	ret = kgsl_mem_entry_attach_and_map(device, private, entry);
+	/* Large allocations are mapped in the background, see below */
+	async_map = kgsl_mem_entry_use_async_map(&entry->memdesc);
+
+	if (async_map)
+		ret = kgsl_mem_entry_attach_to_process(device, private, entry);
+	else
+		ret = kgsl_mem_entry_attach_and_map(device, private, entry);
 	if (ret != 0) {
 		kgsl_sharedmem_free(&entry->memdesc);
 		goto err;
@@ -4364,6 +4554,14 @@ struct kgsl_mem_entry *gpumem_alloc_entry(
 			entry->memdesc.size);
 	trace_kgsl_mem_alloc(entry);
 
+	/*
+	 * Command submissions of the process wait for the map to finish so
+	 * the ioctl can return as soon as the pages are allocated. The entry
+	 * is usable right away for everything but the GPU.
+	 */
+	if (async_map && entry->memdesc.gpuaddr)
+		kgsl_mem_entry_map_async(entry);
+
 	kgsl_mem_entry_commit_process(entry);
 	return entry;
 err:
@@ -4802,6 +5000,10 @@ static unsigned long _gpu_set_svm_region(struct kgsl_process_private *private,
 		return (unsigned long) ret;
 	}
 
+	spin_lock(&private->mem_lock);
+	kgsl_mem_entry_tree_insert(entry);
+	spin_unlock(&private->mem_lock);
+
 	kgsl_memfree_purge(private->pagetable, entry->memdesc.gpuaddr,
 		entry->memdesc.size);
 
@@ -9,6 +9,7 @@
 #include <linux/cdev.h>
 #include <linux/compat.h>
 #include <linux/interrupt.h>
+#include <linux/interval_tree.h>
 #include <linux/kthread.h>
 #include <linux/mm.h>
 #include <uapi/linux/msm_kgsl.h>
@@ -362,6 +363,20 @@ struct kgsl_mem_entry {
 	atomic_t map_count;
 	/** @vbo_count: Count how many VBO ranges this entry is mapped in */
 	atomic_t vbo_count;
+	/**
+	 * @gpuaddr_node: Node in the process GPU address interval tree, empty
+	 * while the entry has no committed GPU address
+	 */
+	struct interval_tree_node gpuaddr_node;
+	/** @rcu: Defers the free of the entry past lockless lookups */
+	struct rcu_head rcu;
+	/** @map_work: Work struct used to map large allocations in background */
+	struct work_struct map_work;
+	/**
+	 * @map_err: Error from the background map, nothing is mapped if set
+	 * and command submissions of the process fail until the entry is freed
+	 */
+	int map_err;
 };
 
 struct kgsl_device_private;
@@ -377,7 +392,7 @@ typedef void (*kgsl_event_func)(struct kgsl_device *, struct kgsl_event_group *,
  * @timestamp: Timestamp for the event to expire
  * @func: Callback function for the event when it expires
  * @priv: Private data passed to the callback function
- * @node: List node for the kgsl_event_group list
+ * @node: List node for the kgsl_event_group list, sorted by timestamp
  * @created: Jiffies when the event was created
  * @work: kthread_work struct for dispatching the callback
  * @result: KGSL event result type to pass to the callback
@@ -394,6 +409,8 @@ struct kgsl_event {
 	struct kthread_work work;
 	int result;
 	struct kgsl_event_group *group;
+	/** @queued: Time in ns when the callback was queued to the worker */
+	u64 queued;
 };
 
 typedef int (*readtimestamp_func)(struct kgsl_device *, void *,
@@ -403,7 +420,7 @@ typedef int (*readtimestamp_func)(struct kgsl_device *, void *,
  * struct event_group - A list of GPU events
  * @context: Pointer to the active context for the events
  * @lock: Spinlock for protecting the list
- * @events: List of active GPU events
+ * @events: List of active GPU events, in timestamp order
  * @group: Node for the master group list
  * @processed: Last processed timestamp
  * @name: String name for the group (for the debugfs file)
@@ -419,6 +436,12 @@ struct kgsl_event_group {
 	char name[64];
 	readtimestamp_func readtimestamp;
 	void *priv;
+	/** @pass_count: Number of events retired by the last processing pass */
+	u32 pass_count;
+	/** @pass_count_max: Most events retired by a single processing pass */
+	u32 pass_count_max;
+	/** @worker_latency_max: Longest wait in ns for an event callback to run */
+	u64 worker_latency_max;
 };
 
 /**
@@ -94,6 +94,12 @@ DEFINE_DEBUGFS_ATTRIBUTE(_reserved_fops,
 DEFINE_DEBUGFS_ATTRIBUTE(_page_count_fops,
 					kgsl_pool_page_count_get, NULL, "%llu\n");
 
+#if IS_ENABLED(CONFIG_QCOM_KGSL_POOL_PREZERO)
+DEFINE_DEBUGFS_ATTRIBUTE(_prezero_target_fops, kgsl_pool_prezero_target_get,
+					kgsl_pool_prezero_target_set, "%llu\n");
+DEFINE_SHOW_ATTRIBUTE(kgsl_pool_prezero);
+#endif
+
 void kgsl_pool_init_debugfs(struct dentry *pool_debugfs,
 					char *name, void *pool)
 {
@@ -119,6 +125,13 @@ void kgsl_pool_init_debugfs(struct dentry *pool_debugfs,
 
 	WARN((IS_ERR_OR_NULL(dentry)),
 		"Unable to create 'count' file for %s\n", name);
+
+#if IS_ENABLED(CONFIG_QCOM_KGSL_POOL_PREZERO)
+	debugfs_create_file("prezero_target", 0644, pool_debugfs, pool,
+		&_prezero_target_fops);
+	debugfs_create_file("prezero", 0444, pool_debugfs, pool,
+		&kgsl_pool_prezero_fops);
+#endif
 }
 
 void kgsl_device_debugfs_init(struct kgsl_device *device)
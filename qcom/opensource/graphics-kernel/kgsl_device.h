@@ -450,6 +450,8 @@ struct kgsl_context {
 	struct list_head faults;
 	/** @fault_lock: Mutex to protect faults */
 	struct mutex fault_lock;
+	/** @frame_ticks: GPU active ticks of the frame being rendered */
+	atomic64_t frame_ticks;
 };
 
 #define _context_comm(_c) \
@@ -544,6 +546,27 @@ struct kgsl_process_private {
 	 * @cmdline: Cmdline string of the process
 	 */
 	char *cmdline;
+	/**
+	 * @mem_tree: Interval tree of the memory entries keyed by GPU address
+	 * range, modified under @mem_lock
+	 */
+	struct rb_root_cached mem_tree;
+	/**
+	 * @mem_seq: Sequence count bumped on @mem_tree updates so that lookups
+	 * can walk the tree under RCU only
+	 */
+	seqcount_spinlock_t mem_seq;
+	/** @async_maps: Number of background IOMMU maps still in flight */
+	atomic_t async_maps;
+	/** @async_map_wq: Woken up when @async_maps drops to zero */
+	wait_queue_head_t async_map_wq;
+	/**
+	 * @async_map_err: Last error from a background IOMMU map, reported to
+	 * command submissions while @async_map_failed is set
+	 */
+	int async_map_err;
+	/** @async_map_failed: Number of live entries whose map failed */
+	atomic_t async_map_failed;
 };
 
 struct kgsl_device_private {
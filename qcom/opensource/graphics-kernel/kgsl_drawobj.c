@@ -19,6 +19,7 @@
  * goes to zero indicating no more pending events.
  */
 
+#include <linux/sched/clock.h>
 #include <linux/slab.h>
 #include <linux/dma-fence-array.h>
 
@@ -1255,6 +1256,7 @@ struct kgsl_drawobj_cmd *kgsl_drawobj_cmd_create(struct kgsl_device *device,
 	INIT_LIST_HEAD(&cmdobj->cmdlist);
 	INIT_LIST_HEAD(&cmdobj->memlist);
 	cmdobj->requeue_cnt = 0;
+	cmdobj->create_ns = local_clock();
 
 	if (!(type & CMDOBJ_TYPE))
 		return cmdobj;
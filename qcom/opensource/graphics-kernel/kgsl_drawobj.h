@@ -87,6 +87,8 @@ struct kgsl_drawobj_cmd {
 	u32 numibs;
 	/* @requeue_cnt: Number of times cmdobj was requeued before submission to dq succeeded */
 	u32 requeue_cnt;
+	/* @create_ns: local_clock() when the submit ioctl created this cmdobj */
+	u64 create_ns;
 };
 
 /* This sync object cannot be sent to hardware */
@@ -6,6 +6,7 @@
 
 #include <linux/debugfs.h>
 #include <linux/rwlock.h>
+#include <linux/sched/clock.h>
 
 #include "kgsl_debugfs.h"
 #include "kgsl_device.h"
@@ -23,9 +24,29 @@ static inline void signal_event(struct kgsl_device *device,
 {
 	list_del(&event->node);
 	event->result = result;
+	event->queued = local_clock();
 	kthread_queue_work(device->events_worker, &event->work);
 }
 
+/*
+ * Insert the event in timestamp order. Timestamps are mostly registered in
+ * increasing order so start looking for the spot from the end of the list.
+ */
+static void _add_event_sorted(struct kgsl_event_group *group,
+		struct kgsl_event *event)
+{
+	struct kgsl_event *pos;
+
+	list_for_each_entry_reverse(pos, &group->events, node) {
+		if (timestamp_cmp(pos->timestamp, event->timestamp) <= 0) {
+			list_add(&event->node, &pos->node);
+			return;
+		}
+	}
+
+	list_add(&event->node, &group->events);
+}
+
 /**
  * _kgsl_event_worker() - Work handler for processing GPU event callbacks
  * @work: Pointer to the kthread_work for the event
@@ -36,7 +57,13 @@ static inline void signal_event(struct kgsl_device *device,
 static void _kgsl_event_worker(struct kthread_work *work)
 {
 	struct kgsl_event *event = container_of(work, struct kgsl_event, work);
+	struct kgsl_event_group *group = event->group;
 	int id = KGSL_CONTEXT_ID(event->context);
+	u64 latency = local_clock() - event->queued;
+
+	/* Racy update is fine, this is only a debug statistic */
+	if (latency > READ_ONCE(group->worker_latency_max))
+		WRITE_ONCE(group->worker_latency_max, latency);
 
 	trace_kgsl_fire_event(id, event->timestamp, event->result,
 		jiffies - event->created, event->func);
@@ -73,6 +100,7 @@ static void _process_event_group(struct kgsl_device *device,
 	struct kgsl_event *event, *tmp;
 	unsigned int timestamp;
 	struct kgsl_context *context;
+	u32 count = 0;
 
 	if (group == NULL)
 		return;
@@ -94,15 +122,27 @@ static void _process_event_group(struct kgsl_device *device,
 	if (!flush && !_do_process_group(group->processed, timestamp))
 		goto out;
 
+	/*
+	 * The list is sorted by timestamp so stop at the first event that is
+	 * still pending unless everything needs to go
+	 */
 	list_for_each_entry_safe(event, tmp, &group->events, node) {
-		if (timestamp_cmp(event->timestamp, timestamp) <= 0)
+		if (timestamp_cmp(event->timestamp, timestamp) <= 0) {
 			signal_event(device, event, KGSL_EVENT_RETIRED);
-		else if (flush)
+			count++;
+		} else if (flush) {
 			signal_event(device, event, KGSL_EVENT_CANCELLED);
-
+		} else {
+			break;
+		}
 	}
 
 	group->processed = timestamp;
+	group->pass_count = count;
+	if (count > group->pass_count_max)
+		group->pass_count_max = count;
+
+	trace_kgsl_process_event_group(group, timestamp, count);
 
 out:
 	spin_unlock(&group->lock);
@@ -147,7 +187,13 @@ void kgsl_cancel_events_timestamp(struct kgsl_device *device,
 	spin_lock(&group->lock);
 
 	list_for_each_entry_safe(event, tmp, &group->events, node) {
-		if (timestamp_cmp(timestamp, event->timestamp) == 0)
+		int cmp = timestamp_cmp(timestamp, event->timestamp);
+
+		/* The rest of the list is for later timestamps */
+		if (cmp < 0)
+			break;
+
+		if (cmp == 0)
 			signal_event(device, event, KGSL_EVENT_CANCELLED);
 	}
 
@@ -290,13 +336,14 @@ int kgsl_add_event(struct kgsl_device *device, struct kgsl_event_group *group,
 
 	if (timestamp_cmp(retired, timestamp) >= 0) {
 		event->result = KGSL_EVENT_RETIRED;
+		event->queued = local_clock();
 		kthread_queue_work(device->events_worker, &event->work);
 		spin_unlock(&group->lock);
 		return 0;
 	}
 
 	/* Add the event to the group list */
-	list_add_tail(&event->node, &group->events);
+	_add_event_sorted(group, event);
 
 	spin_unlock(&group->lock);
 
@@ -363,7 +410,10 @@ static void events_debugfs_print_group(struct seq_file *s,
 
 	spin_lock(&group->lock);
 
-	seq_printf(s, "%s: last=%d\n", group->name, group->processed);
+	seq_printf(s, "%s: last=%d pass=%u pass_max=%u worker_latency_max=%lluus\n",
+		group->name, group->processed, group->pass_count,
+		group->pass_count_max,
+		div_u64(READ_ONCE(group->worker_latency_max), NSEC_PER_USEC));
 
 	list_for_each_entry(event, &group->events, node) {
 
@@ -16,6 +16,7 @@
 #include <linux/delay.h>
 #include <linux/qcom_scm.h>
 #include <linux/random.h>
+#include <linux/rbtree_augmented.h>
 #include <linux/regulator/consumer.h>
 #include <soc/qcom/secure_buffer.h>
 
@@ -44,16 +45,28 @@ static struct page *kgsl_vbo_zero_page;
  * struct kgsl_iommu_addr_entry - entry in the kgsl_pagetable rbtree.
  * @base: starting virtual address of the entry
  * @size: size of the entry
+ * @gap: size of the free range between the previous entry and this one
+ * @max_gap: largest @gap in the subtree rooted at this entry
  * @node: the rbtree node
  */
 struct kgsl_iommu_addr_entry {
 	uint64_t base;
 	uint64_t size;
+	uint64_t gap;
+	uint64_t max_gap;
 	struct rb_node node;
 };
 
 static struct kmem_cache *addr_entry_cache;
 
+static inline uint64_t _addr_entry_gap(struct kgsl_iommu_addr_entry *entry)
+{
+	return entry->gap;
+}
+
+RB_DECLARE_CALLBACKS_MAX(static, addr_entry_gap_cb,
+	struct kgsl_iommu_addr_entry, node, uint64_t, max_gap, _addr_entry_gap)
+
 /* These are dummy TLB ops for the io-pgtable instances */
 
 static void _tlb_flush_all(void *cookie)
@@ -276,30 +289,13 @@ static void kgsl_iommu_flush_tlb(struct kgsl_mmu *mmu)
 		iommu_flush_iotlb_all(to_iommu_domain(&iommu->lpac_context));
 }
 
-static int _iopgtbl_unmap(struct kgsl_iommu_pt *pt, u64 gpuaddr, size_t size)
+static void _iopgtbl_flush_tlb(struct kgsl_iommu_pt *pt)
 {
-	struct io_pgtable_ops *ops = pt->pgtbl_ops;
-	int ret = 0;
-	size_t unmapped;
-
-	if (IS_ENABLED(CONFIG_IOMMU_IO_PGTABLE_LPAE)) {
-		ret = _iopgtbl_unmap_pages(pt, gpuaddr, size);
-		if (ret)
-			return ret;
-		goto flush;
-	}
-
-	unmapped = ops->unmap_pages(ops, gpuaddr, PAGE_SIZE,
-				    size >> PAGE_SHIFT, NULL);
-	if (unmapped != size)
-		return -EINVAL;
-
 	/*
 	 * Skip below logic for 6.1 kernel version and above as
 	 * qcom_skip_tlb_management() API takes care of avoiding
 	 * TLB operations during slumber.
 	 */
-flush:
 	if (KERNEL_VERSION(6, 1, 0) > LINUX_VERSION_CODE) {
 		struct kgsl_device *device = KGSL_MMU_DEVICE(pt->base.mmu);
 
@@ -307,16 +303,92 @@ flush:
 		if (mutex_trylock(&device->mutex)) {
 			if (device->state == KGSL_STATE_SLUMBER) {
 				mutex_unlock(&device->mutex);
-				return 0;
+				return;
 			}
 			mutex_unlock(&device->mutex);
 		}
 	}
 
 	kgsl_iommu_flush_tlb(pt->base.mmu);
+}
+
+/* Clear the page table entries but leave the TLB invalidation to the caller */
+static int _iopgtbl_unmap_noflush(struct kgsl_iommu_pt *pt, u64 gpuaddr,
+		size_t size)
+{
+	struct io_pgtable_ops *ops = pt->pgtbl_ops;
+	size_t unmapped = 0;
+
+	if (IS_ENABLED(CONFIG_IOMMU_IO_PGTABLE_LPAE))
+		return _iopgtbl_unmap_pages(pt, gpuaddr, size);
+
+	/* Ranges are mapped with block sizes, unmap them the same way */
+	while (unmapped < size) {
+		size_t ret, size_to_unmap, pgcount;
+
+		size_to_unmap = iommu_pgsize(pt->info.cfg.pgsize_bitmap,
+				gpuaddr, gpuaddr, size - unmapped, &pgcount);
+		if (size_to_unmap == 0)
+			break;
+
+		ret = ops->unmap_pages(ops, gpuaddr, size_to_unmap, pgcount,
+				NULL);
+		if (ret == 0)
+			break;
+
+		gpuaddr += ret;
+		unmapped += ret;
+	}
+
+	return (unmapped == size) ? 0 : -EINVAL;
+}
+
+static int _iopgtbl_unmap(struct kgsl_iommu_pt *pt, u64 gpuaddr, size_t size)
+{
+	int ret = _iopgtbl_unmap_noflush(pt, gpuaddr, size);
+
+	if (ret)
+		return ret;
+
+	_iopgtbl_flush_tlb(pt);
 	return 0;
 }
 
+/*
+ * Map a physically contiguous chunk using the largest block sizes that the
+ * alignment of both addresses allows so that 64K and 2M runs of pages from
+ * the pools end up in a single page table entry
+ */
+static int _iopgtbl_map_pages(struct kgsl_iommu_pt *pt, u64 gpuaddr,
+		phys_addr_t phys, size_t size, int prot, size_t *mapped)
+{
+	struct io_pgtable_ops *ops = pt->pgtbl_ops;
+	int ret = 0;
+
+	*mapped = 0;
+
+	while (*mapped < size) {
+		size_t pgsize, pgcount, map_size = 0;
+
+		pgsize = iommu_pgsize(pt->info.cfg.pgsize_bitmap,
+				gpuaddr, phys, size - *mapped, &pgcount);
+		if (pgsize == 0)
+			return -EINVAL;
+
+		ret = ops->map_pages(ops, gpuaddr, phys, pgsize, pgcount,
+				     prot, GFP_KERNEL, &map_size);
+
+		gpuaddr += map_size;
+		phys += map_size;
+		*mapped += map_size;
+
+		if (ret)
+			break;
+	}
+
+	return ret;
+}
+
 static size_t _iopgtbl_map_sg(struct kgsl_iommu_pt *pt, u64 gpuaddr,
 		struct sg_table *sgt, int prot)
 {
@@ -344,16 +416,15 @@ static size_t _iopgtbl_map_sg(struct kgsl_iommu_pt *pt, u64 gpuaddr,
 
 	for_each_sg(sgt->sgl, sg, sgt->nents, i) {
 		size_t size = sg->length, map_size = 0;
-		phys_addr_t phys = sg_phys(sg);
 
-		ret = ops->map_pages(ops, addr, phys, PAGE_SIZE, size >> PAGE_SHIFT,
-				     prot, GFP_KERNEL, &map_size);
+		ret = _iopgtbl_map_pages(pt, addr, sg_phys(sg), size, prot,
+				&map_size);
+		mapped += map_size;
 		if (ret) {
 			_iopgtbl_unmap(pt, gpuaddr, mapped);
 			return 0;
 		}
 		addr += size;
-		mapped += map_size;
 	}
 
 	return mapped;
@@ -424,6 +495,23 @@ kgsl_iopgtbl_unmap_range(struct kgsl_pagetable *pt, struct kgsl_memdesc *memdesc
 			length);
 }
 
+static int
+kgsl_iopgtbl_unmap_range_noflush(struct kgsl_pagetable *pt,
+		struct kgsl_memdesc *memdesc, u64 offset, u64 length)
+{
+	if (WARN_ON(offset >= memdesc->size ||
+		(offset + length) > memdesc->size))
+		return -ERANGE;
+
+	return _iopgtbl_unmap_noflush(to_iommu_pt(pt),
+			memdesc->gpuaddr + offset, length);
+}
+
+static void kgsl_iopgtbl_flush_tlb(struct kgsl_pagetable *pt)
+{
+	_iopgtbl_flush_tlb(to_iommu_pt(pt));
+}
+
 static size_t _iopgtbl_map_page_to_range(struct kgsl_iommu_pt *pt,
 		struct page *page, u64 gpuaddr, size_t range, int prot)
 {
@@ -1923,7 +2011,7 @@ static struct kgsl_iommu_addr_entry *_find_gpuaddr(
 static int _remove_gpuaddr(struct kgsl_pagetable *pagetable,
 		uint64_t gpuaddr)
 {
-	struct kgsl_iommu_addr_entry *entry;
+	struct kgsl_iommu_addr_entry *entry, *next;
 
 	entry = _find_gpuaddr(pagetable, gpuaddr);
 
@@ -1945,7 +2033,18 @@ static int _remove_gpuaddr(struct kgsl_pagetable *pagetable,
 							pagetable->va_start);
 	}
 
-	rb_erase(&entry->node, &pagetable->rbtree);
+	/* The next entry inherits the gap in front of the removed one */
+	next = rb_entry_safe(rb_next(&entry->node),
+		struct kgsl_iommu_addr_entry, node);
+
+	rb_erase_augmented(&entry->node, &pagetable->rbtree,
+		&addr_entry_gap_cb);
+
+	if (next) {
+		next->gap += entry->size + entry->gap;
+		addr_entry_gap_cb_propagate(&next->node, NULL);
+	}
+
 	kmem_cache_free(addr_entry_cache, entry);
 	return 0;
 }
@@ -1954,6 +2053,7 @@ static int _insert_gpuaddr(struct kgsl_pagetable *pagetable,
 		uint64_t gpuaddr, uint64_t size)
 {
 	struct rb_node **node, *parent = NULL;
+	struct kgsl_iommu_addr_entry *prev, *next;
 	struct kgsl_iommu_addr_entry *new =
 		kmem_cache_alloc(addr_entry_cache, GFP_ATOMIC);
 
@@ -1984,7 +2084,24 @@ static int _insert_gpuaddr(struct kgsl_pagetable *pagetable,
 	}
 
 	rb_link_node(&new->node, parent, node);
-	rb_insert_color(&new->node, &pagetable->rbtree);
+
+	/* Split the gap in front of the next entry */
+	prev = rb_entry_safe(rb_prev(&new->node),
+		struct kgsl_iommu_addr_entry, node);
+	next = rb_entry_safe(rb_next(&new->node),
+		struct kgsl_iommu_addr_entry, node);
+
+	new->gap = prev ? new->base - (prev->base + prev->size) : new->base;
+	new->max_gap = new->gap;
+	addr_entry_gap_cb_propagate(parent, NULL);
+
+	rb_insert_augmented(&new->node, &pagetable->rbtree,
+		&addr_entry_gap_cb);
+
+	if (next) {
+		next->gap = next->base - (new->base + new->size);
+		addr_entry_gap_cb_propagate(&next->node, NULL);
+	}
 
 	return 0;
 }
@@ -2018,11 +2135,50 @@ static u64 _get_unmapped_area_hint(struct kgsl_pagetable *pagetable,
 	return hint;
 }
 
+static inline struct kgsl_iommu_addr_entry *_addr_entry(struct rb_node *node)
+{
+	return rb_entry_safe(node, struct kgsl_iommu_addr_entry, node);
+}
+
+/* Check if the free range [@start, @end) has room for the allocation */
+static bool _gap_fits_bottomup(u64 start, u64 end, u64 bottom, u64 top,
+		u64 size, u64 align, u64 *addr)
+{
+	start = ALIGN(max_t(u64, start, bottom), align);
+	end = min_t(u64, end, top);
+
+	if (start >= end || end - start < size)
+		return false;
+
+	*addr = start;
+	return true;
+}
+
+static bool _gap_fits_topdown(u64 start, u64 end, u64 bottom, u64 top,
+		u64 size, u64 align, u64 *addr)
+{
+	u64 chunk;
+
+	start = max_t(u64, start, bottom);
+	end = min_t(u64, end, top);
+
+	if (start >= end || end < size)
+		return false;
+
+	chunk = (end - size) & ~(align - 1);
+	if (chunk < start)
+		return false;
+
+	*addr = chunk;
+	return true;
+}
+
 static uint64_t _get_unmapped_area(struct kgsl_pagetable *pagetable,
 		uint64_t bottom, uint64_t top, uint64_t size,
 		uint64_t align)
 {
-	struct rb_node *node;
+	struct rb_node *node = pagetable->rbtree.rb_node;
+	struct kgsl_iommu_addr_entry *entry, *child;
 	uint64_t start;
 
 	/* Check if we can assign a gpuaddr based on the last allocation */
@@ -2030,49 +2186,59 @@ static uint64_t _get_unmapped_area(struct kgsl_pagetable *pagetable,
 	if (!IS_ERR_VALUE(start))
 		return start;
 
-	/* Fall back to searching through the range. */
-	node = rb_first(&pagetable->rbtree);
-	bottom = ALIGN(bottom, align);
-	start = bottom;
+	/*
+	 * Fall back to an in-order walk of the gaps, skipping the subtrees
+	 * whose largest gap is too small or which lie below the range.
+	 */
+	if (!node || _addr_entry(node)->max_gap < size)
+		goto check_highest;
 
-	while (node != NULL) {
-		uint64_t gap;
-		struct kgsl_iommu_addr_entry *entry = rb_entry(node,
-			struct kgsl_iommu_addr_entry, node);
+	while (1) {
+		entry = _addr_entry(node);
+		child = _addr_entry(node->rb_left);
 
-		/*
-		 * Skip any entries that are outside of the range, but make sure
-		 * to account for some that might straddle the lower bound
-		 */
-		if (entry->base < bottom) {
-			if (entry->base + entry->size > bottom)
-				start = ALIGN(entry->base + entry->size, align);
-			node = rb_next(node);
+		/* The gaps of the left subtree end before the gap of this entry */
+		if (child && child->max_gap >= size &&
+			entry->base - entry->gap > bottom) {
+			node = node->rb_left;
 			continue;
 		}
+check_current:
+		entry = _addr_entry(node);
 
-		/* Stop if we went over the top */
-		if (entry->base >= top)
-			break;
+		/* The remaining gaps are all above the range */
+		if (entry->base - entry->gap >= top)
+			return (uint64_t) -ENOMEM;
 
-		/* Make sure there is a gap to consider */
-		if (start < entry->base) {
-			gap = entry->base - start;
+		if (entry->gap >= size && _gap_fits_bottomup(
+			entry->base - entry->gap, entry->base, bottom, top,
+			size, align, &start))
+			return start;
 
-			if (gap >= size)
-				return start;
+		child = _addr_entry(node->rb_right);
+		if (child && child->max_gap >= size &&
+			entry->base + entry->size < top) {
+			node = node->rb_right;
+			continue;
 		}
 
-		/* Stop if there is no more room in the region */
-		if (entry->base + entry->size >= top)
-			return (uint64_t) -ENOMEM;
+		/* Go back up to the first ancestor reached from its left */
+		while (1) {
+			struct rb_node *prev = node;
 
-		/* Start the next cycle at the end of the current entry */
-		start = ALIGN(entry->base + entry->size, align);
-		node = rb_next(node);
+			node = rb_parent(node);
+			if (!node)
+				goto check_highest;
+			if (prev == node->rb_left)
+				goto check_current;
+		}
 	}
 
-	if (start + size <= top)
+check_highest:
+	entry = _addr_entry(rb_last(&pagetable->rbtree));
+	start = entry ? entry->base + entry->size : 0;
+
+	if (_gap_fits_bottomup(start, top, bottom, top, size, align, &start))
 		return start;
 
 	return (uint64_t) -ENOMEM;
@@ -2082,10 +2248,9 @@ static uint64_t _get_unmapped_area_topdown(struct kgsl_pagetable *pagetable,
 		uint64_t bottom, uint64_t top, uint64_t size,
 		uint64_t align)
 {
-	struct rb_node *node = rb_last(&pagetable->rbtree);
-	uint64_t end = top;
-	uint64_t mask = ~(align - 1);
-	struct kgsl_iommu_addr_entry *entry;
+	struct rb_node *node = pagetable->rbtree.rb_node;
+	struct kgsl_iommu_addr_entry *entry, *child;
+	uint64_t addr;
 
 	/* Make sure that the bottom is correctly aligned */
 	bottom = ALIGN(bottom, align);
@@ -2094,58 +2259,72 @@ static uint64_t _get_unmapped_area_topdown(struct kgsl_pagetable *pagetable,
 	if (size > (top - bottom))
 		return -ENOMEM;
 
-	/* Walk back through the list to find the highest entry in the range */
-	for (node = rb_last(&pagetable->rbtree); node != NULL; node = rb_prev(node)) {
-		entry = rb_entry(node, struct kgsl_iommu_addr_entry, node);
-		if (entry->base < top)
-			break;
-	}
-
-	while (node != NULL) {
-		uint64_t offset;
+	/* Try the free range above the highest entry first */
+	entry = _addr_entry(rb_last(&pagetable->rbtree));
+	if (_gap_fits_topdown(entry ? entry->base + entry->size : 0, top,
+		bottom, top, size, align, &addr))
+		return addr;
 
-		entry = rb_entry(node, struct kgsl_iommu_addr_entry, node);
+	/*
+	 * Walk the gaps in reverse order, skipping the subtrees whose largest
+	 * gap is too small or which lie above the range.
+	 */
+	if (!node || _addr_entry(node)->max_gap < size)
+		return (uint64_t) -ENOMEM;
 
-		/* If the entire entry is below the range the search is over */
-		if ((entry->base + entry->size) < bottom)
-			break;
+	while (1) {
+		entry = _addr_entry(node);
+		child = _addr_entry(node->rb_right);
 
-		/* Get the top of the entry properly aligned */
-		offset = ALIGN(entry->base + entry->size, align);
+		/* The gaps of the right subtree start after this entry */
+		if (child && child->max_gap >= size &&
+			entry->base + entry->size < top) {
+			node = node->rb_right;
+			continue;
+		}
+check_current:
+		entry = _addr_entry(node);
 
-		/*
-		 * Try to allocate the memory from the top of the gap,
-		 * making sure that it fits between the top of this entry and
-		 * the bottom of the previous one
-		 */
+		/* The remaining gaps are all below the range */
+		if (entry->base <= bottom)
+			return (uint64_t) -ENOMEM;
 
-		if ((end > size) && (offset < end)) {
-			uint64_t chunk = (end - size) & mask;
+		if (entry->gap >= size && _gap_fits_topdown(
+			entry->base - entry->gap, entry->base, bottom, top,
+			size, align, &addr))
+			return addr;
 
-			if (chunk >= offset)
-				return chunk;
+		child = _addr_entry(node->rb_left);
+		if (child && child->max_gap >= size &&
+			entry->base - entry->gap > bottom) {
+			node = node->rb_left;
+			continue;
 		}
 
-		/*
-		 * If we get here and the current entry is outside of the range
-		 * then we are officially out of room
-		 */
-
-		if (entry->base < bottom)
-			return (uint64_t) -ENOMEM;
-
-		/* Set the top of the gap to the current entry->base */
-		end = entry->base;
+		/* Go back up to the first ancestor reached from its right */
+		while (1) {
+			struct rb_node *prev = node;
 
-		/* And move on to the next lower entry */
-		node = rb_prev(node);
+			node = rb_parent(node);
+			if (!node)
+				return (uint64_t) -ENOMEM;
+			if (prev == node->rb_right)
+				goto check_current;
+		}
 	}
+}
 
-	/* If we get here then there are no more entries in the region */
-	if ((end > size) && (((end - size) & mask) >= bottom))
-		return (end - size) & mask;
+/* Account a VA range search started at @start_ns, called with the lock held */
+static void _va_alloc_stats_update(struct kgsl_pagetable *pagetable,
+		u64 start_ns)
+{
+	u64 delta = ktime_get_ns() - start_ns;
 
-	return (uint64_t) -ENOMEM;
+	WRITE_ONCE(pagetable->stats.va_allocs, pagetable->stats.va_allocs + 1);
+	WRITE_ONCE(pagetable->stats.va_alloc_ns,
+		pagetable->stats.va_alloc_ns + delta);
+	if (delta > pagetable->stats.va_alloc_max_ns)
+		WRITE_ONCE(pagetable->stats.va_alloc_max_ns, delta);
 }
 
 static uint64_t kgsl_iommu_find_svm_region(struct kgsl_pagetable *pagetable,
@@ -2153,14 +2332,17 @@ static uint64_t kgsl_iommu_find_svm_region(struct kgsl_pagetable *pagetable,
 		uint64_t alignment)
 {
 	uint64_t addr;
+	u64 ts;
 
 	/* Avoid black holes */
 	if (WARN(end <= start, "Bad search range: 0x%llx-0x%llx", start, end))
 		return (uint64_t) -EINVAL;
 
+	ts = ktime_get_ns();
 	spin_lock(&pagetable->lock);
 	addr = _get_unmapped_area_topdown(pagetable,
 			start, end, size, alignment);
+	_va_alloc_stats_update(pagetable, ts);
 	spin_unlock(&pagetable->lock);
 	return addr;
 }
@@ -2226,11 +2408,13 @@ static int get_gpuaddr(struct kgsl_pagetable *pagetable,
 		struct kgsl_memdesc *memdesc, u64 start, u64 end,
 		u64 size, u64 align)
 {
-	u64 addr;
+	u64 addr, ts;
 	int ret;
 
+	ts = ktime_get_ns();
 	spin_lock(&pagetable->lock);
 	addr = _get_unmapped_area(pagetable, start, end, size, align);
+	_va_alloc_stats_update(pagetable, ts);
 	if (addr == (u64) -ENOMEM) {
 		spin_unlock(&pagetable->lock);
 		return -ENOMEM;
@@ -2729,6 +2913,8 @@ static const struct kgsl_mmu_pt_ops iopgtbl_pt_ops = {
 	.mmu_map_zero_page_to_range = kgsl_iopgtbl_map_zero_page_to_range,
 	.mmu_unmap = kgsl_iopgtbl_unmap,
 	.mmu_unmap_range = kgsl_iopgtbl_unmap_range,
+	.mmu_unmap_range_noflush = kgsl_iopgtbl_unmap_range_noflush,
+	.mmu_flush_tlb = kgsl_iopgtbl_flush_tlb,
 	.mmu_destroy_pagetable = kgsl_iommu_destroy_pagetable,
 	.get_ttbr0 = kgsl_iommu_get_ttbr0,
 	.get_context_bank = kgsl_iommu_get_context_bank,
@@ -324,12 +324,40 @@ int kgsl_mmu_set_svm_region(struct kgsl_pagetable *pagetable, uint64_t gpuaddr,
 	return -ENOMEM;
 }
 
+/* Map the memdesc and account it, returns 1 if the pagetable can't map */
+static int _kgsl_mmu_map(struct kgsl_pagetable *pagetable,
+		struct kgsl_memdesc *memdesc)
+{
+	struct kgsl_device *device = KGSL_MMU_DEVICE(pagetable->mmu);
+	int size, ret;
+
+	if (!PT_OP_VALID(pagetable, mmu_map))
+		return 1;
+
+	size = kgsl_memdesc_footprint(memdesc);
+
+	ret = pagetable->pt_ops->mmu_map(pagetable, memdesc);
+	if (ret)
+		return ret;
+
+	atomic_inc(&pagetable->stats.entries);
+	KGSL_STATS_ADD(size, &pagetable->stats.mapped,
+			&pagetable->stats.max_mapped);
+	kgsl_mmu_trace_gpu_mem_pagetable(pagetable);
+
+	if (!kgsl_memdesc_is_global(memdesc)
+			&& !(memdesc->flags & KGSL_MEMFLAGS_USERMEM_ION)) {
+		kgsl_trace_gpu_mem_total(device, size);
+	}
+
+	return 0;
+}
+
 int
 kgsl_mmu_map(struct kgsl_pagetable *pagetable,
 				struct kgsl_memdesc *memdesc)
 {
-	int size;
-	struct kgsl_device *device = KGSL_MMU_DEVICE(pagetable->mmu);
+	int ret;
 
 	if (!memdesc->gpuaddr)
 		return -EINVAL;
@@ -341,29 +369,31 @@ kgsl_mmu_map(struct kgsl_pagetable *pagetable,
 	if (memdesc->flags & KGSL_MEMFLAGS_VBO)
 		return -EINVAL;
 
-	size = kgsl_memdesc_footprint(memdesc);
+	ret = _kgsl_mmu_map(pagetable, memdesc);
+	if (ret < 0)
+		return ret;
 
-	if (PT_OP_VALID(pagetable, mmu_map)) {
-		int ret;
+	if (!ret)
+		memdesc->priv |= KGSL_MEMDESC_MAPPED;
 
-		ret = pagetable->pt_ops->mmu_map(pagetable, memdesc);
-		if (ret)
-			return ret;
+	return 0;
+}
 
-		atomic_inc(&pagetable->stats.entries);
-		KGSL_STATS_ADD(size, &pagetable->stats.mapped,
-				&pagetable->stats.max_mapped);
-		kgsl_mmu_trace_gpu_mem_pagetable(pagetable);
+/*
+ * Same as kgsl_mmu_map() but memdesc->priv is left alone, the caller flags
+ * the memdesc as mapped before it can be shared and handles the error.
+ */
+int kgsl_mmu_map_unflagged(struct kgsl_pagetable *pagetable,
+		struct kgsl_memdesc *memdesc)
+{
+	int ret;
 
-		if (!kgsl_memdesc_is_global(memdesc)
-				&& !(memdesc->flags & KGSL_MEMFLAGS_USERMEM_ION)) {
-			kgsl_trace_gpu_mem_total(device, size);
-		}
+	if (!memdesc->gpuaddr || (memdesc->flags & KGSL_MEMFLAGS_VBO))
+		return -EINVAL;
 
-		memdesc->priv |= KGSL_MEMDESC_MAPPED;
-	}
+	ret = _kgsl_mmu_map(pagetable, memdesc);
 
-	return 0;
+	return ret < 0 ? ret : 0;
 }
 
 int kgsl_mmu_map_child(struct kgsl_pagetable *pt,
@@ -496,6 +526,38 @@ kgsl_mmu_unmap_range(struct kgsl_pagetable *pagetable,
 	return ret;
 }
 
+/*
+ * Same as kgsl_mmu_unmap_range() but the TLB is not invalidated. The caller
+ * must call kgsl_mmu_flush_tlb() before the unmapped pages can be released.
+ */
+int
+kgsl_mmu_unmap_range_noflush(struct kgsl_pagetable *pagetable,
+		struct kgsl_memdesc *memdesc, u64 offset, u64 length)
+{
+	int ret = 0;
+
+	if (!PT_OP_VALID(pagetable, mmu_unmap_range_noflush))
+		return kgsl_mmu_unmap_range(pagetable, memdesc, offset, length);
+
+	/* Only allow virtual buffer objects to use this function */
+	if (!(memdesc->flags & KGSL_MEMFLAGS_VBO))
+		return -EINVAL;
+
+	ret = pagetable->pt_ops->mmu_unmap_range_noflush(pagetable, memdesc,
+		offset, length);
+
+	if (!ret)
+		atomic_long_sub(length, &pagetable->stats.mapped);
+
+	return ret;
+}
+
+void kgsl_mmu_flush_tlb(struct kgsl_pagetable *pagetable)
+{
+	if (PT_OP_VALID(pagetable, mmu_flush_tlb))
+		pagetable->pt_ops->mmu_flush_tlb(pagetable);
+}
+
 void kgsl_mmu_map_global(struct kgsl_device *device,
 		struct kgsl_memdesc *memdesc, u32 padding)
 {
@@ -67,6 +67,12 @@ struct kgsl_pagetable {
 		atomic_t entries;
 		atomic_long_t mapped;
 		atomic_long_t max_mapped;
+		/** @stats.va_allocs: Number of GPU VA range searches */
+		u64 va_allocs;
+		/** @stats.va_alloc_ns: Total time spent searching GPU VA ranges */
+		u64 va_alloc_ns;
+		/** @stats.va_alloc_max_ns: Longest GPU VA range search */
+		u64 va_alloc_max_ns;
 	} stats;
 	const struct kgsl_mmu_pt_ops *pt_ops;
 	uint64_t fault_addr;
@@ -131,6 +137,9 @@ struct kgsl_mmu_pt_ops {
 			struct kgsl_memdesc *memdesc);
 	int (*mmu_unmap_range)(struct kgsl_pagetable *pt,
 			struct kgsl_memdesc *memdesc, u64 offset, u64 length);
+	int (*mmu_unmap_range_noflush)(struct kgsl_pagetable *pt,
+			struct kgsl_memdesc *memdesc, u64 offset, u64 length);
+	void (*mmu_flush_tlb)(struct kgsl_pagetable *pt);
 	void (*mmu_destroy_pagetable)(struct kgsl_pagetable *pt);
 	u64 (*get_ttbr0)(struct kgsl_pagetable *pt);
 	int (*get_context_bank)(struct kgsl_pagetable *pt, struct kgsl_context *context);
@@ -214,6 +223,8 @@ void kgsl_mmu_putpagetable(struct kgsl_pagetable *pagetable);
 
 int kgsl_mmu_map(struct kgsl_pagetable *pagetable,
 		 struct kgsl_memdesc *memdesc);
+int kgsl_mmu_map_unflagged(struct kgsl_pagetable *pagetable,
+		struct kgsl_memdesc *memdesc);
 int kgsl_mmu_map_child(struct kgsl_pagetable *pt,
 		struct kgsl_memdesc *memdesc, u64 offset,
 		struct kgsl_memdesc *child, u64 child_offset,
@@ -224,6 +235,9 @@ int kgsl_mmu_unmap(struct kgsl_pagetable *pagetable,
 		    struct kgsl_memdesc *memdesc);
 int kgsl_mmu_unmap_range(struct kgsl_pagetable *pt,
 		struct kgsl_memdesc *memdesc, u64 offset, u64 length);
+int kgsl_mmu_unmap_range_noflush(struct kgsl_pagetable *pt,
+		struct kgsl_memdesc *memdesc, u64 offset, u64 length);
+void kgsl_mmu_flush_tlb(struct kgsl_pagetable *pt);
 unsigned int kgsl_mmu_log_fault_addr(struct kgsl_mmu *mmu,
 		u64 ttbr0, uint64_t addr);
 bool kgsl_mmu_gpuaddr_in_range(struct kgsl_pagetable *pt, uint64_t gpuaddr,
@@ -6,7 +6,9 @@
 
 #include <asm/cacheflush.h>
 #include <linux/debugfs.h>
+#include <linux/freezer.h>
 #include <linux/highmem.h>
+#include <linux/kthread.h>
 #include <linux/mempool.h>
 #include <linux/of.h>
 #include <linux/scatterlist.h>
@@ -38,6 +40,13 @@ static struct kmem_cache *addr_page_cache;
  * @mempool: Mempool to pre-allocate tracking structs for pages in this pool
  * @debug_root: Pointer to the debugfs root for this pool
  * @max_pages: Limit on number of pages this pool can hold
+ * @zeroed_list: Pages already zeroed and cleaned by the prezero thread
+ * @zeroed_count: Number of pages in @zeroed_list
+ * @zeroed_target: Number of zeroed pages the prezero thread keeps ready
+ * @zeroed_hits: Allocations served from @zeroed_list
+ * @zeroed_misses: Allocations that had to zero the page synchronously
+ * @prezero_pages: Pages zeroed by the prezero thread
+ * @prezero_ns: Time spent by the prezero thread zeroing pages
  */
 struct kgsl_page_pool {
 	unsigned int pool_order;
@@ -48,6 +57,13 @@ struct kgsl_page_pool {
 	mempool_t *mempool;
 	struct dentry *debug_root;
 	unsigned int max_pages;
+	struct list_head zeroed_list;
+	unsigned int zeroed_count;
+	unsigned int zeroed_target;
+	u64 zeroed_hits;
+	u64 zeroed_misses;
+	u64 prezero_pages;
+	u64 prezero_ns;
 };
 
 static void *_pool_entry_alloc(gfp_t gfp_mask, void *arg)
@@ -159,6 +175,13 @@ static void kgsl_destroy_page_pool(struct kgsl_page_pool *pool)
  * @page_list: List of pages held/reserved in this pool
  * @debug_root: Pointer to the debugfs root for this pool
  * @max_pages: Limit on number of pages this pool can hold
+ * @zeroed_list: Pages already zeroed and cleaned by the prezero thread
+ * @zeroed_count: Number of pages in @zeroed_list
+ * @zeroed_target: Number of zeroed pages the prezero thread keeps ready
+ * @zeroed_hits: Allocations served from @zeroed_list
+ * @zeroed_misses: Allocations that had to zero the page synchronously
+ * @prezero_pages: Pages zeroed by the prezero thread
+ * @prezero_ns: Time spent by the prezero thread zeroing pages
  */
 struct kgsl_page_pool {
 	unsigned int pool_order;
@@ -168,6 +191,13 @@ struct kgsl_page_pool {
 	struct list_head page_list;
 	struct dentry *debug_root;
 	unsigned int max_pages;
+	struct list_head zeroed_list;
+	unsigned int zeroed_count;
+	unsigned int zeroed_target;
+	u64 zeroed_hits;
+	u64 zeroed_misses;
+	u64 prezero_pages;
+	u64 prezero_ns;
 };
 
 static int
@@ -229,6 +259,40 @@ static struct kgsl_page_pool kgsl_pools[6];
 static int kgsl_num_pools;
 static int kgsl_pool_max_pages;
 
+/* Number of pages in the pool, zeroed pages included */
+static inline unsigned int kgsl_pool_count(struct kgsl_page_pool *pool)
+{
+	return READ_ONCE(pool->page_count) + READ_ONCE(pool->zeroed_count);
+}
+
+static void
+__kgsl_pool_add_zeroed_page(struct kgsl_page_pool *pool, struct page *p)
+{
+	list_add_tail(&p->lru, &pool->zeroed_list);
+
+	/*
+	 * zeroed_count may be read without the list_lock held. Use WRITE_ONCE
+	 * to avoid compiler optimizations that may break consistency.
+	 */
+	ASSERT_EXCLUSIVE_WRITER(pool->zeroed_count);
+	WRITE_ONCE(pool->zeroed_count, pool->zeroed_count + 1);
+}
+
+static struct page *
+__kgsl_pool_get_zeroed_page(struct kgsl_page_pool *pool)
+{
+	struct page *p;
+
+	p = list_first_entry_or_null(&pool->zeroed_list, struct page, lru);
+	if (p) {
+		ASSERT_EXCLUSIVE_WRITER(pool->zeroed_count);
+		WRITE_ONCE(pool->zeroed_count, pool->zeroed_count - 1);
+		list_del(&p->lru);
+	}
+
+	return p;
+}
+
 /* Return the index of the pool for the specified order */
 static int kgsl_get_pool_index(int order)
 {
@@ -287,6 +351,8 @@ _kgsl_pool_get_page(struct kgsl_page_pool *pool)
 
 	spin_lock(&pool->list_lock);
 	p = __kgsl_pool_get_page(pool);
+	if (p == NULL)
+		p = __kgsl_pool_get_zeroed_page(pool);
 	spin_unlock(&pool->list_lock);
 	if (p != NULL) {
 		/* Use READ_ONCE to read page_count without holding list_lock */
@@ -298,6 +364,291 @@ _kgsl_pool_get_page(struct kgsl_page_pool *pool)
 	return p;
 }
 
+#if IS_ENABLED(CONFIG_QCOM_KGSL_POOL_PREZERO)
+/*
+ * Default amount of memory kept zeroed in each pool, kept small since the
+ * pages stay out of the system until the shrinker takes them back
+ */
+#define KGSL_POOL_PREZERO_DEFAULT_SIZE SZ_1M
+/* Time the prezero thread stops taking new pages after a shrink */
+#define KGSL_POOL_PREZERO_BACKOFF (10 * HZ)
+
+static struct task_struct *kgsl_prezero_task;
+static DECLARE_WAIT_QUEUE_HEAD(kgsl_prezero_wq);
+/* Device used for the cache maintenance of the zeroed pages */
+static struct device *kgsl_prezero_dev;
+/* Jiffies until which the prezero thread only zeroes pages already pooled */
+static unsigned long kgsl_prezero_backoff;
+/* Set by the pool kicks, the thread only tries to fill the pools if set */
+static bool kgsl_prezero_retry = true;
+
+/* Returns a zeroed page from the pool and accounts the hit or the miss */
+static struct page *
+_kgsl_pool_get_zeroed_page(struct kgsl_page_pool *pool)
+{
+	struct page *p;
+
+	spin_lock(&pool->list_lock);
+	p = __kgsl_pool_get_zeroed_page(pool);
+	if (p)
+		WRITE_ONCE(pool->zeroed_hits, pool->zeroed_hits + 1);
+	else
+		WRITE_ONCE(pool->zeroed_misses, pool->zeroed_misses + 1);
+	spin_unlock(&pool->list_lock);
+
+	if (p != NULL) {
+		trace_kgsl_pool_get_page(pool->pool_order,
+				READ_ONCE(pool->page_count));
+		mod_node_page_state(page_pgdat(p), NR_KERNEL_MISC_RECLAIMABLE,
+				-(1 << pool->pool_order));
+	}
+
+	return p;
+}
+
+static bool kgsl_pool_prezero_pending(void)
+{
+	int i;
+
+	if (!READ_ONCE(kgsl_prezero_dev))
+		return false;
+
+	for (i = 0; i < kgsl_num_pools; i++) {
+		struct kgsl_page_pool *pool = &kgsl_pools[i];
+
+		if (READ_ONCE(pool->zeroed_count) <
+				READ_ONCE(pool->zeroed_target))
+			return true;
+	}
+
+	return false;
+}
+
+/* Wake up the prezero thread if some pool is below its target */
+static void kgsl_pool_prezero_kick(struct kgsl_page_pool *pool)
+{
+	if (pool && READ_ONCE(pool->zeroed_count) >=
+			READ_ONCE(pool->zeroed_target))
+		return;
+
+	WRITE_ONCE(kgsl_prezero_retry, true);
+
+	/* Orders the retry flag against the waiter check in wq_has_sleeper */
+	if (wq_has_sleeper(&kgsl_prezero_wq))
+		wake_up(&kgsl_prezero_wq);
+}
+
+/*
+ * Get a page to zero for the pool, either a page not zeroed yet or a new one
+ * from the system if the pool limits allow it.
+ */
+static struct page *kgsl_pool_prezero_get_page(struct kgsl_page_pool *pool)
+{
+	struct page *p;
+	gfp_t gfp_mask;
+
+	spin_lock(&pool->list_lock);
+	p = __kgsl_pool_get_page(pool);
+	spin_unlock(&pool->list_lock);
+
+	if (p)
+		return p;
+
+	/* Don't take back the memory the shrinker just released */
+	if (time_before(jiffies, READ_ONCE(kgsl_prezero_backoff)))
+		return NULL;
+
+	if (kgsl_pool_count(pool) >= pool->max_pages ||
+		(kgsl_pool_max_pages &&
+			kgsl_pool_size_total() >= kgsl_pool_max_pages))
+		return NULL;
+
+	/* Never reclaim to refill the zeroed pages */
+	gfp_mask = (kgsl_gfp_mask(pool->pool_order) & ~__GFP_DIRECT_RECLAIM) |
+			__GFP_NOWARN;
+
+	p = alloc_pages(gfp_mask, pool->pool_order);
+	if (p) {
+		trace_kgsl_pool_alloc_page_system(pool->pool_order);
+		mod_node_page_state(page_pgdat(p), NR_KERNEL_MISC_RECLAIMABLE,
+				(1 << pool->pool_order));
+	}
+
+	return p;
+}
+
+/* Zero pages until the pool reaches its target or can't take more pages */
+static void kgsl_pool_prezero_fill(struct kgsl_page_pool *pool,
+		struct device *dev)
+{
+	while (READ_ONCE(pool->zeroed_count) < READ_ONCE(pool->zeroed_target)) {
+		struct page *p;
+		u64 ts;
+
+		if (kthread_should_stop())
+			return;
+
+		p = kgsl_pool_prezero_get_page(pool);
+		if (!p)
+			return;
+
+		ts = ktime_get_ns();
+		kgsl_zero_page(p, pool->pool_order, dev);
+		ts = ktime_get_ns() - ts;
+
+		spin_lock(&pool->list_lock);
+		__kgsl_pool_add_zeroed_page(pool, p);
+		WRITE_ONCE(pool->prezero_pages, pool->prezero_pages + 1);
+		WRITE_ONCE(pool->prezero_ns, pool->prezero_ns + ts);
+		spin_unlock(&pool->list_lock);
+
+		cond_resched();
+	}
+}
+
+static int kgsl_pool_prezero_thread(void *data)
+{
+	set_user_nice(current, MAX_NICE);
+	set_freezable();
+
+	while (!kthread_should_stop()) {
+		struct device *dev;
+		int i;
+
+		/*
+		 * A pool that couldn't be refilled is only retried after the
+		 * next page free or allocation kicks the thread.
+		 */
+		wait_event_freezable(kgsl_prezero_wq,
+			(READ_ONCE(kgsl_prezero_retry) &&
+				kgsl_pool_prezero_pending()) ||
+			kthread_should_stop());
+
+		dev = READ_ONCE(kgsl_prezero_dev);
+		if (!dev)
+			continue;
+
+		/* Cleared before filling so a kick during the fill isn't lost */
+		WRITE_ONCE(kgsl_prezero_retry, false);
+		smp_mb();
+
+		/* Fill the higher orders first, they are the most costly */
+		for (i = kgsl_num_pools - 1; i >= 0; i--)
+			kgsl_pool_prezero_fill(&kgsl_pools[i], dev);
+	}
+
+	return 0;
+}
+
+static void kgsl_pool_prezero_init(struct kgsl_page_pool *pool,
+		struct device_node *node)
+{
+	u32 target = KGSL_POOL_PREZERO_DEFAULT_SIZE >>
+			(PAGE_SHIFT + pool->pool_order);
+
+	of_property_read_u32(node, "qcom,mempool-prezero-pages", &target);
+
+	pool->zeroed_target = min_t(u32, target, pool->max_pages);
+}
+
+static void kgsl_pool_prezero_start(void)
+{
+	struct task_struct *task;
+
+	if (!kgsl_num_pools)
+		return;
+
+	task = kthread_run(kgsl_pool_prezero_thread, NULL, "kgsl_prezero");
+	if (IS_ERR(task)) {
+		pr_err("kgsl: unable to start the pool prezero thread: %ld\n",
+			PTR_ERR(task));
+		return;
+	}
+
+	kgsl_prezero_task = task;
+}
+
+static void kgsl_pool_prezero_stop(void)
+{
+	if (kgsl_prezero_task)
+		kthread_stop(kgsl_prezero_task);
+
+	kgsl_prezero_task = NULL;
+}
+
+static void kgsl_pool_prezero_shrink(void)
+{
+	WRITE_ONCE(kgsl_prezero_backoff, jiffies + KGSL_POOL_PREZERO_BACKOFF);
+}
+
+int kgsl_pool_prezero_target_get(void *data, u64 *val)
+{
+	struct kgsl_page_pool *pool = data;
+
+	*val = (u64) READ_ONCE(pool->zeroed_target);
+	return 0;
+}
+
+int kgsl_pool_prezero_target_set(void *data, u64 val)
+{
+	struct kgsl_page_pool *pool = data;
+
+	WRITE_ONCE(pool->zeroed_target, min_t(u64, val, pool->max_pages));
+	kgsl_pool_prezero_kick(pool);
+	return 0;
+}
+
+int kgsl_pool_prezero_show(struct seq_file *s, void *unused)
+{
+	struct kgsl_page_pool *pool = s->private;
+	u64 hits, misses, pages, ns;
+
+	spin_lock(&pool->list_lock);
+	hits = pool->zeroed_hits;
+	misses = pool->zeroed_misses;
+	pages = pool->prezero_pages;
+	ns = pool->prezero_ns;
+	spin_unlock(&pool->list_lock);
+
+	seq_printf(s, "zeroed: %u target: %u\n", READ_ONCE(pool->zeroed_count),
+		READ_ONCE(pool->zeroed_target));
+	seq_printf(s, "hits: %llu misses: %llu hit_rate: %llu%%\n", hits, misses,
+		(hits + misses) ? div64_u64(hits * 100, hits + misses) : 0);
+	/* Zeroing cost moved off the allocating threads */
+	seq_printf(s, "saved_us: %llu\n",
+		pages ? div64_u64(div64_u64(ns, pages) * hits, NSEC_PER_USEC) : 0);
+
+	return 0;
+}
+#else
+static struct page *
+_kgsl_pool_get_zeroed_page(struct kgsl_page_pool *pool)
+{
+	return NULL;
+}
+
+static void kgsl_pool_prezero_kick(struct kgsl_page_pool *pool)
+{
+}
+
+static void kgsl_pool_prezero_init(struct kgsl_page_pool *pool,
+		struct device_node *node)
+{
+}
+
+static void kgsl_pool_prezero_start(void)
+{
+}
+
+static void kgsl_pool_prezero_stop(void)
+{
+}
+
+static void kgsl_pool_prezero_shrink(void)
+{
+}
+#endif
+
 int kgsl_pool_size_total(void)
 {
 	int i;
@@ -307,7 +658,8 @@ int kgsl_pool_size_total(void)
 		struct kgsl_page_pool *kgsl_pool = &kgsl_pools[i];
 
 		spin_lock(&kgsl_pool->list_lock);
-		total += kgsl_pool->page_count * (1 << kgsl_pool->pool_order);
+		total += kgsl_pool_count(kgsl_pool) *
+				(1 << kgsl_pool->pool_order);
 		spin_unlock(&kgsl_pool->list_lock);
 	}
 
@@ -324,8 +676,8 @@ static unsigned long kgsl_pool_size_nonreserved(void)
 		struct kgsl_page_pool *pool = &kgsl_pools[i];
 
 		spin_lock(&pool->list_lock);
-		if (pool->page_count > pool->reserved_pages)
-			total += (pool->page_count - pool->reserved_pages) *
+		if (kgsl_pool_count(pool) > pool->reserved_pages)
+			total += (kgsl_pool_count(pool) - pool->reserved_pages) *
 					(1 << pool->pool_order);
 		spin_unlock(&pool->list_lock);
 	}
@@ -344,12 +696,15 @@ _kgsl_pool_get_nonreserved_page(struct kgsl_page_pool *pool)
 	struct page *p = NULL;
 
 	spin_lock(&pool->list_lock);
-	if (pool->page_count <= pool->reserved_pages) {
+	if (kgsl_pool_count(pool) <= pool->reserved_pages) {
 		spin_unlock(&pool->list_lock);
 		return NULL;
 	}
 
+	/* Give back the pages that were not zeroed yet first */
 	p = __kgsl_pool_get_page(pool);
+	if (p == NULL)
+		p = __kgsl_pool_get_zeroed_page(pool);
 	spin_unlock(&pool->list_lock);
 	if (p != NULL) {
 		/* Use READ_ONCE to read page_count without holding list_lock */
@@ -497,6 +852,14 @@ int kgsl_pool_alloc_page(int *page_size, struct page **pages,
 	if ((pages == NULL) || pages_len < (*page_size >> PAGE_SHIFT))
 		return -EINVAL;
 
+#if IS_ENABLED(CONFIG_QCOM_KGSL_POOL_PREZERO)
+	/* All allocations come from the same device, let the thread use it */
+	if (unlikely(!READ_ONCE(kgsl_prezero_dev)) && dev) {
+		WRITE_ONCE(kgsl_prezero_dev, dev);
+		kgsl_pool_prezero_kick(NULL);
+	}
+#endif
+
 	/* If the pool is not configured get pages from the system */
 	if (!kgsl_num_pools) {
 		gfp_t gfp_mask = kgsl_gfp_mask(order);
@@ -537,6 +900,14 @@ int kgsl_pool_alloc_page(int *page_size, struct page **pages,
 	}
 
 	pool_idx = kgsl_get_pool_index(order);
+
+	/* Prefer a page the prezero thread already zeroed and cleaned */
+	page = _kgsl_pool_get_zeroed_page(pool);
+	if (page) {
+		kgsl_pool_prezero_kick(pool);
+		goto zeroed;
+	}
+
 	page = _kgsl_pool_get_page(pool);
 
 	/* Allocate a new page if not allocated from pool */
@@ -560,6 +931,7 @@ int kgsl_pool_alloc_page(int *page_size, struct page **pages,
 done:
 	kgsl_zero_page(page, order, dev);
 
+zeroed:
 	for (j = 0; j < (*page_size >> PAGE_SHIFT); j++) {
 		p = nth_page(page, j);
 		pages[pcount] = p;
@@ -589,8 +961,9 @@ void kgsl_pool_free_page(struct page *page)
 			(kgsl_pool_size_total() < kgsl_pool_max_pages)) {
 		pool = _kgsl_get_pool_from_order(page_order);
 		/* Use READ_ONCE to read page_count without holding list_lock */
-		if (pool && (READ_ONCE(pool->page_count) < pool->max_pages)) {
+		if (pool && (kgsl_pool_count(pool) < pool->max_pages)) {
 			_kgsl_pool_add_page(pool, page);
+			kgsl_pool_prezero_kick(pool);
 			return;
 		}
 	}
@@ -607,7 +980,12 @@ kgsl_pool_shrink_scan_objects(struct shrinker *shrinker,
 					struct shrink_control *sc)
 {
 	/* sc->nr_to_scan represents number of pages to be removed*/
-	unsigned long pcount = kgsl_pool_reduce(sc->nr_to_scan, false);
+	unsigned long pcount;
+
+	/* Keep the prezero thread from refilling the pools under pressure */
+	kgsl_pool_prezero_shrink();
+
+	pcount = kgsl_pool_reduce(sc->nr_to_scan, false);
 
 	/* If pools are exhausted return SHRINK_STOP */
 	return pcount ? pcount : SHRINK_STOP;
@@ -645,7 +1023,7 @@ int kgsl_pool_page_count_get(void *data, u64 *val)
 	struct kgsl_page_pool *pool = data;
 
 	/* Use READ_ONCE to read page_count without holding list_lock */
-	*val = (u64) READ_ONCE(pool->page_count);
+	*val = (u64) kgsl_pool_count(pool);
 	return 0;
 }
 
@@ -704,8 +1082,10 @@ static int kgsl_of_parse_mempool(struct kgsl_page_pool *pool,
 
 	spin_lock_init(&pool->list_lock);
 	kgsl_pool_list_init(pool);
+	INIT_LIST_HEAD(&pool->zeroed_list);
 
 	kgsl_pool_reserve_pages(pool, node);
+	kgsl_pool_prezero_init(pool, node);
 
 	snprintf(name, sizeof(name), "%d_order", (pool->pool_order));
 	kgsl_pool_init_debugfs(pool->debug_root, name, (void *) pool);
@@ -747,12 +1127,16 @@ void kgsl_probe_page_pools(void)
 #else
 	register_shrinker(&kgsl_pool_shrinker);
 #endif
+
+	kgsl_pool_prezero_start();
 }
 
 void kgsl_exit_page_pools(void)
 {
 	int i;
 
+	kgsl_pool_prezero_stop();
+
 	/* Release all pages in pools, if any.*/
 	kgsl_pool_reduce(INT_MAX, true);
 
@@ -83,6 +83,22 @@ void kgsl_pool_free_pages(struct page **pages, unsigned int page_count);
 int kgsl_pool_reserved_get(void *data, u64 *val);
 int kgsl_pool_page_count_get(void *data, u64 *val);
 
+#if IS_ENABLED(CONFIG_QCOM_KGSL_POOL_PREZERO)
+struct seq_file;
+
+int kgsl_pool_prezero_target_get(void *data, u64 *val);
+int kgsl_pool_prezero_target_set(void *data, u64 val);
+
+/**
+ * kgsl_pool_prezero_show - Show the zeroed page statistics of a pool
+ * @s: seq_file with the pool as private data
+ * @unused: Unused
+ *
+ * Return: 0
+ */
+int kgsl_pool_prezero_show(struct seq_file *s, void *unused);
+#endif
+
 /**
  * kgsl_pool_size_total - Return the number of pages in all kgsl page pools
  */
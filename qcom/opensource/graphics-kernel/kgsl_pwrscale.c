@@ -5,6 +5,7 @@
  */
 
 #include <linux/devfreq_cooling.h>
+#include <linux/math64.h>
 #include <linux/slab.h>
 
 #include "kgsl_bus.h"
@@ -18,6 +19,10 @@ static struct devfreq_msm_adreno_tz_data adreno_tz_data = {
 		.floating = true,
 	},
 	.mod_percent = 100,
+	.frame = {
+		.lock = __SPIN_LOCK_UNLOCKED(adreno_tz_data.frame.lock),
+		.headroom = 10,
+	},
 };
 
 static void do_devfreq_suspend(struct work_struct *work);
@@ -43,6 +48,30 @@ void kgsl_pwrscale_fast_bus_hint(bool on)
 	adreno_tz_data.fast_bus_hint = on;
 }
 
+void kgsl_pwrscale_frame_work(struct kgsl_device *device,
+		struct kgsl_context *context, u64 ticks)
+{
+	if (device->pwrscale.enabled && ticks)
+		atomic64_add(ticks, &context->frame_ticks);
+}
+
+void kgsl_pwrscale_frame_done(struct kgsl_device *device,
+		struct kgsl_context *context)
+{
+	struct kgsl_pwrctrl *pwr = &device->pwrctrl;
+	u64 ticks = atomic64_xchg(&context->frame_ticks, 0);
+	u32 freq;
+
+	/* Without profiling data there is nothing to predict from */
+	if (!device->pwrscale.enabled || !ticks)
+		return;
+
+	freq = pwr->pwrlevels[READ_ONCE(pwr->active_pwrlevel)].gpu_freq;
+
+	msm_adreno_tz_frame_update(&adreno_tz_data,
+		mul_u64_u32_div(ticks, freq, KGSL_XO_CLK_FREQ));
+}
+
 /*
  * kgsl_pwrscale_sleep - notify governor that device is going off
  * @device: The device
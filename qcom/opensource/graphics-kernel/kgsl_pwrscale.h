@@ -11,6 +11,8 @@
 #include "kgsl_pwrctrl.h"
 #include "msm_adreno_devfreq.h"
 
+struct kgsl_context;
+
 /* devfreq governor call window in usec */
 #define KGSL_GOVERNOR_CALL_INTERVAL 10000
 
@@ -108,6 +110,31 @@ int msm_adreno_tz_reinit(struct devfreq *devfreq);
 
 void msm_adreno_tz_exit(void);
 
+/**
+ * msm_adreno_tz_frame_update - Report the GPU work of a retired frame
+ * @priv: Governor private data
+ * @cycles: GPU cycles spent on the frame
+ */
+void msm_adreno_tz_frame_update(struct devfreq_msm_adreno_tz_data *priv,
+		u64 cycles);
+
+/**
+ * kgsl_pwrscale_frame_work - Account GPU work to the frame in progress
+ * @device: A GPU device handle
+ * @context: Context that submitted the work
+ * @ticks: Always on counter ticks the GPU was active for the work
+ */
+void kgsl_pwrscale_frame_work(struct kgsl_device *device,
+		struct kgsl_context *context, u64 ticks);
+
+/**
+ * kgsl_pwrscale_frame_done - Report the end of a frame to the governor
+ * @device: A GPU device handle
+ * @context: Context that retired the end of frame command
+ */
+void kgsl_pwrscale_frame_done(struct kgsl_device *device,
+		struct kgsl_context *context);
+
 int devfreq_gpubw_init(void);
 
 void devfreq_gpubw_exit(void);
@@ -328,6 +328,42 @@ mem_entry_max_show(struct kgsl_process_private *priv, int type, char *buf)
 	return scnprintf(buf, PAGE_SIZE, "%llu\n", priv->stats[type].max);
 }
 
+/**
+ * Show the number of GPU VA range searches done in the process pagetable
+ */
+
+static ssize_t
+va_alloc_count_show(struct kgsl_process_private *priv, int type, char *buf)
+{
+	return scnprintf(buf, PAGE_SIZE, "%llu\n",
+			READ_ONCE(priv->pagetable->stats.va_allocs));
+}
+
+/**
+ * Show the average time in ns spent searching a free GPU VA range
+ */
+
+static ssize_t
+va_alloc_avg_ns_show(struct kgsl_process_private *priv, int type, char *buf)
+{
+	u64 count = READ_ONCE(priv->pagetable->stats.va_allocs);
+	u64 total = READ_ONCE(priv->pagetable->stats.va_alloc_ns);
+
+	return scnprintf(buf, PAGE_SIZE, "%llu\n",
+			count ? div64_u64(total, count) : 0);
+}
+
+/**
+ * Show the longest time in ns spent searching a free GPU VA range
+ */
+
+static ssize_t
+va_alloc_max_ns_show(struct kgsl_process_private *priv, int type, char *buf)
+{
+	return scnprintf(buf, PAGE_SIZE, "%llu\n",
+			READ_ONCE(priv->pagetable->stats.va_alloc_max_ns));
+}
+
 static ssize_t process_sysfs_show(struct kobject *kobj,
 	struct attribute *attr, char *buf)
 {
@@ -367,6 +403,9 @@ MEM_ENTRY_ATTR(KGSL_MEM_ENTRY_USER, ion_max, mem_entry_max_show);
 MEM_ENTRY_ATTR(0, imported_mem, imported_mem_show);
 MEM_ENTRY_ATTR(0, gpumem_mapped, gpumem_mapped_show);
 MEM_ENTRY_ATTR(KGSL_MEM_ENTRY_KERNEL, gpumem_unmapped, gpumem_unmapped_show);
+MEM_ENTRY_ATTR(0, va_alloc_count, va_alloc_count_show);
+MEM_ENTRY_ATTR(0, va_alloc_avg_ns, va_alloc_avg_ns_show);
+MEM_ENTRY_ATTR(0, va_alloc_max_ns, va_alloc_max_ns_show);
 
 static struct attribute *mem_entry_attrs[] = {
 	&mem_entry_kernel.attr.attr,
@@ -380,6 +419,9 @@ static struct attribute *mem_entry_attrs[] = {
 	&mem_entry_imported_mem.attr.attr,
 	&mem_entry_gpumem_mapped.attr.attr,
 	&mem_entry_gpumem_unmapped.attr.attr,
+	&mem_entry_va_alloc_count.attr.attr,
+	&mem_entry_va_alloc_avg_ns.attr.attr,
+	&mem_entry_va_alloc_max_ns.attr.attr,
 	NULL,
 };
 ATTRIBUTE_GROUPS(mem_entry);
@@ -1036,6 +1036,61 @@ TRACE_EVENT(kgsl_fire_event,
 			__entry->age, __entry->func)
 );
 
+TRACE_EVENT(kgsl_process_event_group,
+		TP_PROTO(struct kgsl_event_group *group, unsigned int ts,
+			u32 count),
+		TP_ARGS(group, ts, count),
+		TP_STRUCT__entry(
+			__string(name, group->name)
+			__field(unsigned int, ts)
+			__field(u32, count)
+		),
+		TP_fast_assign(
+			__assign_str(name, group->name);
+			__entry->ts = ts;
+			__entry->count = count;
+		),
+		TP_printk(
+			"group=%s ts=%u count=%u",
+			__get_str(name), __entry->ts, __entry->count)
+);
+
+TRACE_EVENT(kgsl_frame_dcvs,
+		TP_PROTO(u32 deadline_us, u32 frames, u64 window_cycles,
+			u64 window_max, u64 busy_cycles, u64 elapsed_us,
+			u64 predicted, u64 target, unsigned long freq),
+		TP_ARGS(deadline_us, frames, window_cycles, window_max,
+			busy_cycles, elapsed_us, predicted, target, freq),
+		TP_STRUCT__entry(
+			__field(u32, deadline_us)
+			__field(u32, frames)
+			__field(u64, window_cycles)
+			__field(u64, window_max)
+			__field(u64, busy_cycles)
+			__field(u64, elapsed_us)
+			__field(u64, predicted)
+			__field(u64, target)
+			__field(unsigned long, freq)
+		),
+		TP_fast_assign(
+			__entry->deadline_us = deadline_us;
+			__entry->frames = frames;
+			__entry->window_cycles = window_cycles;
+			__entry->window_max = window_max;
+			__entry->busy_cycles = busy_cycles;
+			__entry->elapsed_us = elapsed_us;
+			__entry->predicted = predicted;
+			__entry->target = target;
+			__entry->freq = freq;
+		),
+		TP_printk(
+			"deadline=%uus frames=%u window=%llu max=%llu busy=%llu elapsed=%lluus predicted=%llu target=%llu freq=%lu",
+			__entry->deadline_us, __entry->frames,
+			__entry->window_cycles, __entry->window_max,
+			__entry->busy_cycles, __entry->elapsed_us,
+			__entry->predicted, __entry->target, __entry->freq)
+);
+
 TRACE_EVENT(kgsl_active_count,
 
 	TP_PROTO(struct kgsl_device *device, unsigned long ip),
@@ -19,6 +19,8 @@
 struct kgsl_memdesc_bind_range {
 	struct kgsl_mem_entry *entry;
 	struct interval_tree_node range;
+	/** @node: Entry in the list of ranges released after the TLB flush */
+	struct list_head node;
 };
 
 static struct kgsl_memdesc_bind_range *bind_to_range(struct interval_tree_node *node)
@@ -57,6 +59,27 @@ static void bind_range_destroy(struct kgsl_memdesc_bind_range *range)
 	kfree(range);
 }
 
+/*
+ * Ranges unmapped without a TLB flush are queued here and only released once
+ * the TLB has been invalidated, so that the child pages cannot be freed while
+ * the GPU may still reach them through stale TLB entries
+ */
+static void bind_range_reap(struct kgsl_memdesc_bind_range *range,
+		struct list_head *reap)
+{
+	list_add_tail(&range->node, reap);
+}
+
+static void bind_range_reap_all(struct list_head *reap)
+{
+	struct kgsl_memdesc_bind_range *range, *tmp;
+
+	list_for_each_entry_safe(range, tmp, reap, node) {
+		list_del(&range->node);
+		bind_range_destroy(range);
+	}
+}
+
 static u64 bind_range_len(struct kgsl_memdesc_bind_range *range)
 {
 	return (range->range.last - range->range.start) + 1;
@@ -93,7 +116,8 @@ void kgsl_memdesc_print_vbo_ranges(struct kgsl_mem_entry *entry,
 }
 
 static void kgsl_memdesc_remove_range(struct kgsl_mem_entry *target,
-		u64 start, u64 last, struct kgsl_mem_entry *entry)
+		u64 start, u64 last, struct kgsl_mem_entry *entry,
+		struct list_head *reap)
 {
 	struct  interval_tree_node *node, *next;
 	struct kgsl_memdesc_bind_range *range;
@@ -112,7 +136,7 @@ static void kgsl_memdesc_remove_range(struct kgsl_mem_entry *target,
 		 * the entire range between start and last in this case.
 		 */
 		if (!entry || range->entry->id == entry->id) {
-			if (kgsl_mmu_unmap_range(memdesc->pagetable,
+			if (kgsl_mmu_unmap_range_noflush(memdesc->pagetable,
 				memdesc, range->range.start, bind_range_len(range)))
 				continue;
 
@@ -125,7 +149,7 @@ static void kgsl_memdesc_remove_range(struct kgsl_mem_entry *target,
 				kgsl_mmu_map_zero_page_to_range(memdesc->pagetable,
 					memdesc, range->range.start, bind_range_len(range));
 
-			bind_range_destroy(range);
+			bind_range_reap(range, reap);
 		}
 	}
 
@@ -133,7 +157,8 @@ static void kgsl_memdesc_remove_range(struct kgsl_mem_entry *target,
 }
 
 static int kgsl_memdesc_add_range(struct kgsl_mem_entry *target,
-		u64 start, u64 last, struct kgsl_mem_entry *entry, u64 offset)
+		u64 start, u64 last, struct kgsl_mem_entry *entry, u64 offset,
+		struct list_head *reap)
 {
 	struct  interval_tree_node *node, *next;
 	struct kgsl_memdesc *memdesc = &target->memdesc;
@@ -152,8 +177,8 @@ static int kgsl_memdesc_add_range(struct kgsl_mem_entry *target,
 	 * while walking the interval tree.
 	 */
 	if (!(memdesc->flags & KGSL_MEMFLAGS_VBO_NO_MAP_ZERO)) {
-		ret = kgsl_mmu_unmap_range(memdesc->pagetable, memdesc, start,
-			last - start + 1);
+		ret = kgsl_mmu_unmap_range_noflush(memdesc->pagetable, memdesc,
+			start, last - start + 1);
 		if (ret)
 			goto error;
 	}
@@ -176,7 +201,7 @@ static int kgsl_memdesc_add_range(struct kgsl_mem_entry *target,
 			if (last >= cur->range.last) {
 				/* Unmap the entire cur range */
 				if (memdesc->flags & KGSL_MEMFLAGS_VBO_NO_MAP_ZERO) {
-					ret = kgsl_mmu_unmap_range(memdesc->pagetable, memdesc,
+					ret = kgsl_mmu_unmap_range_noflush(memdesc->pagetable, memdesc,
 						cur->range.start,
 						cur->range.last - cur->range.start + 1);
 					if (ret) {
@@ -185,13 +210,13 @@ static int kgsl_memdesc_add_range(struct kgsl_mem_entry *target,
 					}
 				}
 
-				bind_range_destroy(cur);
+				bind_range_reap(cur, reap);
 				continue;
 			}
 
 			/* Unmap the range overlapping cur */
 			if (memdesc->flags & KGSL_MEMFLAGS_VBO_NO_MAP_ZERO) {
-				ret = kgsl_mmu_unmap_range(memdesc->pagetable, memdesc,
+				ret = kgsl_mmu_unmap_range_noflush(memdesc->pagetable, memdesc,
 					cur->range.start,
 					last - cur->range.start + 1);
 				if (ret) {
@@ -230,7 +255,7 @@ static int kgsl_memdesc_add_range(struct kgsl_mem_entry *target,
 
 			/* Unmap the range overlapping cur */
 			if (memdesc->flags & KGSL_MEMFLAGS_VBO_NO_MAP_ZERO) {
-				ret = kgsl_mmu_unmap_range(memdesc->pagetable, memdesc,
+				ret = kgsl_mmu_unmap_range_noflush(memdesc->pagetable, memdesc,
 					start,
 					min_t(u64, cur->range.last, last) - start + 1);
 				if (ret) {
@@ -271,6 +296,7 @@ static void kgsl_sharedmem_vbo_put_gpuaddr(struct kgsl_memdesc *memdesc)
 {
 	struct interval_tree_node *node, *next;
 	struct kgsl_memdesc_bind_range *range;
+	LIST_HEAD(reap);
 	int ret = 0;
 	bool unmap_fail;
 
@@ -279,7 +305,7 @@ static void kgsl_sharedmem_vbo_put_gpuaddr(struct kgsl_memdesc *memdesc)
 	 * pagetable region in one call.
 	 */
 	if (!(memdesc->flags & KGSL_MEMFLAGS_VBO_NO_MAP_ZERO))
-		ret = kgsl_mmu_unmap_range(memdesc->pagetable, memdesc,
+		ret = kgsl_mmu_unmap_range_noflush(memdesc->pagetable, memdesc,
 			0, memdesc->size);
 
 	unmap_fail = ret;
@@ -301,19 +327,23 @@ static void kgsl_sharedmem_vbo_put_gpuaddr(struct kgsl_memdesc *memdesc)
 
 		/* Unmap this range */
 		if (memdesc->flags & KGSL_MEMFLAGS_VBO_NO_MAP_ZERO)
-			ret = kgsl_mmu_unmap_range(memdesc->pagetable, memdesc,
-				range->range.start,
+			ret = kgsl_mmu_unmap_range_noflush(memdesc->pagetable,
+				memdesc, range->range.start,
 				range->range.last - range->range.start + 1);
 
 		/* Put the child's refcount if unmap succeeds */
 		if (!ret)
-			bind_range_destroy(range);
+			bind_range_reap(range, &reap);
 		else
 			kfree(range);
 
 		unmap_fail = unmap_fail || ret;
 	}
 
+	/* Invalidate the TLB once for all the ranges unmapped above */
+	kgsl_mmu_flush_tlb(memdesc->pagetable);
+	bind_range_reap_all(&reap);
+
 	if (unmap_fail)
 		return;
 
@@ -557,6 +587,7 @@ static void kgsl_sharedmem_bind_worker(struct work_struct *work)
 {
 	struct kgsl_sharedmem_bind_op *op = container_of(work,
 		struct kgsl_sharedmem_bind_op, work);
+	LIST_HEAD(reap);
 	int i;
 
 	for (i = 0; i < op->nr_ops; i++) {
@@ -565,14 +596,20 @@ static void kgsl_sharedmem_bind_worker(struct work_struct *work)
 				op->ops[i].start,
 				op->ops[i].last,
 				op->ops[i].entry,
-				op->ops[i].child_offset);
+				op->ops[i].child_offset,
+				&reap);
 		else
 			kgsl_memdesc_remove_range(op->target,
 				op->ops[i].start,
 				op->ops[i].last,
-				op->ops[i].entry);
+				op->ops[i].entry,
+				&reap);
 	}
 
+	/* Invalidate the TLB once for the whole batch of operations */
+	kgsl_mmu_flush_tlb(op->target->memdesc.pagetable);
+	bind_range_reap_all(&reap);
+
 	/* Wake up any threads waiting for the bind operation */
 	complete_all(&op->comp);
 
@@ -9,6 +9,7 @@
 
 #include <linux/devfreq.h>
 #include <linux/notifier.h>
+#include <linux/spinlock.h>
 
 /* Flags used to send bus modifier hint from busmon governer to driver */
 #define BUSMON_FLAG_FAST_HINT		BIT(0)
@@ -58,6 +59,24 @@ struct devfreq_msm_adreno_tz_data {
 	u32 mod_percent;
 	/* Increase IB vote on high ddr stall */
 	bool fast_bus_hint;
+	/* Frame workload history for the deadline based frequency selection */
+	struct {
+		spinlock_t lock;
+		/* Frame deadline set from userspace, 0 to use the TZ algorithm */
+		u32 deadline_us;
+		/* Extra percentage of cycles to account for on top of the prediction */
+		u32 headroom;
+		/* GPU cycles of all the frames retired since the last sample */
+		u64 window_cycles;
+		/* Heaviest frame in GPU cycles retired since the last sample */
+		u64 window_max;
+		/* Number of frames retired since the last sample */
+		u32 window_frames;
+		/* Predicted GPU cycles of the next frame */
+		u64 predicted;
+		/* Time in ns when the last frame retired */
+		u64 last_ns;
+	} frame;
 };
 
 struct msm_adreno_extended_profile {
@@ -455,6 +455,9 @@ enum cdp_mon_phyrx_abort_reason_code {
  * @desc_magic_mismatch: desc magic number mismatch count;
  * @null_pkt_addr: NULL packet address count;
  * @pending_desc_count: Pending desc_count during pdev deinit
+ * @rtap_in_headroom: Radiotap headers built in place, copy avoided
+ * @frags_to_stack: Page frags handed to the stack without copy
+ * @mpdu_batch_deliver: Number of batched MPDU deliveries to the stack
  */
 struct cdp_pdev_mon_stats {
 #ifndef REMOVE_MON_DBG_STATS
@@ -522,6 +525,11 @@ struct cdp_pdev_mon_stats {
 	uint32_t desc_magic_mismatch;
 	uint32_t null_pkt_addr;
 	uint32_t pending_desc_count;
+#ifdef WLAN_RX_MON_ZERO_COPY
+	uint32_t rtap_in_headroom;
+	uint32_t frags_to_stack;
+	uint32_t mpdu_batch_deliver;
+#endif
 };
 
 #ifdef QCA_SUPPORT_LITE_MONITOR
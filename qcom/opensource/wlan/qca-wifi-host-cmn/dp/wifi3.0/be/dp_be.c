@@ -2436,12 +2436,12 @@ dp_mlo_peer_find_hash_attach_be(dp_mld_peer_hash_obj_t mld_hash_obj,
 	mld_hash_obj->mld_peer_hash.idx_bits = log2;
 	/* allocate an array of TAILQ peer object lists */
 	mld_hash_obj->mld_peer_hash.bins = qdf_mem_malloc(
-		hash_elems * sizeof(TAILQ_HEAD(anonymous_tail_q, dp_peer)));
+		hash_elems * sizeof(mld_hash_obj->mld_peer_hash.bins[0]));
 	if (!mld_hash_obj->mld_peer_hash.bins)
 		return QDF_STATUS_E_NOMEM;
 
 	for (i = 0; i < hash_elems; i++)
-		TAILQ_INIT(&mld_hash_obj->mld_peer_hash.bins[i]);
+		DP_TAILQ_INIT_RCU(&mld_hash_obj->mld_peer_hash.bins[i]);
 
 	qdf_spinlock_create(&mld_hash_obj->mld_peer_hash_lock);
 
@@ -2572,36 +2572,43 @@ dp_mlo_peer_find_hash_find_be(struct dp_soc *soc,
 		vdev = NULL;
 	}
 
-	/* search mld peer table if no link peer for given mac address */
+	/*
+	 * search mld peer table if no link peer for given mac address;
+	 * the bins are walked locklessly, MLD peers are freed after a
+	 * grace period by dp_peer_unref_delete()
+	 */
 	index = dp_mlo_peer_find_hash_index(mld_hash_obj, mac_addr);
-	qdf_spin_lock_bh(&mld_hash_obj->mld_peer_hash_lock);
-	TAILQ_FOREACH(peer, &mld_hash_obj->mld_peer_hash.bins[index],
-		      hash_list_elem) {
-		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0) {
-			if ((vdev_id == DP_VDEV_ALL) || (
-				dp_peer_find_mac_addr_cmp(
-						&peer->vdev->mld_mac_addr,
-						&vdev->mld_mac_addr) == 0)) {
-				/* take peer reference before returning */
-				if (dp_peer_get_ref(NULL, peer, mod_id) !=
-						QDF_STATUS_SUCCESS)
-					peer = NULL;
-
-				if (vdev)
-					dp_vdev_unref_delete(soc, vdev, mod_id);
-
-				qdf_spin_unlock_bh(
-					&mld_hash_obj->mld_peer_hash_lock);
-				return peer;
-			}
+	qdf_rcu_read_lock();
+	DP_TAILQ_FOREACH_RCU(peer, &mld_hash_obj->mld_peer_hash.bins[index],
+			     hash_list_elem) {
+		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr))
+			continue;
+
+		/*
+		 * A peer whose last reference is gone is already out of the
+		 * table, skip it. The vdev is only safe to dereference once
+		 * the reference is held.
+		 */
+		if (dp_peer_get_ref(NULL, peer, mod_id) != QDF_STATUS_SUCCESS)
+			continue;
+
+		if ((vdev_id == DP_VDEV_ALL) ||
+		    (dp_peer_find_mac_addr_cmp(&peer->vdev->mld_mac_addr,
+					       &vdev->mld_mac_addr) == 0)) {
+			qdf_rcu_read_unlock();
+
+			if (vdev)
+				dp_vdev_unref_delete(soc, vdev, mod_id);
+
+			return peer;
 		}
+		dp_peer_unref_delete(peer, mod_id);
 	}
+	qdf_rcu_read_unlock();
 
 	if (vdev)
 		dp_vdev_unref_delete(soc, vdev, mod_id);
 
-	qdf_spin_unlock_bh(&mld_hash_obj->mld_peer_hash_lock);
-
 	return NULL; /* failure */
 }
 
@@ -2619,19 +2626,20 @@ dp_mlo_peer_find_hash_remove_be(struct dp_soc *soc, struct dp_peer *peer)
 		return;
 
 	index = dp_mlo_peer_find_hash_index(mld_hash_obj, &peer->mac_addr);
-	QDF_ASSERT(!TAILQ_EMPTY(&mld_hash_obj->mld_peer_hash.bins[index]));
+	QDF_ASSERT(!DP_TAILQ_EMPTY_RCU(&mld_hash_obj->mld_peer_hash.bins[index]));
 
 	qdf_spin_lock_bh(&mld_hash_obj->mld_peer_hash_lock);
-	TAILQ_FOREACH(tmppeer, &mld_hash_obj->mld_peer_hash.bins[index],
-		      hash_list_elem) {
+	DP_TAILQ_FOREACH_PROTECTED(tmppeer,
+				   &mld_hash_obj->mld_peer_hash.bins[index],
+				   hash_list_elem) {
 		if (tmppeer == peer) {
 			found = 1;
 			break;
 		}
 	}
 	QDF_ASSERT(found);
-	TAILQ_REMOVE(&mld_hash_obj->mld_peer_hash.bins[index], peer,
-		     hash_list_elem);
+	DP_TAILQ_REMOVE_RCU(&mld_hash_obj->mld_peer_hash.bins[index], peer,
+			    hash_list_elem);
 
 	dp_info("Peer %pK (" QDF_MAC_ADDR_FMT ") removed. (found %u)",
 		peer, QDF_MAC_ADDR_REF(peer->mac_addr.raw), found);
@@ -2662,8 +2670,8 @@ dp_mlo_peer_find_hash_add_be(struct dp_soc *soc, struct dp_peer *peer)
 		qdf_spin_unlock_bh(&mld_hash_obj->mld_peer_hash_lock);
 		return;
 	}
-	TAILQ_INSERT_TAIL(&mld_hash_obj->mld_peer_hash.bins[index], peer,
-			  hash_list_elem);
+	DP_TAILQ_INSERT_TAIL_RCU(&mld_hash_obj->mld_peer_hash.bins[index],
+				 peer, hash_list_elem);
 	qdf_spin_unlock_bh(&mld_hash_obj->mld_peer_hash_lock);
 
 	dp_info("Peer %pK (" QDF_MAC_ADDR_FMT ") added",
@@ -2683,8 +2691,9 @@ void dp_print_mlo_ast_stats_be(struct dp_soc *soc)
 
 	qdf_spin_lock_bh(&mld_hash_obj->mld_peer_hash_lock);
 	for (index = 0; index < mld_hash_obj->mld_peer_hash.mask; index++) {
-		TAILQ_FOREACH(peer, &mld_hash_obj->mld_peer_hash.bins[index],
-			      hash_list_elem) {
+		DP_TAILQ_FOREACH_PROTECTED(peer,
+					   &mld_hash_obj->mld_peer_hash.bins[index],
+					   hash_list_elem) {
 			dp_print_peer_ast_entries(soc, peer, NULL);
 		}
 	}
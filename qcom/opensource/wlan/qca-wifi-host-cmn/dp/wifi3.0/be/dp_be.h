@@ -170,11 +170,16 @@ enum CMEM_MEM_CLIENTS {
  * @page_p_addr: page physical address
  * @ppt_index: entry index in primary page table where this page physical
  *		address stored
+ * @desc_va_base: RX desc of entry 0 of the page when the RX descs of all
+ *		  the entries are laid out contiguously, else NULL
  */
 struct dp_spt_page_desc {
 	uint8_t *page_v_addr;
 	qdf_dma_addr_t page_p_addr;
 	uint32_t ppt_index;
+#ifdef DP_RX_DESC_CC_CONTIG
+	uint8_t *desc_va_base;
+#endif
 };
 
 /**
@@ -395,7 +400,7 @@ struct dp_soc_be {
 		uint32_t mask;
 		uint32_t idx_bits;
 
-		TAILQ_HEAD(, dp_peer) * bins;
+		DP_TAILQ_HEAD_RCU(, dp_peer) * bins;
 	} mld_peer_hash;
 
 	/* MLO device ctxt list */
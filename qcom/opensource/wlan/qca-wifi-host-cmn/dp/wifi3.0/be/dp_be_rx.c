@@ -1046,6 +1046,66 @@ done:
 	return rx_bufs_used; /* Assume no scale factor for now */
 }
 
+#ifdef DP_RX_DESC_CC_CONTIG
+/**
+ * dp_rx_cc_desc_va_base_update() - track if the RX descs of a SPT page are
+ *				    contiguous
+ * @be_soc: Handle to DP BE Soc structure
+ * @page_desc: SPT page desc of the pool
+ * @entry: SPT page entry index of @rx_desc_elem
+ * @rx_desc_elem: RX desc element put in the SPT page entry
+ *
+ * Return: None
+ */
+static inline void
+dp_rx_cc_desc_va_base_update(struct dp_soc_be *be_soc,
+			     struct dp_spt_page_desc *page_desc,
+			     uint32_t entry,
+			     union dp_rx_desc_list_elem_t *rx_desc_elem)
+{
+	struct dp_spt_page_desc *spt_desc =
+				&be_soc->page_desc_base[page_desc->ppt_index];
+
+	if (!entry) {
+		spt_desc->desc_va_base = (uint8_t *)rx_desc_elem;
+		return;
+	}
+
+	if (spt_desc->desc_va_base &&
+	    (union dp_rx_desc_list_elem_t *)spt_desc->desc_va_base + entry !=
+	    rx_desc_elem)
+		spt_desc->desc_va_base = NULL;
+}
+
+/**
+ * dp_rx_cc_desc_va_base_clear() - forget the RX descs of a SPT page
+ * @be_soc: Handle to DP BE Soc structure
+ * @page_desc: SPT page desc of the pool
+ *
+ * Return: None
+ */
+static inline void
+dp_rx_cc_desc_va_base_clear(struct dp_soc_be *be_soc,
+			    struct dp_spt_page_desc *page_desc)
+{
+	be_soc->page_desc_base[page_desc->ppt_index].desc_va_base = NULL;
+}
+#else
+static inline void
+dp_rx_cc_desc_va_base_update(struct dp_soc_be *be_soc,
+			     struct dp_spt_page_desc *page_desc,
+			     uint32_t entry,
+			     union dp_rx_desc_list_elem_t *rx_desc_elem)
+{
+}
+
+static inline void
+dp_rx_cc_desc_va_base_clear(struct dp_soc_be *be_soc,
+			    struct dp_spt_page_desc *page_desc)
+{
+}
+#endif /* DP_RX_DESC_CC_CONTIG */
+
 #ifdef RX_DESC_MULTI_PAGE_ALLOC
 /**
  * dp_rx_desc_pool_init_be_cc() - initial RX desc pool for cookie conversion
@@ -1092,6 +1152,8 @@ dp_rx_desc_pool_init_be_cc(struct dp_soc *soc,
 		DP_CC_SPT_PAGE_UPDATE_VA(page_desc->page_v_addr,
 					 avail_entry_index,
 					 &rx_desc_elem->rx_desc);
+		dp_rx_cc_desc_va_base_update(be_soc, page_desc,
+					     avail_entry_index, rx_desc_elem);
 		rx_desc_elem->rx_desc.cookie =
 			dp_cc_desc_id_generate(page_desc->ppt_index,
 					       avail_entry_index);
@@ -1149,6 +1211,9 @@ dp_rx_desc_pool_init_be_cc(struct dp_soc *soc,
 		DP_CC_SPT_PAGE_UPDATE_VA(page_desc->page_v_addr,
 					 avail_entry_index,
 					 &rx_desc_pool->array[i].rx_desc);
+		dp_rx_cc_desc_va_base_update(be_soc, page_desc,
+					     avail_entry_index,
+					     &rx_desc_pool->array[i]);
 		rx_desc_pool->array[i].rx_desc.cookie =
 			dp_cc_desc_id_generate(page_desc->ppt_index,
 					       avail_entry_index);
@@ -1179,6 +1244,7 @@ dp_rx_desc_pool_deinit_be_cc(struct dp_soc *soc,
 
 	for (i = 0; i < cc_ctx->total_page_num; i++) {
 		page_desc = &cc_ctx->page_desc_base[i];
+		dp_rx_cc_desc_va_base_clear(be_soc, page_desc);
 		qdf_mem_zero(page_desc->page_v_addr, qdf_page_size);
 	}
 }
@@ -1226,8 +1292,7 @@ QDF_STATUS dp_wbm_get_rx_desc_from_hal_desc_be(struct dp_soc *soc,
 		/* SW do cookie conversion */
 		uint32_t cookie = HAL_RX_BUF_COOKIE_GET(ring_desc);
 
-		*r_rx_desc = (struct dp_rx_desc *)
-				dp_cc_desc_find(soc, cookie);
+		*r_rx_desc = dp_rx_cc_desc_find(soc, cookie);
 	}
 
 	return QDF_STATUS_SUCCESS;
@@ -1256,7 +1321,7 @@ struct dp_rx_desc *dp_rx_desc_ppeds_cookie_2_va(struct dp_soc *soc,
 	if (!cookie)
 		return NULL;
 
-	return (struct dp_rx_desc *)dp_cc_desc_find(soc, cookie);
+	return dp_rx_cc_desc_find(soc, cookie);
 }
 
 QDF_STATUS dp_wbm_get_rx_desc_from_hal_desc_be(struct dp_soc *soc,
@@ -1266,8 +1331,7 @@ QDF_STATUS dp_wbm_get_rx_desc_from_hal_desc_be(struct dp_soc *soc,
 	/* SW do cookie conversion */
 	uint32_t cookie = HAL_RX_BUF_COOKIE_GET(ring_desc);
 
-	*r_rx_desc = (struct dp_rx_desc *)
-			dp_cc_desc_find(soc, cookie);
+	*r_rx_desc = dp_rx_cc_desc_find(soc, cookie);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -1276,7 +1340,7 @@ QDF_STATUS dp_wbm_get_rx_desc_from_hal_desc_be(struct dp_soc *soc,
 struct dp_rx_desc *dp_rx_desc_cookie_2_va_be(struct dp_soc *soc,
 					     uint32_t cookie)
 {
-	return (struct dp_rx_desc *)dp_cc_desc_find(soc, cookie);
+	return dp_rx_cc_desc_find(soc, cookie);
 }
 
 #if defined(WLAN_FEATURE_11BE_MLO)
@@ -143,6 +143,45 @@ QDF_STATUS dp_wbm_get_rx_desc_from_hal_desc_be(struct dp_soc *soc,
 struct dp_rx_desc *dp_rx_desc_cookie_2_va_be(struct dp_soc *soc,
 					     uint32_t cookie);
 
+#ifdef DP_RX_DESC_CC_CONTIG
+/**
+ * dp_rx_cc_desc_find() - find RX desc virtual address by cookie
+ * @soc: Handle to DP Soc structure
+ * @cookie: RX desc cookie ID
+ *
+ * When the RX descs of the SPT page are contiguous, the RX desc address is
+ * computed from the cookie instead of being read from the SPT page, which
+ * saves a cache miss on every conversion.
+ *
+ * Return: RX desc virtual address
+ */
+static inline struct dp_rx_desc *dp_rx_cc_desc_find(struct dp_soc *soc,
+						    uint32_t cookie)
+{
+	struct dp_soc_be *be_soc = dp_get_be_soc_from_dp_soc(soc);
+	union dp_rx_desc_list_elem_t *desc_va_base;
+	uint16_t ppt_page_id, spt_va_id;
+
+	ppt_page_id = (cookie & DP_CC_DESC_ID_PPT_PAGE_OS_MASK) >>
+			DP_CC_DESC_ID_PPT_PAGE_OS_SHIFT;
+	spt_va_id = (cookie & DP_CC_DESC_ID_SPT_VA_OS_MASK) >>
+			DP_CC_DESC_ID_SPT_VA_OS_SHIFT;
+
+	desc_va_base = (union dp_rx_desc_list_elem_t *)
+			be_soc->page_desc_base[ppt_page_id].desc_va_base;
+	if (qdf_likely(desc_va_base))
+		return &desc_va_base[spt_va_id].rx_desc;
+
+	return (struct dp_rx_desc *)dp_cc_desc_find(soc, cookie);
+}
+#else
+static inline struct dp_rx_desc *dp_rx_cc_desc_find(struct dp_soc *soc,
+						    uint32_t cookie)
+{
+	return (struct dp_rx_desc *)dp_cc_desc_find(soc, cookie);
+}
+#endif /* DP_RX_DESC_CC_CONTIG */
+
 #if !defined(DP_FEATURE_HW_COOKIE_CONVERSION) || \
 		defined(DP_HW_COOKIE_CONVERT_EXCEPTION)
 /**
@@ -159,11 +198,8 @@ dp_rx_desc_sw_cc_check(struct dp_soc *soc,
 		       uint32_t rx_buf_cookie,
 		       struct dp_rx_desc **r_rx_desc)
 {
-	if (qdf_unlikely(!(*r_rx_desc))) {
-		*r_rx_desc = (struct dp_rx_desc *)
-				dp_cc_desc_find(soc,
-						rx_buf_cookie);
-	}
+	if (qdf_unlikely(!(*r_rx_desc)))
+		*r_rx_desc = dp_rx_cc_desc_find(soc, rx_buf_cookie);
 }
 #else
 static inline void
@@ -561,16 +597,23 @@ void dp_rx_prefetch_nbuf_data_be(qdf_nbuf_t nbuf, qdf_nbuf_t next)
 #ifdef QCA_DP_RX_HW_SW_NBUF_DESC_PREFETCH
 /**
  * dp_rx_va_prefetch() - function to prefetch the SW desc
+ * @soc: DP soc context
  * @last_prefetched_hw_desc: HW desc
  *
  * Return: prefetched Rx descriptor virtual address
  */
 static inline
-void *dp_rx_va_prefetch(void *last_prefetched_hw_desc)
+void *dp_rx_va_prefetch(struct dp_soc *soc, void *last_prefetched_hw_desc)
 {
 	void *prefetch_desc;
 
+#ifdef DP_FEATURE_HW_COOKIE_CONVERSION
 	prefetch_desc = (void *)hal_rx_get_reo_desc_va(last_prefetched_hw_desc);
+#else
+	/* the ring entry has no VA, convert the cookie as the reap does */
+	prefetch_desc = dp_rx_cc_desc_find(soc,
+			HAL_RX_REO_BUF_COOKIE_GET(last_prefetched_hw_desc));
+#endif
 	qdf_prefetch(prefetch_desc);
 	return prefetch_desc;
 }
@@ -602,7 +645,7 @@ dp_rx_prefetch_hw_sw_nbuf_32_byte_desc(struct dp_soc *soc,
 
 	if (num_entries) {
 		*last_prefetched_sw_desc =
-			dp_rx_va_prefetch(*last_prefetched_hw_desc);
+			dp_rx_va_prefetch(soc, *last_prefetched_hw_desc);
 
 		if ((uintptr_t)*last_prefetched_hw_desc & 0x3f)
 			*last_prefetched_hw_desc =
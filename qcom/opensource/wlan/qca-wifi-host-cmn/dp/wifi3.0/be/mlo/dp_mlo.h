@@ -59,7 +59,7 @@ struct dp_mlo_ctxt {
 		uint32_t mask;
 		uint32_t idx_bits;
 
-		TAILQ_HEAD(, dp_peer) * bins;
+		DP_TAILQ_HEAD_RCU(, dp_peer) * bins;
 	} mld_peer_hash;
 
 	qdf_spinlock_t mld_peer_hash_lock;
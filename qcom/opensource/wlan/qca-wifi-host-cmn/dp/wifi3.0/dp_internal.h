@@ -3162,6 +3162,39 @@ uint32_t dp_reo_status_ring_handler(struct dp_intr *int_ctx,
 				    struct dp_soc *soc);
 #endif
 
+#if defined(WLAN_DP_REO_CMD_BATCH) && !defined(WLAN_SOFTUMAC_SUPPORT)
+/**
+ * dp_reo_cmd_batch_start() - Start batching REO commands
+ * @soc: DP SoC handle
+ *
+ * REO commands the caller sends until the matching dp_reo_cmd_batch_end()
+ * are posted to the REO command ring and signalled to HW once, or earlier
+ * if too many of them are waiting. Batches of a caller may nest. The batch
+ * belongs to the calling task, or to the CPU in softirq, commands sent from
+ * other contexts meanwhile are signalled right away.
+ *
+ * Return: None
+ */
+void dp_reo_cmd_batch_start(struct dp_soc *soc);
+
+/**
+ * dp_reo_cmd_batch_end() - Stop batching REO commands and signal the posted
+ *			    ones to HW
+ * @soc: DP SoC handle
+ *
+ * Return: None
+ */
+void dp_reo_cmd_batch_end(struct dp_soc *soc);
+#else
+static inline void dp_reo_cmd_batch_start(struct dp_soc *soc)
+{
+}
+
+static inline void dp_reo_cmd_batch_end(struct dp_soc *soc)
+{
+}
+#endif
+
 /**
  * dp_aggregate_vdev_stats() - Consolidate stats at VDEV level
  * @vdev: DP VDEV handle
@@ -4638,6 +4671,19 @@ static inline QDF_STATUS dp_soc_swlm_detach(struct dp_soc *soc)
 {
 	return QDF_STATUS_SUCCESS;
 }
+
+/**
+ * dp_swlm_tx_comp_sample() - Feed the completion of a sampled TX descriptor
+ *			      to the software latency manager
+ * @soc: Datapath global soc handle
+ * @tx_desc: completed TX descriptor
+ *
+ * Return: none
+ */
+static inline void
+dp_swlm_tx_comp_sample(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc)
+{
+}
 #endif /* !WLAN_DP_FEATURE_SW_LATENCY_MGR */
 
 #ifndef WLAN_DP_PROFILE_SUPPORT
@@ -1221,6 +1221,25 @@ dp_print_peer_info(struct dp_soc *soc, struct dp_peer *peer, void *arg)
  */
 static void dp_print_peer_table(struct dp_vdev *vdev)
 {
+	struct dp_soc *soc = vdev->pdev->soc;
+	struct dp_peer_hash_tbl *tbl;
+
+	DP_PRINT_STATS("Peer Hash Stats:");
+	qdf_spin_lock_bh(&soc->peer_hash_lock);
+	tbl = qdf_rcu_dereference_protected(soc->peer_hash.tbl, 1);
+	if (tbl)
+		DP_PRINT_STATS("	Bins = %u/%u Peers = %u",
+			       tbl->mask + 1, 1 << soc->peer_hash.max_idx_bits,
+			       soc->peer_hash.num_peers);
+	qdf_spin_unlock_bh(&soc->peer_hash_lock);
+	DP_PRINT_STATS("	Resize = %u Resize fail = %u",
+		       soc->stats.peer_hash.resize,
+		       soc->stats.peer_hash.resize_fail);
+	DP_PRINT_STATS("	Locked lookup fallback = %u",
+		       soc->stats.peer_hash.locked_fallback);
+	DP_PRINT_STATS("	Writer lock contention = %u",
+		       soc->stats.peer_hash.lock_contention);
+
 	DP_PRINT_STATS("Dumping Peer Table  Stats:");
 	dp_vdev_iterate_peer(vdev, dp_print_peer_info, NULL,
 			     DP_MOD_ID_GENERIC_STATS);
@@ -6176,7 +6195,7 @@ static QDF_STATUS dp_cp_peer_del_resp_handler(struct cdp_soc_t *soc_hdl,
 		   cookie,
 		   CDP_TXRX_AST_DELETED);
 	}
-	qdf_mem_free(ast_entry);
+	dp_peer_ast_entry_free_rcu(ast_entry);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -6443,6 +6462,17 @@ free_vdev:
 
 qdf_export_symbol(dp_vdev_unref_delete);
 
+/**
+ * dp_peer_free_rcu() - free a peer after the RCU grace period
+ * @head: rcu head embedded in the peer
+ *
+ * Return: none
+ */
+static void dp_peer_free_rcu(qdf_rcu_head_t *head)
+{
+	qdf_mem_free(qdf_container_of(head, struct dp_peer, rcu_head));
+}
+
 void dp_peer_unref_delete(struct dp_peer *peer, enum dp_mod_id mod_id)
 {
 	struct dp_vdev *vdev = peer->vdev;
@@ -6508,7 +6538,8 @@ void dp_peer_unref_delete(struct dp_peer *peer, enum dp_mod_id mod_id)
 		dp_txrx_peer_detach(soc, peer);
 		dp_cfg_event_record_peer_evt(soc, DP_CFG_EVENT_PEER_UNREF_DEL,
 					     peer, vdev, 0);
-		qdf_mem_free(peer);
+		/* lockless peer hash readers may still be walking past it */
+		qdf_call_rcu(&peer->rcu_head, dp_peer_free_rcu);
 
 		/*
 		 * Decrement ref count taken at peer create
@@ -10908,22 +10939,20 @@ static QDF_STATUS dp_soc_set_swlm_enable(struct cdp_soc_t *soc_hdl,
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	soc->swlm.is_enabled = !!value;
-
-	return QDF_STATUS_SUCCESS;
+	return dp_soc_swlm_set_mode(soc, value);
 }
 
 /**
  * dp_soc_is_swlm_enabled() - Check if SWLM is enabled.
  * @soc_hdl: CDP Soc handle
  *
- * Return: QDF_STATUS
+ * Return: current SWLM mode, 0 if disabled
  */
 static uint8_t dp_soc_is_swlm_enabled(struct cdp_soc_t *soc_hdl)
 {
 	struct dp_soc *soc = cdp_soc_t_to_dp_soc(soc_hdl);
 
-	return soc->swlm.is_enabled;
+	return soc->swlm.is_enabled ? soc->swlm.mode : 0;
 }
 #endif
 
@@ -353,7 +353,7 @@ static QDF_STATUS dp_peer_find_map_attach(struct dp_soc *soc)
 #define DP_AST_HASH_LOAD_SHIFT 0
 
 static inline uint32_t
-dp_peer_find_hash_index(struct dp_soc *soc,
+dp_peer_find_hash_index(struct dp_peer_hash_tbl *tbl,
 			union dp_align_mac_addr *mac_addr)
 {
 	uint32_t index;
@@ -363,23 +363,362 @@ dp_peer_find_hash_index(struct dp_soc *soc,
 		mac_addr->align2.bytes_cd ^
 		mac_addr->align2.bytes_ef;
 
-	index ^= index >> soc->peer_hash.idx_bits;
-	index &= soc->peer_hash.mask;
+	index ^= index >> tbl->idx_bits;
+	index &= tbl->mask;
 	return index;
 }
 
+/**
+ * dp_peer_hash_tbl_get() - get the peer hash table on the writer side
+ * @soc: soc handle
+ *
+ * Caller must hold soc->peer_hash_lock.
+ *
+ * Return: current peer hash table
+ */
+static inline struct dp_peer_hash_tbl *
+dp_peer_hash_tbl_get(struct dp_soc *soc)
+{
+	return qdf_rcu_dereference_protected(soc->peer_hash.tbl, 1);
+}
+
+/**
+ * dp_peer_hash_lock() - take peer_hash_lock on the writer side
+ * @soc: soc handle
+ *
+ * Lookups are lockless, so the lock is only contended between writers and
+ * the rare locked lookup fallback; count when it is.
+ *
+ * Return: none
+ */
+static inline void dp_peer_hash_lock(struct dp_soc *soc)
+{
+	if (qdf_likely(qdf_spin_trylock_bh(&soc->peer_hash_lock)))
+		return;
+
+	qdf_spin_lock_bh(&soc->peer_hash_lock);
+	DP_STATS_INC(soc, peer_hash.lock_contention, 1);
+}
+
+/**
+ * dp_peer_hash_tbl_alloc() - allocate and init a peer hash bucket array
+ * @idx_bits: number of bits in the bucket index
+ *
+ * Growing happens from the HTT peer map path, hence atomic allocation, but
+ * never under peer_hash_lock.
+ *
+ * Return: bucket array, NULL on failure
+ */
+static struct dp_peer_hash_tbl *dp_peer_hash_tbl_alloc(unsigned int idx_bits)
+{
+	struct dp_peer_hash_tbl *tbl;
+	uint32_t i, hash_elems = 1 << idx_bits;
+
+	tbl = qdf_mem_malloc_atomic(sizeof(*tbl) +
+				    hash_elems * sizeof(tbl->bins[0]));
+	if (!tbl)
+		return NULL;
+
+	tbl->mask = hash_elems - 1;
+	tbl->idx_bits = idx_bits;
+	for (i = 0; i < hash_elems; i++)
+		DP_TAILQ_INIT_RCU(&tbl->bins[i]);
+
+	return tbl;
+}
+
+/**
+ * dp_peer_hash_tbl_free_rcu() - free a replaced peer hash bucket array
+ * @head: rcu head embedded in the bucket array
+ *
+ * Return: none
+ */
+static void dp_peer_hash_tbl_free_rcu(qdf_rcu_head_t *head)
+{
+	qdf_mem_free(qdf_container_of(head, struct dp_peer_hash_tbl,
+				      rcu_head));
+}
+
+/**
+ * dp_peer_hash_tbl_overloaded() - check if the peer hash table should grow
+ * @soc: soc handle
+ * @tbl: current bucket array
+ *
+ * Caller must hold soc->peer_hash_lock.
+ *
+ * Return: true if the load factor is exceeded and the table can still grow
+ */
+static inline bool dp_peer_hash_tbl_overloaded(struct dp_soc *soc,
+					       struct dp_peer_hash_tbl *tbl)
+{
+	uint32_t load;
+
+	load = (soc->peer_hash.num_peers * DP_PEER_HASH_LOAD_MULT) >>
+		DP_PEER_HASH_LOAD_SHIFT;
+
+	return load > tbl->mask + 1 &&
+	       tbl->idx_bits < soc->peer_hash.max_idx_bits;
+}
+
+/**
+ * dp_peer_hash_tbl_move() - move all peers to a bigger bucket array
+ * @soc: soc handle
+ * @old_tbl: current bucket array
+ * @new_tbl: empty bucket array replacing @old_tbl
+ *
+ * Caller must hold soc->peer_hash_lock. Peers are moved bucket by bucket
+ * while resize_seq is odd; lockless readers racing with the move may miss a
+ * peer and redo the lookup under the lock. Walking each old bucket from head
+ * to tail keeps the "first added is found first" order of duplicate MACs.
+ *
+ * Return: none
+ */
+static void dp_peer_hash_tbl_move(struct dp_soc *soc,
+				  struct dp_peer_hash_tbl *old_tbl,
+				  struct dp_peer_hash_tbl *new_tbl)
+{
+	struct dp_peer *peer;
+	uint32_t i, index;
+
+	qdf_atomic_inc(&soc->peer_hash.resize_seq);
+	qdf_wmb();
+
+	for (i = 0; i <= old_tbl->mask; i++) {
+		while ((peer = DP_TAILQ_FIRST_PROTECTED(&old_tbl->bins[i]))) {
+			DP_TAILQ_REMOVE_RCU(&old_tbl->bins[i], peer,
+					    hash_list_elem);
+			index = dp_peer_find_hash_index(new_tbl,
+							&peer->mac_addr);
+			DP_TAILQ_INSERT_TAIL_RCU(&new_tbl->bins[index], peer,
+						 hash_list_elem);
+		}
+	}
+
+	qdf_rcu_assign_pointer(soc->peer_hash.tbl, new_tbl);
+	qdf_wmb();
+	qdf_atomic_inc(&soc->peer_hash.resize_seq);
+
+	qdf_call_rcu(&old_tbl->rcu_head, dp_peer_hash_tbl_free_rcu);
+	DP_STATS_INC(soc, peer_hash.resize, 1);
+}
+
+/**
+ * dp_peer_hash_tbl_grow() - double the peer hash bucket array
+ * @soc: soc handle
+ *
+ * Called without soc->peer_hash_lock after an insert found the table
+ * overloaded. The new array is allocated outside the lock; if another
+ * writer grew or detached the table meanwhile, or peers went away, the
+ * allocation is simply dropped.
+ *
+ * Return: none
+ */
+static void dp_peer_hash_tbl_grow(struct dp_soc *soc)
+{
+	struct dp_peer_hash_tbl *old_tbl, *new_tbl;
+	unsigned int idx_bits;
+
+	qdf_rcu_read_lock();
+	old_tbl = qdf_rcu_dereference(soc->peer_hash.tbl);
+	idx_bits = old_tbl ? old_tbl->idx_bits : 0;
+	qdf_rcu_read_unlock();
+
+	if (!idx_bits)
+		return;
+
+	new_tbl = dp_peer_hash_tbl_alloc(idx_bits + 1);
+	if (!new_tbl) {
+		DP_STATS_INC(soc, peer_hash.resize_fail, 1);
+		return;
+	}
+
+	dp_peer_hash_lock(soc);
+	old_tbl = dp_peer_hash_tbl_get(soc);
+	if (!old_tbl || old_tbl->idx_bits != idx_bits ||
+	    !dp_peer_hash_tbl_overloaded(soc, old_tbl)) {
+		qdf_spin_unlock_bh(&soc->peer_hash_lock);
+		qdf_mem_free(new_tbl);
+		return;
+	}
+
+	dp_peer_hash_tbl_move(soc, old_tbl, new_tbl);
+	qdf_spin_unlock_bh(&soc->peer_hash_lock);
+}
+
+/**
+ * dp_peer_hash_tbl_insert() - add a link peer to the peer hash table
+ * @soc: soc handle
+ * @peer: peer to add
+ *
+ * Caller must hold soc->peer_hash_lock and call dp_peer_hash_tbl_grow()
+ * once the lock is dropped if this returns true.
+ *
+ * Return: true if the table is overloaded and should grow
+ */
+static bool dp_peer_hash_tbl_insert(struct dp_soc *soc, struct dp_peer *peer)
+{
+	struct dp_peer_hash_tbl *tbl = dp_peer_hash_tbl_get(soc);
+	uint32_t index;
+
+	/*
+	 * It is important to add the new peer at the tail of the peer list
+	 * with the bin index.  Together with having the hash_find function
+	 * search from head to tail, this ensures that if two entries with
+	 * the same MAC address are stored, the one added first will be
+	 * found first.
+	 */
+	index = dp_peer_find_hash_index(tbl, &peer->mac_addr);
+	DP_TAILQ_INSERT_TAIL_RCU(&tbl->bins[index], peer, hash_list_elem);
+	soc->peer_hash.num_peers++;
+
+	return dp_peer_hash_tbl_overloaded(soc, tbl);
+}
+
+/**
+ * dp_peer_hash_tbl_delete() - remove a link peer from the peer hash table
+ * @soc: soc handle
+ * @peer: peer to remove
+ *
+ * Caller must hold soc->peer_hash_lock.
+ *
+ * Return: none
+ */
+static void dp_peer_hash_tbl_delete(struct dp_soc *soc, struct dp_peer *peer)
+{
+	struct dp_peer_hash_tbl *tbl = dp_peer_hash_tbl_get(soc);
+	struct dp_peer *tmppeer = NULL;
+	uint32_t index;
+	int found = 0;
+
+	index = dp_peer_find_hash_index(tbl, &peer->mac_addr);
+	/* Check if tail is not empty before delete*/
+	QDF_ASSERT(!DP_TAILQ_EMPTY_RCU(&tbl->bins[index]));
+
+	DP_TAILQ_FOREACH_PROTECTED(tmppeer, &tbl->bins[index], hash_list_elem) {
+		if (tmppeer == peer) {
+			found = 1;
+			break;
+		}
+	}
+	QDF_ASSERT(found);
+	if (!found)
+		return;
+
+	DP_TAILQ_REMOVE_RCU(&tbl->bins[index], peer, hash_list_elem);
+	soc->peer_hash.num_peers--;
+}
+
+/**
+ * dp_peer_hash_tbl_attach() - allocate the initial peer hash table
+ * @soc: soc handle
+ *
+ * The table starts small and is grown from the peer count, up to the size
+ * needed for soc->max_peers.
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS dp_peer_hash_tbl_attach(struct dp_soc *soc)
+{
+	struct dp_peer_hash_tbl *tbl;
+	int hash_elems, log2;
+
+	hash_elems = soc->max_peers;
+	hash_elems *= DP_PEER_HASH_LOAD_MULT;
+	hash_elems >>= DP_PEER_HASH_LOAD_SHIFT;
+	log2 = dp_log2_ceil(hash_elems);
+
+	soc->peer_hash.max_idx_bits = log2;
+	soc->peer_hash.num_peers = 0;
+	qdf_atomic_init(&soc->peer_hash.resize_seq);
+
+	tbl = dp_peer_hash_tbl_alloc(qdf_min(log2,
+					     DP_PEER_HASH_MIN_IDX_BITS));
+	if (!tbl)
+		return QDF_STATUS_E_NOMEM;
+
+	qdf_rcu_assign_pointer(soc->peer_hash.tbl, tbl);
+	qdf_spinlock_create(&soc->peer_hash_lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * dp_peer_hash_tbl_detach() - free the peer hash table
+ * @soc: soc handle
+ *
+ * Waits for lockless readers still walking the table, then for the peers
+ * and bucket arrays still pending an RCU free.
+ *
+ * Return: none
+ */
+static void dp_peer_hash_tbl_detach(struct dp_soc *soc)
+{
+	struct dp_peer_hash_tbl *tbl = dp_peer_hash_tbl_get(soc);
+
+	if (!tbl)
+		return;
+
+	qdf_rcu_assign_pointer(soc->peer_hash.tbl, NULL);
+	qdf_synchronize_rcu();
+	qdf_rcu_barrier();
+	qdf_mem_free(tbl);
+	qdf_spinlock_destroy(&soc->peer_hash_lock);
+}
+
+/**
+ * dp_peer_find_hash_find_locked() - peer hash lookup under peer_hash_lock
+ * @soc: soc handle
+ * @mac_addr: aligned peer mac address
+ * @vdev_id: vdev_id
+ * @mod_id: id of module requesting reference
+ *
+ * Authoritative lookup used when a lockless lookup raced with a resize.
+ *
+ * Return: peer with a reference held, NULL if not found
+ */
+static struct dp_peer *
+dp_peer_find_hash_find_locked(struct dp_soc *soc,
+			      union dp_align_mac_addr *mac_addr,
+			      uint8_t vdev_id, enum dp_mod_id mod_id)
+{
+	struct dp_peer_hash_tbl *tbl;
+	struct dp_peer *peer;
+	uint32_t index;
+
+	dp_peer_hash_lock(soc);
+	tbl = dp_peer_hash_tbl_get(soc);
+	if (!tbl)
+		goto fail;
+
+	index = dp_peer_find_hash_index(tbl, mac_addr);
+	DP_TAILQ_FOREACH_PROTECTED(peer, &tbl->bins[index], hash_list_elem) {
+		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0 &&
+		    ((peer->vdev->vdev_id == vdev_id) ||
+		     (vdev_id == DP_VDEV_ALL))) {
+			/* take peer reference before returning */
+			if (dp_peer_get_ref(soc, peer, mod_id) !=
+						QDF_STATUS_SUCCESS)
+				peer = NULL;
+
+			qdf_spin_unlock_bh(&soc->peer_hash_lock);
+			return peer;
+		}
+	}
+fail:
+	qdf_spin_unlock_bh(&soc->peer_hash_lock);
+	return NULL; /* failure */
+}
+
 struct dp_peer *dp_peer_find_hash_find(
 				struct dp_soc *soc, uint8_t *peer_mac_addr,
 				int mac_addr_is_aligned, uint8_t vdev_id,
 				enum dp_mod_id mod_id)
 {
 	union dp_align_mac_addr local_mac_addr_aligned, *mac_addr;
-	uint32_t index;
+	struct dp_peer_hash_tbl *tbl;
+	uint32_t index, seq;
 	struct dp_peer *peer;
 
-	if (!soc->peer_hash.bins)
-		return NULL;
-
 	if (mac_addr_is_aligned) {
 		mac_addr = (union dp_align_mac_addr *)peer_mac_addr;
 	} else {
@@ -388,23 +727,47 @@ struct dp_peer *dp_peer_find_hash_find(
 			peer_mac_addr, QDF_MAC_ADDR_SIZE);
 		mac_addr = &local_mac_addr_aligned;
 	}
-	index = dp_peer_find_hash_index(soc, mac_addr);
-	qdf_spin_lock_bh(&soc->peer_hash_lock);
-	TAILQ_FOREACH(peer, &soc->peer_hash.bins[index], hash_list_elem) {
-		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0 &&
-		    ((peer->vdev->vdev_id == vdev_id) ||
-		     (vdev_id == DP_VDEV_ALL))) {
-			/* take peer reference before returning */
-			if (dp_peer_get_ref(soc, peer, mod_id) !=
-						QDF_STATUS_SUCCESS)
-				peer = NULL;
 
-			qdf_spin_unlock_bh(&soc->peer_hash_lock);
+	qdf_rcu_read_lock();
+	seq = qdf_atomic_read(&soc->peer_hash.resize_seq);
+	qdf_rmb();
+	tbl = qdf_rcu_dereference(soc->peer_hash.tbl);
+	if (!tbl) {
+		qdf_rcu_read_unlock();
+		return NULL;
+	}
+
+	index = dp_peer_find_hash_index(tbl, mac_addr);
+	DP_TAILQ_FOREACH_RCU(peer, &tbl->bins[index], hash_list_elem) {
+		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr))
+			continue;
+
+		/*
+		 * A peer whose last reference is gone is already out of the
+		 * table, skip it. The vdev is only safe to dereference once
+		 * the reference is held.
+		 */
+		if (dp_peer_get_ref(soc, peer, mod_id) != QDF_STATUS_SUCCESS)
+			continue;
+
+		if ((peer->vdev->vdev_id == vdev_id) ||
+		    (vdev_id == DP_VDEV_ALL)) {
+			qdf_rcu_read_unlock();
 			return peer;
 		}
+		dp_peer_unref_delete(peer, mod_id);
 	}
-	qdf_spin_unlock_bh(&soc->peer_hash_lock);
-	return NULL; /* failure */
+
+	qdf_rmb();
+	if (!(seq & 1) && seq == qdf_atomic_read(&soc->peer_hash.resize_seq)) {
+		qdf_rcu_read_unlock();
+		return NULL; /* failure */
+	}
+	qdf_rcu_read_unlock();
+
+	/* raced with a resize, the miss is not reliable */
+	DP_STATS_INC(soc, peer_hash.locked_fallback, 1);
+	return dp_peer_find_hash_find_locked(soc, mac_addr, vdev_id, mod_id);
 }
 
 qdf_export_symbol(dp_peer_find_hash_find);
@@ -418,11 +781,7 @@ qdf_export_symbol(dp_peer_find_hash_find);
  */
 static void dp_peer_find_hash_detach(struct dp_soc *soc)
 {
-	if (soc->peer_hash.bins) {
-		qdf_mem_free(soc->peer_hash.bins);
-		soc->peer_hash.bins = NULL;
-		qdf_spinlock_destroy(&soc->peer_hash_lock);
-	}
+	dp_peer_hash_tbl_detach(soc);
 
 	if (soc->arch_ops.mlo_peer_find_hash_detach)
 		soc->arch_ops.mlo_peer_find_hash_detach(soc);
@@ -436,27 +795,12 @@ static void dp_peer_find_hash_detach(struct dp_soc *soc)
  */
 static QDF_STATUS dp_peer_find_hash_attach(struct dp_soc *soc)
 {
-	int i, hash_elems, log2;
+	QDF_STATUS status;
 
 	/* allocate the peer MAC address -> peer object hash table */
-	hash_elems = soc->max_peers;
-	hash_elems *= DP_PEER_HASH_LOAD_MULT;
-	hash_elems >>= DP_PEER_HASH_LOAD_SHIFT;
-	log2 = dp_log2_ceil(hash_elems);
-	hash_elems = 1 << log2;
-
-	soc->peer_hash.mask = hash_elems - 1;
-	soc->peer_hash.idx_bits = log2;
-	/* allocate an array of TAILQ peer object lists */
-	soc->peer_hash.bins = qdf_mem_malloc(
-		hash_elems * sizeof(TAILQ_HEAD(anonymous_tail_q, dp_peer)));
-	if (!soc->peer_hash.bins)
-		return QDF_STATUS_E_NOMEM;
-
-	for (i = 0; i < hash_elems; i++)
-		TAILQ_INIT(&soc->peer_hash.bins[i]);
-
-	qdf_spinlock_create(&soc->peer_hash_lock);
+	status = dp_peer_hash_tbl_attach(soc);
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
 
 	if (soc->arch_ops.mlo_peer_find_hash_attach &&
 	    (soc->arch_ops.mlo_peer_find_hash_attach(soc) !=
@@ -469,11 +813,10 @@ static QDF_STATUS dp_peer_find_hash_attach(struct dp_soc *soc)
 
 void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer)
 {
-	unsigned index;
+	bool grow;
 
-	index = dp_peer_find_hash_index(soc, &peer->mac_addr);
 	if (peer->peer_type == CDP_LINK_PEER_TYPE) {
-		qdf_spin_lock_bh(&soc->peer_hash_lock);
+		dp_peer_hash_lock(soc);
 
 		if (QDF_IS_STATUS_ERROR(dp_peer_get_ref(soc, peer,
 							DP_MOD_ID_CONFIG))) {
@@ -483,17 +826,12 @@ void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer)
 			return;
 		}
 
-		/*
-		 * It is important to add the new peer at the tail of
-		 * peer list with the bin index. Together with having
-		 * the hash_find function search from head to tail,
-		 * this ensures that if two entries with the same MAC address
-		 * are stored, the one added first will be found first.
-		 */
-		TAILQ_INSERT_TAIL(&soc->peer_hash.bins[index], peer,
-				  hash_list_elem);
+		grow = dp_peer_hash_tbl_insert(soc, peer);
 
 		qdf_spin_unlock_bh(&soc->peer_hash_lock);
+
+		if (grow)
+			dp_peer_hash_tbl_grow(soc);
 	} else if (peer->peer_type == CDP_MLD_PEER_TYPE) {
 		if (soc->arch_ops.mlo_peer_find_hash_add)
 			soc->arch_ops.mlo_peer_find_hash_add(soc, peer);
@@ -504,28 +842,9 @@ void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer)
 
 void dp_peer_find_hash_remove(struct dp_soc *soc, struct dp_peer *peer)
 {
-	unsigned index;
-	struct dp_peer *tmppeer = NULL;
-	int found = 0;
-
-	index = dp_peer_find_hash_index(soc, &peer->mac_addr);
-
 	if (peer->peer_type == CDP_LINK_PEER_TYPE) {
-		/* Check if tail is not empty before delete*/
-		QDF_ASSERT(!TAILQ_EMPTY(&soc->peer_hash.bins[index]));
-
-		qdf_spin_lock_bh(&soc->peer_hash_lock);
-		TAILQ_FOREACH(tmppeer, &soc->peer_hash.bins[index],
-			      hash_list_elem) {
-			if (tmppeer == peer) {
-				found = 1;
-				break;
-			}
-		}
-		QDF_ASSERT(found);
-		TAILQ_REMOVE(&soc->peer_hash.bins[index], peer,
-			     hash_list_elem);
-
+		dp_peer_hash_lock(soc);
+		dp_peer_hash_tbl_delete(soc, peer);
 		dp_peer_unref_delete(peer, DP_MOD_ID_CONFIG);
 		qdf_spin_unlock_bh(&soc->peer_hash_lock);
 	} else if (peer->peer_type == CDP_MLD_PEER_TYPE) {
@@ -549,45 +868,20 @@ uint8_t dp_get_peer_link_id(struct dp_peer *peer)
 #else
 static QDF_STATUS dp_peer_find_hash_attach(struct dp_soc *soc)
 {
-	int i, hash_elems, log2;
-
 	/* allocate the peer MAC address -> peer object hash table */
-	hash_elems = soc->max_peers;
-	hash_elems *= DP_PEER_HASH_LOAD_MULT;
-	hash_elems >>= DP_PEER_HASH_LOAD_SHIFT;
-	log2 = dp_log2_ceil(hash_elems);
-	hash_elems = 1 << log2;
-
-	soc->peer_hash.mask = hash_elems - 1;
-	soc->peer_hash.idx_bits = log2;
-	/* allocate an array of TAILQ peer object lists */
-	soc->peer_hash.bins = qdf_mem_malloc(
-		hash_elems * sizeof(TAILQ_HEAD(anonymous_tail_q, dp_peer)));
-	if (!soc->peer_hash.bins)
-		return QDF_STATUS_E_NOMEM;
-
-	for (i = 0; i < hash_elems; i++)
-		TAILQ_INIT(&soc->peer_hash.bins[i]);
-
-	qdf_spinlock_create(&soc->peer_hash_lock);
-	return QDF_STATUS_SUCCESS;
+	return dp_peer_hash_tbl_attach(soc);
 }
 
 static void dp_peer_find_hash_detach(struct dp_soc *soc)
 {
-	if (soc->peer_hash.bins) {
-		qdf_mem_free(soc->peer_hash.bins);
-		soc->peer_hash.bins = NULL;
-		qdf_spinlock_destroy(&soc->peer_hash_lock);
-	}
+	dp_peer_hash_tbl_detach(soc);
 }
 
 void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer)
 {
-	unsigned index;
+	bool grow;
 
-	index = dp_peer_find_hash_index(soc, &peer->mac_addr);
-	qdf_spin_lock_bh(&soc->peer_hash_lock);
+	dp_peer_hash_lock(soc);
 
 	if (QDF_IS_STATUS_ERROR(dp_peer_get_ref(soc, peer, DP_MOD_ID_CONFIG))) {
 		dp_err("unable to get peer ref at MAP mac: "QDF_MAC_ADDR_FMT,
@@ -596,38 +890,18 @@ void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer)
 		return;
 	}
 
-	/*
-	 * It is important to add the new peer at the tail of the peer list
-	 * with the bin index.  Together with having the hash_find function
-	 * search from head to tail, this ensures that if two entries with
-	 * the same MAC address are stored, the one added first will be
-	 * found first.
-	 */
-	TAILQ_INSERT_TAIL(&soc->peer_hash.bins[index], peer, hash_list_elem);
+	grow = dp_peer_hash_tbl_insert(soc, peer);
 
 	qdf_spin_unlock_bh(&soc->peer_hash_lock);
+
+	if (grow)
+		dp_peer_hash_tbl_grow(soc);
 }
 
 void dp_peer_find_hash_remove(struct dp_soc *soc, struct dp_peer *peer)
 {
-	unsigned index;
-	struct dp_peer *tmppeer = NULL;
-	int found = 0;
-
-	index = dp_peer_find_hash_index(soc, &peer->mac_addr);
-	/* Check if tail is not empty before delete*/
-	QDF_ASSERT(!TAILQ_EMPTY(&soc->peer_hash.bins[index]));
-
-	qdf_spin_lock_bh(&soc->peer_hash_lock);
-	TAILQ_FOREACH(tmppeer, &soc->peer_hash.bins[index], hash_list_elem) {
-		if (tmppeer == peer) {
-			found = 1;
-			break;
-		}
-	}
-	QDF_ASSERT(found);
-	TAILQ_REMOVE(&soc->peer_hash.bins[index], peer, hash_list_elem);
-
+	dp_peer_hash_lock(soc);
+	dp_peer_hash_tbl_delete(soc, peer);
 	dp_peer_unref_delete(peer, DP_MOD_ID_CONFIG);
 	qdf_spin_unlock_bh(&soc->peer_hash_lock);
 }
@@ -979,6 +1253,22 @@ void dp_peer_mec_hash_detach(struct dp_soc *soc)
 }
 #endif
 
+/**
+ * dp_peer_ast_entry_free_cb() - RCU callback freeing an AST entry
+ * @head: rcu head embedded in the AST entry
+ *
+ * Return: none
+ */
+static void dp_peer_ast_entry_free_cb(qdf_rcu_head_t *head)
+{
+	qdf_mem_free(qdf_container_of(head, struct dp_ast_entry, rcu_head));
+}
+
+void dp_peer_ast_entry_free_rcu(struct dp_ast_entry *ast_entry)
+{
+	qdf_call_rcu(&ast_entry->rcu_head, dp_peer_ast_entry_free_cb);
+}
+
 #ifdef FEATURE_AST
 #ifdef WLAN_FEATURE_11BE_MLO
 /**
@@ -997,6 +1287,7 @@ static bool dp_peer_exist_on_pdev(struct dp_soc *soc,
 				  struct dp_pdev *pdev)
 {
 	union dp_align_mac_addr local_mac_addr_aligned, *mac_addr;
+	struct dp_peer_hash_tbl *tbl;
 	unsigned int index;
 	struct dp_peer *peer;
 	bool found = false;
@@ -1009,9 +1300,10 @@ static bool dp_peer_exist_on_pdev(struct dp_soc *soc,
 			peer_mac_addr, QDF_MAC_ADDR_SIZE);
 		mac_addr = &local_mac_addr_aligned;
 	}
-	index = dp_peer_find_hash_index(soc, mac_addr);
-	qdf_spin_lock_bh(&soc->peer_hash_lock);
-	TAILQ_FOREACH(peer, &soc->peer_hash.bins[index], hash_list_elem) {
+	dp_peer_hash_lock(soc);
+	tbl = dp_peer_hash_tbl_get(soc);
+	index = dp_peer_find_hash_index(tbl, mac_addr);
+	DP_TAILQ_FOREACH_PROTECTED(peer, &tbl->bins[index], hash_list_elem) {
 		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0 &&
 		    (peer->vdev->pdev == pdev)) {
 			found = true;
@@ -1041,6 +1333,7 @@ static bool dp_peer_exist_on_pdev(struct dp_soc *soc,
 				  struct dp_pdev *pdev)
 {
 	union dp_align_mac_addr local_mac_addr_aligned, *mac_addr;
+	struct dp_peer_hash_tbl *tbl;
 	unsigned int index;
 	struct dp_peer *peer;
 	bool found = false;
@@ -1053,9 +1346,10 @@ static bool dp_peer_exist_on_pdev(struct dp_soc *soc,
 			peer_mac_addr, QDF_MAC_ADDR_SIZE);
 		mac_addr = &local_mac_addr_aligned;
 	}
-	index = dp_peer_find_hash_index(soc, mac_addr);
-	qdf_spin_lock_bh(&soc->peer_hash_lock);
-	TAILQ_FOREACH(peer, &soc->peer_hash.bins[index], hash_list_elem) {
+	dp_peer_hash_lock(soc);
+	tbl = dp_peer_hash_tbl_get(soc);
+	index = dp_peer_find_hash_index(tbl, mac_addr);
+	DP_TAILQ_FOREACH_PROTECTED(peer, &tbl->bins[index], hash_list_elem) {
 		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0 &&
 		    (peer->vdev->pdev == pdev)) {
 			found = true;
@@ -1086,14 +1380,13 @@ QDF_STATUS dp_peer_ast_hash_attach(struct dp_soc *soc)
 
 	/* allocate an array of TAILQ peer object lists */
 	soc->ast_hash.bins = qdf_mem_malloc(
-		hash_elems * sizeof(TAILQ_HEAD(anonymous_tail_q,
-				dp_ast_entry)));
+		hash_elems * sizeof(soc->ast_hash.bins[0]));
 
 	if (!soc->ast_hash.bins)
 		return QDF_STATUS_E_NOMEM;
 
 	for (i = 0; i < hash_elems; i++)
-		TAILQ_INIT(&soc->ast_hash.bins[i]);
+		DP_TAILQ_INIT_RCU(&soc->ast_hash.bins[i]);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -1140,19 +1433,24 @@ void dp_peer_ast_hash_detach(struct dp_soc *soc)
 
 	qdf_spin_lock_bh(&soc->ast_lock);
 	for (index = 0; index <= soc->ast_hash.mask; index++) {
-		if (!TAILQ_EMPTY(&soc->ast_hash.bins[index])) {
-			TAILQ_FOREACH_SAFE(ast, &soc->ast_hash.bins[index],
-					   hash_list_elem, ast_next) {
-				TAILQ_REMOVE(&soc->ast_hash.bins[index], ast,
-					     hash_list_elem);
+		if (!DP_TAILQ_EMPTY_RCU(&soc->ast_hash.bins[index])) {
+			DP_TAILQ_FOREACH_SAFE_PROTECTED(ast,
+							&soc->ast_hash.bins[index],
+							hash_list_elem,
+							ast_next) {
+				DP_TAILQ_REMOVE_RCU(&soc->ast_hash.bins[index],
+						    ast, hash_list_elem);
 				dp_peer_ast_cleanup(soc, ast);
 				soc->num_ast_entries--;
-				qdf_mem_free(ast);
+				dp_peer_ast_entry_free_rcu(ast);
 			}
 		}
 	}
 	qdf_spin_unlock_bh(&soc->ast_lock);
 
+	/* readers may still walk the bins even if no entry was queued */
+	qdf_synchronize_rcu();
+	qdf_rcu_barrier();
 	qdf_mem_free(soc->ast_hash.bins);
 	soc->ast_hash.bins = NULL;
 }
@@ -1194,7 +1492,8 @@ static inline void dp_peer_ast_hash_add(struct dp_soc *soc,
 	uint32_t index;
 
 	index = dp_peer_ast_hash_index(soc, &ase->mac_addr);
-	TAILQ_INSERT_TAIL(&soc->ast_hash.bins[index], ase, hash_list_elem);
+	DP_TAILQ_INSERT_TAIL_RCU(&soc->ast_hash.bins[index], ase,
+				 hash_list_elem);
 }
 
 void dp_peer_ast_hash_remove(struct dp_soc *soc,
@@ -1209,12 +1508,13 @@ void dp_peer_ast_hash_remove(struct dp_soc *soc,
 
 	index = dp_peer_ast_hash_index(soc, &ase->mac_addr);
 	/* Check if tail is not empty before delete*/
-	QDF_ASSERT(!TAILQ_EMPTY(&soc->ast_hash.bins[index]));
+	QDF_ASSERT(!DP_TAILQ_EMPTY_RCU(&soc->ast_hash.bins[index]));
 
 	dp_peer_debug("ID: %u idx: %u mac_addr: " QDF_MAC_ADDR_FMT,
 		      ase->peer_id, index, QDF_MAC_ADDR_REF(ase->mac_addr.raw));
 
-	TAILQ_FOREACH(tmpase, &soc->ast_hash.bins[index], hash_list_elem) {
+	DP_TAILQ_FOREACH_PROTECTED(tmpase, &soc->ast_hash.bins[index],
+				   hash_list_elem) {
 		if (tmpase == ase) {
 			found = 1;
 			break;
@@ -1224,7 +1524,8 @@ void dp_peer_ast_hash_remove(struct dp_soc *soc,
 	QDF_ASSERT(found);
 
 	if (found)
-		TAILQ_REMOVE(&soc->ast_hash.bins[index], ase, hash_list_elem);
+		DP_TAILQ_REMOVE_RCU(&soc->ast_hash.bins[index], ase,
+				    hash_list_elem);
 }
 
 struct dp_ast_entry *dp_peer_ast_hash_find_by_vdevid(struct dp_soc *soc,
@@ -1240,7 +1541,8 @@ struct dp_ast_entry *dp_peer_ast_hash_find_by_vdevid(struct dp_soc *soc,
 	mac_addr = &local_mac_addr_aligned;
 
 	index = dp_peer_ast_hash_index(soc, mac_addr);
-	TAILQ_FOREACH(ase, &soc->ast_hash.bins[index], hash_list_elem) {
+	DP_TAILQ_FOREACH_PROTECTED(ase, &soc->ast_hash.bins[index],
+				   hash_list_elem) {
 		if ((vdev_id == ase->vdev_id) &&
 		    !dp_peer_find_mac_addr_cmp(mac_addr, &ase->mac_addr)) {
 			return ase;
@@ -1250,6 +1552,33 @@ struct dp_ast_entry *dp_peer_ast_hash_find_by_vdevid(struct dp_soc *soc,
 	return NULL;
 }
 
+bool dp_peer_ast_hash_exist_by_vdevid_rcu(struct dp_soc *soc,
+					  uint8_t *ast_mac_addr,
+					  uint8_t vdev_id)
+{
+	union dp_align_mac_addr local_mac_addr_aligned, *mac_addr;
+	struct dp_ast_entry *ase;
+	bool found = false;
+	uint32_t index;
+
+	qdf_mem_copy(&local_mac_addr_aligned.raw[0],
+		     ast_mac_addr, QDF_MAC_ADDR_SIZE);
+	mac_addr = &local_mac_addr_aligned;
+
+	qdf_rcu_read_lock();
+	index = dp_peer_ast_hash_index(soc, mac_addr);
+	DP_TAILQ_FOREACH_RCU(ase, &soc->ast_hash.bins[index], hash_list_elem) {
+		if ((vdev_id == ase->vdev_id) &&
+		    !dp_peer_find_mac_addr_cmp(mac_addr, &ase->mac_addr)) {
+			found = true;
+			break;
+		}
+	}
+	qdf_rcu_read_unlock();
+
+	return found;
+}
+
 struct dp_ast_entry *dp_peer_ast_hash_find_by_pdevid(struct dp_soc *soc,
 						     uint8_t *ast_mac_addr,
 						     uint8_t pdev_id)
@@ -1263,7 +1592,8 @@ struct dp_ast_entry *dp_peer_ast_hash_find_by_pdevid(struct dp_soc *soc,
 	mac_addr = &local_mac_addr_aligned;
 
 	index = dp_peer_ast_hash_index(soc, mac_addr);
-	TAILQ_FOREACH(ase, &soc->ast_hash.bins[index], hash_list_elem) {
+	DP_TAILQ_FOREACH_PROTECTED(ase, &soc->ast_hash.bins[index],
+				   hash_list_elem) {
 		if ((pdev_id == ase->pdev_id) &&
 		    !dp_peer_find_mac_addr_cmp(mac_addr, &ase->mac_addr)) {
 			return ase;
@@ -1288,7 +1618,8 @@ struct dp_ast_entry *dp_peer_ast_hash_find_soc(struct dp_soc *soc,
 	mac_addr = &local_mac_addr_aligned;
 
 	index = dp_peer_ast_hash_index(soc, mac_addr);
-	TAILQ_FOREACH(ase, &soc->ast_hash.bins[index], hash_list_elem) {
+	DP_TAILQ_FOREACH_PROTECTED(ase, &soc->ast_hash.bins[index],
+				   hash_list_elem) {
 		if (dp_peer_find_mac_addr_cmp(mac_addr, &ase->mac_addr) == 0) {
 			return ase;
 		}
@@ -1314,7 +1645,8 @@ struct dp_ast_entry *dp_peer_ast_hash_find_soc_by_type(
 	mac_addr = &local_mac_addr_aligned;
 
 	index = dp_peer_ast_hash_index(soc, mac_addr);
-	TAILQ_FOREACH(ase, &soc->ast_hash.bins[index], hash_list_elem) {
+	DP_TAILQ_FOREACH_PROTECTED(ase, &soc->ast_hash.bins[index],
+				   hash_list_elem) {
 		if (dp_peer_find_mac_addr_cmp(mac_addr, &ase->mac_addr) == 0 &&
 		    ase->type == type) {
 			return ase;
@@ -1946,7 +2278,7 @@ void dp_peer_free_ast_entry(struct dp_soc *soc,
 	DP_STATS_INC(soc, ast.deleted, 1);
 	dp_peer_ast_hash_remove(soc, ast_entry);
 	dp_peer_ast_cleanup(soc, ast_entry);
-	qdf_mem_free(ast_entry);
+	dp_peer_ast_entry_free_rcu(ast_entry);
 	soc->num_ast_entries--;
 }
 
@@ -2193,6 +2525,13 @@ struct dp_ast_entry *dp_peer_ast_hash_find_by_vdevid(struct dp_soc *soc,
 	return NULL;
 }
 
+bool dp_peer_ast_hash_exist_by_vdevid_rcu(struct dp_soc *soc,
+					  uint8_t *ast_mac_addr,
+					  uint8_t vdev_id)
+{
+	return false;
+}
+
 QDF_STATUS dp_peer_add_ast(struct dp_soc *soc,
 			   struct dp_peer *peer,
 			   uint8_t *mac_addr,
@@ -2352,7 +2691,7 @@ static uint32_t dp_peer_ast_free_wds_entries(struct dp_soc *soc,
 					    ast_entry->cookie,
 					    CDP_TXRX_AST_DELETED);
 
-		qdf_mem_free(ast_entry);
+		dp_peer_ast_entry_free_rcu(ast_entry);
 	}
 
 	return num_ast;
@@ -2472,21 +2811,22 @@ static int dp_peer_ast_free_entry_by_mac(struct dp_soc *soc,
 
 void dp_peer_find_hash_erase(struct dp_soc *soc)
 {
+	struct dp_peer_hash_tbl *tbl = dp_peer_hash_tbl_get(soc);
 	int i;
 
 	/*
 	 * Not really necessary to take peer_ref_mutex lock - by this point,
 	 * it's known that the soc is no longer in use.
 	 */
-	for (i = 0; i <= soc->peer_hash.mask; i++) {
-		if (!TAILQ_EMPTY(&soc->peer_hash.bins[i])) {
+	for (i = 0; i <= tbl->mask; i++) {
+		if (!DP_TAILQ_EMPTY_RCU(&tbl->bins[i])) {
 			struct dp_peer *peer, *peer_next;
 
 			/*
 			 * TAILQ_FOREACH_SAFE must be used here to avoid any
 			 * memory access violation after peer is freed
 			 */
-			TAILQ_FOREACH_SAFE(peer, &soc->peer_hash.bins[i],
+			DP_TAILQ_FOREACH_SAFE_PROTECTED(peer, &tbl->bins[i],
 				hash_list_elem, peer_next) {
 				/*
 				 * Don't remove the peer from the hash table -
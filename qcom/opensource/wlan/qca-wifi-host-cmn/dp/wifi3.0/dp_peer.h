@@ -37,6 +37,62 @@
 
 #define DP_PEER_HASH_LOAD_MULT  2
 #define DP_PEER_HASH_LOAD_SHIFT 0
+/* initial peer hash size, grown from the peer count up to max_peers */
+#define DP_PEER_HASH_MIN_IDX_BITS 4
+
+/*
+ * Ops for the DP_TAILQ_HEAD_RCU/DP_TAILQ_ENTRY_RCU lists (peer, MLD peer and
+ * AST hash bins) which are walked by lockless readers under
+ * qdf_rcu_read_lock(). Writers still serialize on the table lock and use the
+ * _PROTECTED accessors. Removal keeps the next pointer of the element intact,
+ * so a reader standing on it can continue its walk; the element itself must
+ * only be freed after a grace period.
+ */
+#define DP_TAILQ_INIT_RCU(head) do {					\
+		qdf_rcu_assign_pointer((head)->tqh_first, NULL);	\
+		(head)->tqh_last = &(head)->tqh_first;			\
+} while (0)
+
+#define DP_TAILQ_EMPTY_RCU(head)					\
+	(!qdf_rcu_access_pointer((head)->tqh_first))
+
+#define DP_TAILQ_FIRST_PROTECTED(head)					\
+	qdf_rcu_dereference_protected((head)->tqh_first, 1)
+
+#define DP_TAILQ_NEXT_PROTECTED(elm, field)				\
+	qdf_rcu_dereference_protected((elm)->field.tqe_next, 1)
+
+#define DP_TAILQ_INSERT_TAIL_RCU(head, elm, field) do {			\
+		qdf_rcu_assign_pointer((elm)->field.tqe_next, NULL);	\
+		(elm)->field.tqe_prev = (head)->tqh_last;		\
+		qdf_rcu_assign_pointer(*(head)->tqh_last, (elm));	\
+		(head)->tqh_last = &(elm)->field.tqe_next;		\
+} while (0)
+
+#define DP_TAILQ_REMOVE_RCU(head, elm, field) do {			\
+		if (DP_TAILQ_NEXT_PROTECTED((elm), field))		\
+			DP_TAILQ_NEXT_PROTECTED((elm), field)->field.tqe_prev = \
+				(elm)->field.tqe_prev;			\
+		else							\
+			(head)->tqh_last = (elm)->field.tqe_prev;	\
+		qdf_rcu_assign_pointer(*(elm)->field.tqe_prev,		\
+				       DP_TAILQ_NEXT_PROTECTED((elm), field)); \
+} while (0)
+
+#define DP_TAILQ_FOREACH_RCU(var, head, field)				\
+	for ((var) = qdf_rcu_dereference((head)->tqh_first);		\
+	     (var);							\
+	     (var) = qdf_rcu_dereference((var)->field.tqe_next))
+
+#define DP_TAILQ_FOREACH_PROTECTED(var, head, field)			\
+	for ((var) = DP_TAILQ_FIRST_PROTECTED(head);			\
+	     (var);							\
+	     (var) = DP_TAILQ_NEXT_PROTECTED((var), field))
+
+#define DP_TAILQ_FOREACH_SAFE_PROTECTED(var, head, field, tvar)		\
+	for ((var) = DP_TAILQ_FIRST_PROTECTED(head);			\
+	     (var) && ((tvar) = DP_TAILQ_NEXT_PROTECTED((var), field), 1); \
+	     (var) = (tvar))
 
 /* Threshold for peer's cached buf queue beyond which frames are dropped */
 #define DP_RX_CACHED_BUFQ_THRESH 64
@@ -891,6 +947,22 @@ struct dp_ast_entry *dp_peer_ast_hash_find_by_vdevid(struct dp_soc *soc,
 						     uint8_t *ast_mac_addr,
 						     uint8_t vdev_id);
 
+/**
+ * dp_peer_ast_hash_exist_by_vdevid_rcu() - Check for AST entry by MAC address
+ * @soc: SoC handle
+ * @ast_mac_addr: Mac address
+ * @vdev_id: vdev Id
+ *
+ * Lockless variant of dp_peer_ast_hash_find_by_vdevid() for the per packet
+ * path; only reports presence since the entry may be freed once the RCU
+ * read section ends.
+ *
+ * Return: true if an AST entry exists for the MAC on the vdev
+ */
+bool dp_peer_ast_hash_exist_by_vdevid_rcu(struct dp_soc *soc,
+					  uint8_t *ast_mac_addr,
+					  uint8_t vdev_id);
+
 /**
  * dp_peer_ast_hash_find_soc() - Find AST entry by MAC address
  * @soc: SoC handle
@@ -1001,6 +1073,14 @@ void dp_peer_ast_hash_remove(struct dp_soc *soc,
 void dp_peer_free_ast_entry(struct dp_soc *soc,
 			    struct dp_ast_entry *ast_entry);
 
+/**
+ * dp_peer_ast_entry_free_rcu() - Free an AST entry after RCU grace period
+ * @ast_entry: Address search entry, already removed from the AST hash
+ *
+ * Return: None
+ */
+void dp_peer_ast_entry_free_rcu(struct dp_ast_entry *ast_entry);
+
 /**
  * dp_peer_unlink_ast_entry() - Free up the ast entry memory
  * @soc: SoC handle
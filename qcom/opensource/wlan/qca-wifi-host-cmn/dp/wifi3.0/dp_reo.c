@@ -84,6 +84,76 @@ dp_reset_rx_reo_tid_queue(struct dp_soc *soc, void *hw_qdesc_vaddr,
 }
 #endif
 
+#ifdef WLAN_DP_REO_CMD_BATCH
+/*
+ * Max commands posted in a batch before the REO command ring HP is updated.
+ * This only bounds the commands sitting in the ring unseen by HW; signalled
+ * commands HW has not completed yet are bounded by the ring size alone.
+ */
+#define DP_REO_CMD_BATCH_MAX_PENDING 32
+
+/**
+ * dp_reo_cmd_batch_doorbell_stats() - Account a batch doorbell
+ * @soc: DP SoC handle
+ * @num: number of commands signalled by the doorbell
+ *
+ * Return: None
+ */
+static inline void dp_reo_cmd_batch_doorbell_stats(struct dp_soc *soc,
+						   uint16_t num)
+{
+	if (!num)
+		return;
+
+	DP_STATS_INC(soc, reo_cmd_batch.doorbells, 1);
+	DP_STATS_INC(soc, reo_cmd_batch.cmds, num);
+	if (num > soc->stats.reo_cmd_batch.max_per_doorbell)
+		soc->stats.reo_cmd_batch.max_per_doorbell = num;
+}
+
+/**
+ * dp_reo_cmd_batch_limit_check() - Signal the commands of the open batch
+ *				    when too many wait for the doorbell
+ * @soc: DP SoC handle
+ *
+ * Return: None
+ */
+static inline void dp_reo_cmd_batch_limit_check(struct dp_soc *soc)
+{
+	hal_ring_handle_t hal_ring_hdl = soc->reo_cmd_ring.hal_srng;
+
+	if (qdf_likely(hal_reo_cmd_batch_pending(hal_ring_hdl) <
+		       DP_REO_CMD_BATCH_MAX_PENDING))
+		return;
+
+	DP_STATS_INC(soc, reo_cmd_batch.limit_flush, 1);
+	dp_reo_cmd_batch_doorbell_stats(soc,
+					hal_reo_cmd_batch_flush(soc->hal_soc,
+								hal_ring_hdl));
+}
+
+void dp_reo_cmd_batch_start(struct dp_soc *soc)
+{
+	hal_reo_cmd_batch_start(soc->hal_soc, soc->reo_cmd_ring.hal_srng);
+}
+
+void dp_reo_cmd_batch_end(struct dp_soc *soc)
+{
+	uint16_t num;
+
+	num = hal_reo_cmd_batch_end(soc->hal_soc, soc->reo_cmd_ring.hal_srng);
+	if (!num)
+		return;
+
+	DP_STATS_INC(soc, reo_cmd_batch.batches, 1);
+	dp_reo_cmd_batch_doorbell_stats(soc, num);
+}
+#else
+static inline void dp_reo_cmd_batch_limit_check(struct dp_soc *soc)
+{
+}
+#endif /* WLAN_DP_REO_CMD_BATCH */
+
 QDF_STATUS dp_reo_send_cmd(struct dp_soc *soc, enum hal_reo_cmd_type type,
 		     struct hal_reo_cmd_params *params,
 		     void (*callback_fn), void *data)
@@ -120,9 +190,91 @@ QDF_STATUS dp_reo_send_cmd(struct dp_soc *soc, enum hal_reo_cmd_type type,
 		qdf_spin_unlock_bh(&soc->rx.reo_cmd_lock);
 	}
 
+	/* the callback is registered, HW may be told about the command */
+	dp_reo_cmd_batch_limit_check(soc);
+
 	return QDF_STATUS_SUCCESS;
 }
 
+#ifdef WLAN_DP_REO_CMD_BATCH
+uint32_t dp_reo_status_ring_handler(struct dp_intr *int_ctx, struct dp_soc *soc)
+{
+	hal_ring_desc_t reo_desc;
+	struct dp_reo_cmd_info *reo_cmd;
+	struct dp_reo_cmd_info *tmp_cmd;
+	union hal_reo_status reo_status;
+	TAILQ_HEAD(, dp_reo_cmd_info) done_list;
+	uint32_t done_count = 0;
+	int num;
+	int processed_count = 0;
+
+	TAILQ_INIT(&done_list);
+
+	if (dp_srng_access_start(int_ctx, soc, soc->reo_status_ring.hal_srng))
+		return processed_count;
+
+	reo_desc = hal_srng_dst_get_next(soc->hal_soc,
+					 soc->reo_status_ring.hal_srng);
+
+	/*
+	 * Match all the completions of this reap against the pending list
+	 * under a single lock hold, the handlers run once the status ring
+	 * is released.
+	 */
+	qdf_spin_lock_bh(&soc->rx.reo_cmd_lock);
+	while (reo_desc) {
+		uint16_t tlv = HAL_GET_TLV(reo_desc);
+		QDF_STATUS status;
+
+		processed_count++;
+
+		status = hal_reo_status_update(soc->hal_soc,
+					       reo_desc,
+					       &reo_status, tlv, &num);
+		if (status != QDF_STATUS_SUCCESS)
+			goto next;
+
+		/* completions come in posting order, usually the list head */
+		TAILQ_FOREACH(reo_cmd, &soc->rx.reo_cmd_list,
+			      reo_cmd_list_elem) {
+			if (reo_cmd->cmd == num) {
+				TAILQ_REMOVE(&soc->rx.reo_cmd_list, reo_cmd,
+					     reo_cmd_list_elem);
+				qdf_mem_copy(&reo_cmd->status, &reo_status,
+					     sizeof(reo_status));
+				TAILQ_INSERT_TAIL(&done_list, reo_cmd,
+						  reo_cmd_list_elem);
+				done_count++;
+				break;
+			}
+		}
+
+next:
+		reo_desc = hal_srng_dst_get_next(soc,
+						 soc->reo_status_ring.hal_srng);
+	} /* while */
+	qdf_spin_unlock_bh(&soc->rx.reo_cmd_lock);
+
+	dp_srng_access_end(int_ctx, soc, soc->reo_status_ring.hal_srng);
+
+	if (!done_count)
+		return processed_count;
+
+	if (done_count > soc->stats.reo_cmd_batch.max_status_burst)
+		soc->stats.reo_cmd_batch.max_status_burst = done_count;
+
+	/* commands posted by the handlers share one doorbell */
+	dp_reo_cmd_batch_start(soc);
+	TAILQ_FOREACH_SAFE(reo_cmd, &done_list, reo_cmd_list_elem, tmp_cmd) {
+		TAILQ_REMOVE(&done_list, reo_cmd, reo_cmd_list_elem);
+		reo_cmd->handler(soc, reo_cmd->data, &reo_cmd->status);
+		qdf_mem_free(reo_cmd);
+	}
+	dp_reo_cmd_batch_end(soc);
+
+	return processed_count;
+}
+#else
 uint32_t dp_reo_status_ring_handler(struct dp_intr *int_ctx, struct dp_soc *soc)
 {
 	hal_ring_desc_t reo_desc;
@@ -174,6 +326,7 @@ next:
 	dp_srng_access_end(int_ctx, soc, soc->reo_status_ring.hal_srng);
 	return processed_count;
 }
+#endif /* WLAN_DP_REO_CMD_BATCH */
 
 void dp_reo_cmdlist_destroy(struct dp_soc *soc)
 {
@@ -1420,6 +1420,290 @@ static QDF_STATUS dp_rx_defrag_gcmp_demic(struct dp_soc *soc, qdf_nbuf_t nbuf,
 	return QDF_STATUS_SUCCESS;
 }
 
+#ifdef DP_RX_DEFRAG_LINEARIZE
+/**
+ * struct dp_rx_defrag_mic_ctx - incremental Michael MIC state
+ * @l: left half of the Michael state
+ * @r: right half of the Michael state
+ * @pend: bytes of the current 32 bit block not processed yet
+ * @pend_len: number of valid bytes in @pend
+ */
+struct dp_rx_defrag_mic_ctx {
+	uint32_t l;
+	uint32_t r;
+	uint8_t pend[sizeof(uint32_t)];
+	uint8_t pend_len;
+};
+
+/**
+ * dp_rx_defrag_mic_init() - start an incremental Michael MIC
+ * @ctx: MIC state
+ * @key: Michael key
+ * @wh: 802.11 header of the first fragment
+ *
+ * Return: None
+ */
+static void dp_rx_defrag_mic_init(struct dp_rx_defrag_mic_ctx *ctx,
+				  const uint8_t *key,
+				  const struct ieee80211_frame *wh)
+{
+	uint8_t hdr[16] = { 0, };
+	uint32_t l, r;
+	uint32_t i;
+
+	dp_rx_defrag_michdr(wh, hdr);
+
+	l = dp_rx_get_le32(key);
+	r = dp_rx_get_le32(key + 4);
+
+	/* Michael MIC pseudo header: DA, SA, 3 x 0, Priority */
+	for (i = 0; i < sizeof(hdr); i += sizeof(uint32_t)) {
+		l ^= dp_rx_get_le32(&hdr[i]);
+		dp_rx_michael_block(l, r);
+	}
+
+	ctx->l = l;
+	ctx->r = r;
+	ctx->pend_len = 0;
+}
+
+/**
+ * dp_rx_defrag_mic_update() - feed data to an incremental Michael MIC
+ * @ctx: MIC state
+ * @data: data to add to the MIC
+ * @len: length of @data, blocks may straddle consecutive calls
+ *
+ * Return: None
+ */
+static void dp_rx_defrag_mic_update(struct dp_rx_defrag_mic_ctx *ctx,
+				    const uint8_t *data, uint32_t len)
+{
+	uint32_t l = ctx->l;
+	uint32_t r = ctx->r;
+
+	/* complete the block left over by the previous fragment */
+	while (ctx->pend_len && len) {
+		ctx->pend[ctx->pend_len++] = *data++;
+		len--;
+		if (ctx->pend_len == sizeof(uint32_t)) {
+			l ^= dp_rx_get_le32(ctx->pend);
+			dp_rx_michael_block(l, r);
+			ctx->pend_len = 0;
+		}
+	}
+
+	while (len >= sizeof(uint32_t)) {
+		l ^= dp_rx_get_le32(data);
+		dp_rx_michael_block(l, r);
+		data += sizeof(uint32_t);
+		len -= sizeof(uint32_t);
+	}
+
+	while (len--)
+		ctx->pend[ctx->pend_len++] = *data++;
+
+	ctx->l = l;
+	ctx->r = r;
+}
+
+/**
+ * dp_rx_defrag_mic_final() - complete an incremental Michael MIC
+ * @ctx: MIC state
+ * @mic: buffer of IEEE80211_WEP_MICLEN bytes receiving the MIC
+ *
+ * Return: None
+ */
+static void dp_rx_defrag_mic_final(struct dp_rx_defrag_mic_ctx *ctx,
+				   uint8_t mic[])
+{
+	uint8_t *pend = ctx->pend;
+	uint32_t l = ctx->l;
+	uint32_t r = ctx->r;
+
+	/* Last block and padding (0x5a, 4..7 x 0) */
+	switch (ctx->pend_len) {
+	case 0:
+		l ^= dp_rx_get_le32_split(0x5a, 0, 0, 0);
+		break;
+	case 1:
+		l ^= dp_rx_get_le32_split(pend[0], 0x5a, 0, 0);
+		break;
+	case 2:
+		l ^= dp_rx_get_le32_split(pend[0], pend[1], 0x5a, 0);
+		break;
+	case 3:
+		l ^= dp_rx_get_le32_split(pend[0], pend[1], pend[2], 0x5a);
+		break;
+	}
+	dp_rx_michael_block(l, r);
+	dp_rx_michael_block(l, r);
+	dp_rx_put_le32(mic, l);
+	dp_rx_put_le32(mic + 4, r);
+}
+
+/**
+ * dp_rx_defrag_linear_len() - validate the fragments of a sequence and get
+ *			       the length of the reassembled payload
+ * @txrx_peer: Pointer to the txrx peer
+ * @head: first fragment, its PN is the reference for the others
+ * @hdrsize: offset of the payload after the RX TLVs in each fragment
+ *
+ * Does the PN and multicast checks dp_rx_construct_fraglist() does, before
+ * any fragment is modified.
+ *
+ * Return: payload length, 0 if the fragments must be dropped
+ */
+static uint32_t dp_rx_defrag_linear_len(struct dp_txrx_peer *txrx_peer,
+					qdf_nbuf_t head, uint16_t hdrsize)
+{
+	struct dp_soc *soc = txrx_peer->vdev->pdev->soc;
+	uint32_t off = soc->rx_pkt_tlv_size + hdrsize;
+	uint64_t cur_pn128[2] = {0, 0}, prev_pn128[2] = {0, 0};
+	bool needs_pn_check;
+	enum cdp_sec_type sec_type;
+	qdf_nbuf_t msdu;
+	uint32_t len = 0;
+	int index;
+
+	index = hal_rx_msdu_is_wlan_mcast(soc->hal_soc, head) ? dp_sec_mcast :
+				dp_sec_ucast;
+	sec_type = txrx_peer->security[index].sec_type;
+	needs_pn_check = !(sec_type == cdp_sec_type_none ||
+			   sec_type == cdp_sec_type_wep128 ||
+			   sec_type == cdp_sec_type_wep104 ||
+			   sec_type == cdp_sec_type_wep40);
+
+	if (needs_pn_check)
+		hal_rx_tlv_get_pn_num(soc->hal_soc, qdf_nbuf_data(head),
+				      prev_pn128);
+
+	for (msdu = head; msdu; msdu = qdf_nbuf_next(msdu)) {
+		if (qdf_nbuf_len(msdu) < off)
+			return 0;
+
+		/* see dp_rx_construct_fraglist() */
+		if (hal_rx_msdu_is_wlan_mcast(soc->hal_soc, msdu)) {
+			dp_err_rl("Dropping multicast/broadcast fragments");
+			return 0;
+		}
+
+		if (msdu != head && needs_pn_check) {
+			if (dp_rx_defrag_pn_check(soc, msdu, cur_pn128,
+						  prev_pn128)) {
+				dp_info_rl("cur_pn128[0] 0x%llx cur_pn128[1] 0x%llx prev_pn128[0] 0x%llx prev_pn128[1] 0x%llx",
+					   cur_pn128[0], cur_pn128[1],
+					   prev_pn128[0], prev_pn128[1]);
+				return 0;
+			}
+			prev_pn128[0] = cur_pn128[0];
+			prev_pn128[1] = cur_pn128[1];
+		}
+
+		len += qdf_nbuf_len(msdu) - off;
+	}
+
+	return len;
+}
+
+/**
+ * dp_rx_defrag_linearize() - reassemble the fragments in the head buffer
+ * @txrx_peer: Pointer to the txrx peer
+ * @head: first fragment of the decapped fragment chain
+ * @hdrsize: offset of the payload after the RX TLVs in each fragment
+ * @mic_key: Michael key if the TKIP MIC has to be verified, else NULL
+ *
+ * When the reassembled MSDU fits in the RX buffer of the first fragment,
+ * the payload of the other fragments is copied once behind the payload of
+ * the first one, and the TKIP MIC is computed while copying. This replaces
+ * the demic walk of the chain and the nbuf fraglist, so the result is a
+ * linear nbuf which is reinjected or delivered as is.
+ *
+ * The fragment chain is left untouched when the fast path does not apply.
+ *
+ * Return: QDF_STATUS_SUCCESS if @head holds the reassembled MSDU,
+ *	   QDF_STATUS_E_NOSUPPORT if the legacy path has to be used,
+ *	   QDF_STATUS_E_DEFRAG_ERROR if the fragments must be dropped
+ */
+static QDF_STATUS dp_rx_defrag_linearize(struct dp_txrx_peer *txrx_peer,
+					 qdf_nbuf_t head, uint16_t hdrsize,
+					 const uint8_t *mic_key)
+{
+	struct dp_soc *soc = txrx_peer->vdev->pdev->soc;
+	uint32_t off = soc->rx_pkt_tlv_size + hdrsize;
+	struct dp_rx_defrag_mic_ctx mic_ctx;
+	uint8_t mic[IEEE80211_WEP_MICLEN];
+	uint32_t total, mic_len, len, done;
+	qdf_nbuf_t msdu;
+	uint8_t *dst;
+
+	if (!qdf_nbuf_next(head))
+		return QDF_STATUS_E_NOSUPPORT;
+
+	total = dp_rx_defrag_linear_len(txrx_peer, head, hdrsize);
+	if (!total)
+		return QDF_STATUS_E_DEFRAG_ERROR;
+
+	mic_len = mic_key ? dp_f_tkip.ic_miclen : 0;
+	if (total < mic_len)
+		return QDF_STATUS_E_DEFRAG_ERROR;
+
+	/* the reassembled MSDU has to fit the head RX buffer */
+	if (off + total > wlan_cfg_rx_buffer_size(soc->wlan_cfg_ctx) ||
+	    off + total - qdf_nbuf_len(head) > qdf_nbuf_tailroom(head))
+		return QDF_STATUS_E_NOSUPPORT;
+
+	if (mic_key)
+		dp_rx_defrag_mic_init(&mic_ctx, mic_key,
+				      (struct ieee80211_frame *)
+				      (qdf_nbuf_data(head) +
+				       soc->rx_pkt_tlv_size));
+
+	/* payload bytes covered by the MIC, the MIC itself trails them */
+	total -= mic_len;
+	done = 0;
+
+	for (msdu = head; msdu; msdu = qdf_nbuf_next(msdu)) {
+		len = qdf_nbuf_len(msdu) - off;
+
+		if (msdu != head) {
+			dst = qdf_nbuf_put_tail(head, len);
+			qdf_mem_copy(dst, qdf_nbuf_data(msdu) + off, len);
+		}
+
+		if (mic_key && done < total)
+			dp_rx_defrag_mic_update(&mic_ctx,
+						qdf_nbuf_data(msdu) + off,
+						qdf_min(len, total - done));
+		done += len;
+	}
+
+	if (mic_key) {
+		dp_rx_defrag_mic_final(&mic_ctx, mic);
+		dst = qdf_nbuf_data(head) + off + total;
+		if (qdf_mem_cmp(mic, dst, mic_len)) {
+			dp_rx_defrag_err(txrx_peer->vdev, head);
+			return QDF_STATUS_E_DEFRAG_ERROR;
+		}
+		qdf_nbuf_trim_tail(head, mic_len);
+	}
+
+	dp_rx_defrag_frames_free(qdf_nbuf_next(head));
+	qdf_nbuf_set_next(head, NULL);
+
+	DP_STATS_INC(soc, rx.defrag_linear, 1);
+
+	return QDF_STATUS_SUCCESS;
+}
+#else
+static inline QDF_STATUS dp_rx_defrag_linearize(struct dp_txrx_peer *txrx_peer,
+						qdf_nbuf_t head,
+						uint16_t hdrsize,
+						const uint8_t *mic_key)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+#endif /* DP_RX_DEFRAG_LINEARIZE */
+
 QDF_STATUS dp_rx_defrag(struct dp_txrx_peer *txrx_peer, unsigned int tid,
 			qdf_nbuf_t frag_list_head,
 			qdf_nbuf_t frag_list_tail)
@@ -1432,6 +1716,7 @@ QDF_STATUS dp_rx_defrag(struct dp_txrx_peer *txrx_peer, unsigned int tid,
 	struct dp_vdev *vdev = txrx_peer->vdev;
 	struct dp_soc *soc = vdev->pdev->soc;
 	uint8_t status = 0;
+	QDF_STATUS linear_status;
 
 	if (!cur)
 		return QDF_STATUS_E_DEFRAG_ERROR;
@@ -1541,11 +1826,24 @@ QDF_STATUS dp_rx_defrag(struct dp_txrx_peer *txrx_peer, unsigned int tid,
 		break;
 	}
 
-	if (tkip_demic) {
-		msdu = frag_list_head;
+	if (tkip_demic)
 		qdf_mem_copy(key,
 			     &txrx_peer->security[index].michael_key[0],
 			     IEEE80211_WEP_MICLEN);
+
+	linear_status = dp_rx_defrag_linearize(txrx_peer, frag_list_head,
+					       hdr_space,
+					       tkip_demic ? key : NULL);
+	if (QDF_IS_STATUS_SUCCESS(linear_status)) {
+		dp_rx_defrag_nwifi_to_8023(soc, txrx_peer, tid, frag_list_head,
+					   hdr_space);
+		return QDF_STATUS_SUCCESS;
+	} else if (linear_status != QDF_STATUS_E_NOSUPPORT) {
+		return QDF_STATUS_E_DEFRAG_ERROR;
+	}
+
+	if (tkip_demic) {
+		msdu = frag_list_head;
 		status = dp_rx_defrag_tkip_demic(soc, key, msdu,
 						 soc->rx_pkt_tlv_size +
 						 hdr_space);
@@ -1022,6 +1022,7 @@ void dp_rx_tid_delete_cb(struct dp_soc *soc, void *cb_ctxt,
 	 */
 	dp_reo_limit_clean_batch_sz(&list_size);
 
+	dp_reo_cmd_batch_start(soc);
 	while ((qdf_list_peek_front(&soc->reo_desc_freelist,
 		(qdf_list_node_t **)&desc) == QDF_STATUS_SUCCESS) &&
 		((list_size >= REO_DESC_FREELIST_SIZE) ||
@@ -1115,6 +1116,7 @@ void dp_rx_tid_delete_cb(struct dp_soc *soc, void *cb_ctxt,
 			break;
 		}
 	}
+	dp_reo_cmd_batch_end(soc);
 	qdf_spin_unlock_bh(&soc->reo_desc_freelist_lock);
 
 	dp_reo_desc_defer_free(soc);
@@ -1246,11 +1248,43 @@ static void dp_peer_rx_tids_init(struct dp_peer *peer)
 }
 #endif
 
+#ifdef WLAN_DP_REO_CMD_BATCH
+/**
+ * dp_peer_rx_tid_setup_time_record() - Account the time spent in the
+ *					association time rx TID setup
+ * @soc: DP SoC handle
+ * @start_ts: log timestamp taken when the setup started
+ *
+ * Return: None
+ */
+static void dp_peer_rx_tid_setup_time_record(struct dp_soc *soc,
+					     uint64_t start_ts)
+{
+	uint32_t elapsed_us;
+
+	elapsed_us = qdf_log_timestamp_to_usecs(qdf_get_log_timestamp() -
+						start_ts);
+
+	DP_STATS_INC(soc, reo_cmd_batch.tid_setup_cnt, 1);
+	DP_STATS_INC(soc, reo_cmd_batch.tid_setup_total_us, elapsed_us);
+	if (elapsed_us > soc->stats.reo_cmd_batch.tid_setup_max_us)
+		soc->stats.reo_cmd_batch.tid_setup_max_us = elapsed_us;
+}
+#else
+static inline void dp_peer_rx_tid_setup_time_record(struct dp_soc *soc,
+						    uint64_t start_ts)
+{
+}
+#endif
+
 void dp_peer_rx_tid_setup(struct dp_peer *peer)
 {
 	struct dp_soc *soc = peer->vdev->pdev->soc;
 	struct dp_txrx_peer *txrx_peer = dp_get_txrx_peer(peer);
 	struct dp_vdev *vdev = peer->vdev;
+	uint64_t start_ts = qdf_get_log_timestamp();
+
+	dp_reo_cmd_batch_start(soc);
 
 	dp_peer_rx_tids_init(peer);
 
@@ -1277,6 +1311,10 @@ void dp_peer_rx_tid_setup(struct dp_peer *peer)
 	 * Setup the rest of TID's to handle LFR
 	 */
 	dp_peer_setup_remaining_tids(peer);
+
+	dp_reo_cmd_batch_end(soc);
+
+	dp_peer_rx_tid_setup_time_record(soc, start_ts);
 }
 
 void dp_peer_rx_cleanup(struct dp_vdev *vdev, struct dp_peer *peer)
@@ -1289,6 +1327,7 @@ void dp_peer_rx_cleanup(struct dp_vdev *vdev, struct dp_peer *peer)
 
 	dp_info("Remove tids for peer: %pK", peer);
 
+	dp_reo_cmd_batch_start(peer->vdev->pdev->soc);
 	for (tid = 0; tid < DP_MAX_TIDS; tid++) {
 		struct dp_rx_tid *rx_tid = &peer->rx_tid[tid];
 		struct dp_rx_tid_defrag *defrag_rx_tid =
@@ -1310,6 +1349,7 @@ void dp_peer_rx_cleanup(struct dp_vdev *vdev, struct dp_peer *peer)
 		}
 		qdf_spin_unlock_bh(&rx_tid->tid_lock);
 	}
+	dp_reo_cmd_batch_end(peer->vdev->pdev->soc);
 #ifdef notyet /* See if FW can remove queues as part of peer cleanup */
 	if (soc->ol_ops->peer_rx_reorder_queue_remove) {
 		soc->ol_ops->peer_rx_reorder_queue_remove(soc->ctrl_psoc,
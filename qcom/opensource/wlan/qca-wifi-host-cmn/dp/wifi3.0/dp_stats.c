@@ -6037,6 +6037,75 @@ dp_print_wbm2sw_ring_stats_from_hal(struct dp_pdev *pdev)
  * Total of 283
  */
 #define DP_STATS_STR_LEN 283
+
+#ifdef DP_TX_DESC_PCPU_CACHE
+/**
+ * dp_print_tx_desc_pcpu_cache_stats() - Print per-CPU cache stats of a pool
+ * @tx_desc_pool: Tx descriptor pool
+ *
+ * Return: None
+ */
+static void
+dp_print_tx_desc_pcpu_cache_stats(struct dp_tx_desc_pool_s *tx_desc_pool)
+{
+	struct dp_tx_desc_pcpu_cache *cache;
+	int cpu;
+
+	if (!tx_desc_pool->pcpu_cache)
+		return;
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++) {
+		cache = &tx_desc_pool->pcpu_cache[cpu];
+		if (!cache->hit && !cache->refill)
+			continue;
+		DP_PRINT_STATS("	cpu %d: cached %u hit %u refill %u drain %u",
+			       cpu, cache->count, cache->hit,
+			       cache->refill, cache->drain);
+	}
+}
+#else
+static inline void
+dp_print_tx_desc_pcpu_cache_stats(struct dp_tx_desc_pool_s *tx_desc_pool)
+{
+}
+#endif
+
+/**
+ * dp_print_tx_desc_pool_lock_stats() - Print Tx desc pool lock statistics
+ * @soc: DP soc handle
+ *
+ * Return: None
+ */
+static void dp_print_tx_desc_pool_lock_stats(struct dp_soc *soc)
+{
+	struct dp_tx_desc_pool_s *tx_desc_pool;
+	uint8_t desc_pool_id;
+	uint64_t ops_per_lock, num_ops, num_locks;
+
+	for (desc_pool_id = 0;
+	     desc_pool_id < wlan_cfg_get_num_tx_desc_pool(soc->wlan_cfg_ctx);
+	     desc_pool_id++) {
+		tx_desc_pool = dp_get_tx_desc_pool(soc, desc_pool_id);
+		if (!tx_desc_pool->lock_acquired)
+			continue;
+
+		/* qdf_do_div() takes a 32 bit divisor */
+		num_ops = tx_desc_pool->lock_desc_ops;
+		num_locks = tx_desc_pool->lock_acquired;
+		while (num_locks > 0xFFFFFFFF) {
+			num_ops >>= 1;
+			num_locks >>= 1;
+		}
+		ops_per_lock = qdf_do_div(num_ops * 100, num_locks);
+		DP_PRINT_STATS("Tx desc pool %u: lock acquired %llu desc ops %llu desc per lock %llu.%02llu",
+			       desc_pool_id, tx_desc_pool->lock_acquired,
+			       tx_desc_pool->lock_desc_ops,
+			       qdf_do_div(ops_per_lock, 100),
+			       qdf_do_div_rem(ops_per_lock, 100));
+		dp_print_tx_desc_pcpu_cache_stats(tx_desc_pool);
+	}
+}
+
 #ifndef WLAN_SOFTUMAC_SUPPORT
 static int
 dp_fill_rx_interrupt_ctx_stats(struct dp_intr *intr_ctx,
@@ -6256,6 +6325,7 @@ void dp_print_soc_tx_stats(struct dp_soc *soc)
 
 	DP_PRINT_STATS("Tx Descriptors In Use = %u",
 		       soc->stats.tx.desc_in_use);
+	dp_print_tx_desc_pool_lock_stats(soc);
 	DP_PRINT_STATS("Tx Invalid peer:");
 	DP_PRINT_STATS("	Packets = %llu",
 		       soc->stats.tx.tx_invalid_peer.num);
@@ -6458,6 +6528,7 @@ void dp_print_soc_tx_stats(struct dp_soc *soc)
 
 	DP_PRINT_STATS("Tx Descriptors In Use = %u",
 		       soc->stats.tx.desc_in_use);
+	dp_print_tx_desc_pool_lock_stats(soc);
 	DP_PRINT_STATS("Tx Invalid peer:");
 	DP_PRINT_STATS("	Packets = %llu",
 		       soc->stats.tx.tx_invalid_peer.num);
@@ -8469,6 +8540,10 @@ dp_print_soc_rx_stats(struct dp_soc *soc)
 		       soc->stats.rx.rx_frags);
 	DP_PRINT_STATS("Reo reinjected packets: %u",
 		       soc->stats.rx.reo_reinject);
+#ifdef DP_RX_DEFRAG_LINEARIZE
+	DP_PRINT_STATS("Linear defragmented packets: %u",
+		       soc->stats.rx.defrag_linear);
+#endif
 	DP_PRINT_STATS("Errors:\n");
 	DP_PRINT_STATS("Rx Decrypt Errors = %d",
 		       (soc->stats.rx.err.rxdma_error[HAL_RXDMA_ERR_DECRYPT] +
@@ -8577,6 +8652,21 @@ dp_print_soc_rx_stats(struct dp_soc *soc)
 	DP_PRINT_STATS("REO Error(0-14):%s", reo_error);
 	DP_PRINT_STATS("REO CMD SEND FAIL: %d",
 		       soc->stats.rx.err.reo_cmd_send_fail);
+#ifdef WLAN_DP_REO_CMD_BATCH
+	DP_PRINT_STATS("REO CMD batches: %u cmds: %u doorbells: %u limit flush: %u max per doorbell: %u max status burst: %u",
+		       soc->stats.reo_cmd_batch.batches,
+		       soc->stats.reo_cmd_batch.cmds,
+		       soc->stats.reo_cmd_batch.doorbells,
+		       soc->stats.reo_cmd_batch.limit_flush,
+		       soc->stats.reo_cmd_batch.max_per_doorbell,
+		       soc->stats.reo_cmd_batch.max_status_burst);
+	DP_PRINT_STATS("Rx TID setup: %u avg us: %llu max us: %u",
+		       soc->stats.reo_cmd_batch.tid_setup_cnt,
+		       soc->stats.reo_cmd_batch.tid_setup_cnt ?
+		       qdf_do_div(soc->stats.reo_cmd_batch.tid_setup_total_us,
+				  soc->stats.reo_cmd_batch.tid_setup_cnt) : 0,
+		       soc->stats.reo_cmd_batch.tid_setup_max_us);
+#endif
 
 	DP_PRINT_STATS("Rx BAR frames:%d", soc->stats.rx.bar_frame);
 	DP_PRINT_STATS("Rxdma2rel route drop:%d",
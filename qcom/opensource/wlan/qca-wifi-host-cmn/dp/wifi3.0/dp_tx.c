@@ -379,15 +379,24 @@ dp_tx_release_ds_tx_desc(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 }
 #endif
 
-void
-dp_tx_desc_release(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
-		   uint8_t desc_pool_id)
+/**
+ * __dp_tx_desc_release() - Release the resources attached to a tx descriptor
+ * @soc: Soc handle
+ * @tx_desc: Tx Descriptor
+ * @desc_pool_id: Descriptor Pool ID
+ *
+ * Return: false if the descriptor was already returned to its pool, true if
+ *	   the caller still has to free it
+ */
+static inline bool
+__dp_tx_desc_release(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
+		     uint8_t desc_pool_id)
 {
 	struct dp_pdev *pdev = tx_desc->pdev;
 	uint8_t comp_status = 0;
 
 	if (dp_tx_release_ds_tx_desc(soc, tx_desc, desc_pool_id))
-		return;
+		return false;
 
 	qdf_assert(pdev);
 
@@ -423,6 +432,16 @@ dp_tx_desc_release(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 			    qdf_atomic_read(&pdev->num_tx_outstanding));
 	}
 
+	return true;
+}
+
+void
+dp_tx_desc_release(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
+		   uint8_t desc_pool_id)
+{
+	if (!__dp_tx_desc_release(soc, tx_desc, desc_pool_id))
+		return;
+
 	if (tx_desc->flags & DP_TX_DESC_FLAG_SPECIAL)
 		dp_tx_spcl_desc_free(soc, tx_desc, desc_pool_id);
 	else
@@ -430,6 +449,33 @@ dp_tx_desc_release(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 	return;
 }
 
+/**
+ * dp_tx_desc_release_batched() - Release a tx descriptor into a free batch
+ * @soc: Soc handle
+ * @tx_desc: Tx Descriptor
+ * @desc_pool_id: Descriptor Pool ID
+ * @batch: free batch, flushed by the caller at the end of the burst
+ *
+ * Same as dp_tx_desc_release() but regular descriptors are collected in
+ * @batch so the pool lock is taken once per burst instead of once per
+ * descriptor.
+ *
+ * Return: none
+ */
+static inline void
+dp_tx_desc_release_batched(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
+			   uint8_t desc_pool_id,
+			   struct dp_tx_desc_free_batch *batch)
+{
+	if (!__dp_tx_desc_release(soc, tx_desc, desc_pool_id))
+		return;
+
+	if (tx_desc->flags & DP_TX_DESC_FLAG_SPECIAL)
+		dp_tx_spcl_desc_free(soc, tx_desc, desc_pool_id);
+	else
+		dp_tx_desc_free_batch_add(soc, batch, tx_desc, desc_pool_id);
+}
+
 /**
  * dp_tx_prepare_htt_metadata() - Prepare HTT metadata for special frames
  * @vdev: DP vdev Handle
@@ -1610,6 +1656,7 @@ dp_tx_attempt_coalescing(struct dp_soc *soc, struct dp_vdev *vdev,
 		return msdu_info->skip_hp_update;
 
 	tcl_data.nbuf = tx_desc->nbuf;
+	tcl_data.tx_desc = tx_desc;
 	tcl_data.tid = tid;
 	tcl_data.ring_id = ring_id;
 	tcl_data.pkt_len = dp_tx_get_pkt_len(tx_desc);
@@ -3850,24 +3897,17 @@ static inline bool dp_tx_mcast_drop(struct dp_vdev *vdev, qdf_nbuf_t nbuf)
 static inline QDF_STATUS
 dp_tx_per_pkt_vdev_id_check(qdf_nbuf_t nbuf, struct dp_vdev *vdev)
 {
-	struct dp_ast_entry *dst_ast_entry = NULL;
 	qdf_ether_header_t *eh = (qdf_ether_header_t *)qdf_nbuf_data(nbuf);
 
 	if (DP_FRAME_IS_MULTICAST((eh)->ether_dhost) ||
 	    DP_FRAME_IS_BROADCAST((eh)->ether_dhost))
 		return QDF_STATUS_SUCCESS;
 
-	qdf_spin_lock_bh(&vdev->pdev->soc->ast_lock);
-	dst_ast_entry = dp_peer_ast_hash_find_by_vdevid(vdev->pdev->soc,
-							eh->ether_dhost,
-							vdev->vdev_id);
-
 	/* If there is no ast entry, return failure */
-	if (qdf_unlikely(!dst_ast_entry)) {
-		qdf_spin_unlock_bh(&vdev->pdev->soc->ast_lock);
+	if (qdf_unlikely(!dp_peer_ast_hash_exist_by_vdevid_rcu(vdev->pdev->soc,
+							       eh->ether_dhost,
+							       vdev->vdev_id)))
 		return QDF_STATUS_E_FAILURE;
-	}
-	qdf_spin_unlock_bh(&vdev->pdev->soc->ast_lock);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -6469,10 +6509,12 @@ dp_tx_comp_process_desc_list(struct dp_soc *soc,
 	uint16_t peer_id = DP_INVALID_PEER;
 	dp_txrx_ref_handle txrx_ref_handle = NULL;
 	qdf_nbuf_queue_head_t h;
+	struct dp_tx_desc_free_batch free_batch;
 
 	desc = comp_head;
 
 	dp_tx_nbuf_queue_head_init(&h);
+	dp_tx_desc_free_batch_init(&free_batch);
 
 	while (desc) {
 		next = desc->next;
@@ -6536,7 +6578,8 @@ dp_tx_comp_process_desc_list(struct dp_soc *soc,
 					       desc->id, DP_TX_COMP_UNMAP);
 			dp_tx_nbuf_unmap(soc, desc);
 			dp_tx_nbuf_dev_queue_free(&h, desc);
-			dp_tx_desc_free(soc, desc, desc->pool_id);
+			dp_tx_desc_free_batch_add(soc, &free_batch, desc,
+						  desc->pool_id);
 			desc = next;
 			continue;
 		}
@@ -6548,9 +6591,11 @@ dp_tx_comp_process_desc_list(struct dp_soc *soc,
 
 		dp_tx_comp_process_desc(soc, desc, &ts, txrx_peer);
 
-		dp_tx_desc_release(soc, desc, desc->pool_id);
+		dp_tx_desc_release_batched(soc, desc, desc->pool_id,
+					   &free_batch);
 		desc = next;
 	}
+	dp_tx_desc_free_batch_flush(soc, &free_batch);
 	dp_tx_nbuf_dev_kfree_list(&h);
 	if (txrx_peer)
 		dp_txrx_peer_unref_delete(txrx_ref_handle, DP_MOD_ID_TX_COMP);
@@ -6953,6 +6998,10 @@ add_to_pool:
 			DP_HIST_PACKET_COUNT_INC(tx_desc->pdev->pdev_id);
 
 add_to_pool2:
+			if (qdf_unlikely(tx_desc->flags &
+					 DP_TX_DESC_FLAG_SWLM_SAMPLE))
+				dp_swlm_tx_comp_sample(soc, tx_desc);
+
 			/* First ring descriptor on the cycle */
 
 			if (tx_desc->flags & DP_TX_DESC_FLAG_FASTPATH_SIMPLE ||
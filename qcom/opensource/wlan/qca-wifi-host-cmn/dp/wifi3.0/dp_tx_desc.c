@@ -64,6 +64,68 @@ dp_tx_desc_pool_counter_initialize(struct dp_tx_desc_pool_s *tx_desc_pool,
 }
 #endif
 
+#ifdef DP_TX_DESC_PCPU_CACHE
+/**
+ * dp_tx_desc_pcpu_cache_init() - Set up the per-CPU caches of a Tx desc pool
+ * @tx_desc_pool: Handle to DP tx_desc_pool structure
+ * @num_elem: Number of descriptor elements in the pool
+ * @spcl_tx_desc: special descriptor pool, never cached
+ *
+ * Return: None
+ */
+static void
+dp_tx_desc_pcpu_cache_init(struct dp_tx_desc_pool_s *tx_desc_pool,
+			   uint32_t num_elem, bool spcl_tx_desc)
+{
+	uint32_t limit;
+
+	tx_desc_pool->pcpu_cache = NULL;
+	if (spcl_tx_desc)
+		return;
+
+	limit = num_elem /
+		(DP_TX_DESC_PCPU_CACHE_SHARE * QDF_MAX_AVAILABLE_CPU);
+	limit = qdf_min(limit, (uint32_t)DP_TX_DESC_PCPU_CACHE_SIZE);
+	if (limit < 2)
+		return;
+
+	tx_desc_pool->pcpu_cache =
+		qdf_mem_malloc(QDF_MAX_AVAILABLE_CPU *
+			       sizeof(*tx_desc_pool->pcpu_cache));
+	if (!tx_desc_pool->pcpu_cache)
+		return;
+
+	tx_desc_pool->pcpu_limit = limit;
+	tx_desc_pool->pcpu_batch = limit / 2;
+}
+
+/**
+ * dp_tx_desc_pcpu_cache_deinit() - Drop the per-CPU caches of a Tx desc pool
+ * @tx_desc_pool: Handle to DP tx_desc_pool structure
+ *
+ * The cached descriptors live in the pool pages, nothing to return.
+ *
+ * Return: None
+ */
+static void
+dp_tx_desc_pcpu_cache_deinit(struct dp_tx_desc_pool_s *tx_desc_pool)
+{
+	qdf_mem_free(tx_desc_pool->pcpu_cache);
+	tx_desc_pool->pcpu_cache = NULL;
+}
+#else
+static inline void
+dp_tx_desc_pcpu_cache_init(struct dp_tx_desc_pool_s *tx_desc_pool,
+			   uint32_t num_elem, bool spcl_tx_desc)
+{
+}
+
+static inline void
+dp_tx_desc_pcpu_cache_deinit(struct dp_tx_desc_pool_s *tx_desc_pool)
+{
+}
+#endif /* DP_TX_DESC_PCPU_CACHE */
+
 #ifdef DP_UMAC_HW_RESET_SUPPORT
 /**
  * dp_tx_desc_clean_up() - Clean up the tx descriptors
@@ -285,6 +347,9 @@ QDF_STATUS dp_tx_desc_pool_init(struct dp_soc *soc, uint8_t pool_id,
 	tx_desc_pool->elem_size = DP_TX_DESC_SIZE(sizeof(struct dp_tx_desc_s));
 
 	dp_tx_desc_pool_counter_initialize(tx_desc_pool, num_elem_t);
+	tx_desc_pool->lock_acquired = 0;
+	tx_desc_pool->lock_desc_ops = 0;
+	dp_tx_desc_pcpu_cache_init(tx_desc_pool, num_elem_t, spcl_tx_desc);
 	TX_DESC_LOCK_CREATE(&tx_desc_pool->lock);
 
 	return QDF_STATUS_SUCCESS;
@@ -301,6 +366,7 @@ void dp_tx_desc_pool_deinit(struct dp_soc *soc, uint8_t pool_id,
 		tx_desc_pool = dp_get_tx_desc_pool(soc, pool_id);
 	soc->arch_ops.dp_tx_desc_pool_deinit(soc, tx_desc_pool,
 					     pool_id, spcl_tx_desc);
+	dp_tx_desc_pcpu_cache_deinit(tx_desc_pool);
 	TX_DESC_POOL_MEMBER_CLEAN(tx_desc_pool);
 	TX_DESC_LOCK_DESTROY(&tx_desc_pool->lock);
 }
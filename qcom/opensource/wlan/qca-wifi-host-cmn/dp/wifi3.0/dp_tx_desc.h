@@ -99,6 +99,14 @@ do {                                                   \
 #endif /* !QCA_LL_TX_FLOW_CONTROL_V2 */
 #define MAX_POOL_BUFF_COUNT 10000
 
+/*
+ * Per-CPU Tx descriptor cache: a CPU may hold at most
+ * elem_count / (DP_TX_DESC_PCPU_CACHE_SHARE * CPUs) descriptors, capped to
+ * DP_TX_DESC_PCPU_CACHE_SIZE; pools too small for that bypass the cache.
+ */
+#define DP_TX_DESC_PCPU_CACHE_SIZE 64
+#define DP_TX_DESC_PCPU_CACHE_SHARE 2
+
 #ifdef DP_TX_TRACKING
 static inline void dp_tx_desc_set_magic(struct dp_tx_desc_s *tx_desc,
 					uint32_t magic_pattern)
@@ -464,6 +472,21 @@ dp_tx_desc_clear(struct dp_tx_desc_s *tx_desc)
 	tx_desc->next = NULL;
 }
 
+/**
+ * dp_tx_desc_pool_lock_stats_inc() - account one acquisition of the pool lock
+ * @pool: Tx descriptor pool, lock held by the caller
+ * @num_desc: Number of descriptors allocated or freed under this acquisition
+ *
+ * Return: none
+ */
+static inline void
+dp_tx_desc_pool_lock_stats_inc(struct dp_tx_desc_pool_s *pool,
+			       uint32_t num_desc)
+{
+	pool->lock_acquired++;
+	pool->lock_desc_ops += num_desc;
+}
+
 #ifdef QCA_LL_TX_FLOW_CONTROL_V2
 void dp_tx_flow_control_init(struct dp_soc *);
 void dp_tx_flow_control_deinit(struct dp_soc *);
@@ -645,6 +668,7 @@ dp_tx_desc_alloc(struct dp_soc *soc, uint8_t desc_pool_id)
 		if (qdf_likely(pool->avail_desc &&
 		    pool->status != FLOW_POOL_INVALID &&
 		    pool->status != FLOW_POOL_INACTIVE)) {
+			dp_tx_desc_pool_lock_stats_inc(pool, 1);
 			tx_desc = dp_tx_get_desc_flow_pool(pool);
 			tx_desc->pool_id = desc_pool_id;
 			tx_desc->flags = DP_TX_DESC_FLAG_ALLOCATED;
@@ -719,28 +743,21 @@ dp_tx_desc_alloc(struct dp_soc *soc, uint8_t desc_pool_id)
 }
 
 /**
- * dp_tx_desc_free() - Free a tx descriptor and attach it to free list
+ * dp_tx_flow_pool_resume_queue() - resume the next paused netif queue if the
+ *				    pool has enough free descriptors
  * @soc: Handle to DP SoC structure
- * @tx_desc: the tx descriptor to be freed
- * @desc_pool_id: ID of the flow control pool
+ * @pool: flow pool, flow_pool_lock held by the caller
  *
- * Return: None
+ * Return: true if the pool moved up one pause level
  */
-static inline void
-dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
-		uint8_t desc_pool_id)
+static inline bool
+dp_tx_flow_pool_resume_queue(struct dp_soc *soc,
+			     struct dp_tx_desc_pool_s *pool)
 {
-	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
 	qdf_time_t unpause_time = qdf_get_system_timestamp(), pause_dur;
 	enum netif_action_type act = WLAN_WAKE_ALL_NETIF_QUEUE;
 	enum netif_reason_type reason;
 
-	qdf_spin_lock_bh(&pool->flow_pool_lock);
-	tx_desc->vdev_id = DP_INVALID_VDEV_ID;
-	tx_desc->nbuf = NULL;
-	tx_desc->flags = 0;
-	dp_tx_desc_set_magic(tx_desc, DP_TX_MAGIC_PATTERN_FREE);
-	dp_tx_put_desc_flow_pool(pool, tx_desc);
 	switch (pool->status) {
 	case FLOW_POOL_ACTIVE_PAUSED:
 		if (pool->avail_desc > pool->start_th[DP_TH_HI]) {
@@ -794,13 +811,49 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 				pool->max_pause_time[DP_TH_BE_BK] = pause_dur;
 		}
 		break;
+	default:
+		break;
+	}
+
+	if (act == WLAN_WAKE_ALL_NETIF_QUEUE)
+		return false;
+
+	soc->pause_cb(pool->flow_pool_id, act, reason);
+	return true;
+}
+
+/**
+ * dp_tx_flow_pool_update_on_free() - update flow pool state after descriptors
+ *				      were returned to it
+ * @soc: Handle to DP SoC structure
+ * @pool: flow pool, flow_pool_lock held by the caller
+ * @desc_pool_id: ID of the flow control pool
+ *
+ * A burst of frees may cross several start thresholds at once, so the
+ * paused queues are resumed level by level until the pool state is stable.
+ *
+ * Return: true if the pool was freed and flow_pool_lock released
+ */
+static inline bool
+dp_tx_flow_pool_update_on_free(struct dp_soc *soc,
+			       struct dp_tx_desc_pool_s *pool,
+			       uint8_t desc_pool_id)
+{
+	switch (pool->status) {
+	case FLOW_POOL_ACTIVE_PAUSED:
+	case FLOW_POOL_VO_PAUSED:
+	case FLOW_POOL_VI_PAUSED:
+	case FLOW_POOL_BE_BK_PAUSED:
+		while (dp_tx_flow_pool_resume_queue(soc, pool))
+			;
+		break;
 	case FLOW_POOL_INVALID:
 		if (pool->avail_desc == pool->pool_size) {
 			dp_tx_desc_pool_deinit(soc, desc_pool_id, false);
 			dp_tx_desc_pool_free(soc, desc_pool_id, false);
 			qdf_spin_unlock_bh(&pool->flow_pool_lock);
 			dp_err_rl("pool %d is freed!!", desc_pool_id);
-			return;
+			return true;
 		}
 		break;
 
@@ -815,9 +868,33 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 		break;
 	};
 
-	if (act != WLAN_WAKE_ALL_NETIF_QUEUE)
-		soc->pause_cb(pool->flow_pool_id,
-			      act, reason);
+	return false;
+}
+
+/**
+ * dp_tx_desc_free() - Free a tx descriptor and attach it to free list
+ * @soc: Handle to DP SoC structure
+ * @tx_desc: the tx descriptor to be freed
+ * @desc_pool_id: ID of the flow control pool
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
+		uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+
+	qdf_spin_lock_bh(&pool->flow_pool_lock);
+	dp_tx_desc_pool_lock_stats_inc(pool, 1);
+	tx_desc->vdev_id = DP_INVALID_VDEV_ID;
+	tx_desc->nbuf = NULL;
+	tx_desc->flags = 0;
+	dp_tx_desc_set_magic(tx_desc, DP_TX_MAGIC_PATTERN_FREE);
+	dp_tx_put_desc_flow_pool(pool, tx_desc);
+	if (dp_tx_flow_pool_update_on_free(soc, pool, desc_pool_id))
+		return;
+
 	qdf_spin_unlock_bh(&pool->flow_pool_lock);
 }
 
@@ -860,6 +937,7 @@ dp_tx_desc_alloc(struct dp_soc *soc, uint8_t desc_pool_id)
 		qdf_spin_lock_bh(&pool->flow_pool_lock);
 		if (pool->status <= FLOW_POOL_ACTIVE_PAUSED &&
 		    pool->avail_desc) {
+			dp_tx_desc_pool_lock_stats_inc(pool, 1);
 			tx_desc = dp_tx_get_desc_flow_pool(pool);
 			tx_desc->pool_id = desc_pool_id;
 			tx_desc->flags = DP_TX_DESC_FLAG_ALLOCATED;
@@ -892,25 +970,19 @@ static inline struct dp_tx_desc_s *dp_tx_spcl_desc_alloc(struct dp_soc *soc,
 	return NULL;
 }
 /**
- * dp_tx_desc_free() - Free a tx descriptor and attach it to free list
+ * dp_tx_flow_pool_update_on_free() - update flow pool state after descriptors
+ *				      were returned to it
  * @soc: Handle to DP SoC structure
- * @tx_desc: Descriptor to free
+ * @pool: flow pool, flow_pool_lock held by the caller
  * @desc_pool_id: Descriptor pool Id
  *
- * Return: None
+ * Return: true if the pool was freed and flow_pool_lock released
  */
-static inline void
-dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
-		uint8_t desc_pool_id)
+static inline bool
+dp_tx_flow_pool_update_on_free(struct dp_soc *soc,
+			       struct dp_tx_desc_pool_s *pool,
+			       uint8_t desc_pool_id)
 {
-	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
-
-	qdf_spin_lock_bh(&pool->flow_pool_lock);
-	tx_desc->vdev_id = DP_INVALID_VDEV_ID;
-	tx_desc->nbuf = NULL;
-	tx_desc->flags = 0;
-	dp_tx_desc_set_magic(tx_desc, DP_TX_MAGIC_PATTERN_FREE);
-	dp_tx_put_desc_flow_pool(pool, tx_desc);
 	switch (pool->status) {
 	case FLOW_POOL_ACTIVE_PAUSED:
 		if (pool->avail_desc > pool->start_th) {
@@ -927,7 +999,7 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 			qdf_spin_unlock_bh(&pool->flow_pool_lock);
 			qdf_print("%s %d pool is freed!!",
 				  __func__, __LINE__);
-			return;
+			return true;
 		}
 		break;
 
@@ -939,6 +1011,33 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 		break;
 	};
 
+	return false;
+}
+
+/**
+ * dp_tx_desc_free() - Free a tx descriptor and attach it to free list
+ * @soc: Handle to DP SoC structure
+ * @tx_desc: Descriptor to free
+ * @desc_pool_id: Descriptor pool Id
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
+		uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+
+	qdf_spin_lock_bh(&pool->flow_pool_lock);
+	dp_tx_desc_pool_lock_stats_inc(pool, 1);
+	tx_desc->vdev_id = DP_INVALID_VDEV_ID;
+	tx_desc->nbuf = NULL;
+	tx_desc->flags = 0;
+	dp_tx_desc_set_magic(tx_desc, DP_TX_MAGIC_PATTERN_FREE);
+	dp_tx_put_desc_flow_pool(pool, tx_desc);
+	if (dp_tx_flow_pool_update_on_free(soc, pool, desc_pool_id))
+		return;
+
 	qdf_spin_unlock_bh(&pool->flow_pool_lock);
 }
 
@@ -949,6 +1048,38 @@ dp_tx_spcl_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 }
 #endif /* QCA_AC_BASED_FLOW_CONTROL */
 
+/**
+ * dp_tx_desc_free_bulk() - Return a chain of tx descriptors to the free list
+ * @soc: Handle to DP SoC structure
+ * @head_desc: First descriptor of the chain
+ * @tail_desc: Last descriptor of the chain
+ * @num_desc: Number of descriptors in the chain
+ * @desc_pool_id: ID of the flow control pool
+ *
+ * The descriptors must already be cleared, see dp_tx_desc_free_batch_add().
+ * flow_pool_lock is taken once for the whole chain and the pause state is
+ * re-evaluated once for the burst.
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_free_bulk(struct dp_soc *soc, struct dp_tx_desc_s *head_desc,
+		     struct dp_tx_desc_s *tail_desc, uint32_t num_desc,
+		     uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+
+	qdf_spin_lock_bh(&pool->flow_pool_lock);
+	dp_tx_desc_pool_lock_stats_inc(pool, num_desc);
+	tail_desc->next = pool->freelist;
+	pool->freelist = head_desc;
+	pool->avail_desc += num_desc;
+	if (dp_tx_flow_pool_update_on_free(soc, pool, desc_pool_id))
+		return;
+
+	qdf_spin_unlock_bh(&pool->flow_pool_lock);
+}
+
 static inline bool
 dp_tx_desc_thresh_reached(struct cdp_soc_t *soc_hdl, uint8_t vdev_id)
 {
@@ -1003,6 +1134,214 @@ void dp_tx_prefetch_desc(struct dp_tx_desc_s *tx_desc)
 }
 #endif
 
+/**
+ * dp_tx_desc_pool_take() - Detach a chain of descriptors from the freelist
+ * @pool: Tx descriptor pool, lock held by the caller
+ * @num_requested: Maximum number of descriptors to detach
+ * @num_taken: Number of descriptors detached
+ *
+ * Return: NULL terminated chain of descriptors or NULL if pool is exhausted
+ */
+static inline struct dp_tx_desc_s *
+dp_tx_desc_pool_take(struct dp_tx_desc_pool_s *pool, uint32_t num_requested,
+		     uint32_t *num_taken)
+{
+	struct dp_tx_desc_s *head_desc = pool->freelist;
+	struct dp_tx_desc_s *tail_desc = NULL;
+	struct dp_tx_desc_s *tx_desc = head_desc;
+	uint32_t count = 0;
+
+	while (tx_desc && count < num_requested) {
+		tail_desc = tx_desc;
+		tx_desc = tx_desc->next;
+		count++;
+	}
+
+	*num_taken = count;
+	if (!count)
+		return NULL;
+
+	tail_desc->next = NULL;
+	pool->freelist = tx_desc;
+	pool->num_allocated += count;
+	pool->num_free -= count;
+	dp_tx_desc_pool_lock_stats_inc(pool, count);
+
+	return head_desc;
+}
+
+/**
+ * dp_tx_desc_free_list() - Return a chain of descriptors to the freelist
+ * @pool: Tx descriptor pool
+ * @head_desc: First descriptor of the chain
+ * @tail_desc: Last descriptor of the chain
+ * @fast_desc_count: Number of descriptors in the chain
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_free_list(struct dp_tx_desc_pool_s *pool,
+		     struct dp_tx_desc_s *head_desc,
+		     struct dp_tx_desc_s *tail_desc,
+		     uint32_t fast_desc_count)
+{
+	TX_DESC_LOCK_LOCK(&pool->lock);
+	dp_tx_desc_pool_lock_stats_inc(pool, fast_desc_count);
+	pool->num_allocated -= fast_desc_count;
+	pool->num_free += fast_desc_count;
+	tail_desc->next = pool->freelist;
+	pool->freelist = head_desc;
+	TX_DESC_LOCK_UNLOCK(&pool->lock);
+}
+
+#ifdef DP_TX_DESC_PCPU_CACHE
+/**
+ * dp_tx_desc_pcpu_cache_alloc() - Allocate a descriptor from the per-CPU cache
+ * @pool: Tx descriptor pool
+ * @tx_desc: allocated descriptor, NULL if the pool is exhausted
+ *
+ * An empty cache is refilled with pcpu_batch descriptors under a single
+ * acquisition of the pool lock.
+ *
+ * Return: true if the pool has per-CPU caches and served the request
+ */
+static inline bool
+dp_tx_desc_pcpu_cache_alloc(struct dp_tx_desc_pool_s *pool,
+			    struct dp_tx_desc_s **tx_desc)
+{
+	struct dp_tx_desc_pcpu_cache *cache;
+	uint32_t num_taken;
+
+	if (!pool->pcpu_cache)
+		return false;
+
+	qdf_local_bh_disable();
+	cache = &pool->pcpu_cache[qdf_get_cpu()];
+	if (qdf_likely(cache->count)) {
+		cache->hit++;
+	} else {
+		TX_DESC_LOCK_LOCK(&pool->lock);
+		cache->freelist = dp_tx_desc_pool_take(pool, pool->pcpu_batch,
+						       &num_taken);
+		dp_tx_prefetch_desc(pool->freelist);
+		TX_DESC_LOCK_UNLOCK(&pool->lock);
+
+		cache->count = num_taken;
+		if (qdf_unlikely(!num_taken)) {
+			qdf_local_bh_enable();
+			*tx_desc = NULL;
+			return true;
+		}
+		cache->refill++;
+	}
+
+	*tx_desc = cache->freelist;
+	cache->freelist = (*tx_desc)->next;
+	cache->count--;
+	qdf_local_bh_enable();
+
+	return true;
+}
+
+/**
+ * dp_tx_desc_pcpu_cache_free() - Free a descriptor to the per-CPU cache
+ * @pool: Tx descriptor pool
+ * @tx_desc: cleared descriptor to free
+ *
+ * A full cache returns pcpu_batch descriptors to the pool freelist under a
+ * single acquisition of the pool lock.
+ *
+ * Return: true if the pool has per-CPU caches and took the descriptor
+ */
+static inline bool
+dp_tx_desc_pcpu_cache_free(struct dp_tx_desc_pool_s *pool,
+			   struct dp_tx_desc_s *tx_desc)
+{
+	struct dp_tx_desc_pcpu_cache *cache;
+	struct dp_tx_desc_s *head_desc, *tail_desc;
+	uint16_t i;
+
+	if (!pool->pcpu_cache)
+		return false;
+
+	qdf_local_bh_disable();
+	cache = &pool->pcpu_cache[qdf_get_cpu()];
+	if (qdf_unlikely(cache->count >= pool->pcpu_limit)) {
+		head_desc = cache->freelist;
+		tail_desc = head_desc;
+		for (i = 1; i < pool->pcpu_batch; i++)
+			tail_desc = tail_desc->next;
+
+		cache->freelist = tail_desc->next;
+		cache->count -= pool->pcpu_batch;
+		cache->drain++;
+		dp_tx_desc_free_list(pool, head_desc, tail_desc,
+				     pool->pcpu_batch);
+	}
+
+	tx_desc->next = cache->freelist;
+	cache->freelist = tx_desc;
+	cache->count++;
+	qdf_local_bh_enable();
+
+	return true;
+}
+
+/**
+ * dp_tx_desc_pcpu_cache_drain() - Return the local per-CPU cache to the pool
+ * @pool: Tx descriptor pool
+ *
+ * Used before allocations which need a contiguous count of free
+ * descriptors from the pool freelist. Caches of other CPUs can only be
+ * touched by their owner and stay parked; together they hold at most
+ * 1/DP_TX_DESC_PCPU_CACHE_SHARE of the pool.
+ *
+ * Return: None
+ */
+static inline void dp_tx_desc_pcpu_cache_drain(struct dp_tx_desc_pool_s *pool)
+{
+	struct dp_tx_desc_pcpu_cache *cache;
+	struct dp_tx_desc_s *tail_desc;
+	uint32_t count;
+
+	if (!pool->pcpu_cache)
+		return;
+
+	qdf_local_bh_disable();
+	cache = &pool->pcpu_cache[qdf_get_cpu()];
+	count = cache->count;
+	if (count) {
+		tail_desc = cache->freelist;
+		while (tail_desc->next)
+			tail_desc = tail_desc->next;
+
+		dp_tx_desc_free_list(pool, cache->freelist, tail_desc, count);
+		cache->freelist = NULL;
+		cache->count = 0;
+		cache->drain++;
+	}
+	qdf_local_bh_enable();
+}
+#else
+static inline bool
+dp_tx_desc_pcpu_cache_alloc(struct dp_tx_desc_pool_s *pool,
+			    struct dp_tx_desc_s **tx_desc)
+{
+	return false;
+}
+
+static inline bool
+dp_tx_desc_pcpu_cache_free(struct dp_tx_desc_pool_s *pool,
+			   struct dp_tx_desc_s *tx_desc)
+{
+	return false;
+}
+
+static inline void dp_tx_desc_pcpu_cache_drain(struct dp_tx_desc_pool_s *pool)
+{
+}
+#endif /* DP_TX_DESC_PCPU_CACHE */
+
 /**
  * dp_tx_desc_alloc() - Allocate a Software Tx Descriptor from given pool
  * @soc: Handle to DP SoC structure
@@ -1018,6 +1357,13 @@ static inline struct dp_tx_desc_s *dp_tx_desc_alloc(struct dp_soc *soc,
 
 	pool = dp_get_tx_desc_pool(soc, desc_pool_id);
 
+	if (dp_tx_desc_pcpu_cache_alloc(pool, &tx_desc)) {
+		if (qdf_likely(tx_desc))
+			tx_desc->flags = DP_TX_DESC_FLAG_ALLOCATED;
+
+		return tx_desc;
+	}
+
 	TX_DESC_LOCK_LOCK(&pool->lock);
 
 	tx_desc = pool->freelist;
@@ -1031,6 +1377,7 @@ static inline struct dp_tx_desc_s *dp_tx_desc_alloc(struct dp_soc *soc,
 	pool->freelist = pool->freelist->next;
 	pool->num_allocated++;
 	pool->num_free--;
+	dp_tx_desc_pool_lock_stats_inc(pool, 1);
 	dp_tx_prefetch_desc(pool->freelist);
 
 	tx_desc->flags = DP_TX_DESC_FLAG_ALLOCATED;
@@ -1061,6 +1408,7 @@ static inline struct dp_tx_desc_s *dp_tx_spcl_desc_alloc(struct dp_soc *soc,
 	pool->freelist = pool->freelist->next;
 	pool->num_allocated++;
 	pool->num_free--;
+	dp_tx_desc_pool_lock_stats_inc(pool, 1);
 	dp_tx_prefetch_desc(pool->freelist);
 
 	tx_desc->flags = DP_TX_DESC_FLAG_ALLOCATED;
@@ -1078,7 +1426,9 @@ static inline struct dp_tx_desc_s *dp_tx_spcl_desc_alloc(struct dp_soc *soc,
  * @desc_pool_id: pool id should pick up
  * @num_requested: number of required descriptor
  *
- * allocate multiple tx descriptor and make a link
+ * allocate multiple tx descriptor and make a link. Descriptors parked in
+ * the local per-CPU cache count as allocated, return them to the pool
+ * first so that they are available to the num_free check.
  *
  * Return: first descriptor pointer or NULL
  */
@@ -1091,6 +1441,8 @@ static inline struct dp_tx_desc_s *dp_tx_desc_alloc_multiple(
 
 	pool = dp_get_tx_desc_pool(soc, desc_pool_id);
 
+	dp_tx_desc_pcpu_cache_drain(pool);
+
 	TX_DESC_LOCK_LOCK(&pool->lock);
 
 	if ((num_requested == 0) ||
@@ -1117,6 +1469,7 @@ static inline struct dp_tx_desc_s *dp_tx_desc_alloc_multiple(
 	pool->num_allocated += count;
 	pool->freelist = c_desc->next;
 	c_desc->next = NULL;
+	dp_tx_desc_pool_lock_stats_inc(pool, count);
 
 	TX_DESC_LOCK_UNLOCK(&pool->lock);
 	return h_desc;
@@ -1136,7 +1489,11 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 
 	dp_tx_desc_clear(tx_desc);
 	pool = dp_get_tx_desc_pool(soc, desc_pool_id);
+	if (dp_tx_desc_pcpu_cache_free(pool, tx_desc))
+		return;
+
 	TX_DESC_LOCK_LOCK(&pool->lock);
+	dp_tx_desc_pool_lock_stats_inc(pool, 1);
 	tx_desc->next = pool->freelist;
 	pool->freelist = tx_desc;
 	pool->num_allocated--;
@@ -1154,6 +1511,7 @@ dp_tx_spcl_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 
 	pool = dp_get_spcl_tx_desc_pool(soc, desc_pool_id);
 	TX_DESC_LOCK_LOCK(&pool->lock);
+	dp_tx_desc_pool_lock_stats_inc(pool, 1);
 	tx_desc->next = pool->freelist;
 	pool->freelist = tx_desc;
 	pool->num_allocated--;
@@ -1161,22 +1519,109 @@ dp_tx_spcl_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 	TX_DESC_LOCK_UNLOCK(&pool->lock);
 }
 
+/**
+ * dp_tx_desc_free_bulk() - Return a chain of tx descriptors to the free list
+ * @soc: Handle to DP SoC structure
+ * @head_desc: First descriptor of the chain
+ * @tail_desc: Last descriptor of the chain
+ * @num_desc: Number of descriptors in the chain
+ * @desc_pool_id: ID of the free pool
+ *
+ * The descriptors must already be cleared, see dp_tx_desc_free_batch_add().
+ *
+ * Return: None
+ */
 static inline void
-dp_tx_desc_free_list(struct dp_tx_desc_pool_s *pool,
-		     struct dp_tx_desc_s *head_desc,
-		     struct dp_tx_desc_s *tail_desc,
-		     uint32_t fast_desc_count)
+dp_tx_desc_free_bulk(struct dp_soc *soc, struct dp_tx_desc_s *head_desc,
+		     struct dp_tx_desc_s *tail_desc, uint32_t num_desc,
+		     uint8_t desc_pool_id)
 {
-	TX_DESC_LOCK_LOCK(&pool->lock);
-	pool->num_allocated -= fast_desc_count;
-	pool->num_free += fast_desc_count;
-	tail_desc->next = pool->freelist;
-	pool->freelist = head_desc;
-	TX_DESC_LOCK_UNLOCK(&pool->lock);
-}
+	struct dp_tx_desc_pool_s *pool = dp_get_tx_desc_pool(soc, desc_pool_id);
 
+	dp_tx_desc_free_list(pool, head_desc, tail_desc, num_desc);
+}
 #endif /* QCA_LL_TX_FLOW_CONTROL_V2 */
 
+/**
+ * struct dp_tx_desc_free_batch - Tx descriptors collected for a bulk free
+ * @head: First descriptor of the chain
+ * @tail: Last descriptor of the chain
+ * @count: Number of descriptors in the chain
+ * @pool_id: Pool all descriptors of the chain belong to
+ */
+struct dp_tx_desc_free_batch {
+	struct dp_tx_desc_s *head;
+	struct dp_tx_desc_s *tail;
+	uint32_t count;
+	uint8_t pool_id;
+};
+
+/**
+ * dp_tx_desc_free_batch_init() - Initialize an empty free batch
+ * @batch: free batch
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_free_batch_init(struct dp_tx_desc_free_batch *batch)
+{
+	batch->head = NULL;
+	batch->tail = NULL;
+	batch->count = 0;
+	batch->pool_id = 0;
+}
+
+/**
+ * dp_tx_desc_free_batch_flush() - Return all batched descriptors to their pool
+ * @soc: Handle to DP SoC structure
+ * @batch: free batch
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_free_batch_flush(struct dp_soc *soc,
+			    struct dp_tx_desc_free_batch *batch)
+{
+	if (!batch->count)
+		return;
+
+	dp_tx_desc_free_bulk(soc, batch->head, batch->tail, batch->count,
+			     batch->pool_id);
+	dp_tx_desc_free_batch_init(batch);
+}
+
+/**
+ * dp_tx_desc_free_batch_add() - Queue a descriptor for a bulk free
+ * @soc: Handle to DP SoC structure
+ * @batch: free batch
+ * @tx_desc: descriptor to free, must not be a special descriptor
+ * @desc_pool_id: ID of the pool @tx_desc belongs to
+ *
+ * The batch is flushed when a descriptor of another pool is added, callers
+ * flush it once at the end of their burst.
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_free_batch_add(struct dp_soc *soc,
+			  struct dp_tx_desc_free_batch *batch,
+			  struct dp_tx_desc_s *tx_desc, uint8_t desc_pool_id)
+{
+	if (batch->count && batch->pool_id != desc_pool_id)
+		dp_tx_desc_free_batch_flush(soc, batch);
+
+	dp_tx_desc_clear(tx_desc);
+	dp_tx_desc_set_magic(tx_desc, DP_TX_MAGIC_PATTERN_FREE);
+
+	if (!batch->count) {
+		batch->tail = tx_desc;
+		batch->pool_id = desc_pool_id;
+	}
+	tx_desc->next = batch->head;
+	batch->head = tx_desc;
+	batch->count++;
+}
+
 #ifdef QCA_DP_TX_DESC_ID_CHECK
 /**
  * dp_tx_is_desc_id_valid() - check is the tx desc id valid
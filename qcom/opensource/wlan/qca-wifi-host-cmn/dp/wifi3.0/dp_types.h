@@ -27,6 +27,7 @@
 #include <qdf_util.h>
 #include <qdf_list.h>
 #include <qdf_lro.h>
+#include <qdf_rcu.h>
 #include <queue.h>
 #include <htt_common.h>
 #include <htt.h>
@@ -797,6 +798,34 @@ struct dp_tx_tso_num_seg_pool_s {
 	qdf_spinlock_t lock;
 };
 
+/*
+ * Descriptors parked in per-CPU caches are invisible to the flow pool
+ * pause/resume thresholds, so the caches are only used without flow control.
+ */
+#if defined(QCA_LL_TX_FLOW_CONTROL_V2) && defined(DP_TX_DESC_PCPU_CACHE)
+#undef DP_TX_DESC_PCPU_CACHE
+#endif
+
+#ifdef DP_TX_DESC_PCPU_CACHE
+/**
+ * struct dp_tx_desc_pcpu_cache - per-CPU front cache of a Tx desc pool
+ * @freelist: Chain of cached free descriptors
+ * @count: Number of descriptors in @freelist
+ * @hit: Allocations served from this cache
+ * @refill: Batches moved from the pool freelist into this cache
+ * @drain: Batches returned from this cache to the pool freelist
+ *
+ * Only accessed by the owning CPU with bottom halves disabled.
+ */
+struct dp_tx_desc_pcpu_cache {
+	struct dp_tx_desc_s *freelist;
+	uint32_t count;
+	uint32_t hit;
+	uint32_t refill;
+	uint32_t drain;
+};
+#endif
+
 /**
  * struct dp_tx_desc_pool_s - Tx Descriptor pool information
  * @elem_size: Size of each descriptor in the pool
@@ -820,6 +849,14 @@ struct dp_tx_tso_num_seg_pool_s {
  * @elem_count:
  * @num_free: Number of free descriptors
  * @lock: Lock for descriptor allocation/free from/to the pool
+ * @pcpu_cache: Per-CPU front caches, NULL if the pool bypasses them
+ * @pcpu_limit: Number of descriptors a per-CPU cache may hold
+ * @pcpu_batch: Number of descriptors moved between a per-CPU cache and
+ *		the pool freelist
+ * @lock_acquired: Number of times the pool lock was taken to allocate or
+ *		   free descriptors
+ * @lock_desc_ops: Number of descriptors allocated or freed under those
+ *		   lock acquisitions
  */
 struct dp_tx_desc_pool_s {
 	uint16_t elem_size;
@@ -850,7 +887,14 @@ struct dp_tx_desc_pool_s {
 	uint16_t elem_count;
 	uint32_t num_free;
 	qdf_spinlock_t lock;
+#ifdef DP_TX_DESC_PCPU_CACHE
+	struct dp_tx_desc_pcpu_cache *pcpu_cache;
+	uint16_t pcpu_limit;
+	uint16_t pcpu_batch;
+#endif
 #endif
+	uint64_t lock_acquired;
+	uint64_t lock_desc_ops;
 };
 
 /**
@@ -917,6 +961,10 @@ struct dp_reo_cmd_info {
 	void *data;
 	void (*handler)(struct dp_soc *, void *, union hal_reo_status *);
 	TAILQ_ENTRY(dp_reo_cmd_info) reo_cmd_list_elem;
+#ifdef WLAN_DP_REO_CMD_BATCH
+	/* status copied from the status ring, handler runs after the reap */
+	union hal_reo_status status;
+#endif
 };
 
 struct dp_peer_delay_stats {
@@ -1221,6 +1269,18 @@ struct dp_soc_stats {
 		uint32_t deleted;
 	} mec;
 
+	/* Peer hash table stats */
+	struct {
+		/* lockless lookups redone under peer_hash_lock */
+		uint32_t locked_fallback;
+		/* writers which found peer_hash_lock already held */
+		uint32_t lock_contention;
+		/* number of times the bucket array was grown */
+		uint32_t resize;
+		/* bucket array allocation failures while growing */
+		uint32_t resize_fail;
+	} peer_hash;
+
 	/* SOC level TX stats */
 	struct {
 		/* Total packets transmitted */
@@ -1282,6 +1342,10 @@ struct dp_soc_stats {
 		uint32_t rx_frag_err_no_peer;
 		/* No of reinjected packets */
 		uint32_t reo_reinject;
+#ifdef DP_RX_DEFRAG_LINEARIZE
+		/* Fragments reassembled in a linear buffer */
+		uint32_t defrag_linear;
+#endif
 		/* Reap loop packet limit hit */
 		uint32_t reap_loop_pkt_limit_hit;
 		/* Head pointer Out of sync at the end of dp_rx_process */
@@ -1432,6 +1496,29 @@ struct dp_soc_stats {
 	struct reo_cmd_event_history cmd_event_history;
 #endif /* WLAN_FEATURE_DP_EVENT_HISTORY */
 	struct htt_t2h_msg_stats t2h_msg_stats;
+#ifdef WLAN_DP_REO_CMD_BATCH
+	/* REO command batching stats */
+	struct {
+		/* outermost batches closed */
+		uint32_t batches;
+		/* commands signalled to HW by batch doorbells */
+		uint32_t cmds;
+		/* REO command ring HP updates done for batches */
+		uint32_t doorbells;
+		/* doorbells forced by the unsignalled command limit */
+		uint32_t limit_flush;
+		/* max commands signalled by one doorbell */
+		uint32_t max_per_doorbell;
+		/* max completions handled in one status ring reap */
+		uint32_t max_status_burst;
+		/* association time rx TID setup count */
+		uint32_t tid_setup_cnt;
+		/* association time rx TID setup max time in us */
+		uint32_t tid_setup_max_us;
+		/* association time rx TID setup total time in us */
+		uint64_t tid_setup_total_us;
+	} reo_cmd_batch;
+#endif
 };
 
 union dp_align_mac_addr {
@@ -1467,6 +1554,23 @@ struct dp_ast_free_cb_params {
 	uint32_t flags;
 };
 
+/*
+ * TAILQ head/entry for lists which are walked by lockless readers under
+ * qdf_rcu_read_lock(). The forward links are annotated so that every access
+ * goes through the DP_TAILQ_*_RCU/_PROTECTED ops in dp_peer.h.
+ */
+#define DP_TAILQ_HEAD_RCU(name, type)					\
+struct name {								\
+	struct type qdf_rcu *tqh_first;					\
+	struct type qdf_rcu **tqh_last;					\
+}
+
+#define DP_TAILQ_ENTRY_RCU(type)					\
+struct {								\
+	struct type qdf_rcu *tqe_next;					\
+	struct type qdf_rcu **tqe_prev;					\
+}
+
 /**
  * struct dp_ast_entry - AST entry
  *
@@ -1491,6 +1595,7 @@ struct dp_ast_free_cb_params {
  * @callback: ast free/unmap callback
  * @cookie: argument to callback
  * @hash_list_elem: node in soc AST hash list (mac address used as hash)
+ * @rcu_head: defers the free of the entry for lockless AST hash readers
  */
 struct dp_ast_entry {
 	uint16_t ast_idx;
@@ -1508,7 +1613,8 @@ struct dp_ast_entry {
 	txrx_ast_free_cb callback;
 	void *cookie;
 	TAILQ_ENTRY(dp_ast_entry) ase_list_elem;
-	TAILQ_ENTRY(dp_ast_entry) hash_list_elem;
+	DP_TAILQ_ENTRY_RCU(dp_ast_entry) hash_list_elem;
+	qdf_rcu_head_t rcu_head;
 };
 
 /**
@@ -1989,10 +2095,21 @@ struct dp_last_op_info {
 
 #ifdef WLAN_DP_FEATURE_SW_LATENCY_MGR
 
+/* SWLM modes, also the values accepted by gEnableSWLM and the dp_swlm sysfs */
+#define DP_SWLM_MODE_DISABLE	0
+#define DP_SWLM_MODE_FIXED	1
+#define DP_SWLM_MODE_ADAPTIVE	2
+
+/* Coalesced batch sizes are binned by power of 2: 1, 2-3, 4-7, ..., 32+ */
+#define DP_SWLM_BATCH_HIST_MAX	6
+/* Added delay bins: <50, <100, <250, <500, <1000, >=1000 us */
+#define DP_SWLM_DELAY_HIST_MAX	6
+
 /**
  * struct dp_swlm_tcl_data - params for tcl register write coalescing
  *			     decision making
  * @nbuf: TX packet
+ * @tx_desc: TX descriptor of the packet
  * @tid: tid for transmitting the current packet
  * @num_ll_connections: Number of low latency connections on this vdev
  * @ring_id: TCL ring id
@@ -2004,6 +2121,7 @@ struct dp_last_op_info {
  */
 struct dp_swlm_tcl_data {
 	qdf_nbuf_t nbuf;
+	struct dp_tx_desc_s *tx_desc;
 	uint8_t tid;
 	uint8_t num_ll_connections;
 	uint8_t ring_id;
@@ -2047,6 +2165,15 @@ struct dp_swlm_ops {
  *			   throughput did not meet session threshold
  * @tcl.coalesce_success: Num of TCL HP writes coalesced successfully.
  * @tcl.coalesce_fail: Num of TCL HP writes coalesces failed
+ * @tcl.prio_bypass: Num TCL register write coalescing skips, since the
+ *		     socket priority of the pkt marked it latency sensitive
+ * @tcl.depth_reached: Num TCL HP writes flush after the learnt coalescing
+ *		       depth was reached
+ * @tcl.depth_too_low: Num TCL HP writes not coalesced, since the learnt
+ *		       coalescing depth was below 2 packets
+ * @tcl.lat_samples: Num TX completion latency samples taken
+ * @tcl.batch_size_hist: Histogram of packets per coalesced HP write
+ * @tcl.delay_hist: Histogram of delay added to the first coalesced packet
  */
 struct dp_swlm_stats {
 	struct {
@@ -2060,6 +2187,12 @@ struct dp_swlm_stats {
 		uint32_t tput_criteria_fail;
 		uint32_t coalesce_success;
 		uint32_t coalesce_fail;
+		uint32_t prio_bypass;
+		uint32_t depth_reached;
+		uint32_t depth_too_low;
+		uint32_t lat_samples;
+		uint32_t batch_size_hist[DP_SWLM_BATCH_HIST_MAX];
+		uint32_t delay_hist[DP_SWLM_DELAY_HIST_MAX];
 	} tcl[MAX_TCL_DATA_RINGS];
 };
 
@@ -2078,6 +2211,16 @@ struct dp_swlm_stats {
  * @prev_rx_bytes: Previous RX bytes accounted
  * @expire_time: expiry time for sample
  * @tput_pass_cnt: threshold throughput pass counter
+ * @pkts_coalesced: Num packets coalesced in the current session
+ * @session_start_time: Timestamp of the first coalesced packet of the
+ *			current session
+ * @last_pkt_time: Timestamp of the previous packet on this ring
+ * @iat_avg: Moving average of the packet inter-arrival time, in us
+ * @comp_lat_avg: Moving average of the TX completion latency, in us
+ * @sample_desc: TX descriptor whose completion latency is being sampled
+ * @sample_time: Enqueue timestamp of @sample_desc
+ * @coalesce_depth: Learnt number of packets per HP write
+ * @delay_budget: Learnt maximum delay added by coalescing, in us
  */
 struct dp_swlm_tcl_params {
 	struct dp_soc *soc;
@@ -2092,6 +2235,15 @@ struct dp_swlm_tcl_params {
 	uint32_t prev_rx_bytes;
 	uint64_t expire_time;
 	uint32_t tput_pass_cnt;
+	uint32_t pkts_coalesced;
+	uint64_t session_start_time;
+	uint64_t last_pkt_time;
+	uint32_t iat_avg;
+	uint32_t comp_lat_avg;
+	struct dp_tx_desc_s *sample_desc;
+	uint64_t sample_time;
+	uint32_t coalesce_depth;
+	uint32_t delay_budget;
 };
 
 /**
@@ -2108,6 +2260,7 @@ struct dp_swlm_tcl_params {
  *			      ending the coalescing.
  * @tx_pkt_thresh: Threshold for TX packet count, to begin TCL register
  *		       write coalescing
+ * @bypass_prio: Socket priority from which packets are never coalesced
  * @tcl: TCL ring specific params
  */
 
@@ -2118,6 +2271,7 @@ struct dp_swlm_params {
 	uint32_t time_flush_thresh;
 	uint32_t tx_thresh_multiplier;
 	uint32_t tx_pkt_thresh;
+	uint32_t bypass_prio;
 	struct dp_swlm_tcl_params tcl[MAX_TCL_DATA_RINGS];
 };
 
@@ -2126,6 +2280,7 @@ struct dp_swlm_params {
  * @ops: SWLM ops pointers
  * @is_enabled: SWLM enabled/disabled
  * @is_init: SWLM module initialized
+ * @mode: SWLM mode, DP_SWLM_MODE_FIXED or DP_SWLM_MODE_ADAPTIVE
  * @stats: SWLM stats
  * @params: SWLM SRNG params
  * @tcl_flush_timer: flush timer for TCL register writes
@@ -2134,6 +2289,7 @@ struct dp_swlm {
 	struct dp_swlm_ops *ops;
 	uint8_t is_enabled:1,
 		is_init:1;
+	uint8_t mode;
 	struct dp_swlm_stats stats;
 	struct dp_swlm_params params;
 };
@@ -2692,6 +2848,20 @@ struct dp_rx_msdu_done_fail_desc_list {
 };
 #endif
 
+/**
+ * struct dp_peer_hash_tbl - peer MAC address hash bucket array
+ * @mask: bucket index mask
+ * @idx_bits: number of bits in the bucket index
+ * @rcu_head: frees the array after a grace period once it has been replaced
+ * @bins: buckets of peers
+ */
+struct dp_peer_hash_tbl {
+	unsigned mask;
+	unsigned idx_bits;
+	qdf_rcu_head_t rcu_head;
+	DP_TAILQ_HEAD_RCU(, dp_peer) bins[];
+};
+
 /* SOC level structure for data path */
 struct dp_soc {
 	/**
@@ -2892,10 +3062,16 @@ struct dp_soc {
 	/* peer ID to peer object map (array of pointers to peer objects) */
 	struct dp_peer **peer_id_to_obj_map;
 
+	/*
+	 * peer MAC address hash, the table is RCU protected so lookups don't
+	 * take peer_hash_lock; it grows with the number of peers up to
+	 * max_idx_bits and resize_seq is odd while peers are being moved
+	 */
 	struct {
-		unsigned mask;
-		unsigned idx_bits;
-		TAILQ_HEAD(, dp_peer) * bins;
+		struct dp_peer_hash_tbl qdf_rcu *tbl;
+		unsigned max_idx_bits;
+		uint32_t num_peers;
+		qdf_atomic_t resize_seq;
 	} peer_hash;
 
 	/* rx defrag state – TBD: do we need this per radio? */
@@ -2975,7 +3151,7 @@ struct dp_soc {
 	struct {
 		unsigned mask;
 		unsigned idx_bits;
-		TAILQ_HEAD(, dp_ast_entry) * bins;
+		DP_TAILQ_HEAD_RCU(, dp_ast_entry) * bins;
 	} ast_hash;
 
 #ifdef DP_TX_HW_DESC_HISTORY
@@ -5080,7 +5256,9 @@ struct dp_peer {
 	/* node in the vdev's list of peers */
 	TAILQ_ENTRY(dp_peer) peer_list_elem;
 	/* node in the hash table bin's list of peers */
-	TAILQ_ENTRY(dp_peer) hash_list_elem;
+	DP_TAILQ_ENTRY_RCU(dp_peer) hash_list_elem;
+	/* defers the free of the peer for lockless hash readers */
+	qdf_rcu_head_t rcu_head;
 
 	/* TID structures pointer */
 	struct dp_rx_tid *rx_tid;
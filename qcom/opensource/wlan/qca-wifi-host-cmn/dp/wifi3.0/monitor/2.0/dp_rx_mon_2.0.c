@@ -1014,10 +1014,8 @@ dp_rx_mon_handle_rx_hdr(struct dp_pdev *pdev,
 
 	if (!ppdu_info->mpdu_info[user_id].mpdu_start_received) {
 		nbuf = qdf_nbuf_alloc(pdev->soc->osdev,
-				      DP_RX_MON_TLV_ROOM +
-				      DP_RX_MON_MAX_RADIO_TAP_HDR,
-				      DP_RX_MON_TLV_ROOM +
-				      DP_RX_MON_MAX_RADIO_TAP_HDR,
+				      DP_RX_MON_PARENT_BUF_HEADROOM,
+				      DP_RX_MON_PARENT_BUF_HEADROOM,
 				      4, FALSE);
 
 		/**
@@ -1239,7 +1237,7 @@ void dp_rx_mon_drain_wq(struct dp_pdev *pdev)
  *
  * Return: QDF_STATUS
  */
-static QDF_STATUS
+static inline QDF_STATUS
 dp_rx_mon_deliver_mpdu(struct dp_mon_pdev *mon_pdev,
 		       qdf_nbuf_t mpdu,
 		       struct mon_rx_status *rx_status)
@@ -1264,6 +1262,148 @@ dp_rx_mon_deliver_mpdu(struct dp_mon_pdev *mon_pdev,
 	return QDF_STATUS_SUCCESS;
 }
 
+#ifdef WLAN_RX_MON_ZERO_COPY
+/**
+ * dp_rx_mon_update_radiotap() - Add radiotap header to MPDU
+ * @mon_pdev: monitor pdev
+ * @ppdu_info: PPDU info
+ * @mpdu: MPDU nbuf
+ *
+ * The header is built in place in the headroom of the parent nbuf, the
+ * copy through a stack buffer is only done if that is not possible.
+ *
+ * Return: radiotap length, 0 on failure
+ */
+static inline unsigned int
+dp_rx_mon_update_radiotap(struct dp_mon_pdev *mon_pdev,
+			  struct hal_rx_ppdu_info *ppdu_info,
+			  qdf_nbuf_t mpdu)
+{
+	unsigned int rtap_len;
+
+	rtap_len = qdf_nbuf_build_radiotap_in_headroom(&ppdu_info->rx_status,
+						       mpdu);
+	if (qdf_likely(rtap_len)) {
+		mon_pdev->rx_mon_stats.rtap_in_headroom++;
+		return rtap_len;
+	}
+
+	return qdf_nbuf_update_radiotap(&ppdu_info->rx_status, mpdu,
+					qdf_nbuf_headroom(mpdu));
+}
+
+/**
+ * dp_rx_mon_queue_mpdu() - Queue MPDU for batched delivery to osif layer
+ * @mon_pdev: monitor pdev
+ * @mpdu_batch: MPDUs of the PPDU pending delivery
+ * @mpdu: MPDU nbuf
+ * @rx_status: monitor status
+ *
+ * Return: QDF_STATUS
+ */
+static inline QDF_STATUS
+dp_rx_mon_queue_mpdu(struct dp_mon_pdev *mon_pdev,
+		     qdf_nbuf_queue_t *mpdu_batch,
+		     qdf_nbuf_t mpdu,
+		     struct mon_rx_status *rx_status)
+{
+	qdf_nbuf_t nbuf;
+	uint32_t num_frags;
+
+	if (!mon_pdev->mvdev || !mon_pdev->mvdev->monitor_vdev->osif_rx_mon)
+		return QDF_STATUS_E_FAILURE;
+
+	num_frags = qdf_nbuf_get_nr_frags(mpdu);
+	nbuf = qdf_nbuf_get_ext_list(mpdu);
+	while (nbuf) {
+		num_frags += qdf_nbuf_get_nr_frags(nbuf);
+		nbuf = qdf_nbuf_next(nbuf);
+	}
+	mon_pdev->rx_mon_stats.frags_to_stack += num_frags;
+
+	qdf_nbuf_queue_add(mpdu_batch, mpdu);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * dp_rx_mon_deliver_mpdu_batch() - Deliver queued MPDUs to osif layer
+ * @mon_pdev: monitor pdev
+ * @mpdu_batch: MPDUs of the PPDU pending delivery
+ * @rx_status: monitor status of the PPDU
+ *
+ * All MPDUs of the PPDU are handed over as one nbuf chain in a single
+ * osif_rx_mon call. Per MPDU status is carried by the radiotap header of
+ * each MPDU, @rx_status only describes the PPDU.
+ *
+ * Return: none
+ */
+static void
+dp_rx_mon_deliver_mpdu_batch(struct dp_mon_pdev *mon_pdev,
+			     qdf_nbuf_queue_t *mpdu_batch,
+			     struct mon_rx_status *rx_status)
+{
+	qdf_nbuf_t mpdu_list, mpdu, nbuf;
+
+	if (qdf_nbuf_is_queue_empty(mpdu_batch))
+		return;
+
+	mpdu_list = qdf_nbuf_queue_first(mpdu_batch);
+	qdf_nbuf_queue_init(mpdu_batch);
+
+	if (qdf_unlikely(!mon_pdev->mvdev ||
+			 !mon_pdev->mvdev->monitor_vdev->osif_rx_mon)) {
+		while (mpdu_list) {
+			mpdu = mpdu_list;
+			mpdu_list = qdf_nbuf_next(mpdu);
+			qdf_nbuf_set_next(mpdu, NULL);
+			dp_mon_free_parent_nbuf(mon_pdev, mpdu);
+		}
+		return;
+	}
+
+	for (mpdu = mpdu_list; mpdu; mpdu = qdf_nbuf_next(mpdu)) {
+		mon_pdev->rx_mon_stats.mpdus_buf_to_stack++;
+		nbuf = qdf_nbuf_get_ext_list(mpdu);
+
+		while (nbuf) {
+			mon_pdev->rx_mon_stats.mpdus_buf_to_stack++;
+			nbuf = qdf_nbuf_next(nbuf);
+		}
+	}
+
+	mon_pdev->rx_mon_stats.mpdu_batch_deliver++;
+	mon_pdev->mvdev->monitor_vdev->osif_rx_mon(mon_pdev->mvdev->osif_vdev,
+						   mpdu_list,
+						   rx_status);
+}
+#else
+static inline unsigned int
+dp_rx_mon_update_radiotap(struct dp_mon_pdev *mon_pdev,
+			  struct hal_rx_ppdu_info *ppdu_info,
+			  qdf_nbuf_t mpdu)
+{
+	return qdf_nbuf_update_radiotap(&ppdu_info->rx_status, mpdu,
+					qdf_nbuf_headroom(mpdu));
+}
+
+static inline QDF_STATUS
+dp_rx_mon_queue_mpdu(struct dp_mon_pdev *mon_pdev,
+		     qdf_nbuf_queue_t *mpdu_batch,
+		     qdf_nbuf_t mpdu,
+		     struct mon_rx_status *rx_status)
+{
+	return dp_rx_mon_deliver_mpdu(mon_pdev, mpdu, rx_status);
+}
+
+static inline void
+dp_rx_mon_deliver_mpdu_batch(struct dp_mon_pdev *mon_pdev,
+			     qdf_nbuf_queue_t *mpdu_batch,
+			     struct mon_rx_status *rx_status)
+{
+}
+#endif
+
 /**
  * dp_rx_mon_process_ppdu_info() - Process PPDU info
  * @pdev: DP pdev
@@ -1278,10 +1418,13 @@ dp_rx_mon_process_ppdu_info(struct dp_pdev *pdev,
 	struct dp_mon_pdev *mon_pdev = (struct dp_mon_pdev *)pdev->monitor_pdev;
 	uint8_t user;
 	qdf_nbuf_t mpdu;
+	qdf_nbuf_queue_t mpdu_batch;
 
 	if (!ppdu_info)
 		return;
 
+	qdf_nbuf_queue_init(&mpdu_batch);
+
 	for (user = 0; user < ppdu_info->com_info.num_users; user++) {
 		uint16_t mpdu_count;
 		uint16_t mpdu_idx;
@@ -1290,7 +1433,7 @@ dp_rx_mon_process_ppdu_info(struct dp_pdev *pdev,
 
 		if (user >= HAL_MAX_UL_MU_USERS) {
 			dp_mon_err("num user exceeds max limit");
-			return;
+			break;
 		}
 
 		mpdu_count  = ppdu_info->mpdu_count[user];
@@ -1332,9 +1475,9 @@ dp_rx_mon_process_ppdu_info(struct dp_pdev *pdev,
 
 				/* reset mpdu metadata and apply radiotap header over MPDU */
 				qdf_mem_zero(mpdu_meta, sizeof(struct hal_rx_mon_mpdu_info));
-				if (!qdf_nbuf_update_radiotap(&ppdu_info->rx_status,
-							      mpdu,
-							      qdf_nbuf_headroom(mpdu))) {
+				if (!dp_rx_mon_update_radiotap(mon_pdev,
+							       ppdu_info,
+							       mpdu)) {
 					dp_mon_err("failed to update radiotap pdev: %pK",
 						   pdev);
 				}
@@ -1347,9 +1490,10 @@ dp_rx_mon_process_ppdu_info(struct dp_pdev *pdev,
 							      pdev->pdev_id,
 							      mpdu);
 				/* Deliver MPDU to osif layer */
-				status = dp_rx_mon_deliver_mpdu(mon_pdev,
-								mpdu,
-								&ppdu_info->rx_status);
+				status = dp_rx_mon_queue_mpdu(mon_pdev,
+							      &mpdu_batch,
+							      mpdu,
+							      &ppdu_info->rx_status);
 				if (status != QDF_STATUS_SUCCESS)
 					dp_mon_free_parent_nbuf(mon_pdev, mpdu);
 			}
@@ -1357,6 +1501,8 @@ dp_rx_mon_process_ppdu_info(struct dp_pdev *pdev,
 		}
 	}
 
+	dp_rx_mon_deliver_mpdu_batch(mon_pdev, &mpdu_batch,
+				     &ppdu_info->rx_status);
 	dp_rx_mon_free_mpdu_queue(mon_pdev, ppdu_info);
 }
 
@@ -2751,6 +2897,14 @@ void dp_mon_rx_print_advanced_stats_2_0(struct dp_soc *soc,
 		       rx_mon_stats->invalid_dma_length);
 	DP_PRINT_STATS("pending_desc_count= %d",
 		       mon_pdev->rx_mon_stats.pending_desc_count);
+#ifdef WLAN_RX_MON_ZERO_COPY
+	DP_PRINT_STATS("rtap_in_headroom = %d",
+		       rx_mon_stats->rtap_in_headroom);
+	DP_PRINT_STATS("frags_to_stack = %d",
+		       rx_mon_stats->frags_to_stack);
+	DP_PRINT_STATS("mpdu_batch_deliver = %d",
+		       rx_mon_stats->mpdu_batch_deliver);
+#endif
 }
 #endif
 
@@ -50,6 +50,19 @@
 			    + (DP_RX_MON_TLV_HDR_MARKER_LEN)\
 			    + (DP_RX_MON_TLV_TOTAL_LEN))
 
+/*
+ * Headroom of the parent nbuf of an MPDU: protocol/flow tag TLVs and the
+ * radiotap header. In zero copy mode radiotap is built in place and may
+ * need up to RADIOTAP_HEADER_LEN bytes.
+ */
+#ifdef WLAN_RX_MON_ZERO_COPY
+#define DP_RX_MON_PARENT_BUF_HEADROOM \
+	((DP_RX_MON_TLV_ROOM) + (RADIOTAP_HEADER_LEN))
+#else
+#define DP_RX_MON_PARENT_BUF_HEADROOM \
+	((DP_RX_MON_TLV_ROOM) + (DP_RX_MON_MAX_RADIO_TAP_HDR))
+#endif
+
 #define DP_RX_MON_WQ_THRESHOLD 128
 
 #define DP_RX_MON_MAX_RX_HEADER_LEN 128
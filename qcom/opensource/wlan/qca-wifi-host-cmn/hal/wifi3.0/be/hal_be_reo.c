@@ -268,8 +268,7 @@ hal_reo_cmd_queue_stats_be(hal_ring_handle_t  hal_ring_hdl,
 
 	reo_get_queue_stats->clear_stats = cmd->u.stats_params.clear;
 
-	hal_srng_access_end_v1(hal_soc_hdl, hal_ring_hdl,
-			       HIF_RTPM_ID_HAL_REO_CMD);
+	hal_reo_cmd_srng_access_end(hal_soc_hdl, hal_ring_hdl);
 
 	val = reo_desc[CMD_HEADER_DW_OFFSET];
 	return HAL_GET_FIELD(UNIFORM_REO_CMD_HEADER, REO_CMD_NUMBER,
@@ -318,8 +317,7 @@ hal_reo_cmd_flush_queue_be(hal_ring_handle_t hal_ring_hdl,
 		reo_flush_queue->block_resource_index =
 						cmd->u.fl_queue_params.index;
 
-	hal_srng_access_end_v1(hal_soc_hdl, hal_ring_hdl,
-			       HIF_RTPM_ID_HAL_REO_CMD);
+	hal_reo_cmd_srng_access_end(hal_soc_hdl, hal_ring_hdl);
 
 	val = reo_desc[CMD_HEADER_DW_OFFSET];
 	return HAL_GET_FIELD(UNIFORM_REO_CMD_HEADER, REO_CMD_NUMBER,
@@ -396,8 +394,7 @@ hal_reo_cmd_flush_cache_be(hal_ring_handle_t hal_ring_hdl,
 						cp->block_use_after_flush;
 	reo_flush_cache->flush_entire_cache = cp->flush_entire_cache;
 
-	hal_srng_access_end_v1(hal_soc_hdl, hal_ring_hdl,
-			       HIF_RTPM_ID_HAL_REO_CMD);
+	hal_reo_cmd_srng_access_end(hal_soc_hdl, hal_ring_hdl);
 
 	val = reo_desc[CMD_HEADER_DW_OFFSET];
 	return HAL_GET_FIELD(UNIFORM_REO_CMD_HEADER, REO_CMD_NUMBER,
@@ -454,7 +451,7 @@ hal_reo_cmd_unblock_cache_be(hal_ring_handle_t hal_ring_hdl,
 		reo_unblock_cache->cache_block_resource_index =
 						cmd->u.unblk_cache_params.index;
 
-	hal_srng_access_end(hal_soc, hal_ring_hdl);
+	hal_reo_cmd_srng_access_end(hal_soc_hdl, hal_ring_hdl);
 	val = reo_desc[CMD_HEADER_DW_OFFSET];
 	return HAL_GET_FIELD(UNIFORM_REO_CMD_HEADER, REO_CMD_NUMBER,
 				     val);
@@ -499,7 +496,7 @@ hal_reo_cmd_flush_timeout_list_be(hal_ring_handle_t hal_ring_hdl,
 	reo_flush_timeout_list->minimum_forward_buf_count =
 					cmd->u.fl_tim_list_params.min_fwd_buf;
 
-	hal_srng_access_end(hal_soc, hal_ring_hdl);
+	hal_reo_cmd_srng_access_end(hal_soc_hdl, hal_ring_hdl);
 	val = reo_desc[CMD_HEADER_DW_OFFSET];
 	return HAL_GET_FIELD(UNIFORM_REO_CMD_HEADER, REO_CMD_NUMBER,
 				     val);
@@ -616,8 +613,7 @@ hal_reo_cmd_update_rx_queue_be(hal_ring_handle_t hal_ring_hdl,
 	reo_update_rx_reo_queue->pn_95_64 = p->pn_95_64;
 	reo_update_rx_reo_queue->pn_127_96 = p->pn_127_96;
 
-	hal_srng_access_end_v1(hal_soc_hdl, hal_ring_hdl,
-			       HIF_RTPM_ID_HAL_REO_CMD);
+	hal_reo_cmd_srng_access_end(hal_soc_hdl, hal_ring_hdl);
 
 	val = reo_desc[CMD_HEADER_DW_OFFSET];
 	return HAL_GET_FIELD(UNIFORM_REO_CMD_HEADER, REO_CMD_NUMBER,
@@ -898,6 +898,14 @@ struct hal_srng {
 	/* pointer register writing history for this srng */
 	struct hal_srng_reg_his_ctx *reg_his_ctx;
 #endif
+#ifdef WLAN_DP_REO_CMD_BATCH
+	/* Caller owning the open command batch, see hal_reo_cmd_batch_owner */
+	void *batch_owner;
+	/* Nesting depth of the owner's open batches */
+	uint8_t batch_depth;
+	/* Entries posted by the owner and not yet signalled to HW */
+	uint16_t batch_pending;
+#endif
 };
 
 #ifdef HAL_SRNG_REG_HIS_DEBUG
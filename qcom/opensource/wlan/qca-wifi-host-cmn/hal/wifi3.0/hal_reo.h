@@ -21,6 +21,7 @@
 #define _HAL_REO_H_
 
 #include <qdf_types.h>
+#include <qdf_threads.h>
 /* HW headers */
 #include <reo_descriptor_threshold_reached_status.h>
 #include <reo_flush_queue.h>
@@ -583,6 +584,170 @@ hal_uniform_desc_hdr_setup(uint32_t *desc, uint32_t owner, uint32_t buffer_type)
 			   buffer_type);
 }
 
+#ifdef WLAN_DP_REO_CMD_BATCH
+/**
+ * hal_reo_cmd_batch_owner() - Identify the caller of a REO command batch
+ *
+ * A task may sleep and migrate inside a batch, so it is identified by its
+ * task. A softirq runs to completion on its CPU and is identified by the
+ * CPU, so it never joins the batch of a task it interrupted.
+ *
+ * Return: owner token of the caller
+ */
+static inline void *hal_reo_cmd_batch_owner(void)
+{
+	if (qdf_in_task())
+		return qdf_get_current_task();
+
+	return (void *)(uintptr_t)(qdf_get_cpu() + 1);
+}
+
+/**
+ * hal_reo_cmd_srng_access_end() - End REO command ring access after
+ *				   posting a command
+ * @hal_soc_hdl: HAL soc handle
+ * @hal_ring_hdl: REO command srng handle
+ *
+ * Inside its own command batch the HP update of the caller is deferred to
+ * the end of the batch, so the ring is only unlocked here. Any other caller
+ * updates HP, which also signals the commands of the open batch.
+ *
+ * Return: None
+ */
+static inline void
+hal_reo_cmd_srng_access_end(hal_soc_handle_t hal_soc_hdl,
+			    hal_ring_handle_t hal_ring_hdl)
+{
+	struct hal_srng *srng = (struct hal_srng *)hal_ring_hdl;
+
+	if (srng->batch_depth &&
+	    srng->batch_owner == hal_reo_cmd_batch_owner()) {
+		srng->batch_pending++;
+		hal_srng_access_end_reap(hal_soc_hdl, hal_ring_hdl);
+		return;
+	}
+
+	srng->batch_pending = 0;
+	hal_srng_access_end_v1(hal_soc_hdl, hal_ring_hdl,
+			       HIF_RTPM_ID_HAL_REO_CMD);
+}
+
+/**
+ * hal_reo_cmd_batch_start() - Open a REO command batch
+ * @hal_soc_hdl: HAL soc handle
+ * @hal_ring_hdl: REO command srng handle
+ *
+ * Commands the caller posts until the matching hal_reo_cmd_batch_end() are
+ * written to the ring but HW is signalled only once. Batches of the same
+ * caller nest. Only one caller owns a batch at a time, the batches of other
+ * callers are no-ops and their commands are signalled right away.
+ *
+ * Return: None
+ */
+static inline void
+hal_reo_cmd_batch_start(hal_soc_handle_t hal_soc_hdl,
+			hal_ring_handle_t hal_ring_hdl)
+{
+	struct hal_srng *srng = (struct hal_srng *)hal_ring_hdl;
+	void *owner = hal_reo_cmd_batch_owner();
+
+	SRNG_LOCK(&srng->lock);
+	if (!srng->batch_depth)
+		srng->batch_owner = owner;
+
+	if (srng->batch_owner == owner)
+		srng->batch_depth++;
+	SRNG_UNLOCK(&srng->lock);
+}
+
+/**
+ * hal_reo_cmd_batch_flush() - Signal the commands posted so far in the
+ *			       open batch to HW
+ * @hal_soc_hdl: HAL soc handle
+ * @hal_ring_hdl: REO command srng handle
+ *
+ * Return: number of commands signalled
+ */
+static inline uint16_t
+hal_reo_cmd_batch_flush(hal_soc_handle_t hal_soc_hdl,
+			hal_ring_handle_t hal_ring_hdl)
+{
+	struct hal_srng *srng = (struct hal_srng *)hal_ring_hdl;
+	uint16_t pending;
+
+	if (hal_srng_access_start(hal_soc_hdl, hal_ring_hdl))
+		return 0;
+
+	pending = srng->batch_pending;
+	srng->batch_pending = 0;
+
+	if (pending)
+		hal_srng_access_end_v1(hal_soc_hdl, hal_ring_hdl,
+				       HIF_RTPM_ID_HAL_REO_CMD);
+	else
+		hal_srng_access_end_reap(hal_soc_hdl, hal_ring_hdl);
+
+	return pending;
+}
+
+/**
+ * hal_reo_cmd_batch_end() - Close a REO command batch
+ * @hal_soc_hdl: HAL soc handle
+ * @hal_ring_hdl: REO command srng handle
+ *
+ * HW is signalled when the outermost batch of the owner is closed.
+ *
+ * Return: number of commands signalled
+ */
+static inline uint16_t
+hal_reo_cmd_batch_end(hal_soc_handle_t hal_soc_hdl,
+		      hal_ring_handle_t hal_ring_hdl)
+{
+	struct hal_srng *srng = (struct hal_srng *)hal_ring_hdl;
+	void *owner = hal_reo_cmd_batch_owner();
+	uint16_t pending = 0;
+
+	if (hal_srng_access_start(hal_soc_hdl, hal_ring_hdl))
+		return 0;
+
+	if (srng->batch_depth && srng->batch_owner == owner &&
+	    !--srng->batch_depth) {
+		pending = srng->batch_pending;
+		srng->batch_pending = 0;
+		srng->batch_owner = NULL;
+	}
+
+	if (pending)
+		hal_srng_access_end_v1(hal_soc_hdl, hal_ring_hdl,
+				       HIF_RTPM_ID_HAL_REO_CMD);
+	else
+		hal_srng_access_end_reap(hal_soc_hdl, hal_ring_hdl);
+
+	return pending;
+}
+
+/**
+ * hal_reo_cmd_batch_pending() - Number of commands waiting for the doorbell
+ * @hal_ring_hdl: REO command srng handle
+ *
+ * Commands HW was signalled about and did not complete yet are not counted.
+ *
+ * Return: commands posted in the open batch and not yet signalled
+ */
+static inline uint16_t hal_reo_cmd_batch_pending(hal_ring_handle_t hal_ring_hdl)
+{
+	return ((struct hal_srng *)hal_ring_hdl)->batch_pending;
+}
+#else
+static inline void
+hal_reo_cmd_srng_access_end(hal_soc_handle_t hal_soc_hdl,
+			    hal_ring_handle_t hal_ring_hdl)
+{
+	hal_srng_access_end_v1(hal_soc_hdl, hal_ring_hdl,
+			       HIF_RTPM_ID_HAL_REO_CMD);
+}
+#endif /* WLAN_DP_REO_CMD_BATCH */
+
 /**
  * hal_reo_send_cmd() - Send reo cmd using the params provided.
  * @hal_soc_hdl: HAL soc handle
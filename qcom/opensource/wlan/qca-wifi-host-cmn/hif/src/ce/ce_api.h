@@ -260,6 +260,40 @@ QDF_STATUS ce_recv_buf_enqueue(struct CE_handle *copyeng,
 			       void *per_transfer_recv_context,
 			       qdf_dma_addr_t buffer);
 
+#ifdef HIF_CE_RX_BATCH
+/* Max receive completions reaped or buffers posted in one ring access */
+#define CE_RX_BATCH_MAX 16
+
+/**
+ * struct ce_recv_completion - receive completion reaped from a dest ring
+ * @per_transfer_context: context passed to ce_recv_buf_enqueue_batch()
+ * @nbytes: number of bytes received
+ * @transfer_id: transfer id from the status descriptor
+ * @flags: CE_RECV_FLAG_*
+ */
+struct ce_recv_completion {
+	void *per_transfer_context;
+	unsigned int nbytes;
+	unsigned int transfer_id;
+	unsigned int flags;
+};
+
+/**
+ * ce_recv_buf_enqueue_batch() - Make several buffers available to receive
+ * @copyeng: which copy engine to use
+ * @per_transfer_recv_context: contexts passed back to caller's recv_cb
+ * @buffer: addresses of the buffers in CE space
+ * @num: number of buffers
+ *
+ * Buffers are posted in order and the ring head pointer is updated once.
+ *
+ * Return: number of buffers posted, the tail of the arrays was not consumed
+ */
+uint32_t ce_recv_buf_enqueue_batch(struct CE_handle *copyeng,
+				   void **per_transfer_recv_context,
+				   qdf_dma_addr_t *buffer, uint32_t num);
+#endif
+
 /*
  * Register a Receive Callback function.
  * This function is called as soon as data is received
@@ -659,6 +693,16 @@ struct ce_ops {
 			unsigned int *nbytesp,
 			unsigned int *transfer_idp,
 			unsigned int *flagsp);
+#ifdef HIF_CE_RX_BATCH
+	uint32_t (*ce_completed_recv_batch_nolock)(
+			struct CE_state *CE_state,
+			struct ce_recv_completion *comp,
+			uint32_t max);
+	uint32_t (*ce_recv_buf_enqueue_batch)(struct CE_handle *copyeng,
+					      void **per_recv_context,
+					      qdf_dma_addr_t *buffer,
+					      uint32_t num);
+#endif
 	QDF_STATUS (*ce_completed_send_next_nolock)(
 			struct CE_state *CE_state,
 			void **per_CE_contextp,
@@ -229,8 +229,52 @@ struct CE_state {
 	qdf_time_t last_dequeue_time;
 #endif
 	uint32_t ce_wrt_idx_offset;
+#ifdef HIF_CE_RX_BATCH
+	/* receive completions are reaped and replenished in batches */
+	bool rx_batch;
+	/* completions of the current batch not yet given to recv_cb */
+	uint32_t rx_batch_left;
+#endif
 };
 
+#ifdef HIF_CE_RX_BATCH
+/**
+ * ce_rx_batch_enabled() - check if a CE reaps receive completions in batches
+ * @ce_state: CE state
+ *
+ * Return: true if batch reap and bulk replenish are used
+ */
+static inline bool ce_rx_batch_enabled(struct CE_state *ce_state)
+{
+	return ce_state->rx_batch;
+}
+
+/**
+ * ce_rx_batch_post_deferred() - check if receive buffers should be
+ *				 replenished later
+ * @ce_state: CE state
+ *
+ * Buffers consumed by a batch are replenished in bulk once the last
+ * completion of the batch has been handed to recv_cb.
+ *
+ * Return: true if the replenish is left to the end of the batch
+ */
+static inline bool ce_rx_batch_post_deferred(struct CE_state *ce_state)
+{
+	return ce_state->rx_batch && ce_state->rx_batch_left;
+}
+#else
+static inline bool ce_rx_batch_enabled(struct CE_state *ce_state)
+{
+	return false;
+}
+
+static inline bool ce_rx_batch_post_deferred(struct CE_state *ce_state)
+{
+	return false;
+}
+#endif /* HIF_CE_RX_BATCH */
+
 /* Descriptor rings must be aligned to this boundary */
 #define CE_DESC_RING_ALIGN 8
 #define CLOCK_OVERRIDE 0x2
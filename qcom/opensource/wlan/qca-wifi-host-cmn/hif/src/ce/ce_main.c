@@ -1701,6 +1701,57 @@ void hif_ce_print_ring_stats(struct hif_opaque_softc *hif_ctx)
 }
 #endif
 
+#ifdef HIF_CE_RX_BATCH
+/**
+ * ce_mark_rx_batch() - enable batch reap and bulk replenish on the CE
+ * @scn: HIF context
+ * @ce_state: CE state
+ *
+ * Used for the SRNG destination CEs carrying WMI events and HTT messages,
+ * which take bursts of completions.
+ *
+ * Return: None
+ */
+static void ce_mark_rx_batch(struct hif_softc *scn, struct CE_state *ce_state)
+{
+	struct HIF_CE_state *hif_state = HIF_GET_CE_STATE(scn);
+	struct service_to_pipe *svc_map;
+	uint32_t map_sz, map_len;
+	int i;
+
+	if (!ce_state->dest_ring || !ce_srng_based(scn) ||
+	    !hif_state->ce_services->ce_completed_recv_batch_nolock ||
+	    !hif_state->ce_services->ce_recv_buf_enqueue_batch)
+		return;
+
+	hif_select_service_to_pipe_map(scn, &svc_map, &map_sz);
+	map_len = map_sz / sizeof(struct service_to_pipe);
+	for (i = 0; i < map_len; i++) {
+		if (svc_map[i].pipenum != ce_state->id ||
+		    svc_map[i].pipedir != PIPEDIR_IN)
+			continue;
+
+		switch (svc_map[i].service_id) {
+		case WMI_CONTROL_SVC:
+		case WMI_CONTROL_SVC_WMAC1:
+		case WMI_CONTROL_SVC_WMAC2:
+		case HTT_DATA_MSG_SVC:
+		case HTT_DATA2_MSG_SVC:
+		case HTT_DATA3_MSG_SVC:
+			ce_state->rx_batch = true;
+			return;
+		default:
+			break;
+		}
+	}
+}
+#else
+static inline void ce_mark_rx_batch(struct hif_softc *scn,
+				    struct CE_state *ce_state)
+{
+}
+#endif /* HIF_CE_RX_BATCH */
+
 /**
  * hif_get_max_wmi_ep() - Get max WMI EPs configured in target svc map
  * @hif_ctx: hif opaque handle
@@ -2851,6 +2902,7 @@ struct CE_handle *ce_init(struct hif_softc *scn,
 
 	/* update the htt_data attribute */
 	ce_mark_datapath(CE_state);
+	ce_mark_rx_batch(scn, CE_state);
 	scn->ce_id_to_state[CE_id] = CE_state;
 
 	ce_ring_dump_register_region(CE_state, CE_id);
@@ -3658,7 +3710,8 @@ hif_pci_ce_recv_data(struct CE_handle *copyeng, void *ce_context,
 				      QDF_DMA_FROM_DEVICE);
 
 		atomic_inc(&pipe_info->recv_bufs_needed);
-		hif_post_recv_buffers_for_pipe(pipe_info);
+		if (!ce_rx_batch_post_deferred(ce_state))
+			hif_post_recv_buffers_for_pipe(pipe_info);
 		if (scn->target_status == TARGET_STATUS_RESET)
 			hif_ce_rx_nbuf_free(transfer_context);
 		else
@@ -3673,7 +3726,9 @@ hif_pci_ce_recv_data(struct CE_handle *copyeng, void *ce_context,
 			ce_state->force_break = 1;
 			break;
 		}
-	} while (ce_completed_recv_next(copyeng, &ce_context, &transfer_context,
+		/* with batch reap the CE service hands over every completion */
+	} while (!ce_rx_batch_enabled(ce_state) &&
+		 ce_completed_recv_next(copyeng, &ce_context, &transfer_context,
 					&CE_data, &nbytes, &transfer_id,
 					&flags) == QDF_STATUS_SUCCESS);
 
@@ -3876,6 +3931,120 @@ static void hif_post_recv_buffers_failure(struct HIF_CE_pipe_info *pipe_info,
 
 }
 
+#ifdef HIF_CE_RX_BATCH
+/**
+ * hif_post_recv_buffers_batch() - Replenish the receive buffers of a pipe
+ *				   in bulk
+ * @pipe_info: pipe info
+ *
+ * Up to CE_RX_BATCH_MAX buffers are allocated and mapped, then posted to
+ * the CE with a single ring head pointer update.
+ *
+ * Return: QDF_STATUS_SUCCESS if all the needed buffers were posted
+ */
+static QDF_STATUS
+hif_post_recv_buffers_batch(struct HIF_CE_pipe_info *pipe_info)
+{
+	struct hif_softc *scn = HIF_GET_SOFTC(pipe_info->HIF_CE_state);
+	struct CE_handle *ce_hdl = pipe_info->ce_hdl;
+	unsigned int ce_id = ((struct CE_state *)ce_hdl)->id;
+	void *nbufs[CE_RX_BATCH_MAX];
+	qdf_dma_addr_t paddrs[CE_RX_BATCH_MAX];
+	uint32_t bufs_posted = 0;
+	uint32_t num, posted, i;
+	QDF_STATUS status = QDF_STATUS_SUCCESS;
+	qdf_nbuf_t nbuf;
+
+	qdf_spin_lock_bh(&pipe_info->recv_bufs_needed_lock);
+	while (atomic_read(&pipe_info->recv_bufs_needed) > 0) {
+		num = qdf_min(atomic_read(&pipe_info->recv_bufs_needed),
+			      CE_RX_BATCH_MAX);
+		atomic_sub(num, &pipe_info->recv_bufs_needed);
+		qdf_spin_unlock_bh(&pipe_info->recv_bufs_needed_lock);
+
+		for (i = 0; i < num; i++) {
+			hif_record_ce_desc_event(scn, ce_id,
+						 HIF_RX_DESC_PRE_NBUF_ALLOC,
+						 NULL, NULL, 0, 0);
+			nbuf = hif_ce_rx_nbuf_alloc(scn, ce_id);
+			if (!nbuf) {
+				atomic_add(num - i - 1,
+					   &pipe_info->recv_bufs_needed);
+				hif_post_recv_buffers_failure(pipe_info, nbuf,
+					&pipe_info->nbuf_alloc_err_count,
+					HIF_RX_NBUF_ALLOC_FAILURE,
+					"HIF_RX_NBUF_ALLOC_FAILURE");
+				status = QDF_STATUS_E_NOMEM;
+				break;
+			}
+
+			status = qdf_nbuf_map_single(scn->qdf_dev, nbuf,
+						     QDF_DMA_FROM_DEVICE);
+			if (qdf_unlikely(status != QDF_STATUS_SUCCESS)) {
+				atomic_add(num - i - 1,
+					   &pipe_info->recv_bufs_needed);
+				hif_post_recv_buffers_failure(pipe_info, nbuf,
+					&pipe_info->nbuf_dma_err_count,
+					HIF_RX_NBUF_MAP_FAILURE,
+					"HIF_RX_NBUF_MAP_FAILURE");
+				hif_ce_rx_nbuf_free(nbuf);
+				break;
+			}
+
+			nbufs[i] = nbuf;
+			paddrs[i] = qdf_nbuf_get_frag_paddr(nbuf, 0);
+			hif_record_ce_desc_event(scn, ce_id,
+						 HIF_RX_DESC_POST_NBUF_MAP,
+						 NULL, nbuf, 0, 0);
+			qdf_mem_dma_sync_single_for_device(scn->qdf_dev,
+							   paddrs[i],
+							   pipe_info->buf_sz,
+							   DMA_FROM_DEVICE);
+		}
+
+		posted = i ? ce_recv_buf_enqueue_batch(ce_hdl, nbufs, paddrs,
+						       i) : 0;
+		bufs_posted += posted;
+
+		for (; posted < i; posted++) {
+			hif_post_recv_buffers_failure(pipe_info,
+					nbufs[posted],
+					&pipe_info->nbuf_ce_enqueue_err_count,
+					HIF_RX_NBUF_ENQUEUE_FAILURE,
+					"HIF_RX_NBUF_ENQUEUE_FAILURE");
+			qdf_nbuf_unmap_single(scn->qdf_dev, nbufs[posted],
+					      QDF_DMA_FROM_DEVICE);
+			hif_ce_rx_nbuf_free(nbufs[posted]);
+			status = QDF_STATUS_E_FAILURE;
+		}
+
+		if (QDF_IS_STATUS_ERROR(status))
+			return status;
+
+		qdf_spin_lock_bh(&pipe_info->recv_bufs_needed_lock);
+	}
+	pipe_info->nbuf_alloc_err_count =
+		(pipe_info->nbuf_alloc_err_count > bufs_posted) ?
+		pipe_info->nbuf_alloc_err_count - bufs_posted : 0;
+	pipe_info->nbuf_dma_err_count =
+		(pipe_info->nbuf_dma_err_count > bufs_posted) ?
+		pipe_info->nbuf_dma_err_count - bufs_posted : 0;
+	pipe_info->nbuf_ce_enqueue_err_count =
+		(pipe_info->nbuf_ce_enqueue_err_count > bufs_posted) ?
+	pipe_info->nbuf_ce_enqueue_err_count - bufs_posted : 0;
+
+	qdf_spin_unlock_bh(&pipe_info->recv_bufs_needed_lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+#else
+static inline QDF_STATUS
+hif_post_recv_buffers_batch(struct HIF_CE_pipe_info *pipe_info)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+#endif /* HIF_CE_RX_BATCH */
+
 QDF_STATUS hif_post_recv_buffers_for_pipe(struct HIF_CE_pipe_info *pipe_info)
 {
 	struct CE_handle *ce_hdl;
@@ -3899,6 +4068,9 @@ QDF_STATUS hif_post_recv_buffers_for_pipe(struct HIF_CE_pipe_info *pipe_info)
 
 	ce_id = ((struct CE_state *)ce_hdl)->id;
 
+	if (ce_rx_batch_enabled((struct CE_state *)ce_hdl))
+		return hif_post_recv_buffers_batch(pipe_info);
+
 	qdf_spin_lock_bh(&pipe_info->recv_bufs_needed_lock);
 	while (atomic_read(&pipe_info->recv_bufs_needed) > 0) {
 		qdf_dma_addr_t CE_data;      /* CE space buffer address */
@@ -805,6 +805,21 @@ ce_recv_buf_enqueue(struct CE_handle *copyeng,
 }
 qdf_export_symbol(ce_recv_buf_enqueue);
 
+#ifdef HIF_CE_RX_BATCH
+uint32_t ce_recv_buf_enqueue_batch(struct CE_handle *copyeng,
+				   void **per_transfer_recv_context,
+				   qdf_dma_addr_t *buffer, uint32_t num)
+{
+	struct CE_state *CE_state = (struct CE_state *)copyeng;
+	struct HIF_CE_state *hif_state = HIF_GET_CE_STATE(CE_state->scn);
+
+	return hif_state->ce_services->ce_recv_buf_enqueue_batch(copyeng,
+			per_transfer_recv_context, buffer, num);
+}
+
+qdf_export_symbol(ce_recv_buf_enqueue_batch);
+#endif
+
 void
 ce_send_watermarks_set(struct CE_handle *copyeng,
 		       unsigned int low_alert_nentries,
@@ -1064,6 +1079,58 @@ static inline bool check_ce_id_and_epping_enabled(int CE_id, uint32_t mode)
 
 #endif /* ENABLE_CE4_COMP_DISABLE_HTT_HTC_MISC_LIST */
 
+#ifdef HIF_CE_RX_BATCH
+/**
+ * ce_engine_service_recv_batch() - Reap receive completions in batches and
+ *				    hand them to the recv callback
+ * @hif_state: HIF CE state
+ * @CE_state: CE state, ce_index_lock held
+ *
+ * Every completion of a reaped batch is delivered, the service yield is
+ * only honoured between batches.
+ *
+ * Return: true if the service loop has to break out
+ */
+static bool ce_engine_service_recv_batch(struct HIF_CE_state *hif_state,
+					 struct CE_state *CE_state)
+{
+	struct ce_recv_completion comp[CE_RX_BATCH_MAX];
+	uint32_t num, i;
+
+	do {
+		num = hif_state->ce_services->ce_completed_recv_batch_nolock(
+				CE_state, comp, CE_RX_BATCH_MAX);
+		if (!num)
+			break;
+
+		qdf_spin_unlock(&CE_state->ce_index_lock);
+		for (i = 0; i < num; i++) {
+			CE_state->rx_batch_left = num - i - 1;
+			CE_state->recv_cb((struct CE_handle *)CE_state,
+					  CE_state->recv_context,
+					  comp[i].per_transfer_context, 0,
+					  comp[i].nbytes, comp[i].transfer_id,
+					  comp[i].flags);
+		}
+		qdf_spin_lock(&CE_state->ce_index_lock);
+
+		if (qdf_unlikely(CE_state->force_break)) {
+			qdf_atomic_set(&CE_state->rx_pending, 1);
+			return true;
+		}
+	} while (num == CE_RX_BATCH_MAX);
+
+	return false;
+}
+#else
+static inline bool
+ce_engine_service_recv_batch(struct HIF_CE_state *hif_state,
+			     struct CE_state *CE_state)
+{
+	return false;
+}
+#endif /* HIF_CE_RX_BATCH */
+
 /*
  * ce_engine_service_reg:
  *
@@ -1090,7 +1157,10 @@ void ce_engine_service_reg(struct hif_softc *scn, int CE_id)
 	uint32_t mode = hif_get_conparam(scn);
 
 more_completions:
-	if (CE_state->recv_cb) {
+	if (CE_state->recv_cb && ce_rx_batch_enabled(CE_state)) {
+		if (ce_engine_service_recv_batch(hif_state, CE_state))
+			return;
+	} else if (CE_state->recv_cb) {
 
 		/* Pop completed recv buffers and call
 		 * the registered recv callback for each
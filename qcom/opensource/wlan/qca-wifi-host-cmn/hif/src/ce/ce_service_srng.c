@@ -540,6 +540,180 @@ done:
 	return status;
 }
 
+#ifdef HIF_CE_RX_BATCH
+/**
+ * ce_completed_recv_batch_nolock_srng() - Reap receive completions
+ * @CE_state: CE state
+ * @comp: array filled with the completions
+ * @max: size of @comp
+ *
+ * All the completions available, up to @max, are reaped in a single access
+ * of the status ring so its tail pointer is written once.
+ * The caller takes responsibility for any necessary locking.
+ *
+ * Return: number of completions reaped
+ */
+static uint32_t
+ce_completed_recv_batch_nolock_srng(struct CE_state *CE_state,
+				    struct ce_recv_completion *comp,
+				    uint32_t max)
+{
+	struct CE_ring_state *dest_ring = CE_state->dest_ring;
+	struct CE_ring_state *status_ring = CE_state->status_ring;
+	unsigned int nentries_mask = dest_ring->nentries_mask;
+	unsigned int sw_index = dest_ring->sw_index;
+	struct hif_softc *scn = CE_state->scn;
+	struct ce_srng_dest_status_desc *dest_status;
+	struct ce_srng_dest_status_desc dest_status_info;
+	uint32_t num = 0;
+
+	/* HP/TP update if any should happen only once per interrupt,
+	 * therefore checking for CE receive_count.
+	 */
+	hal_srng_check_and_update_hptp(scn->hal_soc, status_ring->srng_ctx,
+				       !CE_state->receive_count);
+
+	if (hal_srng_access_start(scn->hal_soc, status_ring->srng_ctx))
+		return 0;
+
+	while (num < max) {
+		dest_status = hal_srng_dst_peek(scn->hal_soc,
+						status_ring->srng_ctx);
+		if (!dest_status)
+			break;
+
+		dest_status_info = *dest_status;
+		if (!dest_status_info.nbytes) {
+			uint32_t hp, tp;
+
+			/* descriptor not written yet, see the single reap */
+			hal_get_sw_hptp(scn->hal_soc, status_ring->srng_ctx,
+					&tp, &hp);
+			hif_info_rl("No data to reap, hp %d tp %d", hp, tp);
+			break;
+		}
+
+		hal_srng_dst_get_next(scn->hal_soc, status_ring->srng_ctx);
+		dest_status->nbytes = 0;
+
+		comp[num].nbytes = dest_status_info.nbytes;
+		comp[num].transfer_id = dest_status_info.meta_data;
+		comp[num].flags = (dest_status_info.byte_swap) ?
+				  CE_RECV_FLAG_SWAPPED : 0;
+		comp[num].per_transfer_context =
+			dest_ring->per_transfer_context[sw_index];
+		dest_ring->per_transfer_context[sw_index] = 0;  /* sanity */
+
+		sw_index = CE_RING_IDX_INCR(nentries_mask, sw_index);
+
+		hif_record_ce_srng_desc_event(scn, CE_state->id,
+					      HIF_CE_DEST_STATUS_RING_REAP,
+					      (union ce_srng_desc *)dest_status,
+					      comp[num].per_transfer_context,
+					      sw_index, comp[num].nbytes,
+					      status_ring->srng_ctx);
+		num++;
+	}
+
+	if (!num) {
+		hal_srng_access_end_reap(scn->hal_soc, status_ring->srng_ctx);
+		return 0;
+	}
+
+	dest_ring->sw_index = sw_index;
+	hal_srng_access_end(scn->hal_soc, status_ring->srng_ctx);
+	hif_record_ce_srng_desc_event(scn, CE_state->id,
+				      HIF_CE_DEST_RING_BUFFER_REAP,
+				      NULL, NULL,
+				      dest_ring->sw_index, num,
+				      dest_ring->srng_ctx);
+
+	return num;
+}
+
+/**
+ * ce_recv_buf_enqueue_batch_srng() - Post several receive buffers
+ * @copyeng: copy engine handle
+ * @per_recv_context: virtual addresses of the nbufs
+ * @buffer: physical addresses of the nbufs
+ * @num: number of buffers
+ *
+ * Return: number of buffers posted
+ */
+static uint32_t
+ce_recv_buf_enqueue_batch_srng(struct CE_handle *copyeng,
+			       void **per_recv_context,
+			       qdf_dma_addr_t *buffer, uint32_t num)
+{
+	struct CE_state *CE_state = (struct CE_state *)copyeng;
+	struct CE_ring_state *dest_ring = CE_state->dest_ring;
+	unsigned int nentries_mask = dest_ring->nentries_mask;
+	unsigned int write_index;
+	struct hif_softc *scn = CE_state->scn;
+	struct ce_srng_dest_desc *dest_desc;
+	uint64_t dma_addr;
+	uint32_t avail;
+	uint32_t posted = 0;
+
+	qdf_spin_lock_bh(&CE_state->ce_index_lock);
+	write_index = dest_ring->write_index;
+
+	if (Q_TARGET_ACCESS_BEGIN(scn) < 0) {
+		qdf_spin_unlock_bh(&CE_state->ce_index_lock);
+		return 0;
+	}
+
+	/* HP/TP update if any should happen only once per interrupt,
+	 * therefore checking for CE receive_count.
+	 */
+	hal_srng_check_and_update_hptp(scn->hal_soc, dest_ring->srng_ctx,
+				       !CE_state->receive_count);
+
+	if (hal_srng_access_start(scn->hal_soc, dest_ring->srng_ctx)) {
+		Q_TARGET_ACCESS_END(scn);
+		qdf_spin_unlock_bh(&CE_state->ce_index_lock);
+		return 0;
+	}
+
+	avail = hal_srng_src_num_avail(scn->hal_soc, dest_ring->srng_ctx,
+				       false);
+	num = qdf_min(num, avail);
+
+	while (posted < num) {
+		dest_desc = hal_srng_src_get_next(scn->hal_soc,
+						  dest_ring->srng_ctx);
+		if (!dest_desc)
+			break;
+
+		dma_addr = buffer[posted];
+		CE_ADDR_COPY(dest_desc, dma_addr);
+
+		dest_ring->per_transfer_context[write_index] =
+			per_recv_context[posted];
+		write_index = CE_RING_IDX_INCR(nentries_mask, write_index);
+
+		hif_record_ce_srng_desc_event(scn, CE_state->id,
+					      HIF_CE_DEST_RING_BUFFER_POST,
+					      (union ce_srng_desc *)dest_desc,
+					      per_recv_context[posted],
+					      write_index, 0,
+					      dest_ring->srng_ctx);
+		posted++;
+	}
+
+	dest_ring->write_index = write_index;
+	if (posted)
+		hal_srng_access_end(scn->hal_soc, dest_ring->srng_ctx);
+	else
+		hal_srng_access_end_reap(scn->hal_soc, dest_ring->srng_ctx);
+
+	Q_TARGET_ACCESS_END(scn);
+	qdf_spin_unlock_bh(&CE_state->ce_index_lock);
+
+	return posted;
+}
+#endif /* HIF_CE_RX_BATCH */
+
 static QDF_STATUS
 ce_revoke_recv_next_srng(struct CE_handle *copyeng,
 		    void **per_CE_contextp,
@@ -1301,6 +1475,10 @@ static struct ce_ops ce_service_srng = {
 	.ce_srng_cleanup = ce_ring_cleanup_srng,
 	.ce_sendlist_send = ce_sendlist_send_srng,
 	.ce_completed_recv_next_nolock = ce_completed_recv_next_nolock_srng,
+#ifdef HIF_CE_RX_BATCH
+	.ce_completed_recv_batch_nolock = ce_completed_recv_batch_nolock_srng,
+	.ce_recv_buf_enqueue_batch = ce_recv_buf_enqueue_batch_srng,
+#endif
 	.ce_revoke_recv_next = ce_revoke_recv_next_srng,
 	.ce_cancel_send_next = ce_cancel_send_next_srng,
 	.ce_recv_buf_enqueue = ce_recv_buf_enqueue_srng,
@@ -141,4 +141,113 @@
 #define qdf_ht_get(table, cursor, entry_field, key, key_field) \
 	__qdf_ht_get(table, cursor, entry_field, key, key_field)
 
+/*
+ * qdf_rcu_ht - opaque resizable hashtable with lock-free lookups
+ *
+ * Lookups only need to be inside an RCU read-side critical section, they
+ * never take a lock and may run concurrently with additions, removals and
+ * resizing. Additions and removals serialize against each other internally
+ * per bucket, so callers do not need a lock of their own for the table.
+ * The table grows and shrinks in the background with the number of entries.
+ *
+ * Entries must not be freed or reused until an RCU grace period has elapsed
+ * after their removal, see qdf_call_rcu() and qdf_synchronize_rcu().
+ */
+#define qdf_rcu_ht __qdf_rcu_ht
+
+/*
+ * qdf_rcu_ht_entry - opaque entry for membership in a qdf_rcu_ht
+ */
+#define qdf_rcu_ht_entry __qdf_rcu_ht_entry
+
+/*
+ * qdf_rcu_ht_params - constant description of the entries of a qdf_rcu_ht
+ */
+#define qdf_rcu_ht_params __qdf_rcu_ht_params
+
+/**
+ * qdf_rcu_ht_params_init() - initializer for a qdf_rcu_ht_params instance
+ * @type: entry container struct type
+ * @entry_field: name of the qdf_rcu_ht_entry field in @type
+ * @key_field: name of the key field in @type, compared bytewise
+ * @hint: expected number of entries, used to size the initial table
+ *
+ * The params should be a static const instance so the add, remove and
+ * get operations can be specialized by the compiler.
+ */
+#define qdf_rcu_ht_params_init(type, entry_field, key_field, hint) \
+	__qdf_rcu_ht_params_init(type, entry_field, key_field, hint)
+
+/**
+ * qdf_rcu_ht_init() - initialize a qdf_rcu_ht instance
+ * @table: pointer to the qdf_rcu_ht instance to initialize
+ * @params: qdf_rcu_ht_params of the table, must outlive the table
+ *
+ * Return: QDF_STATUS
+ */
+#define qdf_rcu_ht_init(table, params) __qdf_rcu_ht_init(table, params)
+
+/**
+ * qdf_rcu_ht_deinit() - de-initialize a qdf_rcu_ht instance
+ * @table: pointer to the qdf_rcu_ht instance to de-initialize
+ * @free_cb: optional callback, void (*)(void *obj, void *arg), called for
+ *	each remaining entry container
+ * @arg: context passed to @free_cb
+ *
+ * Must not run concurrently with any other operation on @table. May sleep.
+ *
+ * Return: none
+ */
+#define qdf_rcu_ht_deinit(table, free_cb, arg) \
+	__qdf_rcu_ht_deinit(table, free_cb, arg)
+
+/**
+ * qdf_rcu_ht_count() - number of entries in a qdf_rcu_ht
+ * @table: pointer to the qdf_rcu_ht instance
+ *
+ * Return: number of entries
+ */
+#define qdf_rcu_ht_count(table) __qdf_rcu_ht_count(table)
+
+/**
+ * qdf_rcu_ht_add() - add an entry to a qdf_rcu_ht instance
+ * @table: pointer to the qdf_rcu_ht instance to add an entry to
+ * @entry: pointer to the qdf_rcu_ht_entry of the container to add
+ * @params: qdf_rcu_ht_params of @table
+ *
+ * Safe to call from any context.
+ *
+ * Return: QDF_STATUS_E_EXISTS if an entry with the same key is present,
+ *	   QDF_STATUS_SUCCESS on success, other errors on allocation failure
+ */
+#define qdf_rcu_ht_add(table, entry, params) \
+	__qdf_rcu_ht_add(table, entry, params)
+
+/**
+ * qdf_rcu_ht_remove() - remove an entry from a qdf_rcu_ht instance
+ * @table: pointer to the qdf_rcu_ht instance to remove an entry from
+ * @entry: pointer to the qdf_rcu_ht_entry of the container to remove
+ * @params: qdf_rcu_ht_params of @table
+ *
+ * Safe to call from any context.
+ *
+ * Return: QDF_STATUS_E_NOENT if @entry is not in @table, else
+ *	   QDF_STATUS_SUCCESS
+ */
+#define qdf_rcu_ht_remove(table, entry, params) \
+	__qdf_rcu_ht_remove(table, entry, params)
+
+/**
+ * qdf_rcu_ht_get() - get the entry container with a key matching @key
+ * @table: pointer to the qdf_rcu_ht instance to look in
+ * @key: pointer to the key to look up
+ * @params: qdf_rcu_ht_params of @table
+ *
+ * Must be called inside an RCU read-side critical section, the returned
+ * container is only guaranteed to be valid until the end of it.
+ *
+ * Return: pointer to the entry container, NULL if not found
+ */
+#define qdf_rcu_ht_get(table, key, params) __qdf_rcu_ht_get(table, key, params)
+
 #endif /* __QDF_HASHTABLE_H */
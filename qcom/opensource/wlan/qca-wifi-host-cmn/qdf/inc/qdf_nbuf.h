@@ -4778,6 +4778,20 @@ static inline void qdf_nbuf_set_gso_type_udp_l4(qdf_nbuf_t nbuf)
 	__qdf_nbuf_set_gso_type_udp_l4(nbuf);
 }
 
+/**
+ * qdf_nbuf_set_gso_type_udp_l4_fraglist() - set the gso type to GSO UDP L4
+ *					     with fraglist segmentation
+ * @nbuf: Network buffer
+ *
+ * Falls back to plain GSO UDP L4 when the kernel has no fraglist GSO.
+ *
+ * Return: true if fraglist GSO is set, false otherwise
+ */
+static inline bool qdf_nbuf_set_gso_type_udp_l4_fraglist(qdf_nbuf_t nbuf)
+{
+	return __qdf_nbuf_set_gso_type_udp_l4_fraglist(nbuf);
+}
+
 /**
  * qdf_nbuf_set_ip_summed_partial() - set the ip summed to CHECKSUM_PARTIAL
  * @nbuf: Network buffer
@@ -5052,6 +5066,17 @@ static inline void qdf_nbuf_set_priority(qdf_nbuf_t buf, uint32_t p)
 	__qdf_nbuf_set_priority(buf, p);
 }
 
+/**
+ * qdf_nbuf_get_sk_priority() - get the priority of the originating socket
+ * @buf: Network buffer
+ *
+ * Return: socket priority, 0 for packets without a local socket
+ */
+static inline uint32_t qdf_nbuf_get_sk_priority(qdf_nbuf_t buf)
+{
+	return __qdf_nbuf_get_sk_priority(buf);
+}
+
 static inline void qdf_nbuf_record_rx_queue(qdf_nbuf_t buf, uint32_t queue_id)
 {
 	__qdf_nbuf_record_rx_queue(buf, queue_id);
@@ -5111,6 +5136,21 @@ qdf_nbuf_get_last_frag_list_nbuf(qdf_nbuf_t nbuf)
 unsigned int qdf_nbuf_update_radiotap(struct mon_rx_status *rx_status,
 				      qdf_nbuf_t nbuf, uint32_t headroom_sz);
 
+/**
+ * qdf_nbuf_build_radiotap_in_headroom() - build radiotap directly in the
+ *					   headroom of a frag only nbuf
+ * @rx_status: rx_status containing required info to build radiotap
+ * @nbuf: nbuf with an empty linear part, payload held in page frags
+ *
+ * Unlike qdf_nbuf_update_radiotap(), the header is not built on the stack
+ * and copied; it is written in place and becomes the linear part of @nbuf.
+ * Needs RADIOTAP_HEADER_LEN bytes of headroom.
+ *
+ * Return: radiotap length, 0 if not built
+ */
+unsigned int qdf_nbuf_build_radiotap_in_headroom(struct mon_rx_status *rx_status,
+						 qdf_nbuf_t nbuf);
+
 /**
  * qdf_nbuf_mark_wakeup_frame() - mark wakeup frame.
  * @buf: Pointer to nbuf
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: qdf_objpool.h - typed object pools
+ *
+ * An object pool hands out fixed size objects of one type from a cache
+ * backed by the OS slab allocator. Freed objects go back to a per-CPU cache
+ * and are reused by the next allocation on that CPU, which is cheaper than
+ * a generic allocation and keeps objects of one type packed together instead
+ * of fragmenting the generic size classes.
+ *
+ * Each pool keeps in use, high water, allocation and failure counters which
+ * are reported along with the major allocations in the memory debugfs.
+ */
+
+#ifndef __QDF_OBJPOOL_H
+#define __QDF_OBJPOOL_H
+
+#include "i_qdf_objpool.h"
+#include "qdf_atomic.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+
+#define QDF_OBJPOOL_NAME_SIZE 32
+
+/**
+ * typedef qdf_objpool_ctor_t - object constructor
+ * @obj: object to construct
+ *
+ * Called when the pool populates new backing memory, not on every
+ * allocation. Objects must therefore be returned to the pool in their
+ * constructed state.
+ */
+typedef void (*qdf_objpool_ctor_t)(void *obj);
+
+/**
+ * struct qdf_objpool - a typed object pool
+ * @cache: backing OS object cache
+ * @name: name of the pool, shown in the memory debugfs
+ * @obj_size: size of the objects
+ * @ctor: object constructor, NULL if objects are zeroed on allocation
+ * @in_use: number of objects currently allocated
+ * @high_water: largest value @in_use has reached
+ * @allocs: number of successful allocations
+ * @alloc_fail: number of failed allocations
+ * @node: membership in the list of pools
+ */
+struct qdf_objpool {
+	__qdf_objpool_cache_t cache;
+	char name[QDF_OBJPOOL_NAME_SIZE];
+	qdf_size_t obj_size;
+	qdf_objpool_ctor_t ctor;
+	qdf_atomic_t in_use;
+	qdf_atomic_t high_water;
+	qdf_atomic_t allocs;
+	qdf_atomic_t alloc_fail;
+	__qdf_objpool_node_t node;
+};
+
+/**
+ * struct qdf_objpool_stats - snapshot of the object pool counters
+ * @obj_size: size of the objects
+ * @in_use: number of objects currently allocated
+ * @high_water: largest number of objects allocated at the same time
+ * @allocs: number of successful allocations
+ * @alloc_fail: number of failed allocations
+ */
+struct qdf_objpool_stats {
+	uint32_t obj_size;
+	uint32_t in_use;
+	uint32_t high_water;
+	uint32_t allocs;
+	uint32_t alloc_fail;
+};
+
+/**
+ * qdf_objpool_create() - create an object pool
+ * @name: name of the pool
+ * @obj_size: size of the objects
+ * @ctor: optional object constructor
+ *
+ * Without a constructor, objects are zeroed on every allocation like
+ * qdf_mem_malloc() does. May sleep.
+ *
+ * Return: new object pool, NULL on failure
+ */
+struct qdf_objpool *qdf_objpool_create(const char *name, qdf_size_t obj_size,
+				       qdf_objpool_ctor_t ctor);
+
+/**
+ * qdf_objpool_create_type() - create a pool of objects of a given type
+ * @name: name of the pool
+ * @type: type of the objects
+ * @ctor: optional object constructor
+ *
+ * Return: new object pool, NULL on failure
+ */
+#define qdf_objpool_create_type(name, type, ctor) \
+	qdf_objpool_create(name, sizeof(type), ctor)
+
+/**
+ * qdf_objpool_destroy() - destroy an object pool
+ * @pool: pool to destroy, may be NULL
+ *
+ * All objects must have been returned to the pool. May sleep.
+ *
+ * Return: None
+ */
+void qdf_objpool_destroy(struct qdf_objpool *pool);
+
+/**
+ * qdf_objpool_alloc() - allocate an object from a pool
+ * @pool: pool to allocate from
+ *
+ * Safe to call from any context.
+ *
+ * Return: constructed or zeroed object, NULL on failure
+ */
+void *qdf_objpool_alloc(struct qdf_objpool *pool);
+
+/**
+ * qdf_objpool_alloc_type() - allocate a typed object from a pool
+ * @pool: pool to allocate from
+ * @type: type of the object
+ *
+ * Return: constructed or zeroed object, NULL on failure
+ */
+#define qdf_objpool_alloc_type(pool, type) \
+	((type *)qdf_objpool_alloc(pool))
+
+/**
+ * qdf_objpool_free() - return an object to its pool
+ * @pool: pool the object was allocated from
+ * @obj: object to free, may be NULL
+ *
+ * Return: None
+ */
+void qdf_objpool_free(struct qdf_objpool *pool, void *obj);
+
+/**
+ * qdf_objpool_get_stats() - get a snapshot of the pool counters
+ * @pool: object pool
+ * @stats: filled with the counters of @pool
+ *
+ * Return: None
+ */
+void qdf_objpool_get_stats(struct qdf_objpool *pool,
+			   struct qdf_objpool_stats *stats);
+
+/**
+ * qdf_objpool_print_all() - print the counters of all object pools
+ * @print: the print adapter function
+ * @print_priv: the private data to be consumed by @print
+ * @threshold: only print pools whose high water reached this many objects
+ *
+ * Return: None
+ */
+void qdf_objpool_print_all(qdf_abstract_print print, void *print_priv,
+			   uint32_t threshold);
+
+#endif /* __QDF_OBJPOOL_H */
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: qdf_rcu.h - Public APIs for read-copy-update synchronization
+ */
+
+#ifndef __QDF_RCU_H
+#define __QDF_RCU_H
+
+#include "i_qdf_rcu.h"
+
+/*
+ * qdf_rcu_head_t - opaque callback head embedded in RCU freed objects
+ */
+typedef __qdf_rcu_head_t qdf_rcu_head_t;
+
+/*
+ * qdf_rcu - annotates a pointer which must only be accessed through the
+ * qdf_rcu_*() APIs, e.g. struct foo qdf_rcu *p;
+ */
+#define qdf_rcu __qdf_rcu
+
+/**
+ * qdf_rcu_read_lock() - enter an RCU read-side critical section
+ *
+ * Return: none
+ */
+#define qdf_rcu_read_lock() __qdf_rcu_read_lock()
+
+/**
+ * qdf_rcu_read_unlock() - leave an RCU read-side critical section
+ *
+ * Return: none
+ */
+#define qdf_rcu_read_unlock() __qdf_rcu_read_unlock()
+
+/**
+ * qdf_rcu_dereference() - fetch an RCU protected pointer for reading
+ * @p: pointer to read, only valid inside a read-side critical section
+ *
+ * Return: value of @p
+ */
+#define qdf_rcu_dereference(p) __qdf_rcu_dereference(p)
+
+/**
+ * qdf_rcu_dereference_protected() - fetch an RCU protected pointer when
+ * updates are prevented, e.g. by the writer lock
+ * @p: pointer to read
+ * @c: condition under which the access is safe
+ *
+ * Return: value of @p
+ */
+#define qdf_rcu_dereference_protected(p, c) \
+	__qdf_rcu_dereference_protected(p, c)
+
+/**
+ * qdf_rcu_access_pointer() - fetch an RCU protected pointer without
+ * dereferencing it, e.g. to compare it against NULL
+ * @p: pointer to read
+ *
+ * Return: value of @p
+ */
+#define qdf_rcu_access_pointer(p) __qdf_rcu_access_pointer(p)
+
+/**
+ * qdf_rcu_assign_pointer() - publish an RCU protected pointer
+ * @p: pointer to assign
+ * @v: value to publish, fully initialized before this call
+ *
+ * Return: none
+ */
+#define qdf_rcu_assign_pointer(p, v) __qdf_rcu_assign_pointer(p, v)
+
+/**
+ * qdf_call_rcu() - invoke a callback after a grace period
+ * @head: qdf_rcu_head_t embedded in the object to be reclaimed
+ * @func: callback, runs in softirq context
+ *
+ * Return: none
+ */
+#define qdf_call_rcu(head, func) __qdf_call_rcu(head, func)
+
+/**
+ * qdf_synchronize_rcu() - wait for a grace period, may sleep
+ *
+ * Return: none
+ */
+#define qdf_synchronize_rcu() __qdf_synchronize_rcu()
+
+/**
+ * qdf_rcu_barrier() - wait for all pending qdf_call_rcu() callbacks, may sleep
+ *
+ * Return: none
+ */
+#define qdf_rcu_barrier() __qdf_rcu_barrier()
+
+#endif /* __QDF_RCU_H */
@@ -340,6 +340,12 @@ typedef __qdf_wait_queue_head_t qdf_wait_queue_head_t;
  */
 #define qdf_in_interrupt  __qdf_in_interrupt
 
+/**
+ * qdf_in_task - returns true if in task context, also with bottom halves
+ *		 disabled, and not in irq or softirq handling
+ */
+#define qdf_in_task  __qdf_in_task
+
 /**
  * qdf_is_macaddr_equal() - compare two QDF MacAddress
  * @mac_addr1: Pointer to one qdf MacAddress to compare
@@ -20,6 +20,8 @@
 #define __I_QDF_HASHTABLE_H
 
 #include "linux/hashtable.h"
+#include "linux/rhashtable.h"
+#include "qdf_status.h"
 
 #define __qdf_ht hlist_head
 #define __qdf_ht_entry hlist_node
@@ -50,4 +52,35 @@ do { \
 #define __qdf_ht_for_each_safe(table, i, tmp, cursor, entry_field) \
 	hash_for_each_safe(table, i, tmp, cursor, entry_field)
 
+#define __qdf_rcu_ht rhashtable
+#define __qdf_rcu_ht_entry rhash_head
+#define __qdf_rcu_ht_params rhashtable_params
+
+#define __qdf_rcu_ht_params_init(type, entry_field, key_field, hint) \
+{ \
+	.head_offset = offsetof(type, entry_field), \
+	.key_offset = offsetof(type, key_field), \
+	.key_len = sizeof_field(type, key_field), \
+	.nelem_hint = (hint), \
+	.automatic_shrinking = true, \
+}
+
+#define __qdf_rcu_ht_init(table, params) \
+	qdf_status_from_os_return(rhashtable_init(table, &(params)))
+
+#define __qdf_rcu_ht_deinit(table, free_cb, arg) \
+	rhashtable_free_and_destroy(table, free_cb, arg)
+
+#define __qdf_rcu_ht_count(table) atomic_read(&(table)->nelems)
+
+#define __qdf_rcu_ht_add(table, entry, params) \
+	qdf_status_from_os_return(rhashtable_lookup_insert_fast(table, entry, \
+								params))
+
+#define __qdf_rcu_ht_remove(table, entry, params) \
+	qdf_status_from_os_return(rhashtable_remove_fast(table, entry, params))
+
+#define __qdf_rcu_ht_get(table, key, params) \
+	rhashtable_lookup(table, key, params)
+
 #endif /* __I_QDF_HASHTABLE_H */
@@ -37,6 +37,7 @@
 #include <qdf_util.h>
 #include <qdf_mem.h>
 #include <linux/tcp.h>
+#include <net/sock.h>
 #include <qdf_util.h>
 #include <qdf_nbuf_frag.h>
 #include "qdf_time.h"
@@ -1743,6 +1744,24 @@ static inline void __qdf_nbuf_set_priority(struct sk_buff *skb, uint32_t p)
 	skb->priority = p;
 }
 
+/**
+ * __qdf_nbuf_get_sk_priority() - return the priority of the socket which
+ *				  originated the skb
+ * @skb: Pointer to network buffer
+ *
+ * Unlike skb->priority, which the driver rewrites with the user priority,
+ * this is the value the application set with SO_PRIORITY.
+ *
+ * Return: socket priority, 0 if the skb has no full socket attached
+ */
+static inline uint32_t __qdf_nbuf_get_sk_priority(struct sk_buff *skb)
+{
+	if (!skb->sk || !sk_fullsock(skb->sk))
+		return 0;
+
+	return READ_ONCE(skb->sk->sk_priority);
+}
+
 /**
  * __qdf_nbuf_set_next() - sets the next skb pointer of the current skb
  * @skb: Current skb
@@ -3215,6 +3234,27 @@ static inline void __qdf_nbuf_set_gso_type_udp_l4(struct sk_buff *skb)
 	skb_shinfo(skb)->gso_type = SKB_GSO_UDP_L4;
 }
 
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(5, 6, 0))
+/**
+ * __qdf_nbuf_set_gso_type_udp_l4_fraglist() - set the gso type to GSO UDP L4
+ *					       with fraglist segmentation
+ * @skb: Pointer to network buffer
+ *
+ * Return: true if fraglist GSO is supported and set, false otherwise
+ */
+static inline bool __qdf_nbuf_set_gso_type_udp_l4_fraglist(struct sk_buff *skb)
+{
+	skb_shinfo(skb)->gso_type = SKB_GSO_UDP_L4 | SKB_GSO_FRAGLIST;
+	return true;
+}
+#else
+static inline bool __qdf_nbuf_set_gso_type_udp_l4_fraglist(struct sk_buff *skb)
+{
+	skb_shinfo(skb)->gso_type = SKB_GSO_UDP_L4;
+	return false;
+}
+#endif
+
 /**
  * __qdf_nbuf_set_ip_summed_partial() - set the ip summed to CHECKSUM_PARTIAL
  * @skb: Pointer to network buffer
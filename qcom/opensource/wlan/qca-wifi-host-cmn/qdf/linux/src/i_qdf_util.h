@@ -173,6 +173,7 @@ static inline bool __qdf_is_macaddr_equal(const struct qdf_mac_addr *mac_addr1,
 }
 
 #define __qdf_in_interrupt in_interrupt
+#define __qdf_in_task in_task
 
 #define __qdf_min(_a, _b) min(_a, _b)
 #define __qdf_max(_a, _b) max(_a, _b)
@@ -28,6 +28,7 @@
 #include "qdf_lock.h"
 #include "qdf_mc_timer.h"
 #include "qdf_module.h"
+#include "qdf_objpool.h"
 #include <qdf_trace.h>
 #include "qdf_str.h"
 #include "qdf_talloc.h"
@@ -700,6 +701,12 @@ static int qdf_major_alloc_show(struct seq_file *seq, void *v)
 				     priv->threshold,
 				     qdf_print_major_alloc);
 
+	/* object pools are not per domain, report them once */
+	if (priv->type == LIST_TYPE_MEM && domain_id == QDF_DEBUG_DOMAIN_INIT) {
+		seq_puts(seq, "\nObject Pools\n");
+		qdf_objpool_print_all(seq_printf_printer, seq, priv->threshold);
+	}
+
 	return 0;
 }
 
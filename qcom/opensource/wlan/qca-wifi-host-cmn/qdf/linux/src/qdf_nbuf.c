@@ -5477,10 +5477,16 @@ static unsigned int qdf_nbuf_update_radiotap_tx_flags(
 	return rtap_len;
 }
 
-unsigned int qdf_nbuf_update_radiotap(struct mon_rx_status *rx_status,
-				      qdf_nbuf_t nbuf, uint32_t headroom_sz)
+/**
+ * qdf_nbuf_build_radiotap() - build the radiotap header from rx_status
+ * @rx_status: rx_status containing required info to build radiotap
+ * @rtap_buf: zeroed buffer of RADIOTAP_HEADER_LEN bytes
+ *
+ * Return: radiotap length, 0 on error
+ */
+static unsigned int qdf_nbuf_build_radiotap(struct mon_rx_status *rx_status,
+					    uint8_t *rtap_buf)
 {
-	uint8_t rtap_buf[RADIOTAP_HEADER_LEN] = {0};
 	struct ieee80211_radiotap_header *rthdr =
 		(struct ieee80211_radiotap_header *)rtap_buf;
 	uint32_t rtap_hdr_len = sizeof(struct ieee80211_radiotap_header);
@@ -5781,6 +5787,19 @@ unsigned int qdf_nbuf_update_radiotap(struct mon_rx_status *rx_status,
 	put_unaligned_le32(it_present_val, it_present);
 	rthdr->it_len = cpu_to_le16(rtap_len);
 
+	return rtap_len;
+}
+
+unsigned int qdf_nbuf_update_radiotap(struct mon_rx_status *rx_status,
+				      qdf_nbuf_t nbuf, uint32_t headroom_sz)
+{
+	uint8_t rtap_buf[RADIOTAP_HEADER_LEN] = {0};
+	unsigned int rtap_len;
+
+	rtap_len = qdf_nbuf_build_radiotap(rx_status, rtap_buf);
+	if (!rtap_len)
+		return 0;
+
 	if (headroom_sz < rtap_len) {
 		qdf_debug("DEBUG: Not enough space to update radiotap");
 		return 0;
@@ -5790,6 +5809,33 @@ unsigned int qdf_nbuf_update_radiotap(struct mon_rx_status *rx_status,
 	qdf_mem_copy(qdf_nbuf_data(nbuf), rtap_buf, rtap_len);
 	return rtap_len;
 }
+
+unsigned int qdf_nbuf_build_radiotap_in_headroom(struct mon_rx_status *rx_status,
+						 qdf_nbuf_t nbuf)
+{
+	uint8_t *rtap_buf;
+	unsigned int rtap_len;
+
+	/*
+	 * The linear part must be empty: the header is then built where it
+	 * ends up and becomes the whole linear part in front of the frags.
+	 */
+	if (skb_headlen(nbuf) || skb_headroom(nbuf) < RADIOTAP_HEADER_LEN)
+		return 0;
+
+	rtap_buf = nbuf->data - RADIOTAP_HEADER_LEN;
+	qdf_mem_zero(rtap_buf, RADIOTAP_HEADER_LEN);
+
+	rtap_len = qdf_nbuf_build_radiotap(rx_status, rtap_buf);
+	if (!rtap_len)
+		return 0;
+
+	nbuf->data = rtap_buf;
+	skb_set_tail_pointer(nbuf, rtap_len);
+	nbuf->len += rtap_len;
+
+	return rtap_len;
+}
 #else
 static unsigned int qdf_nbuf_update_radiotap_vht_flags(
 					struct mon_rx_status *rx_status,
@@ -5822,8 +5868,16 @@ unsigned int qdf_nbuf_update_radiotap(struct mon_rx_status *rx_status,
 	qdf_err("ERROR: struct ieee80211_radiotap_header not supported");
 	return 0;
 }
+
+unsigned int qdf_nbuf_build_radiotap_in_headroom(struct mon_rx_status *rx_status,
+						 qdf_nbuf_t nbuf)
+{
+	qdf_err("ERROR: struct ieee80211_radiotap_header not supported");
+	return 0;
+}
 #endif
 qdf_export_symbol(qdf_nbuf_update_radiotap);
+qdf_export_symbol(qdf_nbuf_build_radiotap_in_headroom);
 
 void __qdf_nbuf_reg_free_cb(qdf_nbuf_free_t cb_func_ptr)
 {
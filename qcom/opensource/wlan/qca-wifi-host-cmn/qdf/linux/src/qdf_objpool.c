@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: qdf_objpool.c
+ *
+ * Linux implementation of the QDF object pools on top of kmem caches
+ */
+
+#include <linux/spinlock.h>
+#include "qdf_mem.h"
+#include "qdf_module.h"
+#include "qdf_objpool.h"
+#include "qdf_str.h"
+
+static LIST_HEAD(qdf_objpool_list);
+static DEFINE_SPINLOCK(qdf_objpool_list_lock);
+
+struct qdf_objpool *qdf_objpool_create(const char *name, qdf_size_t obj_size,
+				       qdf_objpool_ctor_t ctor)
+{
+	struct qdf_objpool *pool;
+
+	if (!name || !obj_size)
+		return NULL;
+
+	pool = qdf_mem_malloc(sizeof(*pool));
+	if (!pool)
+		return NULL;
+
+	/* the cache keeps a reference to its name */
+	qdf_str_lcopy(pool->name, name, sizeof(pool->name));
+	pool->obj_size = obj_size;
+	pool->ctor = ctor;
+	pool->cache = kmem_cache_create(pool->name, obj_size, 0,
+					SLAB_HWCACHE_ALIGN, ctor);
+	if (!pool->cache) {
+		qdf_err("Failed to create object pool %s", name);
+		qdf_mem_free(pool);
+		return NULL;
+	}
+
+	qdf_atomic_init(&pool->in_use);
+	qdf_atomic_init(&pool->high_water);
+	qdf_atomic_init(&pool->allocs);
+	qdf_atomic_init(&pool->alloc_fail);
+
+	spin_lock_bh(&qdf_objpool_list_lock);
+	list_add_tail(&pool->node, &qdf_objpool_list);
+	spin_unlock_bh(&qdf_objpool_list_lock);
+
+	return pool;
+}
+
+qdf_export_symbol(qdf_objpool_create);
+
+void qdf_objpool_destroy(struct qdf_objpool *pool)
+{
+	int32_t in_use;
+
+	if (!pool)
+		return;
+
+	spin_lock_bh(&qdf_objpool_list_lock);
+	list_del(&pool->node);
+	spin_unlock_bh(&qdf_objpool_list_lock);
+
+	in_use = qdf_atomic_read(&pool->in_use);
+	if (in_use)
+		qdf_err("Object pool %s destroyed with %d objects in use",
+			pool->name, in_use);
+
+	kmem_cache_destroy(pool->cache);
+	qdf_mem_free(pool);
+}
+
+qdf_export_symbol(qdf_objpool_destroy);
+
+void *qdf_objpool_alloc(struct qdf_objpool *pool)
+{
+	gfp_t flags = qdf_mem_malloc_flags();
+	int32_t in_use;
+	void *obj;
+
+	if (!pool->ctor)
+		flags |= __GFP_ZERO;
+
+	obj = kmem_cache_alloc(pool->cache, flags);
+	if (qdf_unlikely(!obj)) {
+		qdf_atomic_inc(&pool->alloc_fail);
+		return NULL;
+	}
+
+	qdf_atomic_inc(&pool->allocs);
+	in_use = qdf_atomic_inc_return(&pool->in_use);
+
+	/* racy by design, a concurrent update may only be off by a few */
+	if (in_use > qdf_atomic_read(&pool->high_water))
+		qdf_atomic_set(&pool->high_water, in_use);
+
+	return obj;
+}
+
+qdf_export_symbol(qdf_objpool_alloc);
+
+void qdf_objpool_free(struct qdf_objpool *pool, void *obj)
+{
+	if (!obj)
+		return;
+
+	qdf_atomic_dec(&pool->in_use);
+	kmem_cache_free(pool->cache, obj);
+}
+
+qdf_export_symbol(qdf_objpool_free);
+
+void qdf_objpool_get_stats(struct qdf_objpool *pool,
+			   struct qdf_objpool_stats *stats)
+{
+	stats->obj_size = pool->obj_size;
+	stats->in_use = qdf_atomic_read(&pool->in_use);
+	stats->high_water = qdf_atomic_read(&pool->high_water);
+	stats->allocs = qdf_atomic_read(&pool->allocs);
+	stats->alloc_fail = qdf_atomic_read(&pool->alloc_fail);
+}
+
+qdf_export_symbol(qdf_objpool_get_stats);
+
+void qdf_objpool_print_all(qdf_abstract_print print, void *print_priv,
+			   uint32_t threshold)
+{
+	struct qdf_objpool_stats stats;
+	struct qdf_objpool *pool;
+
+	print(print_priv, "%-24s %8s %8s %10s %10s %10s",
+	      "object pool", "size", "in use", "high water", "allocs",
+	      "failures");
+
+	spin_lock_bh(&qdf_objpool_list_lock);
+	list_for_each_entry(pool, &qdf_objpool_list, node) {
+		qdf_objpool_get_stats(pool, &stats);
+		if (stats.high_water < threshold)
+			continue;
+
+		print(print_priv, "%-24s %8u %8u %10u %10u %10u",
+		      pool->name, stats.obj_size, stats.in_use,
+		      stats.high_water, stats.allocs, stats.alloc_fail);
+	}
+	spin_unlock_bh(&qdf_objpool_list_lock);
+}
+
+qdf_export_symbol(qdf_objpool_print_all);
@@ -16,8 +16,12 @@
  * PERFORMANCE OF THIS SOFTWARE.
  */
 
+#include "qdf_atomic.h"
 #include "qdf_hashtable.h"
 #include "qdf_hashtable_test.h"
+#include "qdf_mem.h"
+#include "qdf_rcu.h"
+#include "qdf_threads.h"
 #include "qdf_trace.h"
 
 /* 16 buckets */
@@ -74,11 +78,194 @@ static uint32_t qdf_ht_test_single(void)
 	return 0;
 }
 
+/* enough entries to grow the table several times past its initial size */
+#define QDF_RCU_HT_STABLE_COUNT 64
+#define QDF_RCU_HT_CHURN_COUNT 1024
+#define QDF_RCU_HT_CHURN_ROUNDS 16
+#define QDF_RCU_HT_READERS 2
+
+struct qdf_rcu_ht_test_item {
+	struct qdf_rcu_ht_entry entry;
+	uint32_t key;
+};
+
+static const struct qdf_rcu_ht_params qdf_rcu_ht_test_params =
+	qdf_rcu_ht_params_init(struct qdf_rcu_ht_test_item, entry, key, 16);
+
+struct qdf_rcu_ht_test_ctx {
+	struct qdf_rcu_ht table;
+	struct qdf_rcu_ht_test_item *stable;
+	struct qdf_rcu_ht_test_item *churn;
+	qdf_atomic_t lookups;
+	qdf_atomic_t misses;
+};
+
+static uint32_t qdf_rcu_ht_test_single(void)
+{
+	struct qdf_rcu_ht_test_item item = { .key = 1 };
+	struct qdf_rcu_ht_test_item dup = { .key = 1 };
+	struct qdf_rcu_ht_test_item *cursor;
+	struct qdf_rcu_ht table;
+	uint32_t key = 1;
+
+	QDF_BUG(QDF_IS_STATUS_SUCCESS(qdf_rcu_ht_init(&table,
+						      qdf_rcu_ht_test_params)));
+
+	/* a table should ... */
+	QDF_BUG(QDF_IS_STATUS_SUCCESS(qdf_rcu_ht_add(&table, &item.entry,
+						     qdf_rcu_ht_test_params)));
+	QDF_BUG(qdf_rcu_ht_count(&table) == 1);
+
+	/* ... find an added entry */
+	qdf_rcu_read_lock();
+	cursor = qdf_rcu_ht_get(&table, &key, qdf_rcu_ht_test_params);
+	QDF_BUG(cursor == &item);
+	qdf_rcu_read_unlock();
+
+	/* ... reject a duplicate key */
+	QDF_BUG(qdf_rcu_ht_add(&table, &dup.entry, qdf_rcu_ht_test_params) ==
+		QDF_STATUS_E_EXISTS);
+	QDF_BUG(qdf_rcu_ht_count(&table) == 1);
+
+	/* ... not find a removed entry */
+	QDF_BUG(QDF_IS_STATUS_SUCCESS(qdf_rcu_ht_remove(&table, &item.entry,
+							qdf_rcu_ht_test_params)));
+	qdf_rcu_read_lock();
+	cursor = qdf_rcu_ht_get(&table, &key, qdf_rcu_ht_test_params);
+	QDF_BUG(!cursor);
+	qdf_rcu_read_unlock();
+
+	/* ... fail to remove an entry twice */
+	QDF_BUG(qdf_rcu_ht_remove(&table, &item.entry,
+				  qdf_rcu_ht_test_params) ==
+		QDF_STATUS_E_NOENT);
+	QDF_BUG(!qdf_rcu_ht_count(&table));
+
+	qdf_rcu_ht_deinit(&table, NULL, NULL);
+
+	return 0;
+}
+
+static QDF_STATUS qdf_rcu_ht_test_reader(void *context)
+{
+	struct qdf_rcu_ht_test_ctx *ctx = context;
+	struct qdf_rcu_ht_test_item *cursor;
+	uint32_t key;
+	int i;
+
+	while (!qdf_thread_should_stop()) {
+		for (i = 0; i < QDF_RCU_HT_STABLE_COUNT; i++) {
+			key = ctx->stable[i].key;
+
+			qdf_rcu_read_lock();
+			cursor = qdf_rcu_ht_get(&ctx->table, &key,
+						qdf_rcu_ht_test_params);
+			if (!cursor || cursor->key != key)
+				qdf_atomic_inc(&ctx->misses);
+			qdf_rcu_read_unlock();
+
+			qdf_atomic_inc(&ctx->lookups);
+		}
+
+		qdf_sleep_us(10);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static uint32_t qdf_rcu_ht_test_concurrent(void)
+{
+	qdf_thread_t *readers[QDF_RCU_HT_READERS];
+	struct qdf_rcu_ht_test_ctx *ctx;
+	uint32_t errors = 0;
+	int round, i;
+
+	ctx = qdf_mem_malloc(sizeof(*ctx));
+	if (!ctx)
+		return 1;
+
+	ctx->stable = qdf_mem_malloc(sizeof(*ctx->stable) *
+				     QDF_RCU_HT_STABLE_COUNT);
+	ctx->churn = qdf_mem_malloc(sizeof(*ctx->churn) *
+				    QDF_RCU_HT_CHURN_COUNT);
+	if (!ctx->stable || !ctx->churn) {
+		errors++;
+		goto free_ctx;
+	}
+
+	QDF_BUG(QDF_IS_STATUS_SUCCESS(qdf_rcu_ht_init(&ctx->table,
+						      qdf_rcu_ht_test_params)));
+	qdf_atomic_init(&ctx->lookups);
+	qdf_atomic_init(&ctx->misses);
+
+	/* even keys stay in the table, odd keys come and go */
+	for (i = 0; i < QDF_RCU_HT_STABLE_COUNT; i++) {
+		ctx->stable[i].key = i * 2;
+		QDF_BUG(QDF_IS_STATUS_SUCCESS(
+			qdf_rcu_ht_add(&ctx->table, &ctx->stable[i].entry,
+				       qdf_rcu_ht_test_params)));
+	}
+
+	for (i = 0; i < QDF_RCU_HT_CHURN_COUNT; i++)
+		ctx->churn[i].key = i * 2 + 1;
+
+	for (i = 0; i < QDF_RCU_HT_READERS; i++) {
+		readers[i] = qdf_thread_run(qdf_rcu_ht_test_reader, ctx);
+		QDF_BUG(readers[i]);
+	}
+
+	/* readers should always find the stable keys while the table ... */
+	for (round = 0; round < QDF_RCU_HT_CHURN_ROUNDS; round++) {
+		/* ... grows */
+		for (i = 0; i < QDF_RCU_HT_CHURN_COUNT; i++)
+			QDF_BUG(QDF_IS_STATUS_SUCCESS(
+				qdf_rcu_ht_add(&ctx->table,
+					       &ctx->churn[i].entry,
+					       qdf_rcu_ht_test_params)));
+		QDF_BUG(qdf_rcu_ht_count(&ctx->table) ==
+			QDF_RCU_HT_STABLE_COUNT + QDF_RCU_HT_CHURN_COUNT);
+
+		/* ... and shrinks again */
+		for (i = 0; i < QDF_RCU_HT_CHURN_COUNT; i++)
+			QDF_BUG(QDF_IS_STATUS_SUCCESS(
+				qdf_rcu_ht_remove(&ctx->table,
+						  &ctx->churn[i].entry,
+						  qdf_rcu_ht_test_params)));
+		QDF_BUG(qdf_rcu_ht_count(&ctx->table) ==
+			QDF_RCU_HT_STABLE_COUNT);
+
+		/* removed entries are reused, wait for the readers first */
+		qdf_synchronize_rcu();
+	}
+
+	for (i = 0; i < QDF_RCU_HT_READERS; i++)
+		if (readers[i])
+			qdf_thread_join(readers[i]);
+
+	QDF_BUG(qdf_atomic_read(&ctx->lookups));
+	if (qdf_atomic_read(&ctx->misses)) {
+		qdf_err("%d lookups of stable keys failed",
+			qdf_atomic_read(&ctx->misses));
+		errors++;
+	}
+
+	qdf_rcu_ht_deinit(&ctx->table, NULL, NULL);
+
+free_ctx:
+	qdf_mem_free(ctx->churn);
+	qdf_mem_free(ctx->stable);
+	qdf_mem_free(ctx);
+
+	return errors;
+}
+
 uint32_t qdf_ht_unit_test(void)
 {
 	uint32_t errors = 0;
 
 	errors += qdf_ht_test_single();
+	errors += qdf_rcu_ht_test_single();
+	errors += qdf_rcu_ht_test_concurrent();
 
 	return errors;
 }
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_objpool.h"
+#include "qdf_objpool_test.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_util.h"
+
+#define QDF_OBJPOOL_TEST_MAGIC 0x6f626a70
+#define QDF_OBJPOOL_TEST_COUNT 64
+#define QDF_OBJPOOL_BENCH_COUNT 256
+#define QDF_OBJPOOL_BENCH_ROUNDS 64
+
+struct qdf_objpool_test_obj {
+	uint32_t magic;
+	uint32_t id;
+	uint8_t payload[120];
+};
+
+static void qdf_objpool_test_ctor(void *obj)
+{
+	struct qdf_objpool_test_obj *test_obj = obj;
+
+	test_obj->magic = QDF_OBJPOOL_TEST_MAGIC;
+	test_obj->id = 0;
+}
+
+static uint32_t qdf_objpool_test_alloc_free(void)
+{
+	struct qdf_objpool_test_obj *objs[QDF_OBJPOOL_TEST_COUNT];
+	struct qdf_objpool_stats stats;
+	struct qdf_objpool *pool;
+	int i;
+
+	pool = qdf_objpool_create_type("qdf_objpool_test",
+				       struct qdf_objpool_test_obj, NULL);
+	QDF_BUG(pool);
+	if (!pool)
+		return 1;
+
+	/* a pool should ... */
+	for (i = 0; i < QDF_OBJPOOL_TEST_COUNT; i++) {
+		objs[i] = qdf_objpool_alloc_type(pool,
+						 struct qdf_objpool_test_obj);
+		QDF_BUG(objs[i]);
+
+		/* ... hand out zeroed objects without a constructor */
+		QDF_BUG(!objs[i]->magic && !objs[i]->id);
+		objs[i]->magic = QDF_OBJPOOL_TEST_MAGIC;
+		objs[i]->id = i;
+	}
+
+	/* ... hand out distinct objects */
+	for (i = 0; i < QDF_OBJPOOL_TEST_COUNT; i++)
+		QDF_BUG(objs[i]->id == i);
+
+	/* ... account for the objects in use */
+	qdf_objpool_get_stats(pool, &stats);
+	QDF_BUG(stats.obj_size == sizeof(struct qdf_objpool_test_obj));
+	QDF_BUG(stats.in_use == QDF_OBJPOOL_TEST_COUNT);
+	QDF_BUG(stats.allocs == QDF_OBJPOOL_TEST_COUNT);
+	QDF_BUG(!stats.alloc_fail);
+
+	for (i = 0; i < QDF_OBJPOOL_TEST_COUNT; i++)
+		qdf_objpool_free(pool, objs[i]);
+
+	/* ... keep the high water once the objects are freed */
+	qdf_objpool_get_stats(pool, &stats);
+	QDF_BUG(!stats.in_use);
+	QDF_BUG(stats.high_water == QDF_OBJPOOL_TEST_COUNT);
+
+	/* ... accept NULL on free */
+	qdf_objpool_free(pool, NULL);
+
+	qdf_objpool_destroy(pool);
+
+	return 0;
+}
+
+static uint32_t qdf_objpool_test_ctor_hook(void)
+{
+	struct qdf_objpool_test_obj *objs[QDF_OBJPOOL_TEST_COUNT];
+	struct qdf_objpool *pool;
+	int i;
+
+	pool = qdf_objpool_create_type("qdf_objpool_ctor_test",
+				       struct qdf_objpool_test_obj,
+				       qdf_objpool_test_ctor);
+	QDF_BUG(pool);
+	if (!pool)
+		return 1;
+
+	/* a pool with a constructor should ... */
+	for (i = 0; i < QDF_OBJPOOL_TEST_COUNT; i++) {
+		objs[i] = qdf_objpool_alloc_type(pool,
+						 struct qdf_objpool_test_obj);
+		QDF_BUG(objs[i]);
+
+		/* ... hand out constructed objects */
+		QDF_BUG(objs[i]->magic == QDF_OBJPOOL_TEST_MAGIC);
+		objs[i]->id = i;
+	}
+
+	/* ... get the objects back in their constructed state */
+	for (i = 0; i < QDF_OBJPOOL_TEST_COUNT; i++) {
+		objs[i]->id = 0;
+		qdf_objpool_free(pool, objs[i]);
+	}
+
+	/* ... not construct reused objects again */
+	for (i = 0; i < QDF_OBJPOOL_TEST_COUNT; i++) {
+		objs[i] = qdf_objpool_alloc_type(pool,
+						 struct qdf_objpool_test_obj);
+		QDF_BUG(objs[i]);
+		QDF_BUG(objs[i]->magic == QDF_OBJPOOL_TEST_MAGIC);
+		QDF_BUG(!objs[i]->id);
+	}
+
+	for (i = 0; i < QDF_OBJPOOL_TEST_COUNT; i++)
+		qdf_objpool_free(pool, objs[i]);
+
+	qdf_objpool_destroy(pool);
+
+	return 0;
+}
+
+static uint32_t qdf_objpool_test_bench(void)
+{
+	struct qdf_objpool_test_obj **objs;
+	struct qdf_objpool *pool;
+	uint64_t pool_us, malloc_us;
+	uint64_t start;
+	uint32_t ops;
+	int round, i;
+
+	objs = qdf_mem_malloc(sizeof(*objs) * QDF_OBJPOOL_BENCH_COUNT);
+	if (!objs)
+		return 1;
+
+	pool = qdf_objpool_create_type("qdf_objpool_bench",
+				       struct qdf_objpool_test_obj, NULL);
+	QDF_BUG(pool);
+	if (!pool) {
+		qdf_mem_free(objs);
+		return 1;
+	}
+
+	/* the same alloc/free churn through the pool and qdf_mem_malloc */
+	start = qdf_get_log_timestamp();
+	for (round = 0; round < QDF_OBJPOOL_BENCH_ROUNDS; round++) {
+		for (i = 0; i < QDF_OBJPOOL_BENCH_COUNT; i++)
+			objs[i] = qdf_objpool_alloc(pool);
+		for (i = 0; i < QDF_OBJPOOL_BENCH_COUNT; i++)
+			qdf_objpool_free(pool, objs[i]);
+	}
+	pool_us = qdf_log_timestamp_to_usecs(qdf_get_log_timestamp() - start);
+
+	start = qdf_get_log_timestamp();
+	for (round = 0; round < QDF_OBJPOOL_BENCH_ROUNDS; round++) {
+		for (i = 0; i < QDF_OBJPOOL_BENCH_COUNT; i++)
+			objs[i] = qdf_mem_malloc(sizeof(**objs));
+		for (i = 0; i < QDF_OBJPOOL_BENCH_COUNT; i++)
+			qdf_mem_free(objs[i]);
+	}
+	malloc_us = qdf_log_timestamp_to_usecs(qdf_get_log_timestamp() - start);
+
+	ops = QDF_OBJPOOL_BENCH_ROUNDS * QDF_OBJPOOL_BENCH_COUNT;
+	qdf_nofl_info("objpool bench: %u alloc/free pairs of %zu bytes",
+		      ops, sizeof(**objs));
+	qdf_nofl_info("objpool bench: qdf_objpool %llu us, qdf_mem_malloc %llu us",
+		      pool_us, malloc_us);
+	qdf_nofl_info("objpool bench: qdf_objpool %llu ops/ms, qdf_mem_malloc %llu ops/ms",
+		      qdf_do_div((uint64_t)ops * 1000, pool_us ? pool_us : 1),
+		      qdf_do_div((uint64_t)ops * 1000,
+				 malloc_us ? malloc_us : 1));
+
+	qdf_objpool_destroy(pool);
+	qdf_mem_free(objs);
+
+	return 0;
+}
+
+uint32_t qdf_objpool_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += qdf_objpool_test_alloc_free();
+	errors += qdf_objpool_test_ctor_hook();
+	errors += qdf_objpool_test_bench();
+
+	return errors;
+}
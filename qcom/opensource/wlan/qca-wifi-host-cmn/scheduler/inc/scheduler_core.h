@@ -34,6 +34,9 @@
 #define SCHEDULER_NUMBER_OF_MSG_QUEUE 6
 #define SCHEDULER_WRAPPER_MAX_FAIL_COUNT (SCHEDULER_CORE_MAX_MESSAGES * 3)
 #define SCHEDULER_WATCHDOG_TIMEOUT (10 * 1000) /* 10s */
+#ifndef SCHEDULER_MSG_BATCH_SIZE
+#define SCHEDULER_MSG_BATCH_SIZE 8
+#endif
 
 #ifdef CONFIG_AP_PLATFORM
 #define SCHED_DEBUG_PANIC(msg)
@@ -109,6 +112,9 @@ struct scheduler_mq_ctx {
  * @timeout: timeout value for scheduler watchdog timer
  * @watchdog_timer: timer for triggering a scheduler watchdog bite
  * @watchdog_callback: the callback of the current msg being processed
+ * @watchdog_start_us: timestamp when the current msg started execution
+ * @watchdog_active: the thread is draining the queues and the watchdog
+ *	timer is armed
  */
 struct scheduler_ctx {
 	struct scheduler_mq_ctx queue_ctx;
@@ -127,6 +133,8 @@ struct scheduler_ctx {
 	uint32_t timeout;
 	qdf_timer_t watchdog_timer;
 	void *watchdog_callback;
+	uint64_t watchdog_start_us;
+	bool watchdog_active;
 };
 
 /**
@@ -217,6 +225,32 @@ void scheduler_mq_put_front(struct scheduler_mq_type *msg_q,
  */
 struct scheduler_msg *scheduler_mq_get(struct scheduler_mq_type *msg_q);
 
+/**
+ * scheduler_mq_get_batch() - move messages from message queue to a list
+ * @msg_q: Pointer to the message queue
+ * @batch: list to append the dequeued messages to
+ * @max_msgs: maximum number of messages to dequeue
+ *
+ * This function dequeues up to @max_msgs messages from the front of the
+ * given message queue while holding the queue lock only once.
+ *
+ * Return: number of messages moved to @batch
+ */
+uint32_t scheduler_mq_get_batch(struct scheduler_mq_type *msg_q,
+				qdf_list_t *batch, uint32_t max_msgs);
+
+/**
+ * scheduler_watchdog_check() - check the execution time of the current msg
+ * @sched_ctx: pointer to scheduler context
+ *
+ * Called from the watchdog timer while the scheduler thread is draining
+ * its queues. The timer is re-armed for the remaining allotted time of the
+ * message being processed instead of being armed around every message.
+ *
+ * Return: true if the current msg exceeded its allotted time
+ */
+bool scheduler_watchdog_check(struct scheduler_ctx *sched_ctx);
+
 /**
  * scheduler_queues_init() - to initialize all the modules' queues
  * @sched_ctx: pointer to scheduler context
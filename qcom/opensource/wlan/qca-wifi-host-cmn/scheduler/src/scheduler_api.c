@@ -76,6 +76,9 @@ static void scheduler_watchdog_timeout(void *arg)
 {
 	struct scheduler_ctx *sched = arg;
 
+	if (!scheduler_watchdog_check(sched))
+		return;
+
 	if (qdf_is_recovering()) {
 		sched_debug("Recovery is in progress ignore timeout");
 		return;
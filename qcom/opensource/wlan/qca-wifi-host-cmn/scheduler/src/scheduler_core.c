@@ -19,14 +19,69 @@
 
 #include <scheduler_core.h>
 #include <qdf_atomic.h>
+#include <qdf_time.h>
+#include <qdf_util.h>
 #include "qdf_flex_mem.h"
+#include "qdf_objpool.h"
 
 static struct scheduler_ctx g_sched_ctx;
 static struct scheduler_ctx *gp_sched_ctx;
 
+#ifdef WLAN_SCHED_MSG_OBJPOOL
+static struct qdf_objpool *sched_pool;
+
+static QDF_STATUS sched_msg_pool_init(void)
+{
+	sched_pool = qdf_objpool_create_type("wlan_sched_msg",
+					     struct scheduler_msg, NULL);
+	if (!sched_pool)
+		return QDF_STATUS_E_NOMEM;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static void sched_msg_pool_deinit(void)
+{
+	qdf_objpool_destroy(sched_pool);
+	sched_pool = NULL;
+}
+
+static inline struct scheduler_msg *sched_msg_pool_alloc(void)
+{
+	return qdf_objpool_alloc_type(sched_pool, struct scheduler_msg);
+}
+
+static inline void sched_msg_pool_free(struct scheduler_msg *msg)
+{
+	qdf_objpool_free(sched_pool, msg);
+}
+#else
 DEFINE_QDF_FLEX_MEM_POOL(sched_pool, sizeof(struct scheduler_msg),
 			 WLAN_SCHED_REDUCTION_LIMIT);
 
+static QDF_STATUS sched_msg_pool_init(void)
+{
+	qdf_flex_mem_init(&sched_pool);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static void sched_msg_pool_deinit(void)
+{
+	qdf_flex_mem_deinit(&sched_pool);
+}
+
+static inline struct scheduler_msg *sched_msg_pool_alloc(void)
+{
+	return qdf_flex_mem_alloc(&sched_pool);
+}
+
+static inline void sched_msg_pool_free(struct scheduler_msg *msg)
+{
+	qdf_flex_mem_free(&sched_pool, msg);
+}
+#endif /* WLAN_SCHED_MSG_OBJPOOL */
+
 #ifdef WLAN_SCHED_HISTORY_SIZE
 
 #define SCHEDULER_HISTORY_HEADER "|Callback                               "\
@@ -63,6 +118,87 @@ struct sched_history_item {
 static struct sched_history_item sched_history[WLAN_SCHED_HISTORY_SIZE];
 static uint32_t sched_history_index;
 
+#define SCHED_LATENCY_HIST_MAX 6
+
+/* upper bounds in microseconds of all but the last histogram bucket */
+static const uint32_t
+sched_latency_hist_bounds[SCHED_LATENCY_HIST_MAX - 1] = {
+	100, 1000, 10000, 100000, 1000000
+};
+
+/**
+ * struct sched_queue_stats - per message queue latency histograms
+ * @queue_hist: histogram of the time messages spent in the queue
+ * @run_hist: histogram of the time taken to process messages
+ * @queue_max_us: maximum time a message spent in the queue
+ * @run_max_us: maximum time taken to process a message
+ */
+struct sched_queue_stats {
+	uint32_t queue_hist[SCHED_LATENCY_HIST_MAX];
+	uint32_t run_hist[SCHED_LATENCY_HIST_MAX];
+	uint32_t queue_max_us;
+	uint32_t run_max_us;
+};
+
+static struct sched_queue_stats
+sched_queue_stats[SCHEDULER_NUMBER_OF_MSG_QUEUE];
+
+static uint8_t sched_latency_hist_bucket(uint32_t duration_us)
+{
+	uint8_t i;
+
+	for (i = 0; i < SCHED_LATENCY_HIST_MAX - 1; i++) {
+		if (duration_us < sched_latency_hist_bounds[i])
+			break;
+	}
+
+	return i;
+}
+
+static void sched_queue_stats_update(uint8_t qidx,
+				     struct sched_history_item *hist)
+{
+	struct sched_queue_stats *stats;
+
+	if (qidx >= SCHEDULER_NUMBER_OF_MSG_QUEUE)
+		return;
+
+	stats = &sched_queue_stats[qidx];
+	stats->queue_hist[sched_latency_hist_bucket(hist->queue_duration_us)]++;
+	stats->run_hist[sched_latency_hist_bucket(hist->run_duration_us)]++;
+
+	if (hist->queue_duration_us > stats->queue_max_us)
+		stats->queue_max_us = hist->queue_duration_us;
+	if (hist->run_duration_us > stats->run_max_us)
+		stats->run_max_us = hist->run_duration_us;
+}
+
+static void sched_queue_stats_print(void)
+{
+	struct sched_queue_stats *stats;
+	uint8_t i;
+
+	sched_nofl_fatal("|Qidx|Type |<100us    |<1ms      |<10ms     "
+			 "|<100ms    |<1s       |>=1s      |Max(us)   |");
+
+	for (i = 0; i < SCHEDULER_NUMBER_OF_MSG_QUEUE; i++) {
+		stats = &sched_queue_stats[i];
+
+		sched_nofl_fatal("|%4u|queue|%10u|%10u|%10u|%10u|%10u|%10u|%10u|",
+				 i, stats->queue_hist[0], stats->queue_hist[1],
+				 stats->queue_hist[2], stats->queue_hist[3],
+				 stats->queue_hist[4], stats->queue_hist[5],
+				 stats->queue_max_us);
+		sched_nofl_fatal("|%4u|run  |%10u|%10u|%10u|%10u|%10u|%10u|%10u|",
+				 i, stats->run_hist[0], stats->run_hist[1],
+				 stats->run_hist[2], stats->run_hist[3],
+				 stats->run_hist[4], stats->run_hist[5],
+				 stats->run_max_us);
+	}
+
+	sched_nofl_fatal(SCHEDULER_HISTORY_LINE);
+}
+
 static void sched_history_queue(struct scheduler_mq_type *queue,
 				struct scheduler_msg *msg)
 {
@@ -86,12 +222,13 @@ static void sched_history_start(struct scheduler_msg *msg)
 	sched_history[sched_history_index] = hist;
 }
 
-static void sched_history_stop(void)
+static void sched_history_stop(uint8_t qidx)
 {
 	struct sched_history_item *hist = &sched_history[sched_history_index];
 	uint64_t stopped_at_us = qdf_get_log_timestamp_usecs();
 
 	hist->run_duration_us = stopped_at_us - hist->run_start_us;
+	sched_queue_stats_update(qidx, hist);
 
 	sched_history_index++;
 	sched_history_index %= WLAN_SCHED_HISTORY_SIZE;
@@ -135,20 +272,27 @@ void sched_history_print(void)
 	sched_nofl_fatal(SCHEDULER_HISTORY_LINE);
 
 	qdf_mem_free(history);
+
+	sched_queue_stats_print();
 }
 #else /* WLAN_SCHED_HISTORY_SIZE */
 
 static inline void sched_history_queue(struct scheduler_mq_type *queue,
 				       struct scheduler_msg *msg) { }
 static inline void sched_history_start(struct scheduler_msg *msg) { }
-static inline void sched_history_stop(void) { }
+static inline void sched_history_stop(uint8_t qidx) { }
 void sched_history_print(void) { }
 
 #endif /* WLAN_SCHED_HISTORY_SIZE */
 
 QDF_STATUS scheduler_create_ctx(void)
 {
-	qdf_flex_mem_init(&sched_pool);
+	QDF_STATUS status;
+
+	status = sched_msg_pool_init();
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
 	gp_sched_ctx = &g_sched_ctx;
 
 	return QDF_STATUS_SUCCESS;
@@ -157,7 +301,7 @@ QDF_STATUS scheduler_create_ctx(void)
 QDF_STATUS scheduler_destroy_ctx(void)
 {
 	gp_sched_ctx = NULL;
-	qdf_flex_mem_deinit(&sched_pool);
+	sched_msg_pool_deinit();
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -281,6 +425,26 @@ struct scheduler_msg *scheduler_mq_get(struct scheduler_mq_type *msg_q)
 	return qdf_container_of(node, struct scheduler_msg, node);
 }
 
+uint32_t scheduler_mq_get_batch(struct scheduler_mq_type *msg_q,
+				qdf_list_t *batch, uint32_t max_msgs)
+{
+	qdf_list_node_t *node;
+	uint32_t count = 0;
+
+	qdf_spin_lock_irqsave(&msg_q->mq_lock);
+	while (count < max_msgs) {
+		if (QDF_IS_STATUS_ERROR(qdf_list_remove_front(&msg_q->mq_list,
+							      &node)))
+			break;
+
+		qdf_list_insert_back(batch, node);
+		count++;
+	}
+	qdf_spin_unlock_irqrestore(&msg_q->mq_lock);
+
+	return count;
+}
+
 QDF_STATUS scheduler_queues_deinit(struct scheduler_ctx *sched_ctx)
 {
 	return scheduler_all_queues_deinit(sched_ctx);
@@ -318,7 +482,7 @@ struct scheduler_msg *scheduler_core_msg_dup(struct scheduler_msg *msg)
 	    SCHEDULER_CORE_MAX_MESSAGES)
 		goto buffer_full;
 
-	dup = qdf_flex_mem_alloc(&sched_pool);
+	dup = sched_msg_pool_alloc();
 	if (!dup) {
 		sched_err("out of memory");
 		goto dec_queue_count;
@@ -344,22 +508,97 @@ dec_queue_count:
 
 void scheduler_core_msg_free(struct scheduler_msg *msg)
 {
-	qdf_flex_mem_free(&sched_pool, msg);
+	sched_msg_pool_free(msg);
 	qdf_atomic_dec(&__sched_queue_depth);
 }
 
+bool scheduler_watchdog_check(struct scheduler_ctx *sched_ctx)
+{
+	uint64_t start_us = sched_ctx->watchdog_start_us;
+	uint64_t elapsed_us;
+	uint32_t elapsed_ms;
+
+	if (!sched_ctx->watchdog_active)
+		return false;
+
+	if (!start_us) {
+		/* between two messages, check again after a full timeout */
+		qdf_timer_mod(&sched_ctx->watchdog_timer, sched_ctx->timeout);
+		return false;
+	}
+
+	elapsed_us = qdf_get_log_timestamp_usecs() - start_us;
+	elapsed_ms = qdf_do_div(elapsed_us, 1000);
+	if (elapsed_ms >= sched_ctx->timeout) {
+		/* keep watching in case the message stays stuck */
+		qdf_timer_mod(&sched_ctx->watchdog_timer, sched_ctx->timeout);
+		return true;
+	}
+
+	qdf_timer_mod(&sched_ctx->watchdog_timer,
+		      sched_ctx->timeout - elapsed_ms);
+
+	return false;
+}
+
+static void scheduler_watchdog_arm(struct scheduler_ctx *sch_ctx)
+{
+	if (sch_ctx->watchdog_active)
+		return;
+
+	sch_ctx->watchdog_start_us = 0;
+	sch_ctx->watchdog_active = true;
+	qdf_timer_mod(&sch_ctx->watchdog_timer, sch_ctx->timeout);
+}
+
+static void scheduler_watchdog_disarm(struct scheduler_ctx *sch_ctx)
+{
+	if (!sch_ctx->watchdog_active)
+		return;
+
+	sch_ctx->watchdog_active = false;
+	qdf_timer_stop(&sch_ctx->watchdog_timer);
+}
+
+static void scheduler_process_msg(struct scheduler_ctx *sch_ctx, uint8_t qidx,
+				  struct scheduler_msg *msg)
+{
+	QDF_STATUS status;
+
+	if (!sch_ctx->queue_ctx.scheduler_msg_process_fn[qidx])
+		return;
+
+	sch_ctx->watchdog_msg_type = msg->type;
+	sch_ctx->watchdog_callback = msg->callback;
+
+	sched_history_start(msg);
+	sch_ctx->watchdog_start_us = qdf_get_log_timestamp_usecs();
+	status = sch_ctx->queue_ctx.scheduler_msg_process_fn[qidx](msg);
+	sch_ctx->watchdog_start_us = 0;
+	sched_history_stop(qidx);
+
+	if (QDF_IS_STATUS_ERROR(status))
+		sched_err("Failed processing Qid[%d] message",
+			  sch_ctx->queue_ctx.sch_msg_q[qidx].qid);
+
+	scheduler_core_msg_free(msg);
+}
+
 static void scheduler_thread_process_queues(struct scheduler_ctx *sch_ctx,
 					    bool *shutdown)
 {
 	int i;
-	QDF_STATUS status;
 	struct scheduler_msg *msg;
+	qdf_list_t batch;
+	qdf_list_node_t *node;
 
 	if (!sch_ctx) {
 		QDF_DEBUG_PANIC("sch_ctx is null");
 		return;
 	}
 
+	qdf_list_create(&batch, SCHEDULER_MSG_BATCH_SIZE);
+
 	/* start with highest priority queue : timer queue at index 0 */
 	i = 0;
 	while (i < SCHEDULER_NUMBER_OF_MSG_QUEUE) {
@@ -380,36 +619,29 @@ static void scheduler_thread_process_queues(struct scheduler_ctx *sch_ctx,
 			break;
 		}
 
-		msg = scheduler_mq_get(&sch_ctx->queue_ctx.sch_msg_q[i]);
-		if (!msg) {
+		if (!scheduler_mq_get_batch(&sch_ctx->queue_ctx.sch_msg_q[i],
+					    &batch, SCHEDULER_MSG_BATCH_SIZE)) {
 			/* check next queue */
 			i++;
 			continue;
 		}
 
-		if (sch_ctx->queue_ctx.scheduler_msg_process_fn[i]) {
-			sch_ctx->watchdog_msg_type = msg->type;
-			sch_ctx->watchdog_callback = msg->callback;
+		scheduler_watchdog_arm(sch_ctx);
 
-			sched_history_start(msg);
-			qdf_timer_start(&sch_ctx->watchdog_timer,
-					sch_ctx->timeout);
-			status = sch_ctx->queue_ctx.
-					scheduler_msg_process_fn[i](msg);
-			qdf_timer_stop(&sch_ctx->watchdog_timer);
-			sched_history_stop();
-
-			if (QDF_IS_STATUS_ERROR(status))
-				sched_err("Failed processing Qid[%d] message",
-					  sch_ctx->queue_ctx.sch_msg_q[i].qid);
-
-			scheduler_core_msg_free(msg);
+		while (QDF_IS_STATUS_SUCCESS(qdf_list_remove_front(&batch,
+								   &node))) {
+			msg = qdf_container_of(node, struct scheduler_msg,
+					       node);
+			scheduler_process_msg(sch_ctx, i, msg);
 		}
 
 		/* start again with highest priority queue at index 0 */
 		i = 0;
 	}
 
+	scheduler_watchdog_disarm(sch_ctx);
+	qdf_list_destroy(&batch);
+
 	/* Check for any Suspend Indication */
 	if (qdf_atomic_test_and_clear_bit(MC_SUSPEND_EVENT_MASK,
 			&sch_ctx->sch_event_flag)) {
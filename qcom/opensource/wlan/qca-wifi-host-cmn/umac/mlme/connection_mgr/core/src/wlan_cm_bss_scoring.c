@@ -2999,9 +2999,8 @@ static void cm_find_and_remove_dup_candidate(struct scan_cache_node *bss_entry,
 						qdf_list_remove_node(
 							candidate_list,
 							cur_node);
-						util_scan_free_cache_entry(
-							scan_node->entry);
-						qdf_mem_free(cur_node);
+						wlan_scan_free_result_node(
+							scan_node);
 						goto next;
 					}
 				}
@@ -3499,8 +3498,7 @@ void wlan_cm_calculate_bss_score(struct wlan_objmgr_pdev *pdev,
 					scan_entry->entry->channel.chan_freq,
 					scan_entry->entry->rssi_raw,
 					denylist_action);
-			util_scan_free_cache_entry(scan_entry->entry);
-			qdf_mem_free(scan_entry);
+			wlan_scan_free_result_node(scan_entry);
 		} else {
 			cm_list_insert_sorted(scan_list, scan_entry);
 		}
@@ -3516,8 +3514,7 @@ void wlan_cm_calculate_bss_score(struct wlan_objmgr_pdev *pdev,
 			force_connect_candidate->entry->rssi_raw);
 		cm_list_insert_sorted(scan_list, force_connect_candidate);
 	} else if (force_connect_candidate) {
-		util_scan_free_cache_entry(force_connect_candidate->entry);
-		qdf_mem_free(force_connect_candidate);
+		wlan_scan_free_result_node(force_connect_candidate);
 	}
 
 	cm_eliminate_common_candidate(scan_list);
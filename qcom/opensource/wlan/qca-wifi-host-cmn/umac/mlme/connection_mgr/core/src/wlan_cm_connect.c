@@ -1586,7 +1586,7 @@ cm_connect_fetch_candidates(struct wlan_objmgr_pdev *pdev,
 
 	cm_update_mlo_filter(pdev, cm_req, filter);
 
-	candidate_list = wlan_scan_get_result(pdev, filter);
+	candidate_list = wlan_scan_get_snapshot_result(pdev, filter);
 	if (candidate_list) {
 		num_bss = qdf_list_size(candidate_list);
 		mlme_debug(CM_PREFIX_FMT "num_entries found %d",
@@ -1722,8 +1722,7 @@ static void cm_update_candidate_list(struct cnx_mgr *cm_ctx,
 			mlme_err(CM_PREFIX_FMT "failed to insert node for " QDF_MAC_ADDR_FMT " to candidate list",
 				 CM_PREFIX_REF(vdev_id, cm_req->cm_id),
 				 QDF_MAC_ADDR_REF(scan_entry->entry->bssid.bytes));
-			util_scan_free_cache_entry(scan_entry->entry);
-			qdf_mem_free(scan_entry);
+			wlan_scan_free_result_node(scan_entry);
 			goto free_list;
 		}
 		prev_candidate = scan_entry;
@@ -211,7 +211,7 @@ static QDF_STATUS cm_roam_get_candidates(struct wlan_objmgr_pdev *pdev,
 	cm_connect_prepare_scan_filter_for_roam(cm_ctx, cm_req, filter,
 						security_valid_for_6ghz);
 
-	candidate_list = wlan_scan_get_result(pdev, filter);
+	candidate_list = wlan_scan_get_snapshot_result(pdev, filter);
 	if (candidate_list) {
 		num_bss = qdf_list_size(candidate_list);
 		mlme_debug(CM_PREFIX_FMT "num_entries found %d",
@@ -42,6 +42,7 @@
  *   operation is done ref_cnt is decremented.
  */
 #include <qdf_status.h>
+#include <qdf_objpool.h>
 #include <wlan_objmgr_psoc_obj.h>
 #include <wlan_objmgr_pdev_obj.h>
 #include <wlan_objmgr_vdev_obj.h>
@@ -291,6 +292,46 @@ static void scm_add_rnr_channel_db(struct wlan_objmgr_pdev *pdev,
 }
 #endif
 
+#ifdef WLAN_SCAN_NODE_OBJPOOL
+static struct qdf_objpool *scm_node_pool;
+
+QDF_STATUS scm_db_node_pool_init(void)
+{
+	scm_node_pool = qdf_objpool_create_type("wlan_scan_node",
+						struct scan_cache_node, NULL);
+	if (!scm_node_pool)
+		return QDF_STATUS_E_NOMEM;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+void scm_db_node_pool_deinit(void)
+{
+	qdf_objpool_destroy(scm_node_pool);
+	scm_node_pool = NULL;
+}
+
+static inline struct scan_cache_node *scm_scan_node_alloc(void)
+{
+	return qdf_objpool_alloc_type(scm_node_pool, struct scan_cache_node);
+}
+
+static inline void scm_scan_node_free(struct scan_cache_node *scan_node)
+{
+	qdf_objpool_free(scm_node_pool, scan_node);
+}
+#else
+static inline struct scan_cache_node *scm_scan_node_alloc(void)
+{
+	return qdf_mem_malloc(sizeof(struct scan_cache_node));
+}
+
+static inline void scm_scan_node_free(struct scan_cache_node *scan_node)
+{
+	qdf_mem_free(scan_node);
+}
+#endif
+
 /**
  * scm_del_scan_node() - API to remove scan node from the list
  * @list: hash list
@@ -308,7 +349,7 @@ static void scm_del_scan_node(qdf_list_t *list,
 	status = qdf_list_remove_node(list, &scan_node->node);
 	if (QDF_IS_STATUS_SUCCESS(status)) {
 		util_scan_free_cache_entry(scan_node->entry);
-		qdf_mem_free(scan_node);
+		scm_scan_node_free(scan_node);
 	}
 }
 
@@ -1059,6 +1100,45 @@ static void scm_dump_scan_entry(struct wlan_objmgr_pdev *pdev,
 		       scan_params->snr, scan_params->phy_mode, log_str);
 }
 
+QDF_STATUS scm_scan_db_add_entry(struct scan_dbs *scan_db,
+				 struct scan_cache_entry *scan_params,
+				 struct scan_cache_node *dup_node)
+{
+	struct scan_cache_node *scan_node = NULL;
+	QDF_STATUS status;
+
+	if (scan_db->num_entries >= MAX_SCAN_CACHE_SIZE) {
+		status = scm_flush_oldest_entry(scan_db);
+		if (QDF_IS_STATUS_ERROR(status)) {
+			/* release ref taken for dup node */
+			if (dup_node)
+				scm_scan_entry_put_ref(scan_db, dup_node, true);
+			return status;
+		}
+	}
+
+	scan_node = scm_scan_node_alloc();
+	if (!scan_node) {
+		/* release ref taken for dup node */
+		if (dup_node)
+			scm_scan_entry_put_ref(scan_db, dup_node, true);
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	scan_node->entry = scan_params;
+	qdf_spin_lock_bh(&scan_db->scan_db_lock);
+	scm_add_scan_node(scan_db, scan_node, dup_node);
+
+	if (dup_node) {
+		/* release ref taken for dup node and delete it */
+		scm_scan_entry_del(scan_db, dup_node);
+		scm_scan_entry_put_ref(scan_db, dup_node, false);
+	}
+	qdf_spin_unlock_bh(&scan_db->scan_db_lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+
 /**
  * scm_add_update_entry() - add or update scan entry
  * @psoc: psoc ptr
@@ -1071,9 +1151,7 @@ static QDF_STATUS scm_add_update_entry(struct wlan_objmgr_psoc *psoc,
 	struct wlan_objmgr_pdev *pdev, struct scan_cache_entry *scan_params)
 {
 	struct scan_cache_node *dup_node = NULL;
-	struct scan_cache_node *scan_node = NULL;
 	bool is_dup_found = false;
-	QDF_STATUS status;
 	struct scan_dbs *scan_db;
 	struct wlan_scan_obj *scan_obj;
 
@@ -1102,36 +1180,8 @@ static QDF_STATUS scm_add_update_entry(struct wlan_objmgr_psoc *psoc,
 	if (scan_obj->cb.inform_beacon)
 		scan_obj->cb.inform_beacon(pdev, scan_params);
 
-	if (scan_db->num_entries >= MAX_SCAN_CACHE_SIZE) {
-		status = scm_flush_oldest_entry(scan_db);
-		if (QDF_IS_STATUS_ERROR(status)) {
-			/* release ref taken for dup node */
-			if (is_dup_found)
-				scm_scan_entry_put_ref(scan_db, dup_node, true);
-			return status;
-		}
-	}
-
-	scan_node = qdf_mem_malloc(sizeof(*scan_node));
-	if (!scan_node) {
-		/* release ref taken for dup node */
-		if (is_dup_found)
-			scm_scan_entry_put_ref(scan_db, dup_node, true);
-		return QDF_STATUS_E_NOMEM;
-	}
-
-	scan_node->entry = scan_params;
-	qdf_spin_lock_bh(&scan_db->scan_db_lock);
-	scm_add_scan_node(scan_db, scan_node, dup_node);
-
-	if (is_dup_found) {
-		/* release ref taken for dup node and delete it */
-		scm_scan_entry_del(scan_db, dup_node);
-		scm_scan_entry_put_ref(scan_db, dup_node, false);
-	}
-	qdf_spin_unlock_bh(&scan_db->scan_db_lock);
-
-	return QDF_STATUS_SUCCESS;
+	return scm_scan_db_add_entry(scan_db, scan_params,
+				     is_dup_found ? dup_node : NULL);
 }
 
 #ifdef CONFIG_REG_CLIENT
@@ -1453,7 +1503,7 @@ QDF_STATUS scm_handle_bcn_probe(struct scheduler_msg *msg)
  * scan entry
  * @psoc: psoc pointer
  * @db_entry: scan entry
- * @filter: filter to be applied
+ * @compiled: compiled filter to be applied
  * @scan_list: scan list to which entry is added
  *
  * Return: QDF_STATUS
@@ -1461,18 +1511,19 @@ QDF_STATUS scm_handle_bcn_probe(struct scheduler_msg *msg)
 static QDF_STATUS
 scm_scan_apply_filter_get_entry(struct wlan_objmgr_psoc *psoc,
 	struct scan_cache_entry *db_entry,
-	struct scan_filter *filter,
+	struct scan_filter_compiled *compiled,
 	qdf_list_t *scan_list)
 {
 	struct scan_cache_node *scan_node = NULL;
 	struct security_info security = {0};
 	bool match;
 
-	if (!filter)
+	if (!compiled->filter)
 		match = true;
 	else
-		match = scm_filter_match(psoc, db_entry,
-					filter, &security);
+		match = scm_filter_compiled_prematch(compiled, db_entry) &&
+			scm_filter_match(psoc, db_entry,
+					 compiled->filter, &security);
 
 	if (!match)
 		return QDF_STATUS_SUCCESS;
@@ -1501,13 +1552,13 @@ scm_scan_apply_filter_get_entry(struct wlan_objmgr_psoc *psoc,
  * scm_get_results() - Iterate and get scan results
  * @psoc: psoc ptr
  * @scan_db: scan db
- * @filter: filter to be applied
+ * @compiled: compiled filter to be applied
  * @scan_list: scan list to which entry is added
  *
  * Return: void
  */
 static void scm_get_results(struct wlan_objmgr_psoc *psoc,
-	struct scan_dbs *scan_db, struct scan_filter *filter,
+	struct scan_dbs *scan_db, struct scan_filter_compiled *compiled,
 	qdf_list_t *scan_list)
 {
 	int i, count;
@@ -1515,14 +1566,16 @@ static void scm_get_results(struct wlan_objmgr_psoc *psoc,
 	struct scan_cache_node *next_node = NULL;
 
 	for (i = 0 ; i < SCAN_HASH_SIZE; i++) {
-		cur_node = scm_get_next_node(scan_db,
-			   &scan_db->scan_hash_tbl[i], NULL);
+		if (!scm_filter_compiled_has_bucket(compiled, i))
+			continue;
 		count = qdf_list_size(&scan_db->scan_hash_tbl[i]);
 		if (!count)
 			continue;
+		cur_node = scm_get_next_node(scan_db,
+			   &scan_db->scan_hash_tbl[i], NULL);
 		while (cur_node) {
 			scm_scan_apply_filter_get_entry(psoc,
-				cur_node->entry, filter, scan_list);
+				cur_node->entry, compiled, scan_list);
 			next_node = scm_get_next_node(scan_db,
 				&scan_db->scan_hash_tbl[i], cur_node);
 			cur_node = next_node;
@@ -1550,10 +1603,8 @@ QDF_STATUS scm_purge_scan_results(qdf_list_t *scan_list)
 			struct scan_cache_node, node);
 		status = qdf_list_remove_node(scan_list,
 					cur_lst);
-		if (QDF_IS_STATUS_SUCCESS(status)) {
-			util_scan_free_cache_entry(cur_node->entry);
-			qdf_mem_free(cur_node);
-		}
+		if (QDF_IS_STATUS_SUCCESS(status))
+			scm_free_scan_result_node(cur_node);
 		cur_lst = next_lst;
 		next_lst = NULL;
 	}
@@ -1570,6 +1621,7 @@ qdf_list_t *scm_get_scan_result(struct wlan_objmgr_pdev *pdev,
 	struct wlan_objmgr_psoc *psoc;
 	struct scan_dbs *scan_db;
 	qdf_list_t *tmp_list;
+	struct scan_filter_compiled *compiled;
 
 	if (!pdev) {
 		scm_err("pdev is NULL");
@@ -1593,14 +1645,348 @@ qdf_list_t *scm_get_scan_result(struct wlan_objmgr_pdev *pdev,
 		scm_err("failed tp allocate scan_result");
 		return NULL;
 	}
+	compiled = qdf_mem_malloc_atomic(sizeof(*compiled));
+	if (!compiled) {
+		qdf_mem_free(tmp_list);
+		return NULL;
+	}
 	qdf_list_create(tmp_list,
 			MAX_SCAN_CACHE_SIZE);
+	scm_filter_compile(filter, compiled);
 	scm_age_out_entries(psoc, scan_db);
-	scm_get_results(psoc, scan_db, filter, tmp_list);
+	scm_get_results(psoc, scan_db, compiled, tmp_list);
+	qdf_mem_free(compiled);
 
 	return tmp_list;
 }
 
+/**
+ * scm_scan_snapshot_collect() - take a reference on the scan db nodes which
+ * pass the cheap checks of the compiled filter
+ * @scan_db: scan db
+ * @compiled: compiled filter
+ * @snapshot: snapshot to fill
+ * @max_entries: capacity of @snapshot
+ *
+ * The whole walk is done under a single scan_db_lock hold, instead of one
+ * lock round trip per node as scm_get_next_node() does.
+ *
+ * Return: void
+ */
+static void scm_scan_snapshot_collect(struct scan_dbs *scan_db,
+				      struct scan_filter_compiled *compiled,
+				      struct scan_cache_snapshot *snapshot,
+				      uint32_t max_entries)
+{
+	int i;
+	qdf_list_node_t *cur_lst;
+	struct scan_cache_node *scan_node;
+	struct scan_snapshot_entry *snap_entry;
+
+	qdf_spin_lock_bh(&scan_db->scan_db_lock);
+	for (i = 0; i < SCAN_HASH_SIZE; i++) {
+		if (!scm_filter_compiled_has_bucket(compiled, i))
+			continue;
+
+		cur_lst = scm_get_next_valid_node(&scan_db->scan_hash_tbl[i],
+						  NULL);
+		while (cur_lst) {
+			if (snapshot->num_entries >= max_entries)
+				goto unlock;
+
+			scan_node = qdf_container_of(cur_lst,
+						     struct scan_cache_node,
+						     node);
+			if (scm_filter_compiled_prematch(compiled,
+							 scan_node->entry)) {
+				scm_scan_entry_get_ref(scan_node);
+				snap_entry =
+				    &snapshot->entries[snapshot->num_entries++];
+				snap_entry->node = scan_node;
+				snap_entry->entry = scan_node->entry;
+			}
+			cur_lst = scm_get_next_valid_node(
+					&scan_db->scan_hash_tbl[i], cur_lst);
+		}
+	}
+unlock:
+	qdf_spin_unlock_bh(&scan_db->scan_db_lock);
+}
+
+/**
+ * scm_scan_snapshot_apply_filter() - run the full filter on the collected
+ * entries and drop the ones which don't match
+ * @psoc: psoc ptr
+ * @compiled: compiled filter
+ * @snapshot: snapshot to filter
+ *
+ * The full match may call back into other components, so it is run without
+ * scan_db_lock; the references taken while collecting keep the nodes alive.
+ * Entries are stored latest first, like scm_get_scan_result() does.
+ *
+ * Return: void
+ */
+static void
+scm_scan_snapshot_apply_filter(struct wlan_objmgr_psoc *psoc,
+			       struct scan_filter_compiled *compiled,
+			       struct scan_cache_snapshot *snapshot)
+{
+	struct scan_dbs *scan_db = snapshot->scan_db;
+	struct scan_snapshot_entry *snap_entry, tmp;
+	uint32_t i, num_match = 0;
+	bool match;
+
+	for (i = 0; i < snapshot->num_entries; i++) {
+		snap_entry = &snapshot->entries[i];
+		qdf_mem_zero(&snap_entry->neg_sec_info,
+			     sizeof(snap_entry->neg_sec_info));
+		if (!compiled->filter)
+			match = true;
+		else
+			match = scm_filter_match(psoc, snap_entry->entry,
+						 compiled->filter,
+						 &snap_entry->neg_sec_info);
+		if (!match)
+			continue;
+		/* Swap keeps matched entries in order, unmatched at the tail */
+		if (i != num_match) {
+			tmp = snapshot->entries[num_match];
+			snapshot->entries[num_match] = *snap_entry;
+			*snap_entry = tmp;
+		}
+		num_match++;
+	}
+
+	if (num_match != snapshot->num_entries) {
+		qdf_spin_lock_bh(&scan_db->scan_db_lock);
+		for (i = num_match; i < snapshot->num_entries; i++)
+			scm_scan_entry_put_ref(scan_db,
+					       snapshot->entries[i].node,
+					       false);
+		qdf_spin_unlock_bh(&scan_db->scan_db_lock);
+	}
+
+	/*
+	 * New entries without a duplicate are added at the bucket tail, so
+	 * reverse to return the latest first, as scm_get_scan_result() does.
+	 */
+	for (i = 0; i < num_match / 2; i++) {
+		tmp = snapshot->entries[i];
+		snapshot->entries[i] = snapshot->entries[num_match - 1 - i];
+		snapshot->entries[num_match - 1 - i] = tmp;
+	}
+	snapshot->num_entries = num_match;
+}
+
+struct scan_cache_snapshot *
+scm_scan_db_get_snapshot(struct wlan_objmgr_psoc *psoc,
+			 struct scan_dbs *scan_db,
+			 struct scan_filter *filter)
+{
+	struct scan_cache_snapshot *snapshot;
+	struct scan_filter_compiled *compiled;
+	uint32_t max_entries;
+
+	compiled = qdf_mem_malloc_atomic(sizeof(*compiled));
+	if (!compiled)
+		return NULL;
+
+	/*
+	 * Entries added after this point are simply not part of the snapshot,
+	 * same as if the snapshot had been taken a little earlier.
+	 */
+	max_entries = qdf_min(scan_db->num_entries,
+			      (uint32_t)MAX_SCAN_CACHE_SIZE);
+	snapshot = qdf_mem_malloc_atomic(sizeof(*snapshot) +
+					 max_entries *
+					 sizeof(snapshot->entries[0]));
+	if (!snapshot) {
+		scm_err("failed to allocate scan snapshot of %u entries",
+			max_entries);
+		qdf_mem_free(compiled);
+		return NULL;
+	}
+
+	qdf_atomic_init(&snapshot->ref_cnt);
+	qdf_atomic_inc(&snapshot->ref_cnt);
+	snapshot->pdev = NULL;
+	snapshot->scan_db = scan_db;
+	snapshot->num_entries = 0;
+
+	scm_filter_compile(filter, compiled);
+	scm_scan_snapshot_collect(scan_db, compiled, snapshot, max_entries);
+	scm_scan_snapshot_apply_filter(psoc, compiled, snapshot);
+	qdf_mem_free(compiled);
+
+	return snapshot;
+}
+
+struct scan_cache_snapshot *
+scm_get_scan_snapshot(struct wlan_objmgr_pdev *pdev,
+		      struct scan_filter *filter)
+{
+	struct wlan_objmgr_psoc *psoc;
+	struct scan_cache_snapshot *snapshot;
+	struct scan_dbs *scan_db;
+
+	if (!pdev) {
+		scm_err("pdev is NULL");
+		return NULL;
+	}
+
+	psoc = wlan_pdev_get_psoc(pdev);
+	if (!psoc) {
+		scm_err("psoc is NULL");
+		return NULL;
+	}
+
+	scan_db = wlan_pdev_get_scan_db(psoc, pdev);
+	if (!scan_db) {
+		scm_err("scan_db is NULL");
+		return NULL;
+	}
+
+	/* The scan db is flushed on pdev delete, pin it for the snapshot */
+	if (QDF_IS_STATUS_ERROR(wlan_objmgr_pdev_try_get_ref(pdev,
+							     WLAN_SCAN_ID))) {
+		scm_err("unable to get pdev reference");
+		return NULL;
+	}
+
+	scm_age_out_entries(psoc, scan_db);
+
+	snapshot = scm_scan_db_get_snapshot(psoc, scan_db, filter);
+	if (!snapshot) {
+		wlan_objmgr_pdev_release_ref(pdev, WLAN_SCAN_ID);
+		return NULL;
+	}
+	snapshot->pdev = pdev;
+
+	return snapshot;
+}
+
+void scm_scan_snapshot_get_ref(struct scan_cache_snapshot *snapshot)
+{
+	if (!snapshot) {
+		scm_err("snapshot is NULL");
+		QDF_ASSERT(0);
+		return;
+	}
+
+	qdf_atomic_inc(&snapshot->ref_cnt);
+}
+
+void scm_scan_snapshot_put_ref(struct scan_cache_snapshot *snapshot)
+{
+	struct scan_dbs *scan_db;
+	uint32_t i;
+
+	if (!snapshot) {
+		scm_err("snapshot is NULL");
+		QDF_ASSERT(0);
+		return;
+	}
+
+	if (!qdf_atomic_dec_and_test(&snapshot->ref_cnt))
+		return;
+
+	scan_db = snapshot->scan_db;
+	qdf_spin_lock_bh(&scan_db->scan_db_lock);
+	for (i = 0; i < snapshot->num_entries; i++)
+		scm_scan_entry_put_ref(scan_db, snapshot->entries[i].node,
+				       false);
+	qdf_spin_unlock_bh(&scan_db->scan_db_lock);
+
+	if (snapshot->pdev)
+		wlan_objmgr_pdev_release_ref(snapshot->pdev, WLAN_SCAN_ID);
+	qdf_mem_free(snapshot);
+}
+
+void scm_free_scan_result_node(struct scan_cache_node *scan_node)
+{
+	if (!scan_node->snapshot) {
+		util_scan_free_cache_entry(scan_node->entry);
+		qdf_mem_free(scan_node);
+		return;
+	}
+
+	/* Shallow copy, the frame and IEs belong to the snapshot entry */
+	qdf_mem_free(scan_node->entry);
+	scm_scan_snapshot_put_ref(scan_node->snapshot);
+	qdf_mem_free(scan_node);
+}
+
+qdf_list_t *scm_scan_snapshot_get_result(struct scan_cache_snapshot *snapshot)
+{
+	struct scan_snapshot_entry *snap_entry;
+	struct scan_cache_node *scan_node;
+	qdf_list_t *scan_list;
+	uint32_t i;
+
+	scan_list = qdf_mem_malloc_atomic(sizeof(*scan_list));
+	if (!scan_list) {
+		scm_err("failed to allocate scan_result");
+		return NULL;
+	}
+	qdf_list_create(scan_list, MAX_SCAN_CACHE_SIZE);
+
+	for (i = 0; i < snapshot->num_entries; i++) {
+		snap_entry = &snapshot->entries[i];
+		scan_node = qdf_mem_malloc_atomic(sizeof(*scan_node));
+		if (!scan_node)
+			goto fail;
+
+		/*
+		 * Only the entry struct is copied, its IE pointers keep
+		 * pointing into the frame of the db entry, which the snapshot
+		 * keeps alive and unchanged. The copy itself is private, so
+		 * the caller may update its scores and ml_info.
+		 */
+		scan_node->entry = qdf_mem_malloc_atomic(
+					sizeof(*scan_node->entry));
+		if (!scan_node->entry) {
+			qdf_mem_free(scan_node);
+			goto fail;
+		}
+		qdf_mem_copy(scan_node->entry, snap_entry->entry,
+			     sizeof(*scan_node->entry));
+		qdf_mem_copy(&scan_node->entry->neg_sec_info,
+			     &snap_entry->neg_sec_info,
+			     sizeof(scan_node->entry->neg_sec_info));
+
+		scm_scan_snapshot_get_ref(snapshot);
+		scan_node->snapshot = snapshot;
+		qdf_list_insert_back(scan_list, &scan_node->node);
+	}
+
+	return scan_list;
+
+fail:
+	/* A truncated list would silently hide candidates from the caller */
+	scm_err("failed to allocate scan result node %u of %u", i,
+		snapshot->num_entries);
+	scm_purge_scan_results(scan_list);
+
+	return NULL;
+}
+
+qdf_list_t *scm_get_scan_result_from_snapshot(struct wlan_objmgr_pdev *pdev,
+					      struct scan_filter *filter)
+{
+	struct scan_cache_snapshot *snapshot;
+	qdf_list_t *scan_list;
+
+	snapshot = scm_get_scan_snapshot(pdev, filter);
+	if (!snapshot)
+		return NULL;
+
+	scan_list = scm_scan_snapshot_get_result(snapshot);
+	/* Every node holds its own reference from here on */
+	scm_scan_snapshot_put_ref(snapshot);
+
+	return scan_list;
+}
+
 /**
  * scm_iterate_db_and_call_func() - iterate and call the func
  * @scan_db: scan db
@@ -1710,17 +2096,8 @@ scm_scan_apply_filter_flush_entry(struct wlan_objmgr_psoc *psoc,
 	return QDF_STATUS_SUCCESS;
 }
 
-/**
- * scm_flush_scan_entries() - API to flush scan entries depending on filters
- * @psoc: psoc ptr
- * @scan_db: scan db
- * @filter: filter
- * @pdev_id: pdev id of the scan db
- *
- * Return: void
- */
-static void scm_flush_scan_entries(struct wlan_objmgr_psoc *psoc,
-	struct scan_dbs *scan_db, struct scan_filter *filter, uint8_t pdev_id)
+void scm_scan_db_flush(struct wlan_objmgr_psoc *psoc,
+		       struct scan_dbs *scan_db, struct scan_filter *filter)
 {
 	int i;
 	struct scan_cache_node *cur_node;
@@ -1737,6 +2114,21 @@ static void scm_flush_scan_entries(struct wlan_objmgr_psoc *psoc,
 			cur_node = next_node;
 		}
 	}
+}
+
+/**
+ * scm_flush_scan_entries() - API to flush scan entries depending on filters
+ * @psoc: psoc ptr
+ * @scan_db: scan db
+ * @filter: filter
+ * @pdev_id: pdev id of the scan db
+ *
+ * Return: void
+ */
+static void scm_flush_scan_entries(struct wlan_objmgr_psoc *psoc,
+	struct scan_dbs *scan_db, struct scan_filter *filter, uint8_t pdev_id)
+{
+	scm_scan_db_flush(psoc, scan_db, filter);
 	/* if all scan results are flushed reset scan channel info as well */
 	if (!filter)
 		scm_reset_scan_chan_info(psoc, pdev_id);
@@ -2096,41 +2488,97 @@ void scm_update_rnr_from_scan_cache(struct wlan_objmgr_pdev *pdev)
 }
 #endif
 
-QDF_STATUS scm_update_scan_mlme_info(struct wlan_objmgr_pdev *pdev,
-	struct scan_cache_entry *entry)
+/**
+ * scm_scan_entry_replace_mlme() - replace a scan db node by a copy carrying
+ * new mlme info
+ * @scan_db: scan db
+ * @scan_node: node to replace, referenced by the caller
+ * @mlme: mlme info of the copy
+ *
+ * Entries are never modified once they are in the scan db, as scan snapshots
+ * may reference them. The copy is inserted in place of @scan_node, which is
+ * logically deleted, so that current holders of @scan_node keep seeing the
+ * old info. The reference of the caller on @scan_node is released.
+ *
+ * The copy duplicates the frame too, like any beacon update of the entry.
+ * mlme updates only come from the connection manager and are rare next to
+ * beacon updates, and an update that changes nothing is skipped.
+ *
+ * Return: QDF_STATUS_E_AGAIN if @scan_node got deleted meanwhile and the
+ * lookup needs to be redone
+ */
+static QDF_STATUS scm_scan_entry_replace_mlme(struct scan_dbs *scan_db,
+					      struct scan_cache_node *scan_node,
+					      struct mlme_info *mlme)
 {
-	uint8_t hash_idx;
-	struct scan_dbs *scan_db;
-	struct scan_cache_node *cur_node;
-	struct scan_cache_node *next_node = NULL;
-	struct wlan_objmgr_psoc *psoc;
+	struct scan_cache_node *new_node;
+	struct scan_cache_entry *new_entry;
+	QDF_STATUS status = QDF_STATUS_SUCCESS;
 
-	psoc = wlan_pdev_get_psoc(pdev);
-	if (!psoc) {
-		scm_err("psoc is NULL");
-		return QDF_STATUS_E_INVAL;
+	/* Nothing changed, keep the node and skip the copy */
+	if (!qdf_mem_cmp(&scan_node->entry->mlme_info, mlme, sizeof(*mlme))) {
+		scm_scan_entry_put_ref(scan_db, scan_node, true);
+		return QDF_STATUS_SUCCESS;
 	}
-	scan_db = wlan_pdev_get_scan_db(psoc, pdev);
-	if (!scan_db) {
-		scm_err("scan_db is NULL");
-		return QDF_STATUS_E_INVAL;
+
+	/* The entry is immutable, no lock is needed to copy it */
+	new_entry = util_scan_copy_cache_entry(scan_node->entry);
+	if (!new_entry) {
+		scm_scan_entry_put_ref(scan_db, scan_node, true);
+		return QDF_STATUS_E_NOMEM;
 	}
+	qdf_mem_copy(&new_entry->mlme_info, mlme, sizeof(*mlme));
+
+	new_node = scm_scan_node_alloc();
+	if (!new_node) {
+		util_scan_free_cache_entry(new_entry);
+		scm_scan_entry_put_ref(scan_db, scan_node, true);
+		return QDF_STATUS_E_NOMEM;
+	}
+	new_node->entry = new_entry;
+
+	qdf_spin_lock_bh(&scan_db->scan_db_lock);
+	if (scan_node->cookie == SCAN_NODE_ACTIVE_COOKIE) {
+		scm_add_scan_node(scan_db, new_node, scan_node);
+		scm_scan_entry_del(scan_db, scan_node);
+	} else {
+		/* Replaced by a newer beacon or another mlme update */
+		status = QDF_STATUS_E_AGAIN;
+	}
+	scm_scan_entry_put_ref(scan_db, scan_node, false);
+	qdf_spin_unlock_bh(&scan_db->scan_db_lock);
+
+	if (status == QDF_STATUS_E_AGAIN) {
+		util_scan_free_cache_entry(new_entry);
+		scm_scan_node_free(new_node);
+	}
+
+	return status;
+}
+
+QDF_STATUS scm_scan_db_update_mlme_info(struct scan_dbs *scan_db,
+					struct scan_cache_entry *entry)
+{
+	uint8_t hash_idx;
+	struct scan_cache_node *cur_node;
+	struct scan_cache_node *next_node = NULL;
+	QDF_STATUS status;
 
 	hash_idx = SCAN_GET_HASH(entry->bssid.bytes);
 
+retry:
 	cur_node = scm_get_next_node(scan_db,
 			&scan_db->scan_hash_tbl[hash_idx], NULL);
 
 	while (cur_node) {
 		if (util_is_scan_entry_match(entry,
 					cur_node->entry)) {
-			/* Acquire db lock to prevent simultaneous update */
-			qdf_spin_lock_bh(&scan_db->scan_db_lock);
-			scm_update_mlme_info(entry, cur_node->entry);
-			qdf_spin_unlock_bh(&scan_db->scan_db_lock);
-			scm_scan_entry_put_ref(scan_db,
-					cur_node, true);
-			return QDF_STATUS_SUCCESS;
+			status = scm_scan_entry_replace_mlme(scan_db, cur_node,
+							     &entry->mlme_info);
+			if (status == QDF_STATUS_E_AGAIN)
+				goto retry;
+
+			return status;
 		}
 		next_node = scm_get_next_node(scan_db,
 				&scan_db->scan_hash_tbl[hash_idx], cur_node);
@@ -2140,6 +2588,26 @@ QDF_STATUS scm_update_scan_mlme_info(struct wlan_objmgr_pdev *pdev,
 	return QDF_STATUS_E_INVAL;
 }
 
+QDF_STATUS scm_update_scan_mlme_info(struct wlan_objmgr_pdev *pdev,
+	struct scan_cache_entry *entry)
+{
+	struct scan_dbs *scan_db;
+	struct wlan_objmgr_psoc *psoc;
+
+	psoc = wlan_pdev_get_psoc(pdev);
+	if (!psoc) {
+		scm_err("psoc is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+	scan_db = wlan_pdev_get_scan_db(psoc, pdev);
+	if (!scan_db) {
+		scm_err("scan_db is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	return scm_scan_db_update_mlme_info(scan_db, entry);
+}
+
 QDF_STATUS scm_scan_update_mlme_by_bssinfo(struct wlan_objmgr_pdev *pdev,
 		struct bss_info *bss_info, struct mlme_info *mlme)
 {
@@ -2149,6 +2617,7 @@ QDF_STATUS scm_scan_update_mlme_by_bssinfo(struct wlan_objmgr_pdev *pdev,
 	struct scan_cache_node *next_node = NULL;
 	struct wlan_objmgr_psoc *psoc;
 	struct scan_cache_entry *entry;
+	QDF_STATUS status;
 
 	psoc = wlan_pdev_get_psoc(pdev);
 	if (!psoc) {
@@ -2162,6 +2631,7 @@ QDF_STATUS scm_scan_update_mlme_by_bssinfo(struct wlan_objmgr_pdev *pdev,
 	}
 
 	hash_idx = SCAN_GET_HASH(bss_info->bssid.bytes);
+retry:
 	cur_node = scm_get_next_node(scan_db,
 			&scan_db->scan_hash_tbl[hash_idx], NULL);
 	while (cur_node) {
@@ -2169,18 +2639,16 @@ QDF_STATUS scm_scan_update_mlme_by_bssinfo(struct wlan_objmgr_pdev *pdev,
 		if (qdf_is_macaddr_equal(&bss_info->bssid, &entry->bssid) &&
 			(util_is_ssid_match(&bss_info->ssid, &entry->ssid)) &&
 			(bss_info->freq == entry->channel.chan_freq)) {
-			/* Acquire db lock to prevent simultaneous update */
-			qdf_spin_lock_bh(&scan_db->scan_db_lock);
-			qdf_mem_copy(&entry->mlme_info, mlme,
-					sizeof(struct mlme_info));
 			scm_debug("BSSID: "QDF_MAC_ADDR_FMT" set assoc_state to %d with age %lu ms",
 				  QDF_MAC_ADDR_REF(entry->bssid.bytes),
 				  mlme->assoc_state,
 				  util_scan_entry_age(entry));
-			scm_scan_entry_put_ref(scan_db,
-					cur_node, false);
-			qdf_spin_unlock_bh(&scan_db->scan_db_lock);
-			return QDF_STATUS_SUCCESS;
+			status = scm_scan_entry_replace_mlme(scan_db, cur_node,
+							     mlme);
+			if (status == QDF_STATUS_E_AGAIN)
+				goto retry;
+
+			return status;
 		}
 		next_node = scm_get_next_node(scan_db,
 				&scan_db->scan_hash_tbl[hash_idx], cur_node);
@@ -2219,9 +2687,7 @@ scm_scan_get_scan_entry_by_mac_freq(struct wlan_objmgr_pdev *pdev,
 				    uint16_t freq)
 {
 	struct scan_filter *scan_filter;
-	qdf_list_t *list = NULL;
-	struct scan_cache_node *first_node = NULL;
-	qdf_list_node_t *cur_node = NULL;
+	struct scan_cache_snapshot *snapshot;
 	struct scan_cache_entry *scan_entry = NULL;
 
 	scan_filter = qdf_mem_malloc(sizeof(*scan_filter));
@@ -2232,9 +2698,9 @@ scm_scan_get_scan_entry_by_mac_freq(struct wlan_objmgr_pdev *pdev,
 	scan_filter->num_of_channels = 1;
 	qdf_copy_macaddr(&scan_filter->bssid_list[0], bssid);
 
-	list = scm_get_scan_result(pdev, scan_filter);
+	snapshot = scm_get_scan_snapshot(pdev, scan_filter);
 	qdf_mem_free(scan_filter);
-	if (!list || (list && !qdf_list_size(list))) {
+	if (!snapshot || !snapshot->num_entries) {
 		scm_debug("Scan entry for bssid:"
 			  QDF_MAC_ADDR_FMT "and freq %d not found",
 			  QDF_MAC_ADDR_REF(bssid->bytes), freq);
@@ -2243,21 +2709,14 @@ scm_scan_get_scan_entry_by_mac_freq(struct wlan_objmgr_pdev *pdev,
 	/*
 	 * There might be multiple scan results in the scan db with given mac
 	 * address(e.g. SSID/some capabilities of the AP have just changed and
-	 * old entry is not aged out yet). scm_get_scan_result() inserts the
-	 * latest scan result at the front of the given list. So, it's ok to
-	 * pick scan result from the front node alone.
+	 * old entry is not aged out yet). The snapshot keeps the latest scan
+	 * result first, so it's ok to pick the first entry alone.
 	 */
-	qdf_list_peek_front(list, &cur_node);
-	first_node = qdf_container_of(cur_node,
-				      struct scan_cache_node,
-				      node);
-
-	if (first_node && first_node->entry)
-		scan_entry = util_scan_copy_cache_entry(first_node->entry);
+	scan_entry = util_scan_copy_cache_entry(snapshot->entries[0].entry);
 
 done:
-	if (list)
-		scm_purge_scan_results(list);
+	if (snapshot)
+		scm_scan_snapshot_put_ref(snapshot);
 
 	return scan_entry;
 }
@@ -2268,9 +2727,8 @@ scm_scan_get_entry_by_mac_addr(struct wlan_objmgr_pdev *pdev,
 			       struct element_info *frame)
 {
 	struct scan_filter *scan_filter;
-	qdf_list_t *list = NULL;
-	struct scan_cache_node *first_node = NULL;
-	qdf_list_node_t *cur_node = NULL;
+	struct scan_cache_snapshot *snapshot;
+	struct scan_cache_entry *entry;
 	QDF_STATUS status = QDF_STATUS_SUCCESS;
 
 	scan_filter = qdf_mem_malloc(sizeof(*scan_filter));
@@ -2278,38 +2736,30 @@ scm_scan_get_entry_by_mac_addr(struct wlan_objmgr_pdev *pdev,
 		return QDF_STATUS_E_NOMEM;
 	scan_filter->num_of_bssid = 1;
 	qdf_copy_macaddr(&scan_filter->bssid_list[0], bssid);
-	list = scm_get_scan_result(pdev, scan_filter);
+	snapshot = scm_get_scan_snapshot(pdev, scan_filter);
 	qdf_mem_free(scan_filter);
-	if (!list || (list && !qdf_list_size(list))) {
+	if (!snapshot || !snapshot->num_entries) {
 		status = QDF_STATUS_E_INVAL;
 		goto done;
 	}
 	/*
 	 * There might be multiple scan results in the scan db with given mac
 	 * address(e.g. SSID/some capabilities of the AP have just changed and
-	 * old entry is not aged out yet). scm_get_scan_result() inserts the
-	 * latest scan result at the front of the given list. So, it's ok to
-	 * pick scan result from the front node alone.
+	 * old entry is not aged out yet). The snapshot keeps the latest scan
+	 * result first, so it's ok to pick the first entry alone.
 	 */
-	qdf_list_peek_front(list, &cur_node);
-	first_node = qdf_container_of(cur_node,
-				      struct scan_cache_node,
-				      node);
-	if (first_node && first_node->entry) {
-		frame->len = first_node->entry->raw_frame.len;
-		frame->ptr = qdf_mem_malloc(frame->len);
-		if (!frame->ptr) {
-			status = QDF_STATUS_E_NOMEM;
-			goto done;
-		}
-		qdf_mem_copy(frame->ptr,
-			     first_node->entry->raw_frame.ptr,
-			     frame->len);
+	entry = snapshot->entries[0].entry;
+	frame->len = entry->raw_frame.len;
+	frame->ptr = qdf_mem_malloc(frame->len);
+	if (!frame->ptr) {
+		status = QDF_STATUS_E_NOMEM;
+		goto done;
 	}
+	qdf_mem_copy(frame->ptr, entry->raw_frame.ptr, frame->len);
 
 done:
-	if (list)
-		scm_purge_scan_results(list);
+	if (snapshot)
+		scm_scan_snapshot_put_ref(snapshot);
 
 	return status;
 }
@@ -2347,10 +2797,8 @@ scm_scan_get_entry_by_bssid(struct wlan_objmgr_pdev *pdev,
 			    struct qdf_mac_addr *bssid)
 {
 	struct scan_filter *scan_filter;
-	qdf_list_t *list = NULL;
-	struct scan_cache_node *first_node = NULL;
-	qdf_list_node_t *cur_node = NULL;
-	struct scan_cache_entry *entry = NULL, *scan_entry = NULL;
+	struct scan_cache_snapshot *snapshot;
+	struct scan_cache_entry *scan_entry = NULL;
 
 	if (!pdev)
 		return NULL;
@@ -2362,25 +2810,19 @@ scm_scan_get_entry_by_bssid(struct wlan_objmgr_pdev *pdev,
 	scan_filter->num_of_bssid = 1;
 	qdf_mem_copy(scan_filter->bssid_list[0].bytes,
 		     bssid, sizeof(struct qdf_mac_addr));
-	list = scm_get_scan_result(pdev, scan_filter);
+	snapshot = scm_get_scan_snapshot(pdev, scan_filter);
 	qdf_mem_free(scan_filter);
 
-	if (!list || (!qdf_list_size(list))) {
+	if (!snapshot || !snapshot->num_entries) {
 		scm_debug("Scan entry for bssid: "QDF_MAC_ADDR_FMT" not found",
 			  QDF_MAC_ADDR_REF(bssid->bytes));
 		goto exit;
 	}
 
-	qdf_list_peek_front(list, &cur_node);
-	first_node = qdf_container_of(cur_node, struct scan_cache_node,
-				      node);
-	if (first_node && first_node->entry) {
-		entry = first_node->entry;
-		scan_entry = util_scan_copy_cache_entry(entry);
-	}
+	scan_entry = util_scan_copy_cache_entry(snapshot->entries[0].entry);
 exit:
-	if (list)
-		scm_purge_scan_results(list);
+	if (snapshot)
+		scm_scan_snapshot_put_ref(snapshot);
 
 	return scan_entry;
 }
@@ -119,6 +119,138 @@ qdf_list_t *scm_get_scan_result(struct wlan_objmgr_pdev *pdev,
  */
 QDF_STATUS scm_purge_scan_results(qdf_list_t *scan_result);
 
+/**
+ * scm_scan_db_add_entry() - insert a scan entry in the scan db
+ * @scan_db: scan db
+ * @scan_params: entry to insert, owned by the scan db on success
+ * @dup_node: referenced older node of the same BSS, replaced by the new one,
+ *  or NULL
+ *
+ * The reference on @dup_node is released in every case.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS scm_scan_db_add_entry(struct scan_dbs *scan_db,
+				 struct scan_cache_entry *scan_params,
+				 struct scan_cache_node *dup_node);
+
+/**
+ * scm_scan_db_flush() - delete the scan db entries matching a filter
+ * @psoc: psoc ptr, only used to match @filter
+ * @scan_db: scan db
+ * @filter: filter, NULL to delete every entry
+ *
+ * Entries still referenced are only unlinked logically and freed along with
+ * the last reference.
+ *
+ * Return: void
+ */
+void scm_scan_db_flush(struct wlan_objmgr_psoc *psoc,
+		       struct scan_dbs *scan_db, struct scan_filter *filter);
+
+/**
+ * scm_scan_db_get_snapshot() - take a read-only snapshot of a scan db
+ * @psoc: psoc ptr, only used to match @filter
+ * @scan_db: scan db
+ * @filter: Filters, NULL to get every entry
+ *
+ * Same as scm_get_scan_snapshot() but without aging out the scan db first.
+ *
+ * Return: snapshot, NULL on failure
+ */
+struct scan_cache_snapshot *
+scm_scan_db_get_snapshot(struct wlan_objmgr_psoc *psoc,
+			 struct scan_dbs *scan_db,
+			 struct scan_filter *filter);
+
+/**
+ * scm_get_scan_snapshot() - take a read-only snapshot of the scan db
+ * @pdev: pdev info
+ * @filter: Filters, NULL to get every entry
+ *
+ * Unlike scm_get_scan_result(), matching entries are not duplicated: the
+ * snapshot references the scan db entries, which must not be modified.
+ * The snapshot holds a reference on @pdev, so the scan db outlives it.
+ * The caller owns one reference and releases it with
+ * scm_scan_snapshot_put_ref().
+ *
+ * Return: snapshot, NULL on failure
+ */
+struct scan_cache_snapshot *
+scm_get_scan_snapshot(struct wlan_objmgr_pdev *pdev,
+		      struct scan_filter *filter);
+
+/**
+ * scm_scan_snapshot_get_ref() - take an additional snapshot reference
+ * @snapshot: scan snapshot
+ *
+ * Return: void
+ */
+void scm_scan_snapshot_get_ref(struct scan_cache_snapshot *snapshot);
+
+/**
+ * scm_scan_snapshot_put_ref() - release a snapshot reference
+ * @snapshot: scan snapshot
+ *
+ * The scan entries and the pdev referenced by the snapshot are released
+ * along with the last reference.
+ *
+ * Return: void
+ */
+void scm_scan_snapshot_put_ref(struct scan_cache_snapshot *snapshot);
+
+/**
+ * scm_scan_snapshot_get_result() - build a scan result list from a snapshot
+ * @snapshot: scan snapshot
+ *
+ * Every node of the list takes its own reference on @snapshot, the reference
+ * of the caller is left untouched. See scm_get_scan_result_from_snapshot().
+ *
+ * Return: scan list, NULL if it could not be built completely
+ */
+qdf_list_t *scm_scan_snapshot_get_result(struct scan_cache_snapshot *snapshot);
+
+/**
+ * scm_get_scan_result_from_snapshot() - fetches scan result backed by a
+ * snapshot
+ * @pdev: pdev info
+ * @filter: Filters
+ *
+ * Same list as scm_get_scan_result(), but the entries are shallow copies of
+ * the scan db entries: the frame and IEs are shared with the scan db, which
+ * is kept from freeing them by a snapshot reference held by each node. The
+ * entry fields themselves are private to the caller. Nodes removed from the
+ * list must be released with scm_free_scan_result_node().
+ *
+ * Return: scan list
+ */
+qdf_list_t *scm_get_scan_result_from_snapshot(struct wlan_objmgr_pdev *pdev,
+					      struct scan_filter *filter);
+
+/**
+ * scm_free_scan_result_node() - free a node of a scan result list
+ * @scan_node: node already removed from the list
+ *
+ * Handles both the deep copies of scm_get_scan_result() and the snapshot
+ * backed copies of scm_get_scan_result_from_snapshot().
+ *
+ * Return: void
+ */
+void scm_free_scan_result_node(struct scan_cache_node *scan_node);
+
+/**
+ * scm_scan_db_update_mlme_info() - updates a scan db entry with mlme data
+ * @scan_db: scan db
+ * @entry: source scan entry to read mlme info
+ *
+ * The matching entry is replaced by a copy carrying the new mlme info, the
+ * old one stays untouched for the snapshots referencing it.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS scm_scan_db_update_mlme_info(struct scan_dbs *scan_db,
+					struct scan_cache_entry *entry);
+
 /**
  * scm_update_scan_mlme_info() - updates scan entry with mlme data
  * @pdev: pdev object
@@ -221,6 +353,33 @@ QDF_STATUS scm_db_init(struct wlan_objmgr_psoc *psoc);
  */
 QDF_STATUS scm_db_deinit(struct wlan_objmgr_psoc *psoc);
 
+#ifdef WLAN_SCAN_NODE_OBJPOOL
+/**
+ * scm_db_node_pool_init() - create the pool of scan db nodes
+ *
+ * The pool is shared by the scan db of all the psocs.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS scm_db_node_pool_init(void);
+
+/**
+ * scm_db_node_pool_deinit() - destroy the pool of scan db nodes
+ *
+ * Return: void
+ */
+void scm_db_node_pool_deinit(void);
+#else
+static inline QDF_STATUS scm_db_node_pool_init(void)
+{
+	return QDF_STATUS_SUCCESS;
+}
+
+static inline void scm_db_node_pool_deinit(void)
+{
+}
+#endif
+
 #ifdef FEATURE_6G_SCAN_CHAN_SORT_ALGO
 
 /**
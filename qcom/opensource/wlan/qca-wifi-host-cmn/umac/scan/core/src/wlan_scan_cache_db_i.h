@@ -38,6 +38,64 @@ bool scm_filter_match(struct wlan_objmgr_psoc *psoc,
 	struct scan_filter *filter,
 	struct security_info *security);
 
+/**
+ * struct scan_filter_compiled - scan filter pre-processed for fast matching
+ * @filter: filter this was compiled from, NULL to match every entry
+ * @hash_bitmap: scan db hash buckets which can hold a matching BSSID
+ * @num_freq: number of frequencies in @freq_list, 0 if any channel matches
+ * @freq_list: channel frequencies of @filter in ascending order
+ *
+ * Checks which reject most entries (BSSID, channel, age, 6 GHz) are resolved
+ * once here, so that only the entries passing them go through the full
+ * scm_filter_match().
+ */
+struct scan_filter_compiled {
+	struct scan_filter *filter;
+	uint64_t hash_bitmap;
+	uint16_t num_freq;
+	qdf_freq_t freq_list[NUM_CHANNELS];
+};
+
+/**
+ * scm_filter_compile() - private API to pre-process a scan filter
+ * @filter: filter to compile, may be NULL. It is referenced, not copied, and
+ *  must stay valid for as long as @compiled is used
+ * @compiled: compiled filter to fill
+ *
+ * Return: void
+ */
+void scm_filter_compile(struct scan_filter *filter,
+			struct scan_filter_compiled *compiled);
+
+/**
+ * scm_filter_compiled_prematch() - private API to run the cheap checks of a
+ * compiled filter on an entry
+ * @compiled: compiled filter
+ * @db_entry: db entry
+ *
+ * Safe to be called with scan_db_lock held. An entry passing this must still
+ * be checked with scm_filter_match().
+ *
+ * Return: false if the entry can't match the filter
+ */
+bool scm_filter_compiled_prematch(struct scan_filter_compiled *compiled,
+				  struct scan_cache_entry *db_entry);
+
+/**
+ * scm_filter_compiled_has_bucket() - check if a scan db hash bucket can
+ * hold entries matching the compiled filter
+ * @compiled: compiled filter
+ * @hash_idx: scan db hash index
+ *
+ * Return: true if the bucket needs to be walked
+ */
+static inline bool
+scm_filter_compiled_has_bucket(struct scan_filter_compiled *compiled,
+			       uint8_t hash_idx)
+{
+	return !!(compiled->hash_bitmap & (1ULL << hash_idx));
+}
+
 /**
  * wlan_pdevid_get_scan_db() - private API to get scan db from pdev id
  * @psoc: psoc object
@@ -1066,3 +1066,111 @@ bool scm_filter_match(struct wlan_objmgr_psoc *psoc,
 
 	return true;
 }
+
+QDF_COMPILE_TIME_ASSERT(scm_filter_hash_bitmap_check,
+			SCAN_HASH_SIZE <= sizeof(uint64_t) * 8);
+
+void scm_filter_compile(struct scan_filter *filter,
+			struct scan_filter_compiled *compiled)
+{
+	uint16_t i, j;
+	qdf_freq_t freq;
+
+	compiled->filter = filter;
+	compiled->num_freq = 0;
+
+	if (!filter || !filter->num_of_bssid) {
+		compiled->hash_bitmap = ~0ULL;
+	} else {
+		compiled->hash_bitmap = 0;
+		for (i = 0; i < filter->num_of_bssid; i++) {
+			/* zero/broadcast BSSID is a wildcard, walk everything */
+			if (qdf_is_macaddr_zero(&filter->bssid_list[i]) ||
+			    qdf_is_macaddr_broadcast(&filter->bssid_list[i])) {
+				compiled->hash_bitmap = ~0ULL;
+				break;
+			}
+			compiled->hash_bitmap |=
+			  1ULL << SCAN_GET_HASH(filter->bssid_list[i].bytes);
+		}
+	}
+
+	if (!filter)
+		return;
+
+	for (i = 0; i < filter->num_of_channels; i++) {
+		freq = filter->chan_freq_list[i];
+		/* A zero frequency in the list matches any channel */
+		if (!freq) {
+			compiled->num_freq = 0;
+			return;
+		}
+
+		/* Insertion sort, the list is compiled once per lookup */
+		for (j = compiled->num_freq;
+		     j && compiled->freq_list[j - 1] > freq; j--)
+			compiled->freq_list[j] = compiled->freq_list[j - 1];
+		compiled->freq_list[j] = freq;
+		compiled->num_freq++;
+	}
+}
+
+/**
+ * scm_filter_compiled_freq_match() - binary search the compiled freq list
+ * @compiled: compiled filter
+ * @freq: frequency of the entry
+ *
+ * Return: true if @freq is part of the filter
+ */
+static bool
+scm_filter_compiled_freq_match(struct scan_filter_compiled *compiled,
+			       qdf_freq_t freq)
+{
+	int low = 0, high = compiled->num_freq - 1, mid;
+
+	while (low <= high) {
+		mid = low + (high - low) / 2;
+		if (compiled->freq_list[mid] == freq)
+			return true;
+		if (compiled->freq_list[mid] < freq)
+			low = mid + 1;
+		else
+			high = mid - 1;
+	}
+
+	return false;
+}
+
+bool scm_filter_compiled_prematch(struct scan_filter_compiled *compiled,
+				  struct scan_cache_entry *db_entry)
+{
+	struct scan_filter *filter = compiled->filter;
+	uint8_t i;
+
+	if (!filter)
+		return true;
+
+	if (filter->num_of_bssid) {
+		for (i = 0; i < filter->num_of_bssid; i++)
+			if (util_is_bssid_match(&filter->bssid_list[i],
+						&db_entry->bssid))
+				break;
+		if (i == filter->num_of_bssid)
+			return false;
+	}
+
+	if (compiled->num_freq &&
+	    !scm_filter_compiled_freq_match(compiled,
+					    db_entry->channel.chan_freq))
+		return false;
+
+	if (filter->age_threshold &&
+	    filter->age_threshold < util_scan_entry_age(db_entry))
+		return false;
+
+	if (filter->ignore_6ghz_channel &&
+	    WLAN_REG_IS_6GHZ_CHAN_FREQ(db_entry->channel.chan_freq))
+		return false;
+
+	return true;
+}
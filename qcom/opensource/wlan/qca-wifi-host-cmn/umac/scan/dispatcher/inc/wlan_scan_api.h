@@ -385,6 +385,77 @@ static inline qdf_list_t *wlan_scan_get_result(struct wlan_objmgr_pdev *pdev,
 	return scm_get_scan_result(pdev, filter);
 }
 
+/**
+ * wlan_scan_get_snapshot_result() - The Public API to get scan results
+ * without duplicating the frames
+ * @pdev: pdev info
+ * @filter: Filters
+ *
+ * Same as wlan_scan_get_result(), but the entries share their frame and IEs
+ * with the scan db. The entry fields can still be modified by the caller.
+ * Nodes removed from the list must be freed with wlan_scan_free_result_node().
+ *
+ * Return: scan list pointer
+ */
+static inline qdf_list_t *
+wlan_scan_get_snapshot_result(struct wlan_objmgr_pdev *pdev,
+			      struct scan_filter *filter)
+{
+	return scm_get_scan_result_from_snapshot(pdev, filter);
+}
+
+/**
+ * wlan_scan_free_result_node() - free a node removed from a scan result list
+ * @scan_node: scan result node
+ *
+ * Return: void
+ */
+static inline void wlan_scan_free_result_node(struct scan_cache_node *scan_node)
+{
+	scm_free_scan_result_node(scan_node);
+}
+
+/**
+ * wlan_scan_get_snapshot() - The Public API to get a read-only scan snapshot
+ * @pdev: pdev info
+ * @filter: Filters
+ *
+ * Zero-copy alternative to wlan_scan_get_result(), release the snapshot with
+ * wlan_scan_snapshot_put_ref().
+ *
+ * Return: scan snapshot pointer
+ */
+static inline struct scan_cache_snapshot *
+wlan_scan_get_snapshot(struct wlan_objmgr_pdev *pdev,
+		       struct scan_filter *filter)
+{
+	return scm_get_scan_snapshot(pdev, filter);
+}
+
+/**
+ * wlan_scan_snapshot_get_ref() - take an additional scan snapshot reference
+ * @snapshot: scan snapshot
+ *
+ * Return: void
+ */
+static inline void
+wlan_scan_snapshot_get_ref(struct scan_cache_snapshot *snapshot)
+{
+	scm_scan_snapshot_get_ref(snapshot);
+}
+
+/**
+ * wlan_scan_snapshot_put_ref() - release a scan snapshot reference
+ * @snapshot: scan snapshot
+ *
+ * Return: void
+ */
+static inline void
+wlan_scan_snapshot_put_ref(struct scan_cache_snapshot *snapshot)
+{
+	scm_scan_snapshot_put_ref(snapshot);
+}
+
 /**
  * wlan_scan_update_mlme_by_bssinfo() - The Public API to update mlme
  * info in the scan entry
@@ -337,12 +337,15 @@ struct bss_info {
  * @ref_cnt: ref count if in use
  * @cookie: cookie to check if entry is logically active
  * @entry: scan entry pointer
+ * @snapshot: for a scan result node, the snapshot pinning the frame @entry
+ *  points into, NULL if @entry is a deep copy owning its own frame
  */
 struct scan_cache_node {
 	qdf_list_node_t node;
 	qdf_atomic_t ref_cnt;
 	uint32_t cookie;
 	struct scan_cache_entry *entry;
+	struct scan_cache_snapshot *snapshot;
 };
 
 /**
@@ -689,6 +692,45 @@ struct scan_cache_entry {
 #endif /* OPLUS_FEATURE_WIFI_VENDOR_FT */
 };
 
+/* forward declaration */
+struct scan_dbs;
+
+/**
+ * struct scan_snapshot_entry - one entry of a scan cache snapshot
+ * @node: scan db node referenced by the snapshot
+ * @entry: scan entry shared with the scan db, must be treated as read-only
+ * @neg_sec_info: security negotiated while matching @entry against the
+ *  filter used to take the snapshot
+ */
+struct scan_snapshot_entry {
+	struct scan_cache_node *node;
+	struct scan_cache_entry *entry;
+	struct security_info neg_sec_info;
+};
+
+/**
+ * struct scan_cache_snapshot - refcounted read-only view of the scan db
+ * @ref_cnt: snapshot reference count, entries are released when it drops to 0
+ * @pdev: pdev owning @scan_db, referenced for the lifetime of the snapshot,
+ *  NULL if the snapshot was taken from a bare scan db
+ * @scan_db: scan db the snapshot was taken from
+ * @num_entries: number of valid entries in @entries
+ * @entries: matching entries, latest entry of a BSSID first
+ *
+ * Entries are not duplicated: the snapshot holds a reference on each scan db
+ * node instead. The scan db never modifies a cached entry in place: an update
+ * from a new beacon/probe response or of the mlme_info inserts a new node and
+ * only unlinks the old one logically, so an entry stays valid and unchanged
+ * for as long as the snapshot holds it.
+ */
+struct scan_cache_snapshot {
+	qdf_atomic_t ref_cnt;
+	struct wlan_objmgr_pdev *pdev;
+	struct scan_dbs *scan_db;
+	uint32_t num_entries;
+	struct scan_snapshot_entry entries[];
+};
+
 #define MAX_FAVORED_BSSID 16
 #define MAX_ALLOWED_SSID_LIST 4
 
@@ -410,6 +410,29 @@ qdf_list_t *ucfg_scan_get_result(struct wlan_objmgr_pdev *pdev,
  */
 QDF_STATUS ucfg_scan_purge_results(qdf_list_t *scan_list);
 
+/**
+ * ucfg_scan_get_snapshot() - The Public API to get a read-only scan snapshot
+ * @pdev: pdev info
+ * @filter: Filters
+ *
+ * Zero-copy alternative to ucfg_scan_get_result(): matching entries are
+ * referenced, not duplicated, and must not be modified.
+ *
+ * Return: scan snapshot pointer, to be released with
+ * ucfg_scan_snapshot_release()
+ */
+struct scan_cache_snapshot *
+ucfg_scan_get_snapshot(struct wlan_objmgr_pdev *pdev,
+		       struct scan_filter *filter);
+
+/**
+ * ucfg_scan_snapshot_release() - release a scan snapshot reference
+ * @snapshot: scan snapshot
+ *
+ * Return: void
+ */
+void ucfg_scan_snapshot_release(struct scan_cache_snapshot *snapshot);
+
 /**
  * ucfg_scan_flush_results() - The Public API to flush scan result
  * @pdev: pdev object
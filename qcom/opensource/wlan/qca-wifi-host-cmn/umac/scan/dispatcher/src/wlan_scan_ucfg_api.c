@@ -65,6 +65,18 @@ QDF_STATUS ucfg_scan_purge_results(qdf_list_t *scan_list)
 	return scm_purge_scan_results(scan_list);
 }
 
+struct scan_cache_snapshot *
+ucfg_scan_get_snapshot(struct wlan_objmgr_pdev *pdev,
+		       struct scan_filter *filter)
+{
+	return scm_get_scan_snapshot(pdev, filter);
+}
+
+void ucfg_scan_snapshot_release(struct scan_cache_snapshot *snapshot)
+{
+	scm_scan_snapshot_put_ref(snapshot);
+}
+
 QDF_STATUS ucfg_scan_flush_results(struct wlan_objmgr_pdev *pdev,
 	struct scan_filter *filter)
 {
@@ -86,6 +98,12 @@ QDF_STATUS ucfg_scan_init(void)
 {
 	QDF_STATUS status;
 
+	status = scm_db_node_pool_init();
+	if (QDF_IS_STATUS_ERROR(status)) {
+		scm_err("Failed to create scan node pool");
+		return status;
+	}
+
 	status = wlan_objmgr_register_psoc_create_handler(WLAN_UMAC_COMP_SCAN,
 		wlan_scan_psoc_created_notification, NULL);
 	if (QDF_IS_STATUS_ERROR(status)) {
@@ -125,6 +143,7 @@ fail_psoc_destroy:
 	wlan_objmgr_unregister_psoc_create_handler(WLAN_UMAC_COMP_SCAN,
 			wlan_scan_psoc_created_notification, NULL);
 fail_create_psoc:
+	scm_db_node_pool_deinit();
 	return status;
 }
 
@@ -154,6 +173,8 @@ QDF_STATUS ucfg_scan_deinit(void)
 	if (status != QDF_STATUS_SUCCESS)
 		scm_err("Failed to unregister vdev delete handler");
 
+	scm_db_node_pool_deinit();
+
 	return status;
 }
 
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_list.h"
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+#include "../core/src/wlan_scan_cache_db.h"
+#include "wlan_scan_cache_db_test.h"
+#include "wlan_scan_utils_api.h"
+
+#define SCM_TEST_FRAME_LEN 64
+#define SCM_TEST_FRAME_BYTE(bssid_byte, i) ((uint8_t)((bssid_byte) ^ (i)))
+
+static struct scan_dbs *scm_test_db_create(void)
+{
+	struct scan_dbs *scan_db;
+	int i;
+
+	scan_db = qdf_mem_malloc(sizeof(*scan_db));
+	if (!scan_db)
+		return NULL;
+
+	qdf_spinlock_create(&scan_db->scan_db_lock);
+	for (i = 0; i < SCAN_HASH_SIZE; i++)
+		qdf_list_create(&scan_db->scan_hash_tbl[i],
+				MAX_SCAN_CACHE_SIZE);
+
+	return scan_db;
+}
+
+static void scm_test_db_destroy(struct scan_dbs *scan_db)
+{
+	int i;
+
+	scm_scan_db_flush(NULL, scan_db, NULL);
+	QDF_BUG(!scan_db->num_entries);
+
+	for (i = 0; i < SCAN_HASH_SIZE; i++)
+		qdf_list_destroy(&scan_db->scan_hash_tbl[i]);
+	qdf_spinlock_destroy(&scan_db->scan_db_lock);
+	qdf_mem_free(scan_db);
+}
+
+static struct scan_cache_entry *scm_test_entry_create(uint8_t bssid_byte)
+{
+	struct scan_cache_entry *entry;
+	uint8_t *frame;
+	int i;
+
+	entry = qdf_mem_malloc(sizeof(*entry));
+	if (!entry)
+		return NULL;
+
+	frame = qdf_mem_malloc(SCM_TEST_FRAME_LEN);
+	if (!frame) {
+		qdf_mem_free(entry);
+		return NULL;
+	}
+	for (i = 0; i < SCM_TEST_FRAME_LEN; i++)
+		frame[i] = SCM_TEST_FRAME_BYTE(bssid_byte, i);
+
+	entry->raw_frame.ptr = frame;
+	entry->raw_frame.len = SCM_TEST_FRAME_LEN;
+	entry->cap_info.wlan_caps.ess = 1;
+	entry->bssid.bytes[0] = 0x02;
+	entry->bssid.bytes[QDF_MAC_ADDR_SIZE - 1] = bssid_byte;
+	entry->ssid.length = 4;
+	qdf_mem_copy(entry->ssid.ssid, "test", entry->ssid.length);
+	entry->channel.chan_freq = 5180;
+
+	return entry;
+}
+
+static bool scm_test_entry_intact(struct scan_cache_entry *entry,
+				  uint8_t bssid_byte)
+{
+	int i;
+
+	if (entry->bssid.bytes[QDF_MAC_ADDR_SIZE - 1] != bssid_byte ||
+	    entry->raw_frame.len != SCM_TEST_FRAME_LEN)
+		return false;
+
+	for (i = 0; i < SCM_TEST_FRAME_LEN; i++)
+		if (entry->raw_frame.ptr[i] !=
+		    SCM_TEST_FRAME_BYTE(bssid_byte, i))
+			return false;
+
+	return true;
+}
+
+static QDF_STATUS scm_test_db_add(struct scan_dbs *scan_db,
+				  uint8_t bssid_byte)
+{
+	struct scan_cache_entry *entry;
+	QDF_STATUS status;
+
+	entry = scm_test_entry_create(bssid_byte);
+	if (!entry)
+		return QDF_STATUS_E_NOMEM;
+
+	status = scm_scan_db_add_entry(scan_db, entry, NULL);
+	if (QDF_IS_STATUS_ERROR(status))
+		util_scan_free_cache_entry(entry);
+
+	return status;
+}
+
+static uint32_t scm_test_snapshot_pins_entries(void)
+{
+	struct scan_cache_snapshot *snapshot;
+	struct scan_dbs *scan_db;
+
+	scan_db = scm_test_db_create();
+	QDF_BUG(scan_db);
+	if (!scan_db)
+		return 1;
+
+	QDF_BUG(QDF_IS_STATUS_SUCCESS(scm_test_db_add(scan_db, 1)));
+	QDF_BUG(QDF_IS_STATUS_SUCCESS(scm_test_db_add(scan_db, 2)));
+
+	/* a snapshot should ... */
+	snapshot = scm_scan_db_get_snapshot(NULL, scan_db, NULL);
+	QDF_BUG(snapshot);
+	if (!snapshot) {
+		scm_test_db_destroy(scan_db);
+		return 1;
+	}
+
+	/* ... return the latest entry first */
+	QDF_BUG(snapshot->num_entries == 2);
+	QDF_BUG(scm_test_entry_intact(snapshot->entries[0].entry, 2));
+	QDF_BUG(scm_test_entry_intact(snapshot->entries[1].entry, 1));
+
+	/* ... keep the entries alive once they are flushed from the db */
+	scm_scan_db_flush(NULL, scan_db, NULL);
+	QDF_BUG(scan_db->num_entries == 2);
+	QDF_BUG(scm_test_entry_intact(snapshot->entries[0].entry, 2));
+	QDF_BUG(scm_test_entry_intact(snapshot->entries[1].entry, 1));
+
+	/* ... release them along with the last reference */
+	scm_scan_snapshot_get_ref(snapshot);
+	scm_scan_snapshot_put_ref(snapshot);
+	QDF_BUG(scan_db->num_entries == 2);
+	scm_scan_snapshot_put_ref(snapshot);
+	QDF_BUG(!scan_db->num_entries);
+
+	scm_test_db_destroy(scan_db);
+
+	return 0;
+}
+
+static uint32_t scm_test_mlme_update_copy_on_write(void)
+{
+	struct scan_cache_snapshot *old_snap, *new_snap, *same_snap;
+	struct scan_cache_entry *update;
+	struct scan_dbs *scan_db;
+
+	scan_db = scm_test_db_create();
+	QDF_BUG(scan_db);
+	if (!scan_db)
+		return 1;
+
+	QDF_BUG(QDF_IS_STATUS_SUCCESS(scm_test_db_add(scan_db, 1)));
+	old_snap = scm_scan_db_get_snapshot(NULL, scan_db, NULL);
+	QDF_BUG(old_snap && old_snap->num_entries == 1);
+	if (!old_snap || old_snap->num_entries != 1) {
+		if (old_snap)
+			scm_scan_snapshot_put_ref(old_snap);
+		scm_test_db_destroy(scan_db);
+		return 1;
+	}
+
+	update = scm_test_entry_create(1);
+	QDF_BUG(update);
+	if (!update) {
+		scm_scan_snapshot_put_ref(old_snap);
+		scm_test_db_destroy(scan_db);
+		return 1;
+	}
+	update->mlme_info.assoc_state = SCAN_ENTRY_CON_STATE_ASSOC;
+
+	/* an mlme update should ... */
+	QDF_BUG(QDF_IS_STATUS_SUCCESS(
+			scm_scan_db_update_mlme_info(scan_db, update)));
+
+	/* ... leave the entry seen by an existing snapshot untouched */
+	QDF_BUG(old_snap->entries[0].entry->mlme_info.assoc_state ==
+		SCAN_ENTRY_CON_STATE_NONE);
+	QDF_BUG(scm_test_entry_intact(old_snap->entries[0].entry, 1));
+
+	/* ... be visible, in a new entry, to later snapshots */
+	new_snap = scm_scan_db_get_snapshot(NULL, scan_db, NULL);
+	QDF_BUG(new_snap && new_snap->num_entries == 1);
+	if (new_snap && new_snap->num_entries == 1) {
+		QDF_BUG(new_snap->entries[0].entry !=
+			old_snap->entries[0].entry);
+		QDF_BUG(new_snap->entries[0].entry->mlme_info.assoc_state ==
+			SCAN_ENTRY_CON_STATE_ASSOC);
+		QDF_BUG(scm_test_entry_intact(new_snap->entries[0].entry, 1));
+	}
+
+	/* ... and be skipped when it changes nothing */
+	QDF_BUG(QDF_IS_STATUS_SUCCESS(
+			scm_scan_db_update_mlme_info(scan_db, update)));
+	util_scan_free_cache_entry(update);
+	same_snap = scm_scan_db_get_snapshot(NULL, scan_db, NULL);
+	QDF_BUG(same_snap && same_snap->num_entries == 1);
+	if (new_snap && same_snap && same_snap->num_entries == 1)
+		QDF_BUG(same_snap->entries[0].entry ==
+			new_snap->entries[0].entry);
+	if (same_snap)
+		scm_scan_snapshot_put_ref(same_snap);
+
+	/* ... keep the replaced entry until the old snapshot is released */
+	QDF_BUG(scan_db->num_entries == 2);
+	scm_scan_snapshot_put_ref(old_snap);
+	QDF_BUG(scan_db->num_entries == 1);
+
+	if (new_snap)
+		scm_scan_snapshot_put_ref(new_snap);
+	scm_test_db_destroy(scan_db);
+
+	return 0;
+}
+
+static uint32_t scm_test_result_from_snapshot(void)
+{
+	struct scan_cache_snapshot *snapshot;
+	struct scan_cache_entry *db_entry;
+	struct scan_cache_node *scan_node;
+	qdf_list_node_t *cur_lst = NULL;
+	struct scan_dbs *scan_db;
+	qdf_list_t *scan_list;
+
+	scan_db = scm_test_db_create();
+	QDF_BUG(scan_db);
+	if (!scan_db)
+		return 1;
+
+	QDF_BUG(QDF_IS_STATUS_SUCCESS(scm_test_db_add(scan_db, 1)));
+	QDF_BUG(QDF_IS_STATUS_SUCCESS(scm_test_db_add(scan_db, 2)));
+
+	snapshot = scm_scan_db_get_snapshot(NULL, scan_db, NULL);
+	QDF_BUG(snapshot && snapshot->num_entries == 2);
+	if (!snapshot || snapshot->num_entries != 2) {
+		if (snapshot)
+			scm_scan_snapshot_put_ref(snapshot);
+		scm_test_db_destroy(scan_db);
+		return 1;
+	}
+	db_entry = snapshot->entries[0].entry;
+
+	/* a snapshot backed scan result should ... */
+	scan_list = scm_scan_snapshot_get_result(snapshot);
+	scm_scan_snapshot_put_ref(snapshot);
+	QDF_BUG(scan_list && qdf_list_size(scan_list) == 2);
+	if (!scan_list) {
+		scm_test_db_destroy(scan_db);
+		return 1;
+	}
+
+	qdf_list_peek_front(scan_list, &cur_lst);
+	scan_node = qdf_container_of(cur_lst, struct scan_cache_node, node);
+
+	/* ... share the frame but not the entry with the db */
+	QDF_BUG(scan_node->snapshot == snapshot);
+	QDF_BUG(scan_node->entry != db_entry);
+	QDF_BUG(scan_node->entry->raw_frame.ptr == db_entry->raw_frame.ptr);
+	scan_node->entry->bss_score = 100;
+	QDF_BUG(!db_entry->bss_score);
+
+	/* ... keep its frames alive while the db is flushed */
+	scm_scan_db_flush(NULL, scan_db, NULL);
+	QDF_BUG(scm_test_entry_intact(scan_node->entry, 2));
+
+	/* ... keep the other entries pinned when one node is freed */
+	qdf_list_remove_node(scan_list, cur_lst);
+	scm_free_scan_result_node(scan_node);
+	QDF_BUG(scan_db->num_entries == 2);
+
+	/* ... release the db entries once the list is purged */
+	scm_purge_scan_results(scan_list);
+	QDF_BUG(!scan_db->num_entries);
+
+	scm_test_db_destroy(scan_db);
+
+	return 0;
+}
+
+uint32_t scm_scan_db_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += scm_test_snapshot_pins_entries();
+	errors += scm_test_mlme_update_copy_on_write();
+	errors += scm_test_result_from_snapshot();
+
+	return errors;
+}
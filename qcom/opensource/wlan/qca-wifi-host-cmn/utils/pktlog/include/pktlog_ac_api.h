@@ -45,6 +45,7 @@ struct net_device;
 typedef struct net_device * net_device_handle;
 
 struct pktlog_dev_t;
+struct pktlog_pcpu_rings;
 
 void pktlog_sethandle(struct pktlog_dev_t **pl_handle,
 		     hif_opaque_softc_handle scn);
@@ -120,6 +121,10 @@ struct ath_pktlog_info {
 	uint32_t trigger_interval;
 	uint32_t start_time_thruput;
 	uint32_t start_time_per;
+#ifdef PKTLOG_PCPU_RING
+	/* Per-CPU rings, used when PKTLOG_OPT_PCPU_RING is set in options */
+	struct pktlog_pcpu_rings *pcpu_rings;
+#endif
 };
 #endif /* _PKTLOG_INFO */
 #else                           /* REMOVE_PKT_LOG */
@@ -60,6 +60,23 @@ char *pktlog_getbuf(struct pktlog_dev_t *pl_dev,
 		    struct ath_pktlog_info *pl_info,
 		    size_t log_size, struct ath_pktlog_hdr *pl_hdr);
 
+/**
+ * pktlog_write_record() - log a record with its payload
+ * @pl_dev: pktlog device
+ * @pl_info: pktlog info
+ * @pl_hdr: pktlog header, pl_hdr->size gives the payload length
+ * @data: payload
+ *
+ * The record goes to the ring of the current CPU in the per-CPU ring mode
+ * and to the shared pktlog buffer otherwise.
+ *
+ * Return: 0 on success, -ENOSPC if the record was dropped because the
+ *	   per-CPU ring was full, other negative errno on failure
+ */
+int pktlog_write_record(struct pktlog_dev_t *pl_dev,
+			struct ath_pktlog_info *pl_info,
+			struct ath_pktlog_hdr *pl_hdr, void *data);
+
 #ifdef PKTLOG_HAS_SPECIFIC_DATA
 /**
  * pktlog_hdr_set_specific_data() - set type specific data
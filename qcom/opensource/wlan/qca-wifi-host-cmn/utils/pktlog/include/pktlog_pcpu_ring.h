@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: pktlog_pcpu_ring.h - per-CPU single producer/single consumer rings
+ * used instead of the shared pktlog buffer when PKTLOG_OPT_PCPU_RING is set
+ * in the pktlog options.
+ */
+
+#ifndef _PKTLOG_PCPU_RING_H_
+#define _PKTLOG_PCPU_RING_H_
+
+#ifndef REMOVE_PKT_LOG
+#include <pktlog_ac.h>
+
+/* pktlog options bit selecting the per-CPU ring mode */
+#define PKTLOG_OPT_PCPU_RING	0x1
+
+#ifdef PKTLOG_PCPU_RING
+
+/* Minimum size of the data area of one per-CPU ring */
+#define PKTLOG_PCPU_RING_MIN_SIZE	(64 * 1024)
+
+/**
+ * struct pktlog_pcpu_ring - one per-CPU ring
+ * @hdr: ring header page, shared with the mmap reader
+ * @data: data area following the header page
+ */
+struct pktlog_pcpu_ring {
+	struct ath_pktlog_pcpu_ring_hdr *hdr;
+	uint8_t *data;
+};
+
+/**
+ * struct pktlog_pcpu_rings - set of per-CPU rings
+ * @base: start of the memory backing all the rings
+ * @ring_size: size of a ring, header page included
+ * @data_size: size of the data area of a ring, power of 2
+ * @num_rings: number of rings, one per possible CPU id
+ * @start_ts: log timestamp at which the rings were set up
+ * @ring: rings indexed by CPU id
+ */
+struct pktlog_pcpu_rings {
+	void *base;
+	size_t ring_size;
+	uint32_t data_size;
+	uint32_t num_rings;
+	uint64_t start_ts;
+	struct pktlog_pcpu_ring ring[];
+};
+
+/**
+ * pktlog_pcpu_ring_alloc() - allocate the per-CPU rings
+ * @pl_info: pktlog info, buf_size is split among the rings
+ *
+ * Return: 0 on success, negative errno on failure
+ */
+int pktlog_pcpu_ring_alloc(struct ath_pktlog_info *pl_info);
+
+/**
+ * pktlog_pcpu_ring_free() - free the per-CPU rings
+ * @pl_info: pktlog info
+ *
+ * Waits for the writers still using the rings, may sleep.
+ *
+ * Return: none
+ */
+void pktlog_pcpu_ring_free(struct ath_pktlog_info *pl_info);
+
+/**
+ * pktlog_pcpu_ring_setup() - initialize the ring headers
+ * @rings: rings with @base, @ring_size, @data_size and @num_rings filled in
+ *
+ * Return: none
+ */
+void pktlog_pcpu_ring_setup(struct pktlog_pcpu_rings *rings);
+
+/**
+ * pktlog_pcpu_ring_write() - append a record to the ring of this CPU
+ * @pl_info: pktlog info
+ * @pl_hdr: pktlog header of the record
+ * @data: pl_hdr->size bytes of payload
+ *
+ * Lock free; the record is dropped and accounted when the ring of the
+ * current CPU is full.
+ *
+ * Return: 0 on success, -ENOSPC if the record was dropped, -EINVAL if the
+ *	   ring mode is not active
+ */
+int pktlog_pcpu_ring_write(struct ath_pktlog_info *pl_info,
+			   struct ath_pktlog_hdr *pl_hdr, void *data);
+
+/**
+ * pktlog_pcpu_ring_peek() - get the oldest unread record of a ring
+ * @rings: per-CPU rings
+ * @cpu: ring index
+ *
+ * Padding is consumed on the way. Must be called by the single reader.
+ * A record whose length does not cover its pktlog header and payload is
+ * treated as corruption and the ring is reset to empty.
+ *
+ * Return: record or NULL if the ring is empty
+ */
+struct ath_pktlog_pcpu_rec *
+pktlog_pcpu_ring_peek(struct pktlog_pcpu_rings *rings, uint32_t cpu);
+
+/**
+ * pktlog_pcpu_ring_consume() - release the record returned by
+ *				pktlog_pcpu_ring_peek()
+ * @rings: per-CPU rings
+ * @cpu: ring index
+ * @rec: record to release
+ *
+ * Return: none
+ */
+void pktlog_pcpu_ring_consume(struct pktlog_pcpu_rings *rings, uint32_t cpu,
+			      struct ath_pktlog_pcpu_rec *rec);
+
+/**
+ * pktlog_pcpu_ring_advance() - release the records of a ring up to an offset
+ * @rings: per-CPU rings
+ * @cpu: ring index
+ * @new_tail: free running offset the reader is done with, must be a record
+ *	      boundary between the current tail and head
+ *
+ * Used by mmap readers, which cannot write the ring header themselves.
+ * Must be called by the single reader.
+ *
+ * Return: 0 on success, -EINVAL if @cpu or @new_tail is not valid
+ */
+int pktlog_pcpu_ring_advance(struct pktlog_pcpu_rings *rings, uint32_t cpu,
+			     uint64_t new_tail);
+
+/**
+ * pktlog_pcpu_ring_stats_print() - print per-CPU record and drop counters
+ * @pl_info: pktlog info
+ *
+ * Return: none
+ */
+void pktlog_pcpu_ring_stats_print(struct ath_pktlog_info *pl_info);
+
+/**
+ * pktlog_pcpu_ring_active() - check if the per-CPU ring mode is in use
+ * @pl_info: pktlog info
+ *
+ * Return: true if records are written to the per-CPU rings
+ */
+static inline bool pktlog_pcpu_ring_active(struct ath_pktlog_info *pl_info)
+{
+	return (pl_info->options & PKTLOG_OPT_PCPU_RING) && pl_info->pcpu_rings;
+}
+#else
+static inline int pktlog_pcpu_ring_alloc(struct ath_pktlog_info *pl_info)
+{
+	return -EINVAL;
+}
+
+static inline void pktlog_pcpu_ring_free(struct ath_pktlog_info *pl_info)
+{
+}
+
+static inline void
+pktlog_pcpu_ring_stats_print(struct ath_pktlog_info *pl_info)
+{
+}
+
+static inline int pktlog_pcpu_ring_write(struct ath_pktlog_info *pl_info,
+					 struct ath_pktlog_hdr *pl_hdr,
+					 void *data)
+{
+	return -EINVAL;
+}
+
+static inline bool pktlog_pcpu_ring_active(struct ath_pktlog_info *pl_info)
+{
+	return false;
+}
+#endif /* PKTLOG_PCPU_RING */
+#endif /* REMOVE_PKT_LOG */
+#endif /* _PKTLOG_PCPU_RING_H_ */
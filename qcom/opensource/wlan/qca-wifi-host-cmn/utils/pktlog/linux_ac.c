@@ -34,6 +34,8 @@
 #include <linux/proc_fs.h>
 #include <pktlog_ac_i.h>
 #include <pktlog_ac_fmt.h>
+#include <pktlog_pcpu_ring.h>
+#include <qdf_rcu.h>
 #include "i_host_diag_core_log.h"
 #include "host_diag_core_log.h"
 #include "ani_global.h"
@@ -84,6 +86,9 @@ static int pktlog_open(struct inode *i, struct file *f);
 static int pktlog_release(struct inode *i, struct file *f);
 static ssize_t pktlog_read(struct file *file, char *buf, size_t nbytes,
 			   loff_t *ppos);
+static int pktlog_mmap(struct file *file, struct vm_area_struct *vma);
+static long pktlog_ioctl(struct file *file, unsigned int cmd,
+			 unsigned long arg);
 
 #if (LINUX_VERSION_CODE >= KERNEL_VERSION(5, 6, 0))
 static const struct proc_ops pktlog_fops = {
@@ -91,12 +96,19 @@ static const struct proc_ops pktlog_fops = {
 	.proc_release = pktlog_release,
 	.proc_read = pktlog_read,
 	.proc_lseek = default_llseek,
+	.proc_mmap = pktlog_mmap,
+	.proc_ioctl = pktlog_ioctl,
+#ifdef CONFIG_COMPAT
+	.proc_compat_ioctl = compat_ptr_ioctl,
+#endif
 };
 #else
 static struct file_operations pktlog_fops = {
 	open:  pktlog_open,
 	release:pktlog_release,
 	read : pktlog_read,
+	mmap : pktlog_mmap,
+	unlocked_ioctl : pktlog_ioctl,
 };
 #endif
 
@@ -196,6 +208,133 @@ void pktlog_release_buf(struct hif_opaque_softc *scn)
 	pl_info->buf = NULL;
 }
 
+#ifdef PKTLOG_PCPU_RING
+int pktlog_pcpu_ring_alloc(struct ath_pktlog_info *pl_info)
+{
+	struct pktlog_pcpu_rings *rings;
+	uint32_t data_size;
+
+	if (pl_info->pcpu_rings)
+		return 0;
+
+	rings = qdf_mem_malloc(struct_size(rings, ring, nr_cpu_ids));
+	if (!rings)
+		return -ENOMEM;
+
+	data_size = qdf_rounddown_pow_of_two(pl_info->buf_size / nr_cpu_ids);
+	if (data_size < PKTLOG_PCPU_RING_MIN_SIZE)
+		data_size = PKTLOG_PCPU_RING_MIN_SIZE;
+
+	rings->num_rings = nr_cpu_ids;
+	rings->data_size = data_size;
+	rings->ring_size = PAGE_SIZE + data_size;
+
+	/* zeroed and suitable for remap_vmalloc_range() */
+	rings->base = vmalloc_user(rings->num_rings * rings->ring_size);
+	if (!rings->base) {
+		qdf_mem_free(rings);
+		return -ENOMEM;
+	}
+
+	pktlog_pcpu_ring_setup(rings);
+	qdf_rcu_assign_pointer(pl_info->pcpu_rings, rings);
+
+	qdf_info(PKTLOG_TAG " per-CPU rings: %u x %u bytes",
+		 rings->num_rings, data_size);
+
+	return 0;
+}
+
+void pktlog_pcpu_ring_free(struct ath_pktlog_info *pl_info)
+{
+	struct pktlog_pcpu_rings *rings = pl_info->pcpu_rings;
+
+	if (!rings)
+		return;
+
+	qdf_rcu_assign_pointer(pl_info->pcpu_rings, NULL);
+	qdf_synchronize_rcu();
+
+	/* pages still mapped by a reader are released on munmap */
+	vfree(rings->base);
+	qdf_mem_free(rings);
+}
+
+/**
+ * pktlog_pcpu_ring_read() - merge the per-CPU rings into the reader buffer
+ * @pl_info: pktlog info
+ * @buf: user buffer
+ * @nbytes: size of @buf
+ * @ppos: read offset, only used to emit the buffer header first
+ *
+ * Records are consumed from the rings in timestamp order and copied in the
+ * same ath_pktlog_hdr + payload format as the shared buffer, so the
+ * existing post processing scripts apply. Logging does not need to be
+ * stopped for reading.
+ *
+ * Return: number of bytes copied or negative errno
+ */
+static ssize_t pktlog_pcpu_ring_read(struct ath_pktlog_info *pl_info,
+				     char *buf, size_t nbytes, loff_t *ppos)
+{
+	struct pktlog_pcpu_rings *rings = pl_info->pcpu_rings;
+	struct ath_pktlog_pcpu_rec *rec, *oldest;
+	struct ath_pktlog_bufhdr bufhdr;
+	struct ath_pktlog_hdr *log_hdr;
+	uint32_t cpu, oldest_cpu = 0;
+	size_t count, ret_val = 0;
+
+	if (*ppos < sizeof(bufhdr)) {
+		bufhdr.magic_num = PKTLOG_MAGIC_NUM;
+		bufhdr.version = CUR_PKTLOG_VER;
+		count = QDF_MIN(sizeof(bufhdr) - *ppos, nbytes);
+		if (copy_to_user(buf, (char *)&bufhdr + *ppos, count))
+			return -EFAULT;
+		ret_val += count;
+	}
+
+	while (ret_val < nbytes) {
+		oldest = NULL;
+		for (cpu = 0; cpu < rings->num_rings; cpu++) {
+			rec = pktlog_pcpu_ring_peek(rings, cpu);
+			if (rec && (!oldest ||
+				    rec->timestamp < oldest->timestamp)) {
+				oldest = rec;
+				oldest_cpu = cpu;
+			}
+		}
+
+		if (!oldest)
+			break;
+
+		log_hdr = (struct ath_pktlog_hdr *)(oldest + 1);
+		count = sizeof(*log_hdr) + log_hdr->size;
+		if (count > nbytes - ret_val)
+			break;
+
+		if (copy_to_user(buf + ret_val, log_hdr, count)) {
+			if (!ret_val)
+				return -EFAULT;
+			break;
+		}
+
+		pktlog_pcpu_ring_consume(rings, oldest_cpu, oldest);
+		ret_val += count;
+	}
+
+	*ppos += ret_val;
+
+	return ret_val;
+}
+#else
+static inline ssize_t
+pktlog_pcpu_ring_read(struct ath_pktlog_info *pl_info, char *buf,
+		      size_t nbytes, loff_t *ppos)
+{
+	return 0;
+}
+#endif /* PKTLOG_PCPU_RING */
+
 static void pktlog_cleanup(struct ath_pktlog_info *pl_info)
 {
 	pl_info->log_state = 0;
@@ -636,6 +775,7 @@ static void pktlog_detach(struct hif_opaque_softc *scn)
 		pl_dev->tgt_pktlog_alloced = false;
 	}
 	qdf_spin_unlock_bh(&pl_info->log_lock);
+	pktlog_pcpu_ring_free(pl_info);
 	mutex_unlock(&pl_info->pktlog_mutex);
 	pktlog_cleanup(pl_info);
 
@@ -983,6 +1123,9 @@ __pktlog_read(struct file *file, char *buf, size_t nbytes, loff_t *ppos)
 	if (!pl_info)
 		return 0;
 
+	if (pktlog_pcpu_ring_active(pl_info))
+		return pktlog_pcpu_ring_read(pl_info, buf, nbytes, ppos);
+
 	qdf_spin_lock_bh(&pl_info->log_lock);
 	log_buf = pl_info->buf;
 
@@ -1142,6 +1285,130 @@ pktlog_read(struct file *file, char *buf, size_t nbytes, loff_t *ppos)
 	return err_size;
 }
 
+#ifdef PKTLOG_PCPU_RING
+/**
+ * __pktlog_mmap() - map the per-CPU rings read only
+ * @file: proc file
+ * @vma: user mapping
+ *
+ * The kernel trusts the ring headers and records, so user space only gets
+ * a read only view and releases records through read() or
+ * PKTLOG_IOCTL_PCPU_RING_ADVANCE.
+ *
+ * Return: 0 on success, negative errno on failure
+ */
+static int __pktlog_mmap(struct file *file, struct vm_area_struct *vma)
+{
+	struct ath_pktlog_info *pl_info;
+
+	pl_info = pde_data(file->f_path.dentry->d_inode);
+	if (!pl_info)
+		return -EINVAL;
+
+	if (!pktlog_pcpu_ring_active(pl_info))
+		return -ENODEV;
+
+	if (vma->vm_flags & VM_WRITE)
+		return -EPERM;
+
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(6, 3, 0))
+	vm_flags_clear(vma, VM_MAYWRITE);
+#else
+	vma->vm_flags &= ~VM_MAYWRITE;
+#endif
+
+	return remap_vmalloc_range(vma, pl_info->pcpu_rings->base,
+				   vma->vm_pgoff);
+}
+
+/**
+ * __pktlog_ioctl() - handle the per-CPU ring ioctls
+ * @file: proc file
+ * @cmd: ioctl command
+ * @arg: user pointer to the command argument
+ *
+ * Return: 0 on success, negative errno on failure
+ */
+static long __pktlog_ioctl(struct file *file, unsigned int cmd,
+			   unsigned long arg)
+{
+	struct ath_pktlog_pcpu_ring_advance adv;
+	struct ath_pktlog_info *pl_info;
+
+	if (cmd != PKTLOG_IOCTL_PCPU_RING_ADVANCE)
+		return -ENOTTY;
+
+	pl_info = pde_data(file->f_path.dentry->d_inode);
+	if (!pl_info)
+		return -EINVAL;
+
+	if (!pktlog_pcpu_ring_active(pl_info))
+		return -ENODEV;
+
+	if (copy_from_user(&adv, (void __user *)arg, sizeof(adv)))
+		return -EFAULT;
+
+	return pktlog_pcpu_ring_advance(pl_info->pcpu_rings, adv.cpu,
+					adv.tail);
+}
+#else
+static int __pktlog_mmap(struct file *file, struct vm_area_struct *vma)
+{
+	return -ENODEV;
+}
+
+static long __pktlog_ioctl(struct file *file, unsigned int cmd,
+			   unsigned long arg)
+{
+	return -ENOTTY;
+}
+#endif /* PKTLOG_PCPU_RING */
+
+static int pktlog_mmap(struct file *file, struct vm_area_struct *vma)
+{
+	struct ath_pktlog_info *info = pde_data(file->f_path.dentry->d_inode);
+	struct qdf_op_sync *op_sync;
+	int errno;
+
+	if (!info)
+		return -EINVAL;
+
+	errno = qdf_op_protect(&op_sync);
+	if (errno)
+		return errno;
+
+	mutex_lock(&info->pktlog_mutex);
+	errno = __pktlog_mmap(file, vma);
+	mutex_unlock(&info->pktlog_mutex);
+
+	qdf_op_unprotect(op_sync);
+
+	return errno;
+}
+
+static long pktlog_ioctl(struct file *file, unsigned int cmd,
+			 unsigned long arg)
+{
+	struct ath_pktlog_info *info = pde_data(file->f_path.dentry->d_inode);
+	struct qdf_op_sync *op_sync;
+	long errno;
+
+	if (!info)
+		return -EINVAL;
+
+	errno = qdf_op_protect(&op_sync);
+	if (errno)
+		return errno;
+
+	mutex_lock(&info->pktlog_mutex);
+	errno = __pktlog_ioctl(file, cmd, arg);
+	mutex_unlock(&info->pktlog_mutex);
+
+	qdf_op_unprotect(op_sync);
+
+	return errno;
+}
+
 int pktlogmod_init(void *context)
 {
 	int ret;
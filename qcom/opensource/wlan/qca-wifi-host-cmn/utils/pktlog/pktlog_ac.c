@@ -37,6 +37,7 @@
 #include "qdf_mem.h"
 #include "athdefs.h"
 #include "pktlog_ac_i.h"
+#include "pktlog_pcpu_ring.h"
 #include "cds_api.h"
 #include "wma_types.h"
 #include "htc.h"
@@ -719,6 +720,11 @@ int __pktlog_enable(struct hif_opaque_softc *scn, int32_t log_state,
 
 		pl_dev->tgt_pktlog_alloced = true;
 	}
+
+	if (log_state != 0 && (pl_info->options & PKTLOG_OPT_PCPU_RING) &&
+	    pktlog_pcpu_ring_alloc(pl_info))
+		qdf_print("pktlog per-CPU rings unavailable, using shared buffer");
+
 	if (log_state != 0) {
 		/* WDI subscribe */
 		if (!pl_dev->is_pktlog_cb_subscribed) {
@@ -751,6 +757,7 @@ int __pktlog_enable(struct hif_opaque_softc *scn, int32_t log_state,
 		pl_dev->pl_funcs->pktlog_disable(scn);
 		if (is_iwpriv_command == 0)
 			pl_dev->vendor_cmd_send = false;
+		pktlog_pcpu_ring_stats_print(pl_info);
 	}
 
 	pl_info->log_state = log_state;
@@ -867,6 +874,10 @@ static int __pktlog_setsize(struct hif_opaque_softc *scn, int32_t size)
 	}
 	pl_info->curr_pkt_state = PKTLOG_OPR_NOT_IN_PROGRESS;
 	qdf_spin_unlock_bh(&pl_info->log_lock);
+
+	/* reallocated with the new size on the next enable */
+	pktlog_pcpu_ring_free(pl_info);
+
 	return 0;
 }
 
@@ -39,6 +39,7 @@
 #include "htt.h"
 #include "htt_internal.h"
 #include "pktlog_ac_i.h"
+#include "pktlog_pcpu_ring.h"
 #include "wma_api.h"
 #include "wlan_logging_sock_svc.h"
 
@@ -196,4 +197,22 @@ char *pktlog_getbuf(struct pktlog_dev_t *pl_dev,
 
 	return plarg.buf;
 }
+
+int pktlog_write_record(struct pktlog_dev_t *pl_dev,
+			struct ath_pktlog_info *pl_info,
+			struct ath_pktlog_hdr *pl_hdr, void *data)
+{
+	char *log_buf;
+
+	if (pktlog_pcpu_ring_active(pl_info))
+		return pktlog_pcpu_ring_write(pl_info, pl_hdr, data);
+
+	log_buf = pktlog_getbuf(pl_dev, pl_info, pl_hdr->size, pl_hdr);
+	if (!log_buf)
+		return -ENOMEM;
+
+	qdf_mem_copy(log_buf, data, pl_hdr->size);
+
+	return 0;
+}
 #endif /*REMOVE_PKT_LOG */
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#if !defined(REMOVE_PKT_LOG) && defined(PKTLOG_PCPU_RING)
+#include "qdf_mem.h"
+#include "qdf_defer.h"
+#include "qdf_rcu.h"
+#include "qdf_time.h"
+#include "qdf_util.h"
+#include "pktlog_ac_i.h"
+#include "pktlog_pcpu_ring.h"
+
+void pktlog_pcpu_ring_setup(struct pktlog_pcpu_rings *rings)
+{
+	struct ath_pktlog_pcpu_ring_hdr *hdr;
+	uint8_t *base;
+	uint32_t i;
+
+	for (i = 0; i < rings->num_rings; i++) {
+		base = (uint8_t *)rings->base + i * rings->ring_size;
+		hdr = (struct ath_pktlog_pcpu_ring_hdr *)base;
+
+		qdf_mem_zero(hdr, sizeof(*hdr));
+		hdr->magic_num = PKTLOG_PCPU_RING_MAGIC;
+		hdr->version = CUR_PKTLOG_VER;
+		hdr->cpu = i;
+		hdr->data_size = rings->data_size;
+
+		rings->ring[i].hdr = hdr;
+		rings->ring[i].data = base + rings->ring_size -
+				      rings->data_size;
+	}
+
+	rings->start_ts = qdf_get_log_timestamp();
+}
+
+int pktlog_pcpu_ring_write(struct ath_pktlog_info *pl_info,
+			   struct ath_pktlog_hdr *pl_hdr, void *data)
+{
+	struct pktlog_pcpu_rings *rings;
+	struct ath_pktlog_pcpu_ring_hdr *hdr;
+	struct ath_pktlog_pcpu_rec *rec;
+	uint8_t *ring_data;
+	uint32_t cpu, len, off, pad;
+	uint64_t head, tail;
+	int ret = 0;
+
+	len = qdf_roundup(sizeof(*rec) + sizeof(*pl_hdr) + pl_hdr->size,
+			  PKTLOG_PCPU_REC_ALIGN);
+
+	/* stay on this CPU, its ring has a single producer */
+	qdf_local_bh_disable();
+	qdf_rcu_read_lock();
+
+	rings = qdf_rcu_dereference(pl_info->pcpu_rings);
+	if (!rings) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	cpu = qdf_get_cpu();
+	hdr = rings->ring[cpu].hdr;
+	ring_data = rings->ring[cpu].data;
+
+	head = hdr->head;
+	tail = READ_ONCE(hdr->tail);
+	off = head & (rings->data_size - 1);
+
+	/* records never wrap, skip the end of the data area if needed */
+	pad = (rings->data_size - off < len) ? rings->data_size - off : 0;
+
+	if (len > rings->data_size ||
+	    head + pad + len - tail > rings->data_size) {
+		hdr->drops++;
+		ret = -ENOSPC;
+		goto out;
+	}
+
+	/* do not overwrite data before the reader is done with it */
+	qdf_mb();
+
+	if (pad) {
+		if (pad >= sizeof(*rec)) {
+			rec = (struct ath_pktlog_pcpu_rec *)(ring_data + off);
+			rec->timestamp = 0;
+			rec->len = pad;
+			rec->flags = PKTLOG_PCPU_REC_FLAG_PAD;
+		}
+		head += pad;
+		off = 0;
+	}
+
+	rec = (struct ath_pktlog_pcpu_rec *)(ring_data + off);
+	rec->timestamp = qdf_get_log_timestamp();
+	rec->len = len;
+	rec->flags = 0;
+	qdf_mem_copy(rec + 1, pl_hdr, sizeof(*pl_hdr));
+	qdf_mem_copy((uint8_t *)(rec + 1) + sizeof(*pl_hdr), data,
+		     pl_hdr->size);
+
+	/* publish the record */
+	qdf_wmb();
+	WRITE_ONCE(hdr->head, head + len);
+	hdr->records++;
+
+out:
+	qdf_rcu_read_unlock();
+	qdf_local_bh_enable();
+
+	return ret;
+}
+
+/**
+ * pktlog_pcpu_ring_rec_at() - check the record at a ring offset
+ * @rings: per-CPU rings
+ * @cpu: ring index
+ * @tail: free running offset of the record
+ * @rec: set to the record, NULL for padding
+ *
+ * Return: bytes taken by the record or padding, 0 if it is corrupted
+ */
+static uint32_t pktlog_pcpu_ring_rec_at(struct pktlog_pcpu_rings *rings,
+					uint32_t cpu, uint64_t tail,
+					struct ath_pktlog_pcpu_rec **rec)
+{
+	struct ath_pktlog_pcpu_rec *cur;
+	struct ath_pktlog_hdr *log_hdr;
+	uint32_t off, to_end;
+
+	*rec = NULL;
+	off = tail & (rings->data_size - 1);
+	to_end = rings->data_size - off;
+
+	/* implicit padding, too small for a record header */
+	if (to_end < sizeof(*cur))
+		return to_end;
+
+	cur = (struct ath_pktlog_pcpu_rec *)(rings->ring[cpu].data + off);
+	if (cur->len < sizeof(*cur) || cur->len > to_end)
+		return 0;
+
+	if (cur->flags & PKTLOG_PCPU_REC_FLAG_PAD)
+		return cur->len;
+
+	/* the pktlog header and its payload must fit in the record */
+	log_hdr = (struct ath_pktlog_hdr *)(cur + 1);
+	if (cur->len < sizeof(*cur) + sizeof(*log_hdr) ||
+	    log_hdr->size > cur->len - sizeof(*cur) - sizeof(*log_hdr))
+		return 0;
+
+	*rec = cur;
+
+	return cur->len;
+}
+
+struct ath_pktlog_pcpu_rec *
+pktlog_pcpu_ring_peek(struct pktlog_pcpu_rings *rings, uint32_t cpu)
+{
+	struct ath_pktlog_pcpu_ring_hdr *hdr = rings->ring[cpu].hdr;
+	struct ath_pktlog_pcpu_rec *rec = NULL;
+	uint64_t head, tail;
+	uint32_t len;
+
+	head = READ_ONCE(hdr->head);
+	tail = hdr->tail;
+
+	/* read the records only after head */
+	qdf_rmb();
+
+	while (tail != head) {
+		len = pktlog_pcpu_ring_rec_at(rings, cpu, tail, &rec);
+		if (!len) {
+			qdf_rl_err("cpu %u: corrupted pktlog record", cpu);
+			tail = head;
+			break;
+		}
+
+		if (rec)
+			break;
+
+		tail += len;
+	}
+
+	if (tail != hdr->tail) {
+		qdf_mb();
+		WRITE_ONCE(hdr->tail, tail);
+	}
+
+	return rec;
+}
+
+void pktlog_pcpu_ring_consume(struct pktlog_pcpu_rings *rings, uint32_t cpu,
+			      struct ath_pktlog_pcpu_rec *rec)
+{
+	struct ath_pktlog_pcpu_ring_hdr *hdr = rings->ring[cpu].hdr;
+
+	/* the producer may reuse the space once tail moves */
+	qdf_mb();
+	WRITE_ONCE(hdr->tail, hdr->tail + rec->len);
+}
+
+int pktlog_pcpu_ring_advance(struct pktlog_pcpu_rings *rings, uint32_t cpu,
+			     uint64_t new_tail)
+{
+	struct ath_pktlog_pcpu_ring_hdr *hdr;
+	struct ath_pktlog_pcpu_rec *rec;
+	uint64_t head, tail;
+	uint32_t len;
+
+	if (cpu >= rings->num_rings)
+		return -EINVAL;
+
+	hdr = rings->ring[cpu].hdr;
+	head = READ_ONCE(hdr->head);
+	tail = hdr->tail;
+	if (new_tail < tail || new_tail > head)
+		return -EINVAL;
+
+	qdf_rmb();
+
+	/* only stop on a record boundary, the producer relies on it */
+	while (tail < new_tail) {
+		len = pktlog_pcpu_ring_rec_at(rings, cpu, tail, &rec);
+		if (!len)
+			return -EINVAL;
+
+		tail += len;
+	}
+
+	if (tail != new_tail)
+		return -EINVAL;
+
+	qdf_mb();
+	WRITE_ONCE(hdr->tail, tail);
+
+	return 0;
+}
+
+void pktlog_pcpu_ring_stats_print(struct ath_pktlog_info *pl_info)
+{
+	struct pktlog_pcpu_rings *rings = pl_info->pcpu_rings;
+	struct ath_pktlog_pcpu_ring_hdr *hdr;
+	uint32_t elapsed_ms;
+	uint32_t i;
+
+	if (!rings)
+		return;
+
+	elapsed_ms = qdf_do_div(qdf_log_timestamp_to_usecs(
+				qdf_get_log_timestamp() - rings->start_ts),
+				1000);
+	if (!elapsed_ms)
+		elapsed_ms = 1;
+
+	qdf_nofl_info(PKTLOG_TAG " per-CPU rings: %u x %u bytes, %u ms",
+		      rings->num_rings, rings->data_size, elapsed_ms);
+
+	for (i = 0; i < rings->num_rings; i++) {
+		hdr = rings->ring[i].hdr;
+		if (!hdr->records && !hdr->drops)
+			continue;
+
+		qdf_nofl_info(PKTLOG_TAG " cpu %u: records %llu (%llu/s) drops %llu",
+			      i, hdr->records,
+			      qdf_do_div(hdr->records * 1000, elapsed_ms),
+			      hdr->drops);
+	}
+}
+#endif /* !REMOVE_PKT_LOG && PKTLOG_PCPU_RING */
@@ -25,8 +25,8 @@ process_offload_pktlog_wifi3(struct cdp_pdev *pdev, void *data)
 	struct ath_pktlog_info *pl_info;
 	struct ath_pktlog_hdr pl_hdr;
 	uint32_t *pl_tgt_hdr;
-	void *txdesc_hdr_ctl = NULL;
-	size_t log_size = 0;
+	void *txdesc_hdr_ctl;
+	int ret;
 
 	if (!pl_dev) {
 		QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_ERROR,
@@ -68,19 +68,13 @@ process_offload_pktlog_wifi3(struct cdp_pdev *pdev, void *data)
 	 *  TX_CTL, TX_STATUS, TX_MSDU_ID, TX_FRM_HDR
 	 */
 	pl_info = pl_dev->pl_info;
-	log_size = pl_hdr.size;
-	txdesc_hdr_ctl =
-		(void *)pktlog_getbuf(pl_dev, pl_info, log_size, &pl_hdr);
-	if (!txdesc_hdr_ctl) {
+	txdesc_hdr_ctl = (void *)data + sizeof(struct ath_pktlog_hdr);
+	ret = pktlog_write_record(pl_dev, pl_info, &pl_hdr, txdesc_hdr_ctl);
+	if (ret && ret != -ENOSPC) {
 		QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_ERROR,
 			  "Failed to allocate pktlog descriptor");
 		return A_NO_MEMORY;
 	}
-	qdf_assert(txdesc_hdr_ctl);
-	qdf_assert(pl_hdr->size < PKTLOG_MAX_TX_WORDS * sizeof(u_int32_t));
-	qdf_mem_copy(txdesc_hdr_ctl,
-		     ((void *)data + sizeof(struct ath_pktlog_hdr)),
-		     pl_hdr.size);
 	cds_pkt_stats_to_logger_thread(&pl_hdr, NULL, txdesc_hdr_ctl);
 
 	return A_OK;
@@ -90,10 +84,9 @@ int process_rx_desc_remote_wifi3(void *pdev, void *data)
 {
 	struct pktlog_dev_t *pl_dev = get_pktlog_handle();
 	struct ath_pktlog_hdr pl_hdr;
-	struct ath_pktlog_rx_info rxstat_log;
-	size_t log_size;
 	struct ath_pktlog_info *pl_info;
 	qdf_nbuf_t log_nbuf = (qdf_nbuf_t)data;
+	int ret;
 
 	if (!pl_dev) {
 		qdf_err("Pktlog handle is NULL");
@@ -107,19 +100,16 @@ int process_rx_desc_remote_wifi3(void *pdev, void *data)
 	pl_hdr.log_type = PKTLOG_TYPE_RX_STATBUF;
 	pl_hdr.size = qdf_nbuf_len(log_nbuf);
 	pl_hdr.timestamp = 0;
-	log_size = pl_hdr.size;
-	rxstat_log.rx_desc = (void *)pktlog_getbuf(pl_dev, pl_info,
-						  log_size, &pl_hdr);
-
-	if (!rxstat_log.rx_desc) {
+	ret = pktlog_write_record(pl_dev, pl_info, &pl_hdr,
+				  qdf_nbuf_data(log_nbuf));
+	if (ret && ret != -ENOSPC) {
 		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_DEBUG,
 			  "%s: Rx descriptor is NULL", __func__);
 		return -EINVAL;
 	}
 
-	qdf_mem_copy(rxstat_log.rx_desc, qdf_nbuf_data(log_nbuf), pl_hdr.size);
 	cds_pkt_stats_to_logger_thread(&pl_hdr, NULL,
-				       rxstat_log.rx_desc);
+				       qdf_nbuf_data(log_nbuf));
 	return 0;
 }
 
@@ -130,9 +120,8 @@ process_pktlog_lite_wifi3(void *context, void *log_data,
 	struct pktlog_dev_t *pl_dev = get_pktlog_handle();
 	struct ath_pktlog_info *pl_info;
 	struct ath_pktlog_hdr pl_hdr;
-	struct ath_pktlog_rx_info rxstat_log;
-	size_t log_size;
 	qdf_nbuf_t log_nbuf = (qdf_nbuf_t)log_data;
+	int ret;
 
 	if (!pl_dev) {
 		qdf_err("Pktlog handle is NULL");
@@ -146,18 +135,15 @@ process_pktlog_lite_wifi3(void *context, void *log_data,
 	pl_hdr.log_type = log_type;
 	pl_hdr.size = qdf_nbuf_len(log_nbuf);
 	pl_hdr.timestamp = 0;
-	log_size = pl_hdr.size;
-	rxstat_log.rx_desc = (void *)pktlog_getbuf(pl_dev, pl_info,
-						   log_size, &pl_hdr);
-	if (!rxstat_log.rx_desc) {
+	ret = pktlog_write_record(pl_dev, pl_info, &pl_hdr,
+				  qdf_nbuf_data(log_nbuf));
+	if (ret && ret != -ENOSPC) {
 		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_DEBUG,
 			  "%s: Rx descriptor is NULL", __func__);
 		return -EINVAL;
 	}
 
-	qdf_mem_copy(rxstat_log.rx_desc, qdf_nbuf_data(log_nbuf), pl_hdr.size);
-
-	cds_pkt_stats_to_logger_thread(&pl_hdr, NULL, rxstat_log.rx_desc);
+	cds_pkt_stats_to_logger_thread(&pl_hdr, NULL, qdf_nbuf_data(log_nbuf));
 	return 0;
 }
 #endif /* REMOVE_PKT_LOG */
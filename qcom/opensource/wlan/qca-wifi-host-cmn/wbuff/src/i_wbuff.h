@@ -34,6 +34,52 @@
 #define WBUFF_POOL_ID_SHIFT 1
 #define WBUFF_POOL_ID_BITMASK 0xE
 
+/*
+ * Per-CPU front cache: the number of buffers a CPU may hold is capped to
+ * pool_size / (WBUFF_PCPU_CACHE_SHARE * num CPUs) so small pools don't get
+ * stranded on idle CPUs; pools too small for that bypass the cache.
+ */
+#define WBUFF_PCPU_CACHE_SIZE 16
+#define WBUFF_PCPU_CACHE_SHARE 2
+
+/*
+ * Adaptive pool growth: after WBUFF_GROW_MISS_THRESH consecutive misses on
+ * the shared list, a pool gets WBUFF_GROW_STEP more buffers, up to
+ * WBUFF_GROW_MAX_FACTOR times its registered size.
+ */
+#define WBUFF_GROW_MISS_THRESH 4
+#define WBUFF_GROW_STEP 8
+#define WBUFF_GROW_MAX_FACTOR 2
+
+/**
+ * struct wbuff_pcpu_stats - per-CPU statistics of a wbuff pool
+ * @alloc_success: Successful allocations on this CPU
+ * @alloc_fail: Failed allocations on this CPU
+ * @cache_hit: Allocations served from this CPU's cache
+ * @pending_returns: Buffers handed out minus buffers returned on this CPU,
+ * can be negative when buffers are returned on another CPU
+ */
+struct wbuff_pcpu_stats {
+	uint64_t alloc_success;
+	uint64_t alloc_fail;
+	uint64_t cache_hit;
+	int64_t pending_returns;
+};
+
+/**
+ * struct wbuff_pcpu_cache - per-CPU magazine in front of a wbuff pool
+ * @count: Number of buffers in @bufs
+ * @stats: Statistics for this CPU
+ * @bufs: Cached buffers, used as a stack
+ *
+ * Only accessed by the owning CPU with bottom halves disabled.
+ */
+struct wbuff_pcpu_cache {
+	uint16_t count;
+	struct wbuff_pcpu_stats stats;
+	qdf_nbuf_t bufs[WBUFF_PCPU_CACHE_SIZE];
+};
+
 /**
  * struct wbuff_handle - wbuff handle to the registered module
  * @id: the identifier for the registered module.
@@ -48,38 +94,48 @@ struct wbuff_handle {
  * @pool: nbuf pool
  * @buffer_size: size of the buffer in this @pool
  * @pool_id: pool identifier
- * @alloc_success: Successful allocations for this pool
- * @alloc_fail: Failed allocations for this pool
  * @mem_alloc: Memory allocated for this pool
+ * @pcpu_cache: Per-CPU front caches of the pool, allocated at registration
+ * @pcpu_limit: Number of buffers a per-CPU cache may hold
+ * @pcpu_batch: Number of buffers moved between a per-CPU cache and @pool
+ * @pool_size: Number of buffers currently owned by the pool
+ * @max_pool_size: Upper bound for @pool_size when growing
+ * @miss_streak: Consecutive refills which found @pool empty
+ * @grow_count: Number of times the pool was grown
  */
 struct wbuff_pool {
 	bool initialized;
 	qdf_nbuf_t pool;
 	uint16_t buffer_size;
 	uint8_t pool_id;
-	uint64_t alloc_success;
-	uint64_t alloc_fail;
 	uint64_t mem_alloc;
+	struct wbuff_pcpu_cache __percpu *pcpu_cache;
+	uint16_t pcpu_limit;
+	uint16_t pcpu_batch;
+	uint16_t pool_size;
+	uint16_t max_pool_size;
+	uint16_t miss_streak;
+	uint32_t grow_count;
 };
 
 /**
  * struct wbuff_module - allocation holder for wbuff registered module
  * @registered: To identify whether module is registered
- * @pending_returns: Number of buffers pending to be returned to
- * wbuff by the module
  * @lock: Lock for accessing per module buffer pools
  * @handle: wbuff handle for the registered module
  * @reserve: nbuf headroom to start with
  * @align: alignment for the nbuf
+ * @pf_cache: Page frag cache for the nbuf allocations of this module,
+ *	      serialized by @lock
  * @wbuff_pool: pools for all available buffers for the module
  */
 struct wbuff_module {
 	bool registered;
-	uint16_t pending_returns;
 	qdf_spinlock_t lock;
 	struct wbuff_handle handle;
 	int reserve;
 	int align;
+	qdf_frag_cache_t pf_cache;
 	struct wbuff_pool wbuff_pool[WBUFF_MAX_POOLS];
 };
 
@@ -87,14 +143,12 @@ struct wbuff_module {
  * struct wbuff_holder - allocation holder for wbuff
  * @initialized: to identified whether module is initialized
  * @mod: list of modules
- * @pf_cache: Reference to page frag cache, used for nbuf allocations
  * @wbuff_debugfs_dir: wbuff debugfs root directory
  * @wbuff_stats_dentry: wbuff debugfs stats file
  */
 struct wbuff_holder {
 	bool initialized;
 	struct wbuff_module mod[WBUFF_MAX_MODULES];
-	qdf_frag_cache_t pf_cache;
 	struct dentry *wbuff_debugfs_dir;
 	struct dentry *wbuff_stats_dentry;
 };
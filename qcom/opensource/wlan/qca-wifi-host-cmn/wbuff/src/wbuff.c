@@ -25,7 +25,10 @@
 #include <wbuff.h>
 #include <linux/debugfs.h>
 #include <linux/seq_file.h>
+#include <linux/percpu.h>
+#include <linux/bottom_half.h>
 #include <qdf_debugfs.h>
+#include <qdf_rcu.h>
 #include "i_wbuff.h"
 
 /*
@@ -91,6 +94,9 @@ wbuff_is_valid_alloc_req(struct wbuff_alloc_request *req, uint8_t num)
  * @reserve: nbuf headroom to start with
  * @align: alignment for the nbuf
  *
+ * Allocates from the page frag cache of the module, so the caller must hold
+ * the module lock unless the module is not registered yet.
+ *
  * Return: nbuf if success
  *         NULL if failure
  */
@@ -103,7 +109,7 @@ static qdf_nbuf_t wbuff_prepare_nbuf(uint8_t module_id, uint8_t pool_id,
 	struct wbuff_pool *wbuff_pool = &mod->wbuff_pool[pool_id];
 
 	buf = qdf_nbuf_page_frag_alloc(NULL, len, reserve, align,
-				       &wbuff.pf_cache);
+				       &mod->pf_cache);
 	if (!buf)
 		return NULL;
 	dev_scratch = module_id;
@@ -116,6 +122,205 @@ static qdf_nbuf_t wbuff_prepare_nbuf(uint8_t module_id, uint8_t pool_id,
 	return buf;
 }
 
+/**
+ * wbuff_pool_push() - push a buffer to the shared free list of a pool
+ * @wbuff_pool: wbuff pool
+ * @buf: buffer
+ *
+ * Caller must hold the module lock.
+ *
+ * Return: none
+ */
+static inline void wbuff_pool_push(struct wbuff_pool *wbuff_pool,
+				   qdf_nbuf_t buf)
+{
+	qdf_nbuf_set_next(buf, wbuff_pool->pool);
+	wbuff_pool->pool = buf;
+}
+
+/**
+ * wbuff_pool_pop() - pop a buffer from the shared free list of a pool
+ * @wbuff_pool: wbuff pool
+ *
+ * Caller must hold the module lock.
+ *
+ * Return: buffer, NULL if the free list is empty
+ */
+static inline qdf_nbuf_t wbuff_pool_pop(struct wbuff_pool *wbuff_pool)
+{
+	qdf_nbuf_t buf = wbuff_pool->pool;
+
+	if (buf)
+		wbuff_pool->pool = qdf_nbuf_next(buf);
+
+	return buf;
+}
+
+/**
+ * wbuff_pool_set_pcpu_limit() - size the per-CPU caches of a pool
+ * @wbuff_pool: wbuff pool
+ *
+ * Return: none
+ */
+static void wbuff_pool_set_pcpu_limit(struct wbuff_pool *wbuff_pool)
+{
+	uint32_t limit;
+
+	limit = wbuff_pool->pool_size /
+		(WBUFF_PCPU_CACHE_SHARE * num_possible_cpus());
+	wbuff_pool->pcpu_limit = qdf_min(limit, (uint32_t)WBUFF_PCPU_CACHE_SIZE);
+	wbuff_pool->pcpu_batch = wbuff_pool->pcpu_limit / 2;
+	if (!wbuff_pool->pcpu_batch)
+		wbuff_pool->pcpu_batch = 1;
+}
+
+/**
+ * wbuff_pool_grow() - account a miss and grow the pool if it keeps missing
+ * @module_id: module ID
+ * @wbuff_pool: wbuff pool
+ *
+ * Caller must hold the module lock, which also serializes the page frag
+ * cache of the module used for the allocation.
+ *
+ * Return: none
+ */
+static void wbuff_pool_grow(uint8_t module_id, struct wbuff_pool *wbuff_pool)
+{
+	struct wbuff_module *mod = &wbuff.mod[module_id];
+	qdf_nbuf_t buf;
+	uint16_t num, i;
+
+	if (++wbuff_pool->miss_streak < WBUFF_GROW_MISS_THRESH)
+		return;
+
+	wbuff_pool->miss_streak = 0;
+	if (wbuff_pool->pool_size >= wbuff_pool->max_pool_size)
+		return;
+
+	num = qdf_min((uint16_t)WBUFF_GROW_STEP,
+		      (uint16_t)(wbuff_pool->max_pool_size -
+				 wbuff_pool->pool_size));
+	for (i = 0; i < num; i++) {
+		buf = wbuff_prepare_nbuf(module_id, wbuff_pool->pool_id,
+					 wbuff_pool->buffer_size, mod->reserve,
+					 mod->align);
+		if (!buf)
+			break;
+
+		wbuff_pool_push(wbuff_pool, buf);
+		wbuff_pool->pool_size++;
+	}
+
+	if (i) {
+		wbuff_pool->grow_count++;
+		wbuff_pool_set_pcpu_limit(wbuff_pool);
+	}
+}
+
+/**
+ * wbuff_pool_get_slow() - get a buffer from the shared free list
+ * @module_id: module ID
+ * @wbuff_pool: wbuff pool
+ * @cache: per-CPU cache of the current CPU, refilled in the same lock hold
+ *
+ * Return: buffer, NULL if the pool is exhausted
+ */
+static qdf_nbuf_t wbuff_pool_get_slow(uint8_t module_id,
+				      struct wbuff_pool *wbuff_pool,
+				      struct wbuff_pcpu_cache *cache)
+{
+	struct wbuff_module *mod = &wbuff.mod[module_id];
+	qdf_nbuf_t buf;
+	uint16_t i;
+
+	qdf_spin_lock_bh(&mod->lock);
+	if (!wbuff_pool->pool)
+		wbuff_pool_grow(module_id, wbuff_pool);
+	else
+		wbuff_pool->miss_streak = 0;
+
+	buf = wbuff_pool_pop(wbuff_pool);
+	if (buf) {
+		for (i = 0; i < wbuff_pool->pcpu_batch &&
+		     cache->count < wbuff_pool->pcpu_limit; i++) {
+			cache->bufs[cache->count] = wbuff_pool_pop(wbuff_pool);
+			if (!cache->bufs[cache->count])
+				break;
+			cache->count++;
+		}
+	}
+	qdf_spin_unlock_bh(&mod->lock);
+
+	return buf;
+}
+
+/**
+ * wbuff_pool_put_slow() - return a buffer to the shared free list
+ * @mod: wbuff module reference
+ * @wbuff_pool: wbuff pool
+ * @cache: per-CPU cache of the current CPU, drained in the same lock hold
+ * @buf: buffer
+ *
+ * Return: none
+ */
+static void wbuff_pool_put_slow(struct wbuff_module *mod,
+				struct wbuff_pool *wbuff_pool,
+				struct wbuff_pcpu_cache *cache,
+				qdf_nbuf_t buf)
+{
+	uint16_t i;
+
+	qdf_spin_lock_bh(&mod->lock);
+	wbuff_pool_push(wbuff_pool, buf);
+	for (i = 0; i < wbuff_pool->pcpu_batch && cache->count; i++)
+		wbuff_pool_push(wbuff_pool, cache->bufs[--cache->count]);
+	qdf_spin_unlock_bh(&mod->lock);
+}
+
+/**
+ * wbuff_pool_free() - free all buffers and per-CPU caches of a pool
+ * @wbuff_pool: wbuff pool
+ *
+ * Caller must hold the module lock and make sure no CPU is still using the
+ * per-CPU caches.
+ *
+ * Return: per-CPU caches to be released with free_percpu() once the module
+ *         lock is dropped
+ */
+static struct wbuff_pcpu_cache __percpu *
+wbuff_pool_free(struct wbuff_pool *wbuff_pool)
+{
+	struct wbuff_pcpu_cache __percpu *pcpu_cache = wbuff_pool->pcpu_cache;
+	struct wbuff_pcpu_cache *cache;
+	qdf_nbuf_t first, buf;
+	int cpu;
+
+	if (pcpu_cache) {
+		for_each_possible_cpu(cpu) {
+			cache = per_cpu_ptr(pcpu_cache, cpu);
+			while (cache->count)
+				qdf_nbuf_free(cache->bufs[--cache->count]);
+		}
+	}
+
+	first = wbuff_pool->pool;
+	while (first) {
+		buf = first;
+		first = qdf_nbuf_next(buf);
+		qdf_nbuf_free(buf);
+	}
+
+	wbuff_pool->pool = NULL;
+	wbuff_pool->pcpu_cache = NULL;
+	wbuff_pool->mem_alloc = 0;
+	wbuff_pool->pool_size = 0;
+	wbuff_pool->miss_streak = 0;
+	wbuff_pool->grow_count = 0;
+	wbuff_pool->initialized = false;
+
+	return pcpu_cache;
+}
+
 /**
  * wbuff_is_valid_handle() - validate wbuff handle
  * @handle: wbuff handle passed by module
@@ -160,10 +365,38 @@ static void wbuff_debugfs_print(qdf_debugfs_file_t file, const char *fmt, ...)
 	va_end(args);
 }
 
+/**
+ * wbuff_pool_fold_stats() - sum up the per-CPU statistics of a pool
+ * @wbuff_pool: wbuff pool
+ * @stats: folded statistics
+ *
+ * Return: none
+ */
+static void wbuff_pool_fold_stats(struct wbuff_pool *wbuff_pool,
+				  struct wbuff_pcpu_stats *stats)
+{
+	struct wbuff_pcpu_cache *cache;
+	int cpu;
+
+	qdf_mem_zero(stats, sizeof(*stats));
+	if (!wbuff_pool->pcpu_cache)
+		return;
+
+	for_each_possible_cpu(cpu) {
+		cache = per_cpu_ptr(wbuff_pool->pcpu_cache, cpu);
+		stats->alloc_success += cache->stats.alloc_success;
+		stats->alloc_fail += cache->stats.alloc_fail;
+		stats->cache_hit += cache->stats.cache_hit;
+		stats->pending_returns += cache->stats.pending_returns;
+	}
+}
+
 static int wbuff_stats_debugfs_show(qdf_debugfs_file_t file, void *data)
 {
 	struct wbuff_module *mod;
 	struct wbuff_pool *wbuff_pool;
+	struct wbuff_pcpu_stats stats;
+	int64_t pending_returns;
 	int i, j;
 
 	wbuff_debugfs_print(file, "WBUFF POOL STATS:\n");
@@ -178,22 +411,39 @@ static int wbuff_stats_debugfs_show(qdf_debugfs_file_t file, void *data)
 		wbuff_debugfs_print(file, "Module (%d) : %s\n", i,
 				    wbuff_get_mod_name(i));
 
-		wbuff_debugfs_print(file, "%s %25s %20s %20s\n", "Pool ID",
+		wbuff_debugfs_print(file, "%s %25s %20s %20s %20s %10s %10s %10s\n",
+				    "Pool ID",
 				    "Mem Allocated (In Bytes)",
 				    "Wbuff Success Count",
-				    "Wbuff Fail Count");
-
+				    "Wbuff Fail Count",
+				    "Cache Hit Count",
+				    "Pool Size",
+				    "Max Size",
+				    "Grow Count");
+
+		pending_returns = 0;
+		qdf_spin_lock_bh(&mod->lock);
 		for (j = 0; j < WBUFF_MAX_POOLS; j++) {
 			wbuff_pool = &mod->wbuff_pool[j];
 
 			if (!wbuff_pool->initialized)
 				continue;
 
-			wbuff_debugfs_print(file, "%d %30llu %20llu %20llu\n",
+			wbuff_pool_fold_stats(wbuff_pool, &stats);
+			pending_returns += stats.pending_returns;
+
+			wbuff_debugfs_print(file, "%d %30llu %20llu %20llu %20llu %10u %10u %10u\n",
 					    j, wbuff_pool->mem_alloc,
-					    wbuff_pool->alloc_success,
-					    wbuff_pool->alloc_fail);
+					    stats.alloc_success,
+					    stats.alloc_fail,
+					    stats.cache_hit,
+					    wbuff_pool->pool_size,
+					    wbuff_pool->max_pool_size,
+					    wbuff_pool->grow_count);
 		}
+		qdf_spin_unlock_bh(&mod->lock);
+		wbuff_debugfs_print(file, "Pending returns: %lld\n",
+				    pending_returns);
 		wbuff_debugfs_print(file, "\n");
 	}
 
@@ -318,6 +568,8 @@ wbuff_module_register(struct wbuff_alloc_request *req, uint8_t num_pools,
 		return NULL;
 
 	mod->handle.id = module_id;
+	mod->reserve = reserve;
+	mod->align = align;
 
 	for (i = 0; i < num_pools; i++) {
 		pool_id = req[i].pool_id;
@@ -328,6 +580,10 @@ wbuff_module_register(struct wbuff_alloc_request *req, uint8_t num_pools,
 		if (!pool_size)
 			continue;
 
+		wbuff_pool->pcpu_cache = alloc_percpu(struct wbuff_pcpu_cache);
+		if (!wbuff_pool->pcpu_cache)
+			goto fail;
+
 		/**
 		 * Allocate pool_size number of buffers for
 		 * the pool given by pool_id
@@ -338,34 +594,34 @@ wbuff_module_register(struct wbuff_alloc_request *req, uint8_t num_pools,
 			if (!buf)
 				continue;
 
-			if (!wbuff_pool->pool)
-				qdf_nbuf_set_next(buf, NULL);
-			else
-				qdf_nbuf_set_next(buf, wbuff_pool->pool);
-
-			wbuff_pool->pool = buf;
+			wbuff_pool_push(wbuff_pool, buf);
+			wbuff_pool->pool_size++;
 		}
 
 		wbuff_pool->pool_id = pool_id;
 		wbuff_pool->buffer_size = len;
+		wbuff_pool->max_pool_size = pool_size * WBUFF_GROW_MAX_FACTOR;
+		wbuff_pool_set_pcpu_limit(wbuff_pool);
 		wbuff_pool->initialized = true;
 	}
 
-	mod->reserve = reserve;
-	mod->align = align;
 	mod->registered = true;
 
-
 	return (struct wbuff_mod_handle *)&mod->handle;
+
+fail:
+	for (pool_id = 0; pool_id < WBUFF_MAX_POOLS; pool_id++)
+		free_percpu(wbuff_pool_free(&mod->wbuff_pool[pool_id]));
+
+	return NULL;
 }
 
 QDF_STATUS wbuff_module_deregister(struct wbuff_mod_handle *hdl)
 {
+	struct wbuff_pcpu_cache __percpu *pcpu_cache[WBUFF_MAX_POOLS];
 	struct wbuff_handle *handle;
 	struct wbuff_module *mod = NULL;
 	uint8_t module_id = 0, pool_id = 0;
-	qdf_nbuf_t first = NULL, buf = NULL;
-	struct wbuff_pool *wbuff_pool;
 
 	handle = (struct wbuff_handle *)hdl;
 
@@ -380,27 +636,21 @@ QDF_STATUS wbuff_module_deregister(struct wbuff_mod_handle *hdl)
 	mod = &wbuff.mod[module_id];
 
 	qdf_spin_lock_bh(&mod->lock);
-	for (pool_id = 0; pool_id < WBUFF_MAX_POOLS; pool_id++) {
-		wbuff_pool = &mod->wbuff_pool[pool_id];
-
-		if (!wbuff_pool->initialized)
-			continue;
-
-		first = wbuff_pool->pool;
-		while (first) {
-			buf = first;
-			first = qdf_nbuf_next(buf);
-			qdf_nbuf_free(buf);
-		}
+	mod->registered = false;
+	qdf_spin_unlock_bh(&mod->lock);
 
-		wbuff_pool->mem_alloc = 0;
-		wbuff_pool->alloc_success = 0;
-		wbuff_pool->alloc_fail = 0;
+	/* wait for get/put calls still working on the per-CPU caches */
+	qdf_synchronize_rcu();
 
-	}
-	mod->registered = false;
+	qdf_spin_lock_bh(&mod->lock);
+	for (pool_id = 0; pool_id < WBUFF_MAX_POOLS; pool_id++)
+		pcpu_cache[pool_id] = wbuff_pool_free(&mod->wbuff_pool[pool_id]);
+	qdf_frag_cache_drain(&mod->pf_cache);
 	qdf_spin_unlock_bh(&mod->lock);
 
+	for (pool_id = 0; pool_id < WBUFF_MAX_POOLS; pool_id++)
+		free_percpu(pcpu_cache[pool_id]);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -411,6 +661,7 @@ wbuff_buff_get(struct wbuff_mod_handle *hdl, uint8_t pool_id, uint32_t len,
 	struct wbuff_handle *handle;
 	struct wbuff_module *mod = NULL;
 	struct wbuff_pool *wbuff_pool;
+	struct wbuff_pcpu_cache *cache;
 	uint8_t module_id = 0;
 	qdf_nbuf_t buf = NULL;
 
@@ -434,23 +685,37 @@ wbuff_buff_get(struct wbuff_mod_handle *hdl, uint8_t pool_id, uint32_t len,
 		return NULL;
 
 	wbuff_pool = &mod->wbuff_pool[pool_id];
-	if (!wbuff_pool->initialized)
-		return NULL;
 
-	qdf_spin_lock_bh(&mod->lock);
-	if (wbuff_pool->pool) {
-		buf = wbuff_pool->pool;
-		wbuff_pool->pool = qdf_nbuf_next(buf);
-		mod->pending_returns++;
+	/*
+	 * The per-CPU cache is only touched by its CPU with bottom halves
+	 * disabled; the RCU read section lets deregister wait for us.
+	 */
+	local_bh_disable();
+	qdf_rcu_read_lock();
+	if (!mod->registered || !wbuff_pool->initialized)
+		goto out;
+
+	cache = this_cpu_ptr(wbuff_pool->pcpu_cache);
+	if (cache->count) {
+		buf = cache->bufs[--cache->count];
+		cache->stats.cache_hit++;
+	} else {
+		buf = wbuff_pool_get_slow(module_id, wbuff_pool, cache);
 	}
-	qdf_spin_unlock_bh(&mod->lock);
+
+	if (buf) {
+		cache->stats.alloc_success++;
+		cache->stats.pending_returns++;
+	} else {
+		cache->stats.alloc_fail++;
+	}
+out:
+	qdf_rcu_read_unlock();
+	local_bh_enable();
 
 	if (buf) {
 		qdf_nbuf_set_next(buf, NULL);
 		qdf_net_buf_debug_update_node(buf, func_name, line_num);
-		wbuff_pool->alloc_success++;
-	} else {
-		wbuff_pool->alloc_fail++;
 	}
 
 	return buf;
@@ -461,7 +726,9 @@ qdf_nbuf_t wbuff_buff_put(qdf_nbuf_t buf)
 	qdf_nbuf_t buffer = buf;
 	unsigned long pool_info = 0;
 	uint8_t module_id = 0, pool_id = 0;
+	struct wbuff_module *mod;
 	struct wbuff_pool *wbuff_pool;
+	struct wbuff_pcpu_cache *cache;
 
 	if (qdf_nbuf_get_users(buffer) > 1)
 		return buffer;
@@ -480,21 +747,27 @@ qdf_nbuf_t wbuff_buff_put(qdf_nbuf_t buf)
 	if (module_id >= WBUFF_MAX_MODULES || pool_id >= WBUFF_MAX_POOLS)
 		return buffer;
 
-	wbuff_pool = &wbuff.mod[module_id].wbuff_pool[pool_id];
+	mod = &wbuff.mod[module_id];
+	wbuff_pool = &mod->wbuff_pool[pool_id];
 	if (!wbuff_pool->initialized)
 		return buffer;
 
-	qdf_nbuf_reset(buffer, wbuff.mod[module_id].reserve,
-		       wbuff.mod[module_id].align);
+	qdf_nbuf_reset(buffer, mod->reserve, mod->align);
+
+	local_bh_disable();
+	qdf_rcu_read_lock();
+	if (mod->registered && wbuff_pool->initialized) {
+		cache = this_cpu_ptr(wbuff_pool->pcpu_cache);
+		if (cache->count < wbuff_pool->pcpu_limit)
+			cache->bufs[cache->count++] = buffer;
+		else
+			wbuff_pool_put_slow(mod, wbuff_pool, cache, buffer);
 
-	qdf_spin_lock_bh(&wbuff.mod[module_id].lock);
-	if (wbuff.mod[module_id].registered) {
-		qdf_nbuf_set_next(buffer, wbuff_pool->pool);
-		wbuff_pool->pool = buffer;
-		wbuff.mod[module_id].pending_returns--;
+		cache->stats.pending_returns--;
 		buffer = NULL;
 	}
-	qdf_spin_unlock_bh(&wbuff.mod[module_id].lock);
+	qdf_rcu_read_unlock();
+	local_bh_enable();
 
 	return buffer;
 }
@@ -1642,10 +1642,14 @@
  * <ini>
  * gEnableSWLM - Control DP Software latency manager
  * @Min: 0
- * @Max: 1
+ * @Max: 2
  * @Default: 0
  *
  * This ini is used to enable DP Software latency Manager
+ * 0 - Disabled
+ * 1 - Coalesce TCL register writes based on fixed throughput thresholds
+ * 2 - Coalesce TCL register writes based on measured packet inter-arrival
+ *     time and TX completion latency
  *
  * Supported Feature: STA,P2P and SAP IPA disabled terminating
  *
@@ -1654,8 +1658,8 @@
  * </ini>
  */
 #define CFG_DP_SWLM_ENABLE \
-	CFG_INI_BOOL("gEnableSWLM", false, \
-		     "Enable/Disable DP SWLM")
+	CFG_INI_UINT("gEnableSWLM", 0, 2, 0, \
+		     CFG_VALUE_OR_DEFAULT, "DP SWLM mode")
 /*
  * <ini>
  * wow_check_rx_pending_enable - control to check RX frames pending in Wow
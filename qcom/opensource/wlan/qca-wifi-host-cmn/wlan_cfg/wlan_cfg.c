@@ -5586,11 +5586,21 @@ bool wlan_cfg_is_swlm_enabled(struct wlan_cfg_dp_soc_ctxt *cfg)
 {
 	return (bool)(cfg->is_swlm_enabled);
 }
+
+uint8_t wlan_cfg_get_swlm_mode(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->is_swlm_enabled;
+}
 #else
 bool wlan_cfg_is_swlm_enabled(struct wlan_cfg_dp_soc_ctxt *cfg)
 {
 	return false;
 }
+
+uint8_t wlan_cfg_get_swlm_mode(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return 0;
+}
 #endif
 uint8_t wlan_cfg_radio0_default_reo_get(struct wlan_cfg_dp_soc_ctxt *cfg)
 {
@@ -297,7 +297,7 @@ struct wlan_srng_cfg {
  * @rx_pending_high_threshold: threshold of starting pkt drop
  * @rx_pending_low_threshold: threshold of stopping pkt drop
  * @is_poll_mode_enabled:
- * @is_swlm_enabled: flag to enable/disable SWLM
+ * @is_swlm_enabled: SWLM mode, 0 if disabled
  * @fst_in_cmem:
  * @tx_per_pkt_vdev_id_check: Enable tx perpkt vdev id check
  * @radio0_rx_default_reo:
@@ -2173,6 +2173,14 @@ bool wlan_cfg_is_fst_in_cmem_enabled(struct wlan_cfg_dp_soc_ctxt *cfg);
  */
 bool wlan_cfg_is_swlm_enabled(struct wlan_cfg_dp_soc_ctxt *cfg);
 
+/**
+ * wlan_cfg_get_swlm_mode() - Get SWLM mode
+ * @cfg: soc configuration context
+ *
+ * Return: 0 if disabled, 1 for fixed thresholds, 2 for latency feedback
+ */
+uint8_t wlan_cfg_get_swlm_mode(struct wlan_cfg_dp_soc_ctxt *cfg);
+
 /**
  * wlan_cfg_set_peer_link_stats() - set peer link stats
  *
@@ -1003,6 +1003,19 @@ bool wlan_dp_cfg_is_rx_fisa_lru_del_enabled(struct wlan_dp_psoc_cfg *dp_cfg)
 {
 	return dp_cfg->is_rx_fisa_lru_del_enabled;
 }
+
+/**
+ * wlan_dp_cfg_is_rx_fisa_udp_gso_fraglist() - Get Rx FISA UDP fraglist GSO
+ *					       flag
+ * @dp_cfg: soc configuration context
+ *
+ * Return: true if UDP aggregates are marked for fraglist GSO
+ */
+static inline
+bool wlan_dp_cfg_is_rx_fisa_udp_gso_fraglist(struct wlan_dp_psoc_cfg *dp_cfg)
+{
+	return dp_cfg->is_rx_fisa_udp_gso_fraglist;
+}
 #else
 static inline
 bool wlan_dp_cfg_is_rx_fisa_enabled(struct wlan_dp_psoc_cfg *dp_cfg)
@@ -1015,6 +1028,12 @@ bool wlan_dp_cfg_is_rx_fisa_lru_del_enabled(struct wlan_dp_psoc_cfg *dp_cfg)
 {
 	return false;
 }
+
+static inline
+bool wlan_dp_cfg_is_rx_fisa_udp_gso_fraglist(struct wlan_dp_psoc_cfg *dp_cfg)
+{
+	return false;
+}
 #endif
 
 
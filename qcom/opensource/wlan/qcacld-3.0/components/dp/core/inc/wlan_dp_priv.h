@@ -76,6 +76,11 @@ struct dp_rtpm_tput_policy_context {
 #endif
 
 #define FISA_FLOW_MAX_AGGR_COUNT        16 /* max flow aggregate count */
+/*
+ * flushed aggregate size buckets: 1, 2-3, 4-7, 8-15 and 16 MSDUs, the last
+ * one being FISA_FLOW_MAX_AGGR_COUNT
+ */
+#define FISA_AGGR_SIZE_HIST_MAX		5
 
 /**
  * struct wlan_dp_psoc_cfg - DP configuration parameters.
@@ -139,6 +144,7 @@ struct dp_rtpm_tput_policy_context {
  * @gro_enable: Enable/Disable gro
  * @is_rx_fisa_enabled: flag to enable/disable FISA Rx
  * @is_rx_fisa_lru_del_enabled: flag to enable/disable FST entry delete
+ * @is_rx_fisa_udp_gso_fraglist: mark FISA UDP aggregates for fraglist GSO
  */
 struct wlan_dp_psoc_cfg {
 	bool tx_orphan_enable;
@@ -210,6 +216,7 @@ struct wlan_dp_psoc_cfg {
 #ifdef WLAN_SUPPORT_RX_FISA
 	bool is_rx_fisa_enabled;
 	bool is_rx_fisa_lru_del_enabled;
+	bool is_rx_fisa_udp_gso_fraglist;
 #endif
 };
 
@@ -230,6 +237,9 @@ struct wlan_dp_psoc_cfg {
  * @is_rx_pm_qos_high: Capture rx_pm_qos voting
  * @is_tx_pm_qos_high: Capture tx_pm_qos voting
  * @qtime: timestamp when the record is added
+ * @vote_pkts: packet count next_vote_level was picked from
+ * @pred_flags: DP_BW_PRED_* reasons for vote_pkts to differ from the
+ *		measured packet count
  *
  * The structure keeps track of throughput requirements of wlan driver.
  * An entry is added if either of next_vote_level, next_rx_level or
@@ -244,8 +254,38 @@ struct tx_rx_histogram {
 	bool is_rx_pm_qos_high;
 	bool is_tx_pm_qos_high;
 	uint64_t qtime;
+#ifdef WLAN_DP_BUS_BW_PREDICT
+	uint64_t vote_pkts;
+	uint8_t pred_flags;
+#endif
 };
 
+#ifdef WLAN_DP_BUS_BW_PREDICT
+/* Reasons for the predicted bus bandwidth vote, see dp_bus_bw_predictor */
+#define DP_BW_PRED_TREND	BIT(0)
+#define DP_BW_PRED_RX_BACKLOG	BIT(1)
+#define DP_BW_PRED_HOLD		BIT(2)
+#define DP_BW_PRED_DECAY	BIT(3)
+
+/**
+ * struct dp_bus_bw_predictor - predictive bus bandwidth vote state
+ * @ewma_pkts: EWMA of tx + rx packets per bus bandwidth interval
+ * @prev_pkts: tx + rx packets measured over the previous interval
+ * @vote_pkts: packet count the last vote was picked from
+ * @hold_cnt: intervals left before the vote is allowed to decay
+ * @flags: DP_BW_PRED_* reasons of the last vote
+ * @boost_cnt: number of intervals voted above the measured load
+ */
+struct dp_bus_bw_predictor {
+	uint64_t ewma_pkts;
+	uint64_t prev_pkts;
+	uint64_t vote_pkts;
+	uint8_t hold_cnt;
+	uint8_t flags;
+	uint32_t boost_cnt;
+};
+#endif
+
 /**
  * struct dp_stats - DP stats
  * @tx_rx_stats : Tx/Rx debug stats
@@ -394,100 +434,116 @@ struct fisa_pkt_hist {
 
 /**
  * struct dp_fisa_rx_sw_ft - FISA Flow table entry
- * @hw_fse: HAL Rx Flow Search Entry which matches HW definition
- * @flow_hash: Flow hash value
- * @flow_id_toeplitz: toeplitz hash value
- * @flow_id: Flow index, equivalent to hash value truncated to FST size
- * @stats: Stats tracking for this flow
- * @is_ipv4_addr_entry: Flag indicating whether flow is IPv4 address tuple
- * @is_valid: Flag indicating whether flow is valid
  * @is_populated: Flag indicating whether flow is populated
+ * @is_valid: Flag indicating whether flow is valid
  * @is_flow_udp: Flag indicating whether flow is UDP stream
  * @is_flow_tcp: Flag indicating whether flow is TCP stream
+ * @do_not_aggregate: Flag to indicate not to aggregate this flow
+ * @napi_id: NAPI ID (REO ID) on which the flow is being received
+ * @vdev_id: DP vdev id
+ * @flow_id: Flow index, equivalent to hash value truncated to FST size
+ * @flow_hash: Flow hash value
+ * @metadata:
+ * @vdev: VDEV handle corresponding to the FLOW
+ * @dp_intf: DP interface handle corresponding to the flow
  * @head_skb: HEAD skb where flow is aggregated
+ * @last_skb: The last skb aggregated in the FISA flow
+ * @head_skb_udp_hdr: UDP header address for HEAD skb
+ * @cur_aggr: Current aggregate length of flow
  * @cumulative_l4_checksum: Cumulative L4 checksum
  * @adjusted_cumulative_ip_length: Cumulative IP length
- * @cur_aggr: Current aggregate length of flow
+ * @hal_cumultive_ip_len: HAL cumulative IP length
+ * @frags_cumulative_len:
  * @napi_flush_cumulative_l4_checksum: Cumulative L4 chekcsum for current
  *				       NAPI flush
  * @napi_flush_cumulative_ip_length: Cumulative IP length
- * @last_skb: The last skb aggregated in the FISA flow
+ * @last_hal_aggr_count: last aggregate count fetched from RX PKT TLV
+ * @cur_aggr_gso_size: Current aggreagtesd GSO size
  * @head_skb_ip_hdr_offset: IP header offset
  * @head_skb_l4_hdr_offset: L4 header offset
- * @rx_flow_tuple_info: RX tuple information
- * @napi_id: NAPI ID (REO ID) on which the flow is being received
- * @vdev: VDEV handle corresponding to the FLOW
- * @vdev_id: DP vdev id
- * @dp_intf: DP interface handle corresponding to the flow
- * @bytes_aggregated: Number of bytes currently aggregated
- * @flush_count: Number of Flow flushes done
  * @aggr_count: Aggregation count
- * @do_not_aggregate: Flag to indicate not to aggregate this flow
- * @hal_cumultive_ip_len: HAL cumulative IP length
+ * @bytes_aggregated: Number of bytes currently aggregated
  * @dp_ctx: DP component handle
+ * @last_accessed_ts: Timestamp when the flow was last accessed
+ * @rx_flow_tuple_info: RX tuple information
+ * @hw_fse: HAL Rx Flow Search Entry which matches HW definition
+ * @flow_id_toeplitz: toeplitz hash value
+ * @is_ipv4_addr_entry: Flag indicating whether flow is IPv4 address tuple
+ * @stats: Stats tracking for this flow
+ * @flush_count: Number of Flow flushes done
  * @soc_hdl: DP SoC handle
- * @last_hal_aggr_count: last aggregate count fetched from RX PKT TLV
- * @cur_aggr_gso_size: Current aggreagtesd GSO size
- * @head_skb_udp_hdr: UDP header address for HEAD skb
- * @frags_cumulative_len:
  * @cmem_offset: CMEM offset
- * @metadata:
  * @reo_dest_indication: REO destination indication for the FLOW
  * @flow_init_ts: FLOW init timestamp
- * @last_accessed_ts: Timestamp when the flow was last accessed
  * @pkt_hist: FISA aggreagtion packets history
  * @same_mld_vdev_mismatch: Packets flushed after vdev_mismatch on same MLD
  * @add_timestamp: FISA entry created timestamp
+ * @aggr_size_hist: Number of flushes per aggregate size bucket, in MSDUs
+ * @gso_bytes: Payload bytes delivered in GSO aggregates
+ *
+ * Members are grouped by access pattern: the flow lookup and aggregation
+ * state touched for every packet comes first so it spans as few cache
+ * lines as possible, followed by the tuple used on flow add and the
+ * is_exception check, then setup, debug and statistics fields.
  */
 struct dp_fisa_rx_sw_ft {
-	void *hw_fse;
-	uint32_t flow_hash;
-	uint32_t flow_id_toeplitz;
-	uint32_t flow_id;
-	struct cdp_flow_stats stats;
-	uint8_t is_ipv4_addr_entry;
-	uint8_t is_valid;
+	/* hot: flow lookup, read for every packet */
 	uint8_t is_populated;
+	uint8_t is_valid;
 	uint8_t is_flow_udp;
 	uint8_t is_flow_tcp;
+	uint8_t do_not_aggregate;
+	uint8_t napi_id;
+	uint8_t vdev_id;
+	uint32_t flow_id;
+	uint32_t flow_hash;
+	uint32_t metadata;
+	struct dp_vdev *vdev;
+	struct wlan_dp_intf *dp_intf;
+
+	/* hot: aggregation state, updated for every packet */
 	qdf_nbuf_t head_skb;
+	qdf_nbuf_t last_skb;
+	qdf_net_udphdr_t *head_skb_udp_hdr;
+	uint16_t cur_aggr;
 	uint16_t cumulative_l4_checksum;
 	uint16_t adjusted_cumulative_ip_length;
-	uint16_t cur_aggr;
+	uint16_t hal_cumultive_ip_len;
+	uint16_t frags_cumulative_len;
 	uint16_t napi_flush_cumulative_l4_checksum;
 	uint16_t napi_flush_cumulative_ip_length;
-	qdf_nbuf_t last_skb;
+	uint32_t last_hal_aggr_count;
+	uint32_t cur_aggr_gso_size;
 	uint32_t head_skb_ip_hdr_offset;
 	uint32_t head_skb_l4_hdr_offset;
-	struct cdp_rx_flow_tuple_info rx_flow_tuple_info;
-	uint8_t napi_id;
-	struct dp_vdev *vdev;
-	uint8_t vdev_id;
-	struct wlan_dp_intf *dp_intf;
-	uint64_t bytes_aggregated;
-	uint32_t flush_count;
 	uint32_t aggr_count;
-	uint8_t do_not_aggregate;
-	uint16_t hal_cumultive_ip_len;
+	uint64_t bytes_aggregated;
 	struct wlan_dp_psoc_context *dp_ctx;
+	qdf_time_t last_accessed_ts;
+
+	/* warm: flow add and exception check */
+	struct cdp_rx_flow_tuple_info rx_flow_tuple_info;
+
+	/* cold: setup, flush, debug and statistics */
+	void *hw_fse;
+	uint32_t flow_id_toeplitz;
+	uint8_t is_ipv4_addr_entry;
+	struct cdp_flow_stats stats;
+	uint32_t flush_count;
 	/* TODO - Only reference needed to this is to get vdev.
 	 * Once that ref is removed, this field can be deleted
 	 */
 	struct dp_soc *soc_hdl;
-	uint32_t last_hal_aggr_count;
-	uint32_t cur_aggr_gso_size;
-	qdf_net_udphdr_t *head_skb_udp_hdr;
-	uint16_t frags_cumulative_len;
 	uint32_t cmem_offset;
-	uint32_t metadata;
 	uint32_t reo_dest_indication;
 	qdf_time_t flow_init_ts;
-	qdf_time_t last_accessed_ts;
 #ifdef WLAN_SUPPORT_RX_FISA_HIST
 	struct fisa_pkt_hist pkt_hist;
 #endif
 	uint64_t same_mld_vdev_mismatch;
 	uint64_t add_timestamp;
+	uint32_t aggr_size_hist[FISA_AGGR_SIZE_HIST_MAX];
+	uint64_t gso_bytes;
 };
 
 #define DP_RX_GET_SW_FT_ENTRY_SIZE sizeof(struct dp_fisa_rx_sw_ft)
@@ -504,6 +560,29 @@ struct fse_cache_flush_history {
 	uint32_t flows_deleted;
 };
 
+/**
+ * struct dp_fisa_reo_flow_cache - last flow seen on a REO ring
+ * @sw_ft: SW FT entry of the last flow, NULL if none
+ * @flow_idx: flow index reported by HW for the last flow
+ * @hit: packets resolved from this cache
+ * @miss: packets which needed the full SW FT lookup
+ *
+ * Only accessed with the SW FT lock of the REO ring held. Each ring's entry
+ * is padded to a cache line so rings running on different CPUs don't share
+ * it.
+ */
+struct dp_fisa_reo_flow_cache {
+	union {
+		struct {
+			struct dp_fisa_rx_sw_ft *sw_ft;
+			uint32_t flow_idx;
+			uint32_t hit;
+			uint32_t miss;
+		};
+		uint8_t pad[QDF_CACHE_LINE_SZ];
+	};
+};
+
 /**
  * struct dp_rx_fst - FISA handle
  * @base: Software (DP) FST
@@ -538,6 +617,7 @@ struct fse_cache_flush_history {
  * @rx_hash_enabled: Flag to indicate if Hash based routing supported
  * @rx_toeplitz_hash_key: hash key
  * @rx_pkt_tlv_size: RX packet TLV size
+ * @last_flow: Per REO ring cache of the last resolved flow
  */
 struct dp_rx_fst {
 	uint8_t *base;
@@ -574,6 +654,7 @@ struct dp_rx_fst {
 	bool rx_hash_enabled;
 	uint8_t *rx_toeplitz_hash_key;
 	uint16_t rx_pkt_tlv_size;
+	struct dp_fisa_reo_flow_cache last_flow[MAX_REO_DEST_RINGS];
 };
 
 /**
@@ -769,6 +850,7 @@ struct dp_direct_link_context {
  * @dynamic_rps: dynamic rps
  * @enable_rxthread: Enable/Disable rx thread
  * @enable_dp_rx_threads: Enable/Disable DP rx threads
+ * @enable_dp_rx_work_stealing: Enable/Disable work stealing among DP rx threads
  * @napi_enable: Enable/Disable napi
  * @dp_ops: DP callbacks registered from other modules
  * @sb_ops: South bound direction call backs registered in DP
@@ -793,6 +875,7 @@ struct dp_direct_link_context {
  * @bus_bw_lock: Bus bandwidth work lock
  * @cur_rx_level: Current Rx level
  * @bus_low_vote_cnt: bus low level count
+ * @bw_pred: predictive bus bandwidth vote state
  * @disable_rx_ol_in_concurrency: disable RX offload in concurrency scenarios
  * @disable_rx_ol_in_low_tput: disable RX offload in tput scenarios
  * @txrx_hist_idx: txrx histogram index
@@ -817,6 +900,8 @@ struct dp_direct_link_context {
  * @fisa_enable: Flag to indicate if FISA is enabled or not
  * @fisa_lru_del_enable: Flag to indicate if LRU flow delete is enabled
  * @fisa_dynamic_aggr_size_support: Indicate dynamic aggr size programming support
+ * @fisa_udp_gso_fraglist: Mark UDP aggregates for fraglist GSO instead of
+ *			   plain UDP L4 GSO
  * @skip_fisa_param: FISA skip params structure
  * @skip_fisa_param.skip_fisa: Flag to skip FISA aggr inside @skip_fisa_param
  * @skip_fisa_param.fisa_force_flush: Force flush inside @skip_fisa_param
@@ -840,6 +925,7 @@ struct wlan_dp_psoc_context {
 	bool dynamic_rps;
 	bool enable_rxthread;
 	bool enable_dp_rx_threads;
+	bool enable_dp_rx_work_stealing;
 	bool napi_enable;
 
 	struct wlan_dp_psoc_callbacks dp_ops;
@@ -867,6 +953,9 @@ struct wlan_dp_psoc_context {
 	uint64_t prev_tx;
 	qdf_atomic_t low_tput_gro_enable;
 	uint32_t bus_low_vote_cnt;
+#ifdef WLAN_DP_BUS_BW_PREDICT
+	struct dp_bus_bw_predictor bw_pred;
+#endif
 #ifdef FEATURE_RUNTIME_PM
 	struct dp_rtpm_tput_policy_context rtpm_tput_policy_ctx;
 #endif
@@ -908,6 +997,7 @@ struct wlan_dp_psoc_context {
 	uint8_t fisa_enable;
 	uint8_t fisa_lru_del_enable;
 	bool fisa_dynamic_aggr_size_support;
+	bool fisa_udp_gso_fraglist;
 	/*
 	 * Params used for controlling the fisa aggregation dynamically
 	 */
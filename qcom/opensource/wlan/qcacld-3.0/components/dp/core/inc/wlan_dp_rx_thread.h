@@ -37,6 +37,18 @@
 /* Number of DP RX threads supported */
 #define DP_MAX_RX_THREADS WLAN_CFG_NUM_REO_DEST_RING
 
+/*
+ * Number of flow hash buckets used to key batches for work stealing, one
+ * bit each in dp_rx_thread.gro_pending_keys
+ */
+#define DP_RX_TM_STEAL_FLOW_BUCKETS 64
+/* Flow key value meaning no flow */
+#define DP_RX_TM_STEAL_KEY_NONE (-1)
+/* Queued nbuf_lists above which a thread is considered overloaded */
+#define DP_RX_TM_STEAL_QLEN_THRESH 8
+/* Maximum nbuf_lists taken from an overloaded thread in one steal */
+#define DP_RX_TM_STEAL_MAX_LISTS 16
+
 /*
  * struct dp_rx_tm_handle_cmn - Opaque handle for rx_threads to store
  * rx_tm_handle. This handle will be common for all the threads.
@@ -63,6 +75,11 @@ struct dp_rx_tm_handle_cmn;
  * @dropped_others: packets dropped due to other reasons
  * @dropped_enq_fail: packets dropped due to pending queue full
  * @rx_nbufq_loop_yield: rx loop yield counter
+ * @steal: number of flow batches stolen from overloaded threads
+ * @steal_fail: number of steal attempts that found nothing to take
+ * @stolen_nbuf: packets delivered from stolen flow batches
+ * @stolen_from: number of times a flow batch was stolen from this thread,
+ *		 updated by the stealing thread
  */
 struct dp_rx_thread_stats {
 	unsigned int nbuf_queued[DP_RX_TM_MAX_REO_RINGS];
@@ -79,6 +96,10 @@ struct dp_rx_thread_stats {
 	unsigned int dropped_others;
 	unsigned int dropped_enq_fail;
 	unsigned int rx_nbufq_loop_yield;
+	unsigned int steal;
+	unsigned int steal_fail;
+	unsigned int stolen_nbuf;
+	qdf_atomic_t stolen_from;
 };
 
 /**
@@ -117,6 +138,12 @@ enum dp_rx_refill_thread_state {
  * @napi: napi to deliver packet to stack via GRO
  * @wait_q: wait queue to conditionally wait on events for DP Rx thread
  * @netdev: dummy netdev to initialize the napi structure with
+ * @inflight_key: flow key of the nbuf_list being delivered by this thread,
+ *		  updated under the nbuf_queue lock
+ * @stolen_key: flow key of the batch another thread stole from this thread
+ *		and is still delivering; entries with this key are held back
+ * @gro_pending_keys: bitmap of the flow keys delivered by this thread since
+ *		      its last GRO flush, updated under the nbuf_queue lock
  */
 struct dp_rx_thread {
 	uint8_t id;
@@ -135,6 +162,9 @@ struct dp_rx_thread {
 	qdf_napi_struct napi;
 	qdf_wait_queue_head_t wait_q;
 	qdf_dummy_netdev_t netdev;
+	int inflight_key;
+	qdf_atomic_t stolen_key;
+	uint64_t gro_pending_keys;
 };
 
 /**
@@ -185,6 +215,7 @@ enum dp_rx_thread_state {
  * @state: state of the rx_threads. All of them should be in the same state.
  * @rx_thread: array of pointers of type struct dp_rx_thread
  * @allow_dropping: flag to indicate frame dropping is enabled
+ * @work_stealing: idle threads steal flow batches from overloaded threads
  */
 struct dp_rx_tm_handle {
 	uint8_t num_dp_rx_threads;
@@ -192,6 +223,7 @@ struct dp_rx_tm_handle {
 	enum dp_rx_thread_state state;
 	struct dp_rx_thread **rx_thread;
 	qdf_atomic_t allow_dropping;
+	bool work_stealing;
 };
 
 /**
@@ -209,9 +241,11 @@ enum dp_rx_gro_flush_code {
 /**
  * struct dp_txrx_config - dp txrx configuration passed to dp txrx modules
  * @enable_rx_threads: DP rx threads or not
+ * @enable_rx_work_stealing: let idle DP rx threads steal from busy ones
  */
 struct dp_txrx_config {
 	bool enable_rx_threads;
+	bool enable_rx_work_stealing;
 };
 
 struct dp_txrx_handle_cmn;
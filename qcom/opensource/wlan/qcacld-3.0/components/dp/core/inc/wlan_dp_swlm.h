@@ -31,6 +31,25 @@
 #define DP_SWLM_TCL_TIME_FLUSH_THRESH 1000
 #define DP_SWLM_TCL_TX_THRESH_MULTIPLIER 2
 
+/* Packets from sockets at or above TC_PRIO_INTERACTIVE are never coalesced */
+#define DP_SWLM_TCL_BYPASS_PRIO 6
+
+/*
+ * Latency feedback mode: coalescing may add at most 1/DELAY_DIV of the
+ * measured TX completion latency, bounded by [DELAY_MIN, time_flush_thresh].
+ * The depth is the number of packets expected within that budget at the
+ * measured inter-arrival time, capped to DEPTH_MAX.
+ */
+#define DP_SWLM_ADAPT_DELAY_DIV 8
+#define DP_SWLM_ADAPT_DELAY_MIN 20
+#define DP_SWLM_ADAPT_DEPTH_MAX 32
+/* Inter-arrival samples are capped so a single idle gap doesn't dominate */
+#define DP_SWLM_ADAPT_IAT_MAX 10000
+/* A latency sample not completed within this time (us) is dropped */
+#define DP_SWLM_ADAPT_SAMPLE_TIMEOUT 100000
+/* Weight of the newest sample in the moving averages, as 1/2^n */
+#define DP_SWLM_ADAPT_EWMA_SHIFT 3
+
 /* Inline Functions */
 
 /**
@@ -59,19 +78,75 @@ bool dp_tx_is_special_frame(qdf_nbuf_t nbuf, uint32_t frame_mask)
 	return false;
 }
 
+/**
+ * dp_swlm_tcl_record_flush() - Account a HP write which ends a coalescing
+ *				session in the batch size/delay histograms
+ * @soc: DP soc handle
+ * @ring_id: TCL ring id
+ * @num_pkts: Num packets covered by this HP write
+ * @curr_time: Current timestamp in us
+ *
+ * Returns: none
+ */
+static inline void
+dp_swlm_tcl_record_flush(struct dp_soc *soc, uint8_t ring_id,
+			 uint32_t num_pkts, uint64_t curr_time)
+{
+	static const uint32_t delay_bins[DP_SWLM_DELAY_HIST_MAX - 1] = {
+		50, 100, 250, 500, 1000};
+	struct dp_swlm_tcl_params *tcl = &soc->swlm.params.tcl[ring_id];
+	struct dp_swlm *swlm = &soc->swlm;
+	uint32_t delay = curr_time - tcl->session_start_time;
+	uint8_t bin;
+
+	bin = qdf_min(qdf_fls(num_pkts) - 1, DP_SWLM_BATCH_HIST_MAX - 1);
+	DP_STATS_INC(swlm, tcl[ring_id].batch_size_hist[bin], 1);
+
+	for (bin = 0; bin < DP_SWLM_DELAY_HIST_MAX - 1; bin++)
+		if (delay < delay_bins[bin])
+			break;
+	DP_STATS_INC(swlm, tcl[ring_id].delay_hist[bin], 1);
+
+	tcl->pkts_coalesced = 0;
+}
+
+/**
+ * dp_swlm_tcl_session_add() - Account a coalesced packet in the session
+ * @tcl: TCL ring params
+ * @curr_time: Current timestamp in us
+ *
+ * Returns: none
+ */
+static inline void
+dp_swlm_tcl_session_add(struct dp_swlm_tcl_params *tcl, uint64_t curr_time)
+{
+	if (!tcl->pkts_coalesced)
+		tcl->session_start_time = curr_time;
+	tcl->pkts_coalesced++;
+}
+
 /**
  * dp_swlm_tcl_reset_session_data() -  Reset the TCL coalescing session data
  * @soc: DP soc handle
  * @ring_id: TCL ring id
  *
+ * Called when the HP register is written for the current packet, which also
+ * flushes the packets coalesced so far.
+ *
  * Returns QDF_STATUS
  */
 static inline QDF_STATUS
 dp_swlm_tcl_reset_session_data(struct dp_soc *soc, uint8_t ring_id)
 {
 	struct dp_swlm_params *params = &soc->swlm.params;
+	uint64_t curr_time = qdf_get_log_timestamp_usecs();
+
+	if (params->tcl[ring_id].pkts_coalesced)
+		dp_swlm_tcl_record_flush(soc, ring_id,
+					 params->tcl[ring_id].pkts_coalesced + 1,
+					 curr_time);
 
-	params->tcl[ring_id].coalesce_end_time = qdf_get_log_timestamp_usecs() +
+	params->tcl[ring_id].coalesce_end_time = curr_time +
 		params->time_flush_thresh;
 	params->tcl[ring_id].bytes_coalesced = 0;
 	params->tcl[ring_id].bytes_flush_thresh =
@@ -113,6 +188,12 @@ dp_swlm_tcl_pre_check(struct dp_soc *soc,
 		goto fail;
 	}
 
+	if (qdf_nbuf_get_sk_priority(tcl_data->nbuf) >=
+	    swlm->params.bypass_prio) {
+		DP_STATS_INC(swlm, tcl[tcl_data->ring_id].prio_bypass, 1);
+		goto fail;
+	}
+
 	return QDF_STATUS_SUCCESS;
 
 fail:
@@ -172,6 +253,25 @@ QDF_STATUS dp_soc_swlm_detach(struct dp_soc *soc);
  */
 QDF_STATUS dp_print_swlm_stats(struct dp_soc *soc);
 
+/**
+ * dp_soc_swlm_set_mode() - Switch the software latency manager mode
+ * @soc: Datapath soc handle
+ * @mode: DP_SWLM_MODE_DISABLE, DP_SWLM_MODE_FIXED or DP_SWLM_MODE_ADAPTIVE
+ *
+ * Returns: QDF_STATUS
+ */
+QDF_STATUS dp_soc_swlm_set_mode(struct dp_soc *soc, uint8_t mode);
+
+/**
+ * dp_swlm_tx_comp_sample() - Feed the completion of a sampled TX descriptor
+ *			      to the latency feedback of its TCL ring
+ * @soc: Datapath soc handle
+ * @tx_desc: completed TX descriptor, marked with DP_TX_DESC_FLAG_SWLM_SAMPLE
+ *
+ * Returns: none
+ */
+void dp_swlm_tx_comp_sample(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc);
+
 #endif /* WLAN_DP_FEATURE_SW_LATENCY_MGR */
 
 #endif
@@ -998,8 +998,18 @@ void wlan_dp_display_tx_rx_histogram(struct wlan_objmgr_psoc *psoc)
 	dp_nofl_info("Total entries: %d Current index: %d",
 		     NUM_TX_RX_HISTOGRAM, dp_ctx->txrx_hist_idx);
 
+#ifdef WLAN_DP_BUS_BW_PREDICT
+	dp_nofl_info("BW predict - EWMA: %llu Vote pkts: %llu Boosted intervals: %u",
+		     dp_ctx->bw_pred.ewma_pkts, dp_ctx->bw_pred.vote_pkts,
+		     dp_ctx->bw_pred.boost_cnt);
+#endif
+
 	if (dp_ctx->txrx_hist) {
+#ifdef WLAN_DP_BUS_BW_PREDICT
+		dp_nofl_info("[index][timestamp]: interval_rx, interval_tx, vote_pkts(trend|backlog|hold|decay), bus_bw_level, RX TP Level, TX TP Level, Rx:Tx pm_qos");
+#else
 		dp_nofl_info("[index][timestamp]: interval_rx, interval_tx, bus_bw_level, RX TP Level, TX TP Level, Rx:Tx pm_qos");
+#endif
 
 		for (i = 0; i < NUM_TX_RX_HISTOGRAM; i++) {
 			struct tx_rx_histogram *hist;
@@ -1008,6 +1018,17 @@ void wlan_dp_display_tx_rx_histogram(struct wlan_objmgr_psoc *psoc)
 			if (dp_ctx->txrx_hist[i].qtime <= 0)
 				continue;
 			hist = &dp_ctx->txrx_hist[i];
+#ifdef WLAN_DP_BUS_BW_PREDICT
+			dp_nofl_info("[%3d][%15llu]: %6llu, %6llu, %6llu(%#x), %s, %s, %s, %s:%s",
+				     i, hist->qtime, hist->interval_rx,
+				     hist->interval_tx, hist->vote_pkts,
+				     hist->pred_flags,
+				     pld_bus_width_type_to_str(hist->next_vote_level),
+				     dp_tp_level_to_str(hist->next_rx_level),
+				     dp_tp_level_to_str(hist->next_tx_level),
+				     hist->is_rx_pm_qos_high ? "HIGH" : "LOW",
+				     hist->is_tx_pm_qos_high ? "HIGH" : "LOW");
+#else
 			dp_nofl_info("[%3d][%15llu]: %6llu, %6llu, %s, %s, %s, %s:%s",
 				     i, hist->qtime, hist->interval_rx,
 				     hist->interval_tx,
@@ -1016,6 +1037,7 @@ void wlan_dp_display_tx_rx_histogram(struct wlan_objmgr_psoc *psoc)
 				     dp_tp_level_to_str(hist->next_tx_level),
 				     hist->is_rx_pm_qos_high ? "HIGH" : "LOW",
 				     hist->is_tx_pm_qos_high ? "HIGH" : "LOW");
+#endif
 		}
 	}
 }
@@ -1478,6 +1500,117 @@ bool dp_sap_p2p_update_mid_high_tput(struct wlan_dp_psoc_context *dp_ctx,
 	return false;
 }
 
+#ifdef WLAN_DP_BUS_BW_PREDICT
+/* Weight of the newest interval in the EWMA is 1 / 2^DP_BW_PRED_EWMA_SHIFT */
+#define DP_BW_PRED_EWMA_SHIFT		1
+/* Growth below 1 / 2^DP_BW_PRED_TREND_SHIFT of the load is not a trend */
+#define DP_BW_PRED_TREND_SHIFT		2
+/* Intervals a vote is held before it is allowed to decay */
+#define DP_BW_PRED_HOLD_INTERVALS	3
+
+/**
+ * dp_bus_bw_predict_pkts() - Get the packet count to vote bus bandwidth on
+ * @dp_ctx: handle to dp context
+ * @soc: cdp soc handle
+ * @total_pkts: tx + rx packets measured over the last interval
+ *
+ * While the load ramps up, as a TCP flow opening its window does, the same
+ * growth is expected over the next interval and voted for right away. The
+ * frames still queued to the RX threads are added as they are not counted
+ * yet. A lower load is followed only after DP_BW_PRED_HOLD_INTERVALS, and
+ * then through the EWMA, so that short gaps do not drop the vote.
+ *
+ * Return: packet count to pick the vote level from
+ */
+static uint64_t dp_bus_bw_predict_pkts(struct wlan_dp_psoc_context *dp_ctx,
+				       ol_txrx_soc_handle soc,
+				       uint64_t total_pkts)
+{
+	struct dp_bus_bw_predictor *pred = &dp_ctx->bw_pred;
+	uint64_t vote_pkts = total_pkts;
+	int rx_pending;
+
+	pred->flags = 0;
+
+	if (total_pkts > pred->prev_pkts +
+			 (pred->prev_pkts >> DP_BW_PRED_TREND_SHIFT)) {
+		vote_pkts += total_pkts - pred->prev_pkts;
+		pred->flags |= DP_BW_PRED_TREND;
+	}
+
+	rx_pending = dp_rx_tm_get_pending(soc);
+	if (rx_pending > 0) {
+		vote_pkts += rx_pending;
+		pred->flags |= DP_BW_PRED_RX_BACKLOG;
+	}
+
+	pred->ewma_pkts = (pred->ewma_pkts *
+			   ((1 << DP_BW_PRED_EWMA_SHIFT) - 1) + total_pkts) >>
+			  DP_BW_PRED_EWMA_SHIFT;
+	pred->prev_pkts = total_pkts;
+
+	if (vote_pkts >= pred->vote_pkts) {
+		pred->hold_cnt = DP_BW_PRED_HOLD_INTERVALS;
+	} else if (pred->hold_cnt) {
+		pred->hold_cnt--;
+		vote_pkts = pred->vote_pkts;
+		pred->flags |= DP_BW_PRED_HOLD;
+	} else if (pred->ewma_pkts > vote_pkts) {
+		vote_pkts = pred->ewma_pkts;
+		pred->flags |= DP_BW_PRED_DECAY;
+	}
+
+	pred->vote_pkts = vote_pkts;
+	if (vote_pkts > total_pkts)
+		pred->boost_cnt++;
+
+	return vote_pkts;
+}
+
+/**
+ * dp_bus_bw_predict_reset() - Reset the predictive vote state
+ * @dp_ctx: handle to dp context
+ *
+ * Return: None
+ */
+static inline void dp_bus_bw_predict_reset(struct wlan_dp_psoc_context *dp_ctx)
+{
+	qdf_mem_zero(&dp_ctx->bw_pred, sizeof(dp_ctx->bw_pred));
+}
+
+/**
+ * dp_bus_bw_predict_hist_record() - Record the predicted vote in histogram
+ * @dp_ctx: handle to dp context
+ * @hist: histogram entry
+ *
+ * Return: None
+ */
+static inline void
+dp_bus_bw_predict_hist_record(struct wlan_dp_psoc_context *dp_ctx,
+			      struct tx_rx_histogram *hist)
+{
+	hist->vote_pkts = dp_ctx->bw_pred.vote_pkts;
+	hist->pred_flags = dp_ctx->bw_pred.flags;
+}
+#else
+static inline uint64_t
+dp_bus_bw_predict_pkts(struct wlan_dp_psoc_context *dp_ctx,
+		       ol_txrx_soc_handle soc, uint64_t total_pkts)
+{
+	return total_pkts;
+}
+
+static inline void dp_bus_bw_predict_reset(struct wlan_dp_psoc_context *dp_ctx)
+{
+}
+
+static inline void
+dp_bus_bw_predict_hist_record(struct wlan_dp_psoc_context *dp_ctx,
+			      struct tx_rx_histogram *hist)
+{
+}
+#endif /* WLAN_DP_BUS_BW_PREDICT */
+
 /**
  * dp_pld_request_bus_bandwidth() - Function to control bus bandwidth
  * @dp_ctx: handle to DP context
@@ -1502,6 +1635,7 @@ static void dp_pld_request_bus_bandwidth(struct wlan_dp_psoc_context *dp_ctx,
 	bool tx_level_change;
 	bool dptrace_high_tput_req;
 	u64 total_pkts = tx_packets + rx_packets;
+	u64 vote_pkts;
 	enum pld_bus_width_type next_vote_level = PLD_BUS_WIDTH_IDLE;
 	static enum wlan_tp_level next_rx_level = WLAN_SVC_TP_NONE;
 	enum wlan_tp_level next_tx_level = WLAN_SVC_TP_NONE;
@@ -1522,29 +1656,31 @@ static void dp_pld_request_bus_bandwidth(struct wlan_dp_psoc_context *dp_ctx,
 	if (!soc)
 		return;
 
+	vote_pkts = dp_bus_bw_predict_pkts(dp_ctx, soc, total_pkts);
+
 	if (dp_ctx->high_bus_bw_request) {
 		next_vote_level = PLD_BUS_WIDTH_VERY_HIGH;
 		tput_level = TPUT_LEVEL_VERY_HIGH;
-	} else if (total_pkts > dp_ctx->dp_cfg.bus_bw_super_high_threshold) {
+	} else if (vote_pkts > dp_ctx->dp_cfg.bus_bw_super_high_threshold) {
 		next_vote_level = PLD_BUS_WIDTH_MAX;
 		tput_level = TPUT_LEVEL_SUPER_HIGH;
-	} else if (total_pkts > dp_ctx->dp_cfg.bus_bw_ultra_high_threshold) {
+	} else if (vote_pkts > dp_ctx->dp_cfg.bus_bw_ultra_high_threshold) {
 		next_vote_level = PLD_BUS_WIDTH_ULTRA_HIGH;
 		tput_level = TPUT_LEVEL_ULTRA_HIGH;
-	} else if (total_pkts > dp_ctx->dp_cfg.bus_bw_very_high_threshold) {
+	} else if (vote_pkts > dp_ctx->dp_cfg.bus_bw_very_high_threshold) {
 		next_vote_level = PLD_BUS_WIDTH_VERY_HIGH;
 		tput_level = TPUT_LEVEL_VERY_HIGH;
-	} else if (total_pkts > dp_ctx->dp_cfg.bus_bw_high_threshold) {
+	} else if (vote_pkts > dp_ctx->dp_cfg.bus_bw_high_threshold) {
 		next_vote_level = PLD_BUS_WIDTH_HIGH;
 		tput_level = TPUT_LEVEL_HIGH;
-		if (dp_sap_p2p_update_mid_high_tput(dp_ctx, total_pkts)) {
+		if (dp_sap_p2p_update_mid_high_tput(dp_ctx, vote_pkts)) {
 			next_vote_level = PLD_BUS_WIDTH_MID_HIGH;
 			tput_level = TPUT_LEVEL_MID_HIGH;
 		}
-	} else if (total_pkts > dp_ctx->dp_cfg.bus_bw_medium_threshold) {
+	} else if (vote_pkts > dp_ctx->dp_cfg.bus_bw_medium_threshold) {
 		next_vote_level = PLD_BUS_WIDTH_MEDIUM;
 		tput_level = TPUT_LEVEL_MEDIUM;
-	} else if (total_pkts > dp_ctx->dp_cfg.bus_bw_low_threshold) {
+	} else if (vote_pkts > dp_ctx->dp_cfg.bus_bw_low_threshold) {
 		next_vote_level = PLD_BUS_WIDTH_LOW;
 		tput_level = TPUT_LEVEL_LOW;
 	} else {
@@ -1559,7 +1695,7 @@ static void dp_pld_request_bus_bandwidth(struct wlan_dp_psoc_context *dp_ctx,
 	 */
 	if (!ucfg_ipa_is_fw_wdi_activated(dp_ctx->pdev) &&
 	    policy_mgr_is_current_hwmode_dbs(dp_ctx->psoc) &&
-	    (total_pkts > dp_ctx->dp_cfg.bus_bw_dbs_threshold) &&
+	    (vote_pkts > dp_ctx->dp_cfg.bus_bw_dbs_threshold) &&
 	    (tput_level < TPUT_LEVEL_SUPER_HIGH)) {
 		next_vote_level = PLD_BUS_WIDTH_ULTRA_HIGH;
 		tput_level = TPUT_LEVEL_ULTRA_HIGH;
@@ -1718,6 +1854,8 @@ static void dp_pld_request_bus_bandwidth(struct wlan_dp_psoc_context *dp_ctx,
 			dp_ctx->txrx_hist[index].interval_tx = tx_packets;
 			dp_ctx->txrx_hist[index].qtime =
 				qdf_get_log_timestamp();
+			dp_bus_bw_predict_hist_record(dp_ctx,
+						      &dp_ctx->txrx_hist[index]);
 			dp_ctx->txrx_hist_idx++;
 			dp_ctx->txrx_hist_idx &= NUM_TX_RX_HISTOGRAM_MASK;
 		}
@@ -2166,8 +2304,9 @@ static void __dp_bus_bw_compute_timer_start(struct wlan_objmgr_psoc *psoc)
 	if (QDF_GLOBAL_FTM_MODE == cds_get_conparam())
 		return;
 
-	qdf_periodic_work_start(&dp_ctx->bus_bw_work,
-				dp_ctx->dp_cfg.bus_bw_compute_interval);
+	if (qdf_periodic_work_start(&dp_ctx->bus_bw_work,
+				    dp_ctx->dp_cfg.bus_bw_compute_interval))
+		dp_bus_bw_predict_reset(dp_ctx);
 	dp_ctx->bw_vote_time = qdf_get_log_timestamp();
 }
 
@@ -736,6 +736,9 @@ dp_fisa_rx_delete_flow(struct dp_rx_fst *fisa_hdl,
 	/* Flush the flow before deletion */
 	dp_rx_fisa_flush_flow_wrap(sw_ft_entry);
 
+	if (fisa_hdl->last_flow[reo_id].sw_ft == sw_ft_entry)
+		fisa_hdl->last_flow[reo_id].sw_ft = NULL;
+
 	dp_rx_fisa_save_pkt_hist(sw_ft_entry, &pkt_hist);
 	/* Clear the sw_ft_entry */
 	qdf_mem_zero(sw_ft_entry, sizeof(*sw_ft_entry));
@@ -1153,6 +1156,70 @@ dp_fisa_rx_get_sw_ft_entry(struct dp_rx_fst *fisa_hdl, qdf_nbuf_t nbuf,
 	return sw_ft_entry;
 }
 
+/**
+ * dp_fisa_rx_get_last_flow() - Get SW FT entry from the per REO last flow
+ * @fisa_hdl: handle to FISA context
+ * @nbuf: Received RX packet
+ * @flow_idx: Flow index
+ * @vdev: handle to DP vdev
+ *
+ * Back-to-back packets of one flow on a REO ring resolve to the same SW FT
+ * entry, so skip the table lookup and the per packet vdev/interface update
+ * when the entry is still populated for the same vdev. The caller must hold
+ * the SW FT lock of the REO ring.
+ *
+ * Return: SW FT entry, NULL if the full lookup is needed
+ */
+static inline struct dp_fisa_rx_sw_ft *
+dp_fisa_rx_get_last_flow(struct dp_rx_fst *fisa_hdl, qdf_nbuf_t nbuf,
+			 uint32_t flow_idx, struct dp_vdev *vdev)
+{
+	struct dp_fisa_reo_flow_cache *last_flow =
+			&fisa_hdl->last_flow[QDF_NBUF_CB_RX_CTX_ID(nbuf)];
+	struct dp_fisa_rx_sw_ft *sw_ft_entry = last_flow->sw_ft;
+	uint32_t fse_metadata;
+
+	if (!sw_ft_entry || last_flow->flow_idx != flow_idx ||
+	    !sw_ft_entry->is_populated || sw_ft_entry->vdev != vdev)
+		goto miss;
+
+	if (fisa_hdl->flow_deletion_supported && fisa_hdl->del_flow_count) {
+		fse_metadata =
+			hal_rx_msdu_fse_metadata_get(fisa_hdl->dp_ctx->hal_soc,
+						     qdf_nbuf_data(nbuf));
+		if (fse_metadata != sw_ft_entry->metadata)
+			goto miss;
+	}
+
+	last_flow->hit++;
+	return sw_ft_entry;
+
+miss:
+	last_flow->miss++;
+	return NULL;
+}
+
+/**
+ * dp_fisa_rx_set_last_flow() - Remember the flow resolved on a REO ring
+ * @fisa_hdl: handle to FISA context
+ * @nbuf: Received RX packet
+ * @flow_idx: Flow index
+ * @sw_ft_entry: SW FT entry of the flow, NULL to forget the last flow
+ *
+ * Return: None
+ */
+static inline void
+dp_fisa_rx_set_last_flow(struct dp_rx_fst *fisa_hdl, qdf_nbuf_t nbuf,
+			 uint32_t flow_idx,
+			 struct dp_fisa_rx_sw_ft *sw_ft_entry)
+{
+	struct dp_fisa_reo_flow_cache *last_flow =
+			&fisa_hdl->last_flow[QDF_NBUF_CB_RX_CTX_ID(nbuf)];
+
+	last_flow->sw_ft = sw_ft_entry;
+	last_flow->flow_idx = flow_idx;
+}
+
 #if defined(DP_OFFLOAD_FRAME_WITH_SW_EXCEPTION)
 /*
  * dp_rx_reo_dest_honor_check() - check if packet reo destination is changed
@@ -1223,16 +1290,16 @@ dp_rx_reo_dest_honor_check(struct dp_rx_fst *fisa_hdl, qdf_nbuf_t nbuf,
  * @fisa_hdl: handle to FISA context
  * @vdev: handle to DP vdev
  * @nbuf: incoming msdu
+ * @tlv_reo_dest_ind: REO destination indication from the RX TLV
  *
  * Return: handle SW FT entry for nbuf flow
  */
 static struct dp_fisa_rx_sw_ft *
 dp_rx_get_fisa_flow(struct dp_rx_fst *fisa_hdl, struct dp_vdev *vdev,
-		    qdf_nbuf_t nbuf)
+		    qdf_nbuf_t nbuf, uint32_t tlv_reo_dest_ind)
 {
 	uint8_t *rx_tlv_hdr;
 	uint32_t flow_idx_hash;
-	uint32_t tlv_reo_dest_ind;
 	bool flow_invalid, flow_timeout, flow_idx_valid;
 	struct dp_fisa_rx_sw_ft *sw_ft_entry = NULL;
 	hal_soc_handle_t hal_soc_hdl = fisa_hdl->dp_ctx->hal_soc;
@@ -1242,8 +1309,6 @@ dp_rx_get_fisa_flow(struct dp_rx_fst *fisa_hdl, struct dp_vdev *vdev,
 		return sw_ft_entry;
 
 	rx_tlv_hdr = qdf_nbuf_data(nbuf);
-	hal_rx_msdu_get_reo_destination_indication(hal_soc_hdl, rx_tlv_hdr,
-						   &tlv_reo_dest_ind);
 	status = dp_rx_reo_dest_honor_check(fisa_hdl, nbuf, tlv_reo_dest_ind);
 	if (QDF_IS_STATUS_ERROR(status))
 		return sw_ft_entry;
@@ -1253,8 +1318,15 @@ dp_rx_get_fisa_flow(struct dp_rx_fst *fisa_hdl, struct dp_vdev *vdev,
 
 	flow_idx_valid = is_flow_idx_valid(flow_invalid, flow_timeout);
 	if (flow_idx_valid) {
+		sw_ft_entry = dp_fisa_rx_get_last_flow(fisa_hdl, nbuf,
+						       flow_idx_hash, vdev);
+		if (qdf_likely(sw_ft_entry))
+			goto print_and_return;
+
 		sw_ft_entry = dp_fisa_rx_get_sw_ft_entry(fisa_hdl, nbuf,
 							 flow_idx_hash, vdev);
+		dp_fisa_rx_set_last_flow(fisa_hdl, nbuf, flow_idx_hash,
+					 sw_ft_entry);
 		goto print_and_return;
 	}
 
@@ -1386,6 +1458,7 @@ dp_rx_fisa_aggr_udp(struct dp_rx_fst *fisa_hdl,
 	uint32_t udp_len;
 	uint32_t transport_payload_offset;
 	uint32_t l3_hdr_offset, l4_hdr_offset;
+	bool no_payload;
 
 	qdf_nbuf_pull_head(nbuf, fisa_hdl->rx_pkt_tlv_size + l2_hdr_offset);
 
@@ -1397,14 +1470,20 @@ dp_rx_fisa_aggr_udp(struct dp_rx_fst *fisa_hdl,
 
 	udp_len = qdf_ntohs(udp_hdr->udp_len);
 
+	/* A datagram without payload has no GSO size, it is delivered alone */
+	no_payload = udp_len <= sizeof(qdf_net_udphdr_t);
+
 	/**
-	 * Incoming nbuf is of size greater than ongoing aggregation
-	 * then flush the aggregate and start new aggregation for nbuf
+	 * Incoming nbuf is of size greater than ongoing aggregation, or can't
+	 * be aggregated, then flush the aggregate and start new aggregation
+	 * for nbuf
 	 */
 	if (head_skb &&
-	    (udp_len > qdf_ntohs(fisa_flow->head_skb_udp_hdr->udp_len))) {
+	    (no_payload ||
+	     udp_len > qdf_ntohs(fisa_flow->head_skb_udp_hdr->udp_len))) {
 		/* current msdu should not take into account for flushing */
-		fisa_flow->adjusted_cumulative_ip_length -=
+		if (!no_payload)
+			fisa_flow->adjusted_cumulative_ip_length -=
 					(udp_len - sizeof(qdf_net_udphdr_t));
 		fisa_flow->cur_aggr--;
 		dp_rx_fisa_flush_flow_wrap(fisa_flow);
@@ -1426,6 +1505,9 @@ dp_rx_fisa_aggr_udp(struct dp_rx_fst *fisa_hdl,
 
 		fisa_flow->frags_cumulative_len = 0;
 
+		if (qdf_unlikely(no_payload))
+			dp_rx_fisa_flush_flow_wrap(fisa_flow);
+
 		return FISA_AGGR_DONE;
 	}
 
@@ -1478,17 +1560,23 @@ dp_rx_fisa_aggr_udp(struct dp_rx_fst *fisa_hdl,
 }
 
 /**
- * dp_fisa_rx_linear_skb() - Linearize fraglist skb to linear skb
- * @vdev: handle to DP vdev
- * @head_skb: non linear skb
- * @size: Total length of non linear stiched skb
+ * dp_fisa_rx_record_aggr_size() - Account a flushed aggregate of a flow
+ * @fisa_flow: Flow being flushed
+ * @num_msdu: Number of MSDUs in the aggregate
  *
- * Return: Linearized skb pointer
+ * Return: None
  */
-static qdf_nbuf_t dp_fisa_rx_linear_skb(struct dp_vdev *vdev,
-					qdf_nbuf_t head_skb, uint32_t size)
+static inline void
+dp_fisa_rx_record_aggr_size(struct dp_fisa_rx_sw_ft *fisa_flow,
+			    uint32_t num_msdu)
 {
-	return NULL;
+	uint32_t idx = qdf_fls(num_msdu);
+
+	idx = idx ? idx - 1 : 0;
+	if (idx >= FISA_AGGR_SIZE_HIST_MAX)
+		idx = FISA_AGGR_SIZE_HIST_MAX - 1;
+
+	fisa_flow->aggr_size_hist[idx]++;
 }
 
 #ifdef WLAN_FEATURE_11BE
@@ -1616,7 +1704,7 @@ dp_rx_fisa_flush_udp_flow(struct dp_vdev *vdev,
 	qdf_net_iphdr_t *head_skb_iph;
 	qdf_net_udphdr_t *head_skb_udp_hdr;
 	qdf_nbuf_shared_info_t shinfo;
-	qdf_nbuf_t linear_skb;
+	uint32_t payload_len, gso_segs = 1;
 	struct dp_vdev *fisa_flow_vdev;
 	ol_txrx_soc_handle cdp_soc = fisa_flow->dp_ctx->cdp_soc;
 
@@ -1679,15 +1767,32 @@ dp_rx_fisa_flush_udp_flow(struct dp_vdev *vdev,
 		qdf_nbuf_set_csum_offset(head_skb,
 					 offsetof(qdf_net_udphdr_t, udp_cksum));
 
+		/*
+		 * Every MSDU but the last carries gso_size bytes of payload,
+		 * so the stack can hand the whole aggregate to a UDP_GRO
+		 * socket in one recvmsg, or split it back on the frag_list
+		 * boundaries without linearizing.
+		 */
+		payload_len = fisa_flow->adjusted_cumulative_ip_length -
+			      sizeof(qdf_net_udphdr_t);
+		gso_segs = fisa_flow->cur_aggr_gso_size ?
+			   (payload_len + fisa_flow->cur_aggr_gso_size - 1) /
+			   fisa_flow->cur_aggr_gso_size : 1;
+
 		qdf_nbuf_set_gso_size(head_skb, fisa_flow->cur_aggr_gso_size);
-		dp_fisa_debug("gso_size %d, udp_len %d\n",
+		dp_fisa_debug("gso_size %d, udp_len %d gso_segs %d\n",
 			      qdf_nbuf_get_gso_size(head_skb),
-			      qdf_ntohs(head_skb_udp_hdr->udp_len));
-		qdf_nbuf_set_gso_segs(head_skb, fisa_flow->cur_aggr);
-		qdf_nbuf_set_gso_type_udp_l4(head_skb);
+			      qdf_ntohs(head_skb_udp_hdr->udp_len), gso_segs);
+		qdf_nbuf_set_gso_segs(head_skb, gso_segs);
+		if (!fisa_flow->dp_ctx->fisa_udp_gso_fraglist ||
+		    !qdf_nbuf_set_gso_type_udp_l4_fraglist(head_skb))
+			qdf_nbuf_set_gso_type_udp_l4(head_skb);
 		qdf_nbuf_set_ip_summed_partial(head_skb);
+		fisa_flow->gso_bytes += payload_len;
 	}
 
+	dp_fisa_rx_record_aggr_size(fisa_flow, gso_segs);
+
 	qdf_nbuf_set_next(fisa_flow->head_skb, NULL);
 	QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(fisa_flow->head_skb) = 1;
 	if (fisa_flow->last_skb)
@@ -1700,31 +1805,22 @@ dp_rx_fisa_flush_udp_flow(struct dp_vdev *vdev,
 		goto vdev_ref_get_fail;
 
 	dp_fisa_debug("fisa_flow->curr_aggr %d", fisa_flow->cur_aggr);
-	linear_skb = dp_fisa_rx_linear_skb(vdev, fisa_flow->head_skb, 24000);
-	if (linear_skb) {
-		if (!vdev->osif_rx || QDF_STATUS_SUCCESS !=
-		    vdev->osif_rx(vdev->osif_vdev, linear_skb))
-			qdf_nbuf_free(linear_skb);
-		/* Free non linear skb */
+	/*
+	 * Sanity check head data_len should be equal to sum of
+	 * all fragments length
+	 */
+	if (qdf_unlikely(fisa_flow->frags_cumulative_len !=
+			 qdf_nbuf_get_only_data_len(fisa_flow->head_skb))) {
+		qdf_assert(0);
+		/* Drop the aggregate */
 		qdf_nbuf_free(fisa_flow->head_skb);
-	} else {
-		/*
-		 * Sanity check head data_len should be equal to sum of
-		 * all fragments length
-		 */
-		if (qdf_unlikely(fisa_flow->frags_cumulative_len !=
-				 qdf_nbuf_get_only_data_len(fisa_flow->head_skb))) {
-			qdf_assert(0);
-			/* Drop the aggregate */
-			qdf_nbuf_free(fisa_flow->head_skb);
-			goto out;
-		}
-
-		if (!vdev->osif_rx || QDF_STATUS_SUCCESS !=
-		    vdev->osif_rx(vdev->osif_vdev, fisa_flow->head_skb))
-			qdf_nbuf_free(fisa_flow->head_skb);
+		goto out;
 	}
 
+	if (!vdev->osif_rx || QDF_STATUS_SUCCESS !=
+	    vdev->osif_rx(vdev->osif_vdev, fisa_flow->head_skb))
+		qdf_nbuf_free(fisa_flow->head_skb);
+
 out:
 	if (fisa_flow_vdev)
 		dp_vdev_unref_delete(cdp_soc_t_to_dp_soc(cdp_soc),
@@ -2190,7 +2286,7 @@ QDF_STATUS dp_fisa_rx(struct wlan_dp_psoc_context *dp_ctx,
 
 		/* Add new flow if the there is no ongoing flow */
 		fisa_flow = dp_rx_get_fisa_flow(dp_fisa_rx_hdl, vdev,
-						head_nbuf);
+						head_nbuf, tlv_reo_dest_ind);
 
 		/* Do not FISA aggregate IPSec packets */
 		if (fisa_flow &&
@@ -685,6 +685,10 @@ static void dp_set_rx_mode_value(struct wlan_dp_psoc_context *dp_ctx)
 			dp_ctx->enable_dp_rx_threads = true;
 	}
 
+	if (dp_ctx->enable_dp_rx_threads &&
+	    rx_mode & CFG_ENABLE_DP_RX_WORK_STEALING)
+		dp_ctx->enable_dp_rx_work_stealing = true;
+
 	if (rx_mode & CFG_ENABLE_RPS)
 		dp_ctx->rps = true;
 
@@ -694,8 +698,9 @@ static void dp_set_rx_mode_value(struct wlan_dp_psoc_context *dp_ctx)
 	if (rx_mode & CFG_ENABLE_DYNAMIC_RPS)
 		dp_ctx->dynamic_rps = true;
 
-	dp_info("rx_mode:%u dp_rx_threads:%u rx_thread:%u napi:%u rps:%u dynamic rps %u",
+	dp_info("rx_mode:%u dp_rx_threads:%u work_stealing:%u rx_thread:%u napi:%u rps:%u dynamic rps %u",
 		rx_mode, dp_ctx->enable_dp_rx_threads,
+		dp_ctx->enable_dp_rx_work_stealing,
 		dp_ctx->enable_rxthread, dp_ctx->napi_enable,
 		dp_ctx->rps, dp_ctx->dynamic_rps);
 }
@@ -79,6 +79,7 @@ static void dp_print_fisa_stats(struct wlan_dp_psoc_context *dp_ctx)
 {
 	struct wlan_dp_psoc_cfg *dp_cfg = &dp_ctx->dp_cfg;
 	struct dp_rx_fst *fst = dp_ctx->rx_fst;
+	int i;
 
 	/* Check if it is enabled in the INI */
 	if (!wlan_dp_cfg_is_rx_fisa_enabled(dp_cfg))
@@ -92,6 +93,10 @@ static void dp_print_fisa_stats(struct wlan_dp_psoc_context *dp_ctx)
 		fst->stats.reo_mismatch.allow_fse_metdata_mismatch);
 	dp_info("reo_mismatch: allow_non_aggr: %u",
 		fst->stats.reo_mismatch.allow_non_aggr);
+
+	for (i = 0; i < MAX_REO_DEST_RINGS; i++)
+		dp_info("reo %d last flow hit: %u miss: %u", i,
+			fst->last_flow[i].hit, fst->last_flow[i].miss);
 }
 
 /* Length of string to store tuple information for printing */
@@ -157,6 +162,16 @@ static QDF_STATUS dp_rx_dump_fisa_stats(struct wlan_dp_psoc_context *dp_ctx)
 			qdf_do_div(sw_ft_entry->bytes_aggregated,
 				   sw_ft_entry->flush_count),
 			sw_ft_entry->same_mld_vdev_mismatch);
+
+		if (sw_ft_entry->is_flow_udp)
+			dp_info("Flow[%d] aggr-size 1:%u 2-3:%u 4-7:%u 8-15:%u 16:%u gso-bytes %llu",
+				sw_ft_entry->flow_id,
+				sw_ft_entry->aggr_size_hist[0],
+				sw_ft_entry->aggr_size_hist[1],
+				sw_ft_entry->aggr_size_hist[2],
+				sw_ft_entry->aggr_size_hist[3],
+				sw_ft_entry->aggr_size_hist[4],
+				sw_ft_entry->gso_bytes);
 	}
 	return QDF_STATUS_SUCCESS;
 }
@@ -493,6 +508,8 @@ QDF_STATUS dp_rx_fst_attach(struct wlan_dp_psoc_context *dp_ctx)
 	dp_ctx->fisa_enable = true;
 	dp_ctx->fisa_lru_del_enable =
 				wlan_dp_cfg_is_rx_fisa_lru_del_enabled(dp_cfg);
+	dp_ctx->fisa_udp_gso_fraglist =
+				wlan_dp_cfg_is_rx_fisa_udp_gso_fraglist(dp_cfg);
 
 	qdf_atomic_init(&dp_ctx->skip_fisa_param.skip_fisa);
 	qdf_atomic_init(&fst->pm_suspended);
@@ -761,6 +778,8 @@ void dp_fisa_cfg_init(struct wlan_dp_psoc_cfg *config,
 	config->is_rx_fisa_enabled = cfg_get(psoc, CFG_DP_RX_FISA_ENABLE);
 	config->is_rx_fisa_lru_del_enabled =
 				cfg_get(psoc, CFG_DP_RX_FISA_LRU_DEL_ENABLE);
+	config->is_rx_fisa_udp_gso_fraglist =
+				cfg_get(psoc, CFG_DP_RX_FISA_UDP_GSO_FRAGLIST);
 }
 #else /* WLAN_SUPPORT_RX_FISA */
 
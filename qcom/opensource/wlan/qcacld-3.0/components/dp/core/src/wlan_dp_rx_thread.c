@@ -127,6 +127,34 @@ dp_rx_tm_get_soc_handle(struct dp_rx_tm_handle_cmn *rx_tm_handle_cmn)
 	return soc;
 }
 
+/**
+ * dp_rx_tm_work_stealing() - check whether rx threads steal from each other
+ * @rx_thread: rx_thread pointer
+ *
+ * Return: true if idle rx threads may steal flow batches from busy ones
+ */
+static inline bool dp_rx_tm_work_stealing(struct dp_rx_thread *rx_thread)
+{
+	struct dp_rx_tm_handle *rx_tm_hdl =
+		(struct dp_rx_tm_handle *)rx_thread->rtm_handle_cmn;
+
+	return rx_tm_hdl->work_stealing;
+}
+
+/**
+ * dp_rx_tm_flow_key() - get the flow key of a queued nbuf_list
+ * @nbuf: head nbuf of the nbuf_list
+ *
+ * All nbufs of a flow map to the same key, so moving every queued
+ * nbuf_list of a key between threads keeps the flow in order.
+ *
+ * Return: flow hash bucket of the nbuf
+ */
+static inline int dp_rx_tm_flow_key(qdf_nbuf_t nbuf)
+{
+	return QDF_NBUF_CB_RX_FLOW_ID(nbuf) & (DP_RX_TM_STEAL_FLOW_BUCKETS - 1);
+}
+
 /**
  * dp_rx_tm_thread_dump_stats() - display stats for a rx_thread
  * @rx_thread: rx_thread pointer for which the stats need to be
@@ -157,7 +185,7 @@ static void dp_rx_tm_thread_dump_stats(struct dp_rx_thread *rx_thread)
 				     "reo[%u]:%u ", reo_ring_num, temp);
 	}
 
-	if (!total_queued)
+	if (!total_queued && !rx_thread->stats.steal)
 		return;
 
 	dp_info("thread:%u - qlen:%u queued:(total:%u %s) dequeued:%u stack:%u gro_flushes: %u gro_flushes_by_vdev_del: %u rx_flushes: %u max_len:%u invalid(peer:%u vdev:%u rx-handle:%u others:%u enq fail:%u)",
@@ -176,6 +204,14 @@ static void dp_rx_tm_thread_dump_stats(struct dp_rx_thread *rx_thread)
 		rx_thread->stats.dropped_invalid_os_rx_handles,
 		rx_thread->stats.dropped_others,
 		rx_thread->stats.dropped_enq_fail);
+
+	if (dp_rx_tm_work_stealing(rx_thread))
+		dp_info("thread:%u - steal:%u steal_fail:%u stolen_nbuf:%u stolen_from:%d",
+			rx_thread->id,
+			rx_thread->stats.steal,
+			rx_thread->stats.steal_fail,
+			rx_thread->stats.stolen_nbuf,
+			qdf_atomic_read(&rx_thread->stats.stolen_from));
 }
 
 QDF_STATUS dp_rx_tm_dump_stats(struct dp_rx_tm_handle *rx_tm_hdl)
@@ -268,47 +304,58 @@ QDF_STATUS dp_check_and_update_pending(struct dp_rx_tm_handle_cmn
 #endif
 
 /**
- * dp_rx_tm_thread_enqueue() - enqueue nbuf list into rx_thread
+ * dp_rx_tm_wake_idle_thread() - wake an idle rx_thread to steal from a busy one
+ * @rx_tm_hdl: dp_rx_tm_handle containing the overall thread infrastructure
+ * @busy_thread: rx_thread whose queue crossed the steal threshold
+ *
+ * Return: None
+ */
+static void dp_rx_tm_wake_idle_thread(struct dp_rx_tm_handle *rx_tm_hdl,
+				      struct dp_rx_thread *busy_thread)
+{
+	struct dp_rx_thread *rx_thread;
+	uint8_t i, id;
+
+	/* a thief is already working on this thread */
+	if (qdf_atomic_read(&busy_thread->stolen_key) !=
+	    DP_RX_TM_STEAL_KEY_NONE)
+		return;
+
+	for (i = 1; i < rx_tm_hdl->num_dp_rx_threads; i++) {
+		id = (busy_thread->id + i) % rx_tm_hdl->num_dp_rx_threads;
+		rx_thread = rx_tm_hdl->rx_thread[id];
+		if (!rx_thread ||
+		    qdf_nbuf_queue_head_qlen(&rx_thread->nbuf_queue) ||
+		    qdf_atomic_test_bit(RX_POST_EVENT, &rx_thread->event_flag))
+			continue;
+
+		qdf_set_bit(RX_POST_EVENT, &rx_thread->event_flag);
+		qdf_wake_up_interruptible(&rx_thread->wait_q);
+		return;
+	}
+}
+
+/**
+ * dp_rx_tm_thread_queue_nbuf_list() - queue nbuf list into rx_thread
  * @rx_thread: rx_thread in which the nbuf needs to be queued
  * @nbuf_list: list of packets to be queued into the thread
  *
- * Enqueue packet into rx_thread and wake it up. The function
- * moves the next pointer of the nbuf_list into the ext list of
- * the first nbuf for storage into the thread. Only the first
- * nbuf is queued into the thread nbuf queue. The reverse is
- * done at the time of dequeue.
+ * The function moves the next pointer of the nbuf_list into the ext list
+ * of the first nbuf for storage into the thread. Only the first nbuf is
+ * queued into the thread nbuf queue. The reverse is done at the time of
+ * dequeue. The thread is not woken up, see dp_rx_tm_thread_post().
  *
- * Returns: QDF_STATUS_SUCCESS on success or qdf error code on
- * failure
+ * Returns: number of packets queued
  */
-static QDF_STATUS dp_rx_tm_thread_enqueue(struct dp_rx_thread *rx_thread,
-					  qdf_nbuf_t nbuf_list)
+static uint32_t dp_rx_tm_thread_queue_nbuf_list(struct dp_rx_thread *rx_thread,
+						qdf_nbuf_t nbuf_list)
 {
 	qdf_nbuf_t head_ptr, next_ptr_list;
-	uint32_t temp_qlen;
 	uint32_t num_elements_in_nbuf;
 	uint32_t nbuf_queued;
-	struct dp_rx_tm_handle_cmn *tm_handle_cmn;
-	uint8_t reo_ring_num = QDF_NBUF_CB_RX_CTX_ID(nbuf_list);
-	qdf_wait_queue_head_t *wait_q_ptr;
+	struct dp_rx_tm_handle_cmn *tm_handle_cmn = rx_thread->rtm_handle_cmn;
 	uint8_t allow_dropping;
 
-	tm_handle_cmn = rx_thread->rtm_handle_cmn;
-
-	if (!tm_handle_cmn) {
-		dp_alert("tm_handle_cmn is null!");
-		QDF_BUG(0);
-		return QDF_STATUS_E_FAILURE;
-	}
-
-	wait_q_ptr = &rx_thread->wait_q;
-
-	if (reo_ring_num >= DP_RX_TM_MAX_REO_RINGS) {
-		dp_alert("incorrect ring %u", reo_ring_num);
-		QDF_BUG(0);
-		return QDF_STATUS_E_FAILURE;
-	}
-
 	num_elements_in_nbuf = QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(nbuf_list);
 	nbuf_queued = num_elements_in_nbuf;
 
@@ -317,8 +364,7 @@ static QDF_STATUS dp_rx_tm_thread_enqueue(struct dp_rx_thread *rx_thread,
 	if (unlikely(allow_dropping)) {
 		qdf_nbuf_list_free(nbuf_list);
 		rx_thread->stats.dropped_enq_fail += num_elements_in_nbuf;
-		nbuf_queued = 0;
-		goto enq_done;
+		return 0;
 	}
 
 	dp_rx_tm_walk_skb_list(nbuf_list);
@@ -339,7 +385,7 @@ static QDF_STATUS dp_rx_tm_thread_enqueue(struct dp_rx_thread *rx_thread,
 	}
 
 	if (!head_ptr)
-		goto enq_done;
+		return nbuf_queued;
 
 	QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(head_ptr) = num_elements_in_nbuf;
 
@@ -356,7 +402,28 @@ static QDF_STATUS dp_rx_tm_thread_enqueue(struct dp_rx_thread *rx_thread,
 
 	qdf_nbuf_queue_head_enqueue_tail(&rx_thread->nbuf_queue, head_ptr);
 
-enq_done:
+	return nbuf_queued;
+}
+
+/**
+ * dp_rx_tm_thread_post() - account an enqueue and wake up the rx_thread
+ * @rx_thread: rx_thread into which packets were queued
+ * @reo_ring_num: REO ring the packets were received on
+ * @nbuf_queued: number of packets queued
+ * @prev_qlen: nbuf queue length before the packets were queued
+ *
+ * Called once per enqueue request, however many nbuf lists it queued.
+ *
+ * Return: None
+ */
+static void dp_rx_tm_thread_post(struct dp_rx_thread *rx_thread,
+				 uint8_t reo_ring_num, uint32_t nbuf_queued,
+				 uint32_t prev_qlen)
+{
+	struct dp_rx_tm_handle_cmn *tm_handle_cmn = rx_thread->rtm_handle_cmn;
+	qdf_wait_queue_head_t *wait_q_ptr = &rx_thread->wait_q;
+	uint32_t temp_qlen;
+
 	temp_qlen = qdf_nbuf_queue_head_qlen(&rx_thread->nbuf_queue);
 
 	rx_thread->stats.nbuf_queued[reo_ring_num] += nbuf_queued;
@@ -367,12 +434,69 @@ enq_done:
 	if (temp_qlen > rx_thread->stats.nbufq_max_len)
 		rx_thread->stats.nbufq_max_len = temp_qlen;
 
+	/* poke an idle thread each time another threshold worth is queued */
+	if (dp_rx_tm_work_stealing(rx_thread) &&
+	    temp_qlen / DP_RX_TM_STEAL_QLEN_THRESH >
+	    prev_qlen / DP_RX_TM_STEAL_QLEN_THRESH)
+		dp_rx_tm_wake_idle_thread((struct dp_rx_tm_handle *)tm_handle_cmn,
+					  rx_thread);
+
 	dp_debug("enqueue packet thread %pK wait queue %pK qlen %u",
-		 rx_thread, wait_q_ptr,
-		 qdf_nbuf_queue_head_qlen(&rx_thread->nbuf_queue));
+		 rx_thread, wait_q_ptr, temp_qlen);
 
 	qdf_set_bit(RX_POST_EVENT, &rx_thread->event_flag);
 	qdf_wake_up_interruptible(wait_q_ptr);
+}
+
+/**
+ * dp_rx_tm_thread_check_enqueue() - sanity check an enqueue request
+ * @rx_thread: rx_thread in which the nbuf needs to be queued
+ * @reo_ring_num: REO ring the packets were received on
+ *
+ * Return: QDF_STATUS_SUCCESS if the packets can be queued
+ */
+static QDF_STATUS dp_rx_tm_thread_check_enqueue(struct dp_rx_thread *rx_thread,
+						uint8_t reo_ring_num)
+{
+	if (!rx_thread->rtm_handle_cmn) {
+		dp_alert("tm_handle_cmn is null!");
+		QDF_BUG(0);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	if (reo_ring_num >= DP_RX_TM_MAX_REO_RINGS) {
+		dp_alert("incorrect ring %u", reo_ring_num);
+		QDF_BUG(0);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * dp_rx_tm_thread_enqueue() - enqueue nbuf list into rx_thread
+ * @rx_thread: rx_thread in which the nbuf needs to be queued
+ * @nbuf_list: list of packets to be queued into the thread
+ *
+ * Enqueue packet into rx_thread and wake it up.
+ *
+ * Returns: QDF_STATUS_SUCCESS on success or qdf error code on
+ * failure
+ */
+static QDF_STATUS dp_rx_tm_thread_enqueue(struct dp_rx_thread *rx_thread,
+					  qdf_nbuf_t nbuf_list)
+{
+	uint8_t reo_ring_num = QDF_NBUF_CB_RX_CTX_ID(nbuf_list);
+	uint32_t nbuf_queued, prev_qlen;
+	QDF_STATUS status;
+
+	status = dp_rx_tm_thread_check_enqueue(rx_thread, reo_ring_num);
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
+	prev_qlen = qdf_nbuf_queue_head_qlen(&rx_thread->nbuf_queue);
+	nbuf_queued = dp_rx_tm_thread_queue_nbuf_list(rx_thread, nbuf_list);
+	dp_rx_tm_thread_post(rx_thread, reo_ring_num, nbuf_queued, prev_qlen);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -424,6 +548,47 @@ static void dp_rx_thread_adjust_nbuf_list(qdf_nbuf_t head)
 	}
 }
 
+/**
+ * dp_rx_tm_thread_dequeue_flow() - dequeue the oldest nbuf list whose flow
+ *				    is not held by a thief
+ * @rx_thread: rx_thread from which the nbuf needs to be dequeued
+ *
+ * Used in work stealing mode. Entries carrying the key of a batch that
+ * another thread stole and is still delivering are left in the queue, and
+ * the key of the dequeued entry is published so that it is not stolen
+ * while this thread delivers it, nor while its packets may still sit in
+ * this thread's GRO lists.
+ *
+ * Returns: nbuf dequeued from rx_thread, NULL if nothing can be dequeued
+ */
+static qdf_nbuf_t dp_rx_tm_thread_dequeue_flow(struct dp_rx_thread *rx_thread)
+{
+	qdf_nbuf_t nbuf, tmp_nbuf, head = NULL;
+	ol_txrx_soc_handle soc;
+	int stolen_key;
+	bool gro;
+
+	soc = dp_rx_tm_get_soc_handle(rx_thread->rtm_handle_cmn);
+	gro = cdp_cfg_get(soc, cfg_dp_gro_enable);
+
+	qdf_nbuf_queue_head_lock(&rx_thread->nbuf_queue);
+	stolen_key = qdf_atomic_read(&rx_thread->stolen_key);
+	QDF_NBUF_QUEUE_WALK_SAFE(&rx_thread->nbuf_queue, nbuf, tmp_nbuf) {
+		if (dp_rx_tm_flow_key(nbuf) == stolen_key)
+			continue;
+		qdf_nbuf_unlink_no_lock(nbuf, &rx_thread->nbuf_queue);
+		head = nbuf;
+		break;
+	}
+	rx_thread->inflight_key = head ? dp_rx_tm_flow_key(head) :
+					 DP_RX_TM_STEAL_KEY_NONE;
+	if (head && gro)
+		rx_thread->gro_pending_keys |= 1ULL << rx_thread->inflight_key;
+	qdf_nbuf_queue_head_unlock(&rx_thread->nbuf_queue);
+
+	return head;
+}
+
 /**
  * dp_rx_tm_thread_dequeue() - dequeue nbuf list from rx_thread
  * @rx_thread: rx_thread from which the nbuf needs to be dequeued
@@ -434,7 +599,10 @@ static qdf_nbuf_t dp_rx_tm_thread_dequeue(struct dp_rx_thread *rx_thread)
 {
 	qdf_nbuf_t head;
 
-	head = qdf_nbuf_queue_head_dequeue(&rx_thread->nbuf_queue);
+	if (dp_rx_tm_work_stealing(rx_thread))
+		head = dp_rx_tm_thread_dequeue_flow(rx_thread);
+	else
+		head = qdf_nbuf_queue_head_dequeue(&rx_thread->nbuf_queue);
 	dp_rx_thread_adjust_nbuf_list(head);
 
 	dp_debug("Dequeued %pK nbuf_list", head);
@@ -465,6 +633,45 @@ static inline bool dp_rx_thread_should_yield(struct dp_rx_thread *rx_thread,
 }
 #endif
 
+/**
+ * dp_rx_thread_deliver_nbuf_list() - send a dequeued nbuf list to the stack
+ * @rx_thread: rx_thread delivering the nbuf list
+ * @soc: ol_txrx_soc_handle object
+ * @nbuf_list: nbuf list to be delivered
+ *
+ * Returns: number of packets in the nbuf list
+ */
+static uint32_t dp_rx_thread_deliver_nbuf_list(struct dp_rx_thread *rx_thread,
+					       ol_txrx_soc_handle soc,
+					       qdf_nbuf_t nbuf_list)
+{
+	uint8_t vdev_id;
+	ol_txrx_rx_fp stack_fn;
+	ol_osif_vdev_handle osif_vdev;
+	uint32_t num_list_elements;
+
+	num_list_elements = QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(nbuf_list);
+	/* count aggregated RX frame into stats */
+	num_list_elements += qdf_nbuf_get_gso_segs(nbuf_list);
+	rx_thread->stats.nbuf_dequeued += num_list_elements;
+
+	vdev_id = QDF_NBUF_CB_RX_VDEV_ID(nbuf_list);
+	cdp_get_os_rx_handles_from_vdev(soc, vdev_id, &stack_fn,
+					&osif_vdev);
+	dp_debug("rx_thread %pK sending packet %pK to stack",
+		 rx_thread, nbuf_list);
+	if (!stack_fn || !osif_vdev ||
+	    QDF_STATUS_SUCCESS != stack_fn(osif_vdev, nbuf_list)) {
+		rx_thread->stats.dropped_invalid_os_rx_handles +=
+						num_list_elements;
+		qdf_nbuf_list_free(nbuf_list);
+	} else {
+		rx_thread->stats.nbuf_sent_to_stack += num_list_elements;
+	}
+
+	return num_list_elements;
+}
+
 /**
  * dp_rx_thread_process_nbufq() - process nbuf queue of a thread
  * @rx_thread: rx_thread whose nbuf queue needs to be processed
@@ -474,11 +681,7 @@ static inline bool dp_rx_thread_should_yield(struct dp_rx_thread *rx_thread,
 static int dp_rx_thread_process_nbufq(struct dp_rx_thread *rx_thread)
 {
 	qdf_nbuf_t nbuf_list;
-	uint8_t vdev_id;
-	ol_txrx_rx_fp stack_fn;
-	ol_osif_vdev_handle osif_vdev;
 	ol_txrx_soc_handle soc;
-	uint32_t num_list_elements = 0;
 	uint32_t iterates = 0;
 
 	struct dp_txrx_handle_cmn *txrx_handle_cmn;
@@ -498,27 +701,8 @@ static int dp_rx_thread_process_nbufq(struct dp_rx_thread *rx_thread)
 
 	nbuf_list = dp_rx_tm_thread_dequeue(rx_thread);
 	while (nbuf_list) {
-		num_list_elements =
-			QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(nbuf_list);
-		/* count aggregated RX frame into stats */
-		num_list_elements += qdf_nbuf_get_gso_segs(nbuf_list);
-		rx_thread->stats.nbuf_dequeued += num_list_elements;
-		iterates += num_list_elements;
-
-		vdev_id = QDF_NBUF_CB_RX_VDEV_ID(nbuf_list);
-		cdp_get_os_rx_handles_from_vdev(soc, vdev_id, &stack_fn,
-						&osif_vdev);
-		dp_debug("rx_thread %pK sending packet %pK to stack",
-			 rx_thread, nbuf_list);
-		if (!stack_fn || !osif_vdev ||
-		    QDF_STATUS_SUCCESS != stack_fn(osif_vdev, nbuf_list)) {
-			rx_thread->stats.dropped_invalid_os_rx_handles +=
-							num_list_elements;
-			qdf_nbuf_list_free(nbuf_list);
-		} else {
-			rx_thread->stats.nbuf_sent_to_stack +=
-							num_list_elements;
-		}
+		iterates += dp_rx_thread_deliver_nbuf_list(rx_thread, soc,
+							   nbuf_list);
 		if (qdf_unlikely(dp_rx_thread_should_yield(rx_thread,
 							   iterates))) {
 			rx_thread->stats.rx_nbufq_loop_yield++;
@@ -556,6 +740,15 @@ static void dp_rx_thread_gro_flush(struct dp_rx_thread *rx_thread,
 						   gro_flush_code);
 	qdf_local_bh_enable();
 	rx_thread->stats.gro_flushes++;
+
+	/* a low throughput flush leaves the GRO lists alone */
+	if (gro_flush_code == DP_RX_GRO_LOW_TPUT_FLUSH ||
+	    !rx_thread->gro_pending_keys)
+		return;
+
+	qdf_nbuf_queue_head_lock(&rx_thread->nbuf_queue);
+	rx_thread->gro_pending_keys = 0;
+	qdf_nbuf_queue_head_unlock(&rx_thread->nbuf_queue);
 }
 
 /**
@@ -576,6 +769,129 @@ dp_rx_should_flush(struct dp_rx_thread *rx_thread)
 	return gro_flush_code;
 }
 
+/**
+ * dp_rx_thread_rebind_nbuf_list() - move a stolen nbuf list to a rx_thread
+ * @rx_thread: rx_thread which stole the nbuf list
+ * @nbuf_list: stolen nbuf list
+ *
+ * The GRO NAPI context of a packet is picked from its RX context id, so
+ * point the stolen packets at the thief and keep them off the NAPI the
+ * victim thread is using concurrently.
+ *
+ * Return: None
+ */
+static void dp_rx_thread_rebind_nbuf_list(struct dp_rx_thread *rx_thread,
+					  qdf_nbuf_t nbuf_list)
+{
+	qdf_nbuf_t nbuf;
+
+	for (nbuf = nbuf_list; nbuf; nbuf = qdf_nbuf_next(nbuf))
+		QDF_NBUF_CB_RX_CTX_ID(nbuf) = rx_thread->id;
+}
+
+/**
+ * dp_rx_thread_steal() - steal a flow batch from the most loaded rx_thread
+ * @rx_thread: idle rx_thread doing the stealing
+ *
+ * Takes the oldest queued nbuf lists of one flow key from the rx_thread
+ * with the longest queue and delivers them from @rx_thread. The key being
+ * delivered by the victim is never taken, nor any key the victim delivered
+ * since its last GRO flush since packets of that flow may still be held in
+ * its GRO lists. Until the stolen batch and the GRO state it built up have
+ * been flushed to the stack, the victim holds back its own entries with
+ * that key, so the flow stays in order.
+ *
+ * Return: true if a batch was stolen and delivered
+ */
+static bool dp_rx_thread_steal(struct dp_rx_thread *rx_thread)
+{
+	struct dp_rx_tm_handle *rx_tm_hdl =
+		(struct dp_rx_tm_handle *)rx_thread->rtm_handle_cmn;
+	struct dp_rx_thread *victim = NULL, *thread;
+	qdf_nbuf_t nbuf, tmp_nbuf, stolen_head = NULL, stolen_tail = NULL;
+	uint32_t qlen, max_qlen = 0;
+	uint32_t num_lists = 0, num_nbuf = 0;
+	ol_txrx_soc_handle soc;
+	int key = DP_RX_TM_STEAL_KEY_NONE;
+	int nbuf_key;
+	int i;
+
+	for (i = 0; i < rx_tm_hdl->num_dp_rx_threads; i++) {
+		thread = rx_tm_hdl->rx_thread[i];
+		if (!thread || thread == rx_thread)
+			continue;
+		qlen = qdf_nbuf_queue_head_qlen(&thread->nbuf_queue);
+		if (qlen > max_qlen) {
+			max_qlen = qlen;
+			victim = thread;
+		}
+	}
+
+	if (!victim || max_qlen < DP_RX_TM_STEAL_QLEN_THRESH)
+		return false;
+
+	qdf_nbuf_queue_head_lock(&victim->nbuf_queue);
+	if (qdf_atomic_read(&victim->stolen_key) != DP_RX_TM_STEAL_KEY_NONE)
+		goto unlock;
+
+	QDF_NBUF_QUEUE_WALK_SAFE(&victim->nbuf_queue, nbuf, tmp_nbuf) {
+		nbuf_key = dp_rx_tm_flow_key(nbuf);
+		if (key == DP_RX_TM_STEAL_KEY_NONE) {
+			if (nbuf_key == victim->inflight_key ||
+			    victim->gro_pending_keys & (1ULL << nbuf_key))
+				continue;
+			key = nbuf_key;
+		} else if (nbuf_key != key) {
+			continue;
+		}
+
+		qdf_nbuf_unlink_no_lock(nbuf, &victim->nbuf_queue);
+		if (stolen_tail)
+			qdf_nbuf_set_next(stolen_tail, nbuf);
+		else
+			stolen_head = nbuf;
+		stolen_tail = nbuf;
+
+		if (++num_lists >= DP_RX_TM_STEAL_MAX_LISTS)
+			break;
+	}
+
+	if (num_lists)
+		qdf_atomic_set(&victim->stolen_key, key);
+unlock:
+	qdf_nbuf_queue_head_unlock(&victim->nbuf_queue);
+
+	if (!num_lists) {
+		rx_thread->stats.steal_fail++;
+		return false;
+	}
+
+	soc = dp_rx_tm_get_soc_handle(rx_thread->rtm_handle_cmn);
+	while (stolen_head) {
+		nbuf = stolen_head;
+		stolen_head = qdf_nbuf_next(nbuf);
+		qdf_nbuf_set_next(nbuf, NULL);
+		dp_rx_thread_adjust_nbuf_list(nbuf);
+		dp_rx_thread_rebind_nbuf_list(rx_thread, nbuf);
+		num_nbuf += dp_rx_thread_deliver_nbuf_list(rx_thread, soc,
+							   nbuf);
+	}
+
+	if (cdp_cfg_get(soc, cfg_dp_gro_enable))
+		dp_rx_thread_gro_flush(rx_thread, DP_RX_GRO_NORMAL_FLUSH);
+
+	/* hand the flow back and let the victim drain what it held back */
+	qdf_atomic_set(&victim->stolen_key, DP_RX_TM_STEAL_KEY_NONE);
+	qdf_set_bit(RX_POST_EVENT, &victim->event_flag);
+	qdf_wake_up_interruptible(&victim->wait_q);
+
+	rx_thread->stats.steal++;
+	rx_thread->stats.stolen_nbuf += num_nbuf;
+	qdf_atomic_inc(&victim->stats.stolen_from);
+
+	return true;
+}
+
 /**
  * dp_rx_thread_sub_loop() - rx thread subloop
  * @rx_thread: rx_thread to be processed
@@ -608,6 +924,15 @@ static int dp_rx_thread_sub_loop(struct dp_rx_thread *rx_thread, bool *shutdown)
 
 		dp_rx_thread_process_nbufq(rx_thread);
 
+		/*
+		 * Out of own work, help the busiest thread. Come back around
+		 * after a successful steal to check the own queue first.
+		 */
+		if (dp_rx_tm_work_stealing(rx_thread) &&
+		    !qdf_nbuf_queue_head_qlen(&rx_thread->nbuf_queue) &&
+		    dp_rx_thread_steal(rx_thread))
+			qdf_set_bit(RX_POST_EVENT, &rx_thread->event_flag);
+
 		gro_flush_code = dp_rx_should_flush(rx_thread);
 		/* Only flush when gro_flush_code is either
 		 * DP_RX_GRO_NORMAL_FLUSH or DP_RX_GRO_LOW_TPUT_FLUSH
@@ -847,6 +1172,11 @@ static QDF_STATUS dp_rx_tm_thread_init(struct dp_rx_thread *rx_thread,
 	qdf_event_create(&rx_thread->shutdown_event);
 	qdf_event_create(&rx_thread->vdev_del_event);
 	qdf_atomic_init(&rx_thread->gro_flush_ind);
+	rx_thread->inflight_key = DP_RX_TM_STEAL_KEY_NONE;
+	rx_thread->gro_pending_keys = 0;
+	qdf_atomic_init(&rx_thread->stats.stolen_from);
+	qdf_atomic_init(&rx_thread->stolen_key);
+	qdf_atomic_set(&rx_thread->stolen_key, DP_RX_TM_STEAL_KEY_NONE);
 	qdf_init_waitqueue_head(&rx_thread->wait_q);
 	qdf_scnprintf(thread_name, sizeof(thread_name), "dp_rx_thread_%u", id);
 	dp_info("%s %u", thread_name, id);
@@ -964,8 +1294,11 @@ QDF_STATUS dp_rx_tm_init(struct dp_rx_tm_handle *rx_tm_hdl,
 
 	rx_tm_hdl->num_dp_rx_threads = num_dp_rx_threads;
 	rx_tm_hdl->state = DP_RX_THREADS_INVALID;
+	if (num_dp_rx_threads < 2)
+		rx_tm_hdl->work_stealing = false;
 
-	dp_info("initializing %u threads", num_dp_rx_threads);
+	dp_info("initializing %u threads work stealing %u", num_dp_rx_threads,
+		rx_tm_hdl->work_stealing);
 
 	/* allocate an array to contain the DP RX thread pointers */
 	rx_tm_hdl->rx_thread = qdf_mem_malloc(num_dp_rx_threads *
@@ -1408,6 +1741,52 @@ static uint8_t dp_rx_tm_select_thread(struct dp_rx_tm_handle *rx_tm_hdl,
 	return selected_rx_thread;
 }
 
+/**
+ * dp_rx_tm_thread_enqueue_flows() - enqueue nbuf list as per flow batches
+ * @rx_thread: rx_thread in which the nbufs need to be queued
+ * @nbuf_list: list of packets to be queued into the thread
+ *
+ * Work stealing moves whole queued nbuf lists between threads, so each of
+ * them must carry a single flow key. Split @nbuf_list into runs of
+ * consecutive nbufs sharing a flow key and queue every run on its own,
+ * then account the enqueue and wake the thread once.
+ *
+ * Return: None
+ */
+static void dp_rx_tm_thread_enqueue_flows(struct dp_rx_thread *rx_thread,
+					  qdf_nbuf_t nbuf_list)
+{
+	uint8_t reo_ring_num = QDF_NBUF_CB_RX_CTX_ID(nbuf_list);
+	qdf_nbuf_t head, tail, next;
+	uint32_t num_elements, nbuf_queued = 0, prev_qlen;
+	int key;
+
+	if (QDF_IS_STATUS_ERROR(dp_rx_tm_thread_check_enqueue(rx_thread,
+							      reo_ring_num)))
+		return;
+
+	prev_qlen = qdf_nbuf_queue_head_qlen(&rx_thread->nbuf_queue);
+	head = nbuf_list;
+	while (head) {
+		key = dp_rx_tm_flow_key(head);
+		num_elements = 1;
+		tail = head;
+		next = qdf_nbuf_next(tail);
+		while (next && dp_rx_tm_flow_key(next) == key) {
+			tail = next;
+			next = qdf_nbuf_next(tail);
+			num_elements++;
+		}
+
+		qdf_nbuf_set_next(tail, NULL);
+		QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(head) = num_elements;
+		nbuf_queued += dp_rx_tm_thread_queue_nbuf_list(rx_thread, head);
+		head = next;
+	}
+
+	dp_rx_tm_thread_post(rx_thread, reo_ring_num, nbuf_queued, prev_qlen);
+}
+
 QDF_STATUS dp_rx_tm_enqueue_pkt(struct dp_rx_tm_handle *rx_tm_hdl,
 				qdf_nbuf_t nbuf_list)
 {
@@ -1416,8 +1795,13 @@ QDF_STATUS dp_rx_tm_enqueue_pkt(struct dp_rx_tm_handle *rx_tm_hdl,
 	selected_thread_id =
 		dp_rx_tm_select_thread(rx_tm_hdl,
 				       QDF_NBUF_CB_RX_CTX_ID(nbuf_list));
-	dp_rx_tm_thread_enqueue(rx_tm_hdl->rx_thread[selected_thread_id],
+	if (rx_tm_hdl->work_stealing)
+		dp_rx_tm_thread_enqueue_flows(
+				rx_tm_hdl->rx_thread[selected_thread_id],
 				nbuf_list);
+	else
+		dp_rx_tm_thread_enqueue(rx_tm_hdl->rx_thread[selected_thread_id],
+					nbuf_list);
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -1552,6 +1936,8 @@ QDF_STATUS dp_txrx_init(ol_txrx_soc_handle soc, uint8_t pdev_id,
 	dp_info("%d RX threads in use", num_dp_rx_threads);
 
 	if (dp_ext_hdl->config.enable_rx_threads) {
+		dp_ext_hdl->rx_tm_hdl.work_stealing =
+			dp_ext_hdl->config.enable_rx_work_stealing;
 		qdf_status = dp_rx_tm_init(&dp_ext_hdl->rx_tm_hdl,
 					   num_dp_rx_threads);
 	}
@@ -28,6 +28,7 @@
 #include "hif.h"
 #include <qdf_status.h>
 #include <qdf_nbuf.h>
+#include <dp_tx.h>
 
 /**
  * dp_swlm_is_tput_thresh_reached() - Calculate the current tx and rx TPUT
@@ -130,11 +131,168 @@ coalescing_fail:
 		return 0;
 	}
 
+	dp_swlm_tcl_session_add(&params->tcl[rid], curr_time);
 	qdf_timer_mod(&params->tcl[rid].flush_timer, 1);
 
 	return 1;
 }
 
+/**
+ * dp_swlm_ewma_update() - Update a moving average with a new sample
+ * @avg: moving average, 0 if no sample was taken yet
+ * @sample: new sample
+ *
+ * Returns: none
+ */
+static inline void dp_swlm_ewma_update(uint32_t *avg, uint32_t sample)
+{
+	if (!*avg) {
+		*avg = sample;
+		return;
+	}
+
+	*avg = *avg - (*avg >> DP_SWLM_ADAPT_EWMA_SHIFT) +
+		(sample >> DP_SWLM_ADAPT_EWMA_SHIFT);
+}
+
+/**
+ * dp_swlm_tcl_update_depth() - Derive the coalescing depth and delay budget
+ *				of a TCL ring from the measured latencies
+ * @soc: Datapath global soc handle
+ * @rid: TCL ring id
+ *
+ * Returns: none
+ */
+static void dp_swlm_tcl_update_depth(struct dp_soc *soc, uint8_t rid)
+{
+	struct dp_swlm_params *params = &soc->swlm.params;
+	struct dp_swlm_tcl_params *tcl = &params->tcl[rid];
+	uint32_t budget, depth;
+
+	budget = tcl->comp_lat_avg / DP_SWLM_ADAPT_DELAY_DIV;
+	budget = qdf_min(budget, params->time_flush_thresh);
+	if (budget < DP_SWLM_ADAPT_DELAY_MIN)
+		budget = DP_SWLM_ADAPT_DELAY_MIN;
+
+	if (tcl->iat_avg)
+		depth = qdf_min(budget / tcl->iat_avg,
+				(uint32_t)DP_SWLM_ADAPT_DEPTH_MAX);
+	else
+		depth = DP_SWLM_ADAPT_DEPTH_MAX;
+
+	tcl->delay_budget = budget;
+	tcl->coalesce_depth = depth;
+}
+
+/**
+ * dp_swlm_tcl_sample_latency() - Start a TX completion latency sample
+ * @tcl: TCL ring params
+ * @tx_desc: TX descriptor of the current packet
+ * @curr_time: Current timestamp in us
+ *
+ * Only one descriptor per ring is sampled at a time. A sample lost on the
+ * way (FW completion, vdev detach) is dropped after a timeout.
+ *
+ * Returns: none
+ */
+static inline void
+dp_swlm_tcl_sample_latency(struct dp_swlm_tcl_params *tcl,
+			   struct dp_tx_desc_s *tx_desc, uint64_t curr_time)
+{
+	if (tcl->sample_desc &&
+	    curr_time - tcl->sample_time < DP_SWLM_ADAPT_SAMPLE_TIMEOUT)
+		return;
+
+	tcl->sample_time = curr_time;
+	tcl->sample_desc = tx_desc;
+	tx_desc->flags |= DP_TX_DESC_FLAG_SWLM_SAMPLE;
+}
+
+/**
+ * dp_swlm_can_tcl_wr_coalesce_adaptive() - Latency feedback variant of
+ *					    dp_swlm_can_tcl_wr_coalesce()
+ * @soc: Datapath global soc handle
+ * @tcl_data: priv data for tcl coalescing
+ *
+ * The coalescing depth of each TCL ring is learnt from the packet
+ * inter-arrival time and the measured TX completion latency instead of
+ * fixed throughput thresholds: sparse traffic is never delayed, while a
+ * bulk flow coalesces as many writes as fit in the delay budget.
+ *
+ * Returns: 1 if the current TCL write is to be coalesced
+ *	    0, if the current TCL write is to be processed.
+ */
+static int
+dp_swlm_can_tcl_wr_coalesce_adaptive(struct dp_soc *soc,
+				     struct dp_swlm_tcl_data *tcl_data)
+{
+	u64 curr_time = qdf_get_log_timestamp_usecs();
+	struct dp_swlm *swlm = &soc->swlm;
+	uint8_t rid = tcl_data->ring_id;
+	struct dp_swlm_params *params = &soc->swlm.params;
+	struct dp_swlm_tcl_params *tcl = &params->tcl[rid];
+	uint64_t iat;
+
+	iat = curr_time - tcl->last_pkt_time;
+	tcl->last_pkt_time = curr_time;
+	dp_swlm_ewma_update(&tcl->iat_avg,
+			    qdf_min(iat, (uint64_t)DP_SWLM_ADAPT_IAT_MAX));
+	dp_swlm_tcl_sample_latency(tcl, tcl_data->tx_desc, curr_time);
+
+	if (curr_time >= tcl->expire_time) {
+		tcl->expire_time = curr_time + params->sampling_time;
+		dp_swlm_tcl_update_depth(soc, rid);
+	}
+
+	if (tcl->coalesce_depth < 2) {
+		DP_STATS_INC(swlm, tcl[rid].depth_too_low, 1);
+		goto coalescing_fail;
+	}
+
+	if (tcl->pkts_coalesced + 1 >= tcl->coalesce_depth) {
+		DP_STATS_INC(swlm, tcl[rid].depth_reached, 1);
+		goto coalescing_fail;
+	}
+
+	if (tcl->pkts_coalesced &&
+	    curr_time - tcl->session_start_time >= tcl->delay_budget) {
+		DP_STATS_INC(swlm, tcl[rid].time_thresh_reached, 1);
+		goto coalescing_fail;
+	}
+
+	dp_swlm_tcl_session_add(tcl, curr_time);
+	qdf_timer_mod(&tcl->flush_timer, 1);
+
+	return 1;
+
+coalescing_fail:
+	dp_swlm_tcl_reset_session_data(soc, rid);
+	return 0;
+}
+
+void dp_swlm_tx_comp_sample(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc)
+{
+	struct dp_swlm_params *params = &soc->swlm.params;
+	struct dp_swlm *swlm = &soc->swlm;
+	uint64_t lat;
+	int i;
+
+	tx_desc->flags &= ~DP_TX_DESC_FLAG_SWLM_SAMPLE;
+
+	for (i = 0; i < soc->num_tcl_data_rings; i++) {
+		if (params->tcl[i].sample_desc != tx_desc)
+			continue;
+
+		lat = qdf_get_log_timestamp_usecs() - params->tcl[i].sample_time;
+		params->tcl[i].sample_desc = NULL;
+		dp_swlm_ewma_update(&params->tcl[i].comp_lat_avg,
+				    qdf_min(lat, (uint64_t)
+					    DP_SWLM_ADAPT_SAMPLE_TIMEOUT));
+		DP_STATS_INC(swlm, tcl[i].lat_samples, 1);
+		break;
+	}
+}
+
 QDF_STATUS dp_print_swlm_stats(struct dp_soc *soc)
 {
 	struct dp_swlm *swlm = &soc->swlm;
@@ -162,6 +320,32 @@ QDF_STATUS dp_print_swlm_stats(struct dp_soc *soc)
 			swlm->stats.tcl[i].time_thresh_reached);
 		dp_info("Coalesce fail (TPUT sampling fail): %d",
 			swlm->stats.tcl[i].tput_criteria_fail);
+		dp_info("Coalesce fail (socket priority): %d",
+			swlm->stats.tcl[i].prio_bypass);
+		dp_info("Coalesce fail (depth reached): %d",
+			swlm->stats.tcl[i].depth_reached);
+		dp_info("Coalesce fail (depth too low): %d",
+			swlm->stats.tcl[i].depth_too_low);
+		dp_info("Adaptive: depth %u delay budget %u us inter-arrival %u us completion latency %u us (%u samples)",
+			swlm->params.tcl[i].coalesce_depth,
+			swlm->params.tcl[i].delay_budget,
+			swlm->params.tcl[i].iat_avg,
+			swlm->params.tcl[i].comp_lat_avg,
+			swlm->stats.tcl[i].lat_samples);
+		dp_info("Batch size (1, 2-3, 4-7, 8-15, 16-31, 32+): %u %u %u %u %u %u",
+			swlm->stats.tcl[i].batch_size_hist[0],
+			swlm->stats.tcl[i].batch_size_hist[1],
+			swlm->stats.tcl[i].batch_size_hist[2],
+			swlm->stats.tcl[i].batch_size_hist[3],
+			swlm->stats.tcl[i].batch_size_hist[4],
+			swlm->stats.tcl[i].batch_size_hist[5]);
+		dp_info("Added delay us (<50, <100, <250, <500, <1000, 1000+): %u %u %u %u %u %u",
+			swlm->stats.tcl[i].delay_hist[0],
+			swlm->stats.tcl[i].delay_hist[1],
+			swlm->stats.tcl[i].delay_hist[2],
+			swlm->stats.tcl[i].delay_hist[3],
+			swlm->stats.tcl[i].delay_hist[4],
+			swlm->stats.tcl[i].delay_hist[5]);
 	}
 
 	return QDF_STATUS_SUCCESS;
@@ -171,6 +355,10 @@ static struct dp_swlm_ops dp_latency_mgr_ops = {
 	.tcl_wr_coalesce_check = dp_swlm_can_tcl_wr_coalesce,
 };
 
+static struct dp_swlm_ops dp_latency_mgr_adaptive_ops = {
+	.tcl_wr_coalesce_check = dp_swlm_can_tcl_wr_coalesce_adaptive,
+};
+
 /**
  * dp_swlm_tcl_flush_timer() - Timer handler for tcl register write coalescing
  * @arg: private data of the timer
@@ -190,6 +378,10 @@ static void dp_swlm_tcl_flush_timer(void *arg)
 		return;
 	}
 
+	if (tcl->pkts_coalesced)
+		dp_swlm_tcl_record_flush(soc, tcl->ring_id, tcl->pkts_coalesced,
+					 qdf_get_log_timestamp_usecs());
+
 	DP_STATS_INC(swlm, tcl[tcl->ring_id].timer_flush_success, 1);
 }
 
@@ -211,6 +403,7 @@ static inline QDF_STATUS dp_soc_swlm_tcl_attach(struct dp_soc *soc)
 	swlm->params.time_flush_thresh = DP_SWLM_TCL_TIME_FLUSH_THRESH;
 	swlm->params.tx_thresh_multiplier = DP_SWLM_TCL_TX_THRESH_MULTIPLIER;
 	swlm->params.tx_pkt_thresh = DP_SWLM_TCL_TX_PKT_THRESH;
+	swlm->params.bypass_prio = DP_SWLM_TCL_BYPASS_PRIO;
 
 	for (i = 0; i < soc->num_tcl_data_rings; i++) {
 		swlm->params.tcl[i].soc = soc;
@@ -243,6 +436,33 @@ static inline QDF_STATUS dp_soc_swlm_tcl_detach(struct dp_swlm *swlm,
 	return QDF_STATUS_SUCCESS;
 }
 
+QDF_STATUS dp_soc_swlm_set_mode(struct dp_soc *soc, uint8_t mode)
+{
+	struct dp_swlm *swlm = &soc->swlm;
+
+	switch (mode) {
+	case DP_SWLM_MODE_DISABLE:
+		swlm->is_enabled = false;
+		break;
+	case DP_SWLM_MODE_FIXED:
+		swlm->ops = &dp_latency_mgr_ops;
+		swlm->is_enabled = true;
+		break;
+	case DP_SWLM_MODE_ADAPTIVE:
+		swlm->ops = &dp_latency_mgr_adaptive_ops;
+		swlm->is_enabled = true;
+		break;
+	default:
+		dp_err("Invalid SWLM mode %u", mode);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	swlm->mode = mode;
+	dp_info("SWLM mode %u", mode);
+
+	return QDF_STATUS_SUCCESS;
+}
+
 QDF_STATUS dp_soc_swlm_attach(struct dp_soc *soc)
 {
 	struct wlan_cfg_dp_soc_ctxt *cfg = soc->wlan_cfg_ctx;
@@ -257,14 +477,12 @@ QDF_STATUS dp_soc_swlm_attach(struct dp_soc *soc)
 		return QDF_STATUS_E_NOSUPPORT;
 	}
 
-	swlm->ops = &dp_latency_mgr_ops;
-
 	ret = dp_soc_swlm_tcl_attach(soc);
 	if (QDF_IS_STATUS_ERROR(ret))
 		goto swlm_tcl_setup_fail;
 
 	swlm->is_init = true;
-	swlm->is_enabled = true;
+	dp_soc_swlm_set_mode(soc, wlan_cfg_get_swlm_mode(cfg));
 
 	return QDF_STATUS_SUCCESS;
 
@@ -72,11 +72,13 @@
 #define CFG_ENABLE_NAPI			BIT(2)
 #define CFG_ENABLE_DYNAMIC_RPS		BIT(3)
 #define CFG_ENABLE_DP_RX_THREADS	BIT(4)
+#define CFG_ENABLE_DP_RX_WORK_STEALING	BIT(5)
 #define CFG_RX_MODE_MAX (CFG_ENABLE_RX_THREAD | \
 					  CFG_ENABLE_RPS | \
 					  CFG_ENABLE_NAPI | \
 					  CFG_ENABLE_DYNAMIC_RPS | \
-					  CFG_ENABLE_DP_RX_THREADS)
+					  CFG_ENABLE_DP_RX_THREADS | \
+					  CFG_ENABLE_DP_RX_WORK_STEALING)
 #ifdef MDM_PLATFORM
 #define CFG_RX_MODE_DEFAULT 0
 #elif defined(HELIUMPLUS)
@@ -833,6 +835,9 @@
  * rx_thread for stack. Single threaded.
  * CFG_ENABLE_DP_RX_THREAD | CFG_ENABLE_NAPI (rx_mode=10) - NAPI for bottom
  * half, dp_rx_thread for stack processing. Supports multiple rx threads.
+ * CFG_ENABLE_DP_RX_WORK_STEALING | CFG_ENABLE_DP_RX_THREAD | CFG_ENABLE_NAPI
+ * (rx_mode=52) - as above, and idle dp_rx_threads steal flow batches from
+ * overloaded ones.
  *
  * Usage: Internal
  *
@@ -1293,9 +1298,34 @@
 	CFG_INI_BOOL("dp_rx_fisa_lru_del_enable", true, \
 		     "Enable/Disable DP Rx FISA LRU deletion")
 
+/*
+ * <ini>
+ * dp_rx_fisa_udp_gso_fraglist - Control GSO type of FISA UDP aggregates
+ * @Min: 0
+ * @Max: 1
+ * @Default: 0
+ *
+ * This ini marks the UDP aggregates delivered by FISA for fraglist GSO
+ * instead of plain UDP L4 GSO. Fraglist GSO is cheaper to segment for
+ * sockets without UDP_GRO, but UDP_GRO sockets then no longer receive a
+ * whole aggregate per recvmsg. Only honored on kernels with fraglist GSO.
+ *
+ * Related: dp_rx_fisa_enable
+ *
+ * Supported Feature: STA,P2P and SAP IPA disabled terminating
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_RX_FISA_UDP_GSO_FRAGLIST \
+	CFG_INI_BOOL("dp_rx_fisa_udp_gso_fraglist", false, \
+		     "Enable/Disable DP Rx FISA UDP fraglist GSO")
+
 #define CFG_DP_FISA \
 	CFG(CFG_DP_RX_FISA_ENABLE) \
-	CFG(CFG_DP_RX_FISA_LRU_DEL_ENABLE)
+	CFG(CFG_DP_RX_FISA_LRU_DEL_ENABLE) \
+	CFG(CFG_DP_RX_FISA_UDP_GSO_FRAGLIST)
 #else
 #define CFG_DP_FISA
 #endif
@@ -325,6 +325,14 @@ bool ucfg_dp_is_rx_common_thread_enabled(struct wlan_objmgr_psoc *psoc);
  */
 bool ucfg_dp_is_rx_threads_enabled(struct wlan_objmgr_psoc *psoc);
 
+/**
+ * ucfg_dp_is_rx_work_stealing_enabled() - Get DP RX threads work stealing info
+ * @psoc: PSOC mapped to DP context
+ *
+ * Return: true if idle DP RX threads steal flow batches from busy ones
+ */
+bool ucfg_dp_is_rx_work_stealing_enabled(struct wlan_objmgr_psoc *psoc);
+
 /**
  * ucfg_dp_rx_ol_init() - Initialize Rx offload mode (LRO or GRO)
  * @psoc: PSOC mapped to DP context
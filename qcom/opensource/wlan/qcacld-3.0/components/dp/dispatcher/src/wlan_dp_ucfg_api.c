@@ -1002,6 +1002,19 @@ bool ucfg_dp_is_rx_threads_enabled(struct wlan_objmgr_psoc *psoc)
 	return dp_ctx->enable_dp_rx_threads;
 }
 
+bool ucfg_dp_is_rx_work_stealing_enabled(struct wlan_objmgr_psoc *psoc)
+{
+	struct wlan_dp_psoc_context *dp_ctx;
+
+	dp_ctx = dp_psoc_get_priv(psoc);
+	if (!dp_ctx) {
+		dp_err("DP context not found");
+		return false;
+	}
+
+	return dp_ctx->enable_dp_rx_work_stealing;
+}
+
 #ifdef WLAN_FEATURE_RX_SOFTIRQ_TIME_LIMIT
 /**
  * dp_get_config_rx_softirq_limits() - Update DP rx softirq limit config
@@ -28,6 +28,7 @@
 #include "wlan_cm_roam_public_struct.h"
 #include "wlan_cm_public_struct.h"
 #include "wlan_mlme_vdev_mgr_interface.h"
+#include <wlan_scan_api.h>
 #include "connection_mgr/core/src/wlan_cm_roam.h"
 #include "connection_mgr/core/src/wlan_cm_sm.h"
 #include "connection_mgr/core/src/wlan_cm_main_api.h"
@@ -332,8 +333,7 @@ static void cm_flush_invalid_preauth_ap(struct cnx_mgr *cm_ctx,
 
 		if (!is_valid) {
 			qdf_list_remove_node(candidate_list, cur_node);
-			util_scan_free_cache_entry(scan_node->entry);
-			qdf_mem_free(scan_node);
+			wlan_scan_free_result_node(scan_node);
 		}
 
 		cur_node = next_node;
@@ -73,6 +73,10 @@
 #define WLAN_DSC_TEST (1)
 #endif
 
+#ifdef CONFIG_SCAN_DB_TEST
+#define WLAN_SCAN_DB_TEST (1)
+#endif
+
 #ifdef CONFIG_BERYLLIUM
 #define DP_OFFLOAD_FRAME_WITH_SW_EXCEPTION (1)
 #endif
@@ -89,6 +93,10 @@
 #define WLAN_HASHTABLE_TEST (1)
 #endif
 
+#ifdef CONFIG_QDF_TEST
+#define WLAN_OBJPOOL_TEST (1)
+#endif
+
 #ifdef CONFIG_QDF_TEST
 #define WLAN_PERIODIC_WORK_TEST (1)
 #endif
@@ -1116,6 +1124,10 @@
 #define PKTLOG_HAS_SPECIFIC_DATA (1)
 #endif
 
+#ifdef CONFIG_PKTLOG_PCPU_RING
+#define PKTLOG_PCPU_RING (1)
+#endif
+
 #ifdef CONFIG_LITTLE_ENDIAN
 #define ANI_LITTLE_BYTE_ENDIAN (1)
 #define ANI_LITTLE_BIT_ENDIAN (1)
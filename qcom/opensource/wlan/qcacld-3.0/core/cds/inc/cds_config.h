@@ -84,6 +84,7 @@ struct wlan_cds_feature_set {
  * @tx_flow_stop_queue_th: Threshold to stop queue in percentage
  * @tx_flow_start_queue_offset: Start queue offset in percentage
  * @enable_dp_rx_threads: enable dp rx threads
+ * @enable_dp_rx_work_stealing: enable work stealing among dp rx threads
  * @is_lpass_enabled: Indicate whether LPASS is enabled or not
  * @tx_chain_mask_cck: Tx chain mask enabled or not
  * @sub_20_channel_width: Sub 20 MHz ch width, ini intersected with fw cap
@@ -119,6 +120,7 @@ struct cds_config_info {
 	uint32_t tx_flow_start_queue_offset;
 #endif
 	uint8_t enable_dp_rx_threads;
+	uint8_t enable_dp_rx_work_stealing;
 #ifdef WLAN_FEATURE_LPSS
 	bool is_lpass_enabled;
 #endif
@@ -29,11 +29,13 @@
 #define CFG_ENABLE_NAPI			BIT(2)
 #define CFG_ENABLE_DYNAMIC_RPS		BIT(3)
 #define CFG_ENABLE_DP_RX_THREADS	BIT(4)
+#define CFG_ENABLE_DP_RX_WORK_STEALING	BIT(5)
 #define CFG_RX_MODE_MAX (CFG_ENABLE_RX_THREAD | \
 					  CFG_ENABLE_RPS | \
 					  CFG_ENABLE_NAPI | \
 					  CFG_ENABLE_DYNAMIC_RPS | \
-					  CFG_ENABLE_DP_RX_THREADS)
+					  CFG_ENABLE_DP_RX_THREADS | \
+					  CFG_ENABLE_DP_RX_WORK_STEALING)
 #ifdef MDM_PLATFORM
 #define CFG_RX_MODE_DEFAULT 0
 #elif defined(HELIUMPLUS)
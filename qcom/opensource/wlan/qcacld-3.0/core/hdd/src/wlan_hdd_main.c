@@ -15281,6 +15281,8 @@ static inline void hdd_txrx_populate_cds_config(struct cds_config_info
 	/* configuration for DP RX Threads */
 	cds_cfg->enable_dp_rx_threads =
 		ucfg_dp_is_rx_threads_enabled(hdd_ctx->psoc);
+	cds_cfg->enable_dp_rx_work_stealing =
+		ucfg_dp_is_rx_work_stealing_enabled(hdd_ctx->psoc);
 }
 #else
 static inline void hdd_txrx_populate_cds_config(struct cds_config_info
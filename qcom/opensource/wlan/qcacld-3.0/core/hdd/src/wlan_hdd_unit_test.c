@@ -25,6 +25,7 @@
 #include "wlan_hdd_main.h"
 #include "qdf_delayed_work_test.h"
 #include "qdf_hashtable_test.h"
+#include "qdf_objpool_test.h"
 #include "qdf_periodic_work_test.h"
 #include "qdf_ptr_hash_test.h"
 #include "qdf_slist_test.h"
@@ -34,6 +35,7 @@
 #include "qdf_tracker_test.h"
 #include "qdf_types_test.h"
 #include "wlan_dsc_test.h"
+#include "wlan_scan_cache_db_test.h"
 #include "wlan_hdd_unit_test.h"
 
 typedef uint32_t (*hdd_ut_callback)(void);
@@ -47,6 +49,7 @@ struct hdd_ut_entry hdd_ut_entries[] = {
 	{ .name = "dsc", .callback = dsc_unit_test },
 	{ .name = "qdf_delayed_work", .callback = qdf_delayed_work_unit_test },
 	{ .name = "qdf_ht", .callback = qdf_ht_unit_test },
+	{ .name = "qdf_objpool", .callback = qdf_objpool_unit_test },
 	{ .name = "qdf_periodic_work",
 	  .callback = qdf_periodic_work_unit_test },
 	{ .name = "qdf_ptr_hash", .callback = qdf_ptr_hash_unit_test },
@@ -54,6 +57,7 @@ struct hdd_ut_entry hdd_ut_entries[] = {
 	{ .name = "qdf_talloc", .callback = qdf_talloc_unit_test },
 	{ .name = "qdf_tracker", .callback = qdf_tracker_unit_test },
 	{ .name = "qdf_types", .callback = qdf_types_unit_test },
+	{ .name = "scan_db", .callback = scm_scan_db_unit_test },
 };
 
 #define hdd_for_each_ut_entry(cursor) \
@@ -26,6 +26,7 @@
 #define PKTLOG_MAGIC_NUM        7735225
 
 #ifdef __linux__
+#include <linux/ioctl.h>
 #ifdef MULTI_IF_NAME
 #define PKTLOG_PROC_DIR "ath_pktlog" MULTI_IF_NAME
 #define WLANDEV_BASENAME "cld" MULTI_IF_NAME
@@ -285,6 +286,64 @@ struct ath_pktlog_buf {
 	char log_data[];
 };
 
+/*
+ * Per-CPU ring mode: the pktlog proc entry can be mmap-ed and then exposes
+ * one ring per possible CPU, laid out back to back. Each ring starts with a
+ * header page (struct ath_pktlog_pcpu_ring_hdr) followed by data_size bytes
+ * of records. head and tail are free running byte counters; the producer
+ * only advances head and the reader only advances tail. The mapping is read
+ * only: an mmap reader releases the records it is done with through
+ * PKTLOG_IOCTL_PCPU_RING_ADVANCE, a read() reader consumes them as it
+ * copies them out. Records never wrap,
+ * the space left at the end of the data area is skipped either through a
+ * record flagged PKTLOG_PCPU_REC_FLAG_PAD or, when it is smaller than a
+ * record header, implicitly.
+ */
+#define PKTLOG_PCPU_RING_MAGIC		0x504c5052
+#define PKTLOG_PCPU_REC_FLAG_PAD	0x1
+#define PKTLOG_PCPU_REC_ALIGN		8
+
+struct ath_pktlog_pcpu_ring_hdr {
+	/* Written once when the ring is set up */
+	uint32_t magic_num;
+	uint32_t version;
+	uint32_t cpu;
+	uint32_t data_size;
+	uint32_t reserved0[12];
+	/* Written by the producer */
+	uint64_t head;
+	uint64_t records;
+	uint64_t drops;
+	uint64_t reserved1[5];
+	/* Written on behalf of the reader */
+	uint64_t tail;
+	uint64_t reserved2[7];
+};
+
+/*
+ * Argument of PKTLOG_IOCTL_PCPU_RING_ADVANCE: move the tail of ring cpu to
+ * tail, which must be a record boundary between the current tail and head.
+ */
+struct ath_pktlog_pcpu_ring_advance {
+	uint32_t cpu;
+	uint32_t reserved;
+	uint64_t tail;
+};
+
+#define PKTLOG_IOCTL_PCPU_RING_ADVANCE \
+	_IOW('P', 1, struct ath_pktlog_pcpu_ring_advance)
+
+/*
+ * Each record in a per-CPU ring is this header followed by a struct
+ * ath_pktlog_hdr and its payload, padded to PKTLOG_PCPU_REC_ALIGN. The
+ * timestamp is used to merge the records of all the rings in order.
+ */
+struct ath_pktlog_pcpu_rec {
+	uint64_t timestamp;
+	uint32_t len;
+	uint32_t flags;
+};
+
 #define PKTLOG_MOV_RD_IDX(_rd_offset, _log_buf, _log_size)  \
 	do { \
 		if ((_rd_offset + sizeof(struct ath_pktlog_hdr) + \
@@ -192,6 +192,7 @@ _fixed_ipaths = [
     "cmn/umac/regulatory/core/inc",
     "cmn/umac/regulatory/core/src",
     "cmn/umac/scan/dispatcher/inc",
+    "cmn/umac/scan/test",
     "cmn/umac/thermal/dispatcher/inc",
     "cmn/umac/twt/dispatcher/inc",
     "cmn/umac/wifi_pos/inc",
@@ -394,6 +395,7 @@ _fixed_srcs = [
     "cmn/qdf/linux/src/qdf_mem.c",
     "cmn/qdf/linux/src/qdf_nbuf.c",
     "cmn/qdf/linux/src/qdf_nbuf_frag.c",
+    "cmn/qdf/linux/src/qdf_objpool.c",
     "cmn/qdf/linux/src/qdf_periodic_work.c",
     "cmn/qdf/linux/src/qdf_status.c",
     "cmn/qdf/linux/src/qdf_threads.c",
@@ -1175,6 +1177,11 @@ _conditional_srcs = {
             "cmn/utils/pktlog/pktlog_wifi3.c",
         ],
     },
+    "CONFIG_PKTLOG_PCPU_RING": {
+        True: [
+            "cmn/utils/pktlog/pktlog_pcpu_ring.c",
+        ],
+    },
     "CONFIG_PKT_LOG": {
         #TODO: Currently this is CONFIG_REMOVE_PKT_LOG but expect it to change
         #      Also need a separate config for sysfs
@@ -1375,6 +1382,7 @@ _conditional_srcs = {
         True: [
             "cmn/qdf/test/qdf_delayed_work_test.c",
             "cmn/qdf/test/qdf_hashtable_test.c",
+            "cmn/qdf/test/qdf_objpool_test.c",
             "cmn/qdf/test/qdf_periodic_work_test.c",
             "cmn/qdf/test/qdf_ptr_hash_test.c",
             "cmn/qdf/test/qdf_slist_test.c",
@@ -1429,6 +1437,11 @@ _conditional_srcs = {
             "cmn/hal/wifi3.0/hal_rx_flow.c",
         ],
     },
+    "CONFIG_SCAN_DB_TEST": {
+        True: [
+            "cmn/umac/scan/test/wlan_scan_cache_db_test.c",
+        ],
+    },
     "CONFIG_SMP": {
         True: [
             "cmn/qdf/linux/src/qdf_cpuhp.c",